@@ -2,6 +2,8 @@
 
 #include "AI/ABELSystem.h"
 #include "Core/CaseState.h"
+#include "Core/CaseDefinition.h"
+#include "Core/WitnessIds.h"
 #include "TheLastWitness.h"
 
 UABELSystem::UABELSystem()
@@ -10,8 +12,18 @@ UABELSystem::UABELSystem()
 
 void UABELSystem::Initialize(UCaseState* InCaseState)
 {
+	if (CaseState)
+	{
+		CaseState->OnEvidenceCollectedNative.RemoveAll(this);
+	}
+
 	CaseState = InCaseState;
 
+	if (CaseState)
+	{
+		CaseState->OnEvidenceCollectedNative.AddUObject(this, &UABELSystem::HandleEvidenceCollected);
+	}
+
 	UE_LOG(LogLastWitness, Log, TEXT("[ABELSystem] 初期化完了"));
 }
 
@@ -20,6 +32,7 @@ void UABELSystem::OnCaseStarted()
 	CurrentSuggestions.Empty();
 	RelationshipValue = 0;
 	CurrentDisposition = EABELDisposition::Analytical;
+	HintProgress.Reset();
 
 	// 開始時の挨拶
 	QueueComment(FText::FromString(TEXT(
@@ -46,6 +59,7 @@ void UABELSystem::GenerateSuggestions()
 	// 各提案についてイベント発火
 	for (const FABELSuggestion& Suggestion : CurrentSuggestions)
 	{
+		OnSuggestionReadyNative.Broadcast(Suggestion);
 		OnSuggestionReady.Broadcast(Suggestion);
 	}
 }
@@ -64,104 +78,114 @@ void UABELSystem::GenerateScriptedSuggestions()
 
 void UABELSystem::GenerateEvidenceConnectionSuggestions()
 {
-	const TArray<FEvidence> CollectedEvidence = CaseState->GetCollectedEvidence();
+	if (CaseState->GetCollectedEvidenceCount() < 2)
+	{
+		return;
+	}
 
-	if (CollectedEvidence.Num() < 2)
+	const TSharedPtr<const FCaseDefinition> Definition = CaseState->GetDefinition();
+	if (!Definition.IsValid())
 	{
 		return;
 	}
 
-	// 関連する証拠の組み合わせを探す
-	for (int32 i = 0; i < CollectedEvidence.Num(); i++)
+	const TArray<FEvidence>& AllEvidence = Definition->GetData().AllEvidence;
+	const FCaseRelationGraph& Graph = Definition->GetRelationGraph();
+	const TBitArray<>& Collected = CaseState->GetProgress().Evidence->Collected;
+
+	TArray<int32, TInlineAllocator<32>> CollectedIndices;
+	CaseState->GetCollectedEvidenceIndices(CollectedIndices);
+
+	// 関連グラフ上の隣接証拠のうち、収集済みのものとの組み合わせを探す（各組は小さい側から1回だけ）
+	for (const int32 IndexA : CollectedIndices)
 	{
-		for (int32 j = i + 1; j < CollectedEvidence.Num(); j++)
+		Graph.ForEachNeighbor(Graph.EvidenceNode(IndexA), ECaseNodeKind::Evidence, [&](int32 IndexB)
 		{
-			const FEvidence& A = CollectedEvidence[i];
-			const FEvidence& B = CollectedEvidence[j];
-
-			// 関連があるかチェック
-			if (A.RelatedEvidence.Contains(B.EvidenceId) || B.RelatedEvidence.Contains(A.EvidenceId))
+			if (IndexB <= IndexA || !Collected[IndexB])
 			{
-				// まだ推理で結びつけていないかチェック
-				FDeduction TempDeduction;
-				// 既に解放済みの推理を確認
-				bool bAlreadyDeduced = false;
-				for (const FDeduction& D : CaseState->GetUnlockedDeductions())
-				{
-					if ((D.EvidenceA == A.EvidenceId && D.EvidenceB == B.EvidenceId) ||
-					    (D.EvidenceA == B.EvidenceId && D.EvidenceB == A.EvidenceId))
-					{
-						bAlreadyDeduced = true;
-						break;
-					}
-				}
+				return;
+			}
 
-				if (!bAlreadyDeduced)
-				{
-					FABELSuggestion Suggestion;
-					Suggestion.SuggestionId = GenerateSuggestionId();
-					Suggestion.Type = EABELSuggestionType::EvidenceConnection;
-					Suggestion.Confidence = 0.75f;
-					Suggestion.bIsCorrect = true;
-					Suggestion.bIsEthicallyQuestionable = false;
-					Suggestion.RelatedEvidence.Add(A.EvidenceId);
-					Suggestion.RelatedEvidence.Add(B.EvidenceId);
-
-					Suggestion.Content = FText::Format(
-						NSLOCTEXT("ABEL", "ConnectionSuggestion",
-							"「{0}」と「{1}」の間に関連性を検出しました。推理ボードで結びつけることを推奨します。"),
-						A.DisplayName,
-						B.DisplayName
-					);
-
-					CurrentSuggestions.Add(Suggestion);
-				}
+			// 既に推理で結びつけていないかチェック
+			if (CaseState->IsEvidencePairDeduced(IndexA, IndexB))
+			{
+				return;
 			}
-		}
+
+			const FEvidence& A = AllEvidence[IndexA];
+			const FEvidence& B = AllEvidence[IndexB];
+
+			FABELSuggestion Suggestion;
+			Suggestion.SuggestionId = GenerateSuggestionId();
+			Suggestion.Type = EABELSuggestionType::EvidenceConnection;
+			Suggestion.Confidence = 0.75f;
+			Suggestion.bIsCorrect = true;
+			Suggestion.bIsEthicallyQuestionable = false;
+			Suggestion.RelatedEvidence.Add(A.EvidenceId);
+			Suggestion.RelatedEvidence.Add(B.EvidenceId);
+
+			Suggestion.Content = FText::Format(
+				NSLOCTEXT("ABEL", "ConnectionSuggestion",
+					"「{0}」と「{1}」の間に関連性を検出しました。推理ボードで結びつけることを推奨します。"),
+				A.DisplayName,
+				B.DisplayName
+			);
+
+			CurrentSuggestions.Add(Suggestion);
+		});
 	}
 }
 
 void UABELSystem::GenerateInterrogationSuggestions()
 {
 	// 現在のロケーションにいるキャラクターへの質問を提案
-	const ELocation CurrentLoc = CaseState->GetCurrentLocation();
-	FLocationData LocData;
-	if (!CaseState->GetLocationData(CurrentLoc, LocData))
+	const TSharedPtr<const FCaseDefinition> Definition = CaseState->GetDefinition();
+	if (!Definition.IsValid())
 	{
 		return;
 	}
 
-	for (const FName& CharId : LocData.CharactersPresent)
+	const FLocationHandle CurrentLoc = Definition->FindLocation(CaseState->GetCurrentLocation());
+	if (!CurrentLoc)
 	{
-		FCharacterData Character;
-		if (!CaseState->GetCharacterById(CharId, Character))
+		return;
+	}
+
+	// 居場所・インタビュー済みの判定はハンドルで行い、スナップショットは作らない
+	CaseState->ForEachCharacterAt(CurrentLoc.GetIndex(), [this, &Definition](int32 CharacterIndex)
+	{
+		const FCharacterHandle Handle(CharacterIndex);
+		if (CaseState->IsCharacterInterviewed(Handle))
 		{
-			continue;
+			return;
 		}
 
-		if (!Character.bHasBeenInterviewed)
-		{
-			FABELSuggestion Suggestion;
-			Suggestion.SuggestionId = GenerateSuggestionId();
-			Suggestion.Type = EABELSuggestionType::InterrogationTip;
-			Suggestion.Confidence = 0.6f;
-			Suggestion.bIsCorrect = true;
+		const FCharacterData& Character = Definition->GetCharacter(Handle);
 
-			Suggestion.Content = FText::Format(
-				NSLOCTEXT("ABEL", "InterrogationSuggestion",
-					"{0}にはまだ話を聞いていません。{1}として、有用な情報を持っている可能性があります。"),
-				Character.DisplayName,
-				Character.Role
-			);
+		FABELSuggestion Suggestion;
+		Suggestion.SuggestionId = GenerateSuggestionId();
+		Suggestion.Type = EABELSuggestionType::InterrogationTip;
+		Suggestion.Confidence = 0.6f;
+		Suggestion.bIsCorrect = true;
 
-			CurrentSuggestions.Add(Suggestion);
-		}
-	}
+		// 手元にあるこの人物に関わる証拠を、質問の材料として添える
+		Suggestion.RelatedEvidence = CaseState->QueryEvidenceIds(
+			FEvidenceQuery().RelatedTo(Character.CharacterId).WithCollected(EEvidenceStateFilter::Yes));
+
+		Suggestion.Content = FText::Format(
+			NSLOCTEXT("ABEL", "InterrogationSuggestion",
+				"{0}にはまだ話を聞いていません。{1}として、有用な情報を持っている可能性があります。"),
+			Character.DisplayName,
+			Character.Role
+		);
+
+		CurrentSuggestions.Add(Suggestion);
+	});
 }
 
 void UABELSystem::GenerateNextActionSuggestions()
 {
-	const TArray<FEvidence> CollectedEvidence = CaseState->GetCollectedEvidence();
+	const int32 CollectedCount = CaseState->GetCollectedEvidenceCount();
 
 	// 告発可能なら提案
 	if (CaseState->CanMakeAccusation())
@@ -180,7 +204,7 @@ void UABELSystem::GenerateNextActionSuggestions()
 		CurrentSuggestions.Add(Suggestion);
 	}
 	// 証拠が少ない場合は調査を促す
-	else if (CollectedEvidence.Num() < 3)
+	else if (CollectedCount < 3)
 	{
 		FABELSuggestion Suggestion;
 		Suggestion.SuggestionId = GenerateSuggestionId();
@@ -195,6 +219,121 @@ void UABELSystem::GenerateNextActionSuggestions()
 
 		CurrentSuggestions.Add(Suggestion);
 	}
+	// 行き詰まっていれば、告発までの手順から次の一手を示す
+	else
+	{
+		// 到達できない要素の一覧は不要なので、レポートではなくビット列のまま使う
+		const FCaseReachability& Reachability = GetHintReachability();
+
+		FABELSuggestion Suggestion;
+		Suggestion.SuggestionId = GenerateSuggestionId();
+		Suggestion.Type = EABELSuggestionType::NextAction;
+		Suggestion.bIsCorrect = true;
+
+		if (!Reachability.bAccusationReachable)
+		{
+			Suggestion.Confidence = 0.5f;
+			Suggestion.Content = FText::FromString(TEXT(
+				"告発に必要な証拠の一部は、もう入手できない可能性があります。"
+				"現在の証拠で推論を組み立て直すことを推奨します。"
+			));
+			CurrentSuggestions.Add(Suggestion);
+			return;
+		}
+
+		for (const FCaseSolutionStep& Step : Reachability.Steps)
+		{
+			Suggestion.Content = DescribeSolutionStep(Step);
+			if (!Suggestion.Content.IsEmpty())
+			{
+				if (Step.Action == ECaseSolutionAction::CollectEvidence)
+				{
+					Suggestion.RelatedEvidence.Add(Step.TargetId);
+				}
+				Suggestion.Confidence = 0.7f;
+				CurrentSuggestions.Add(Suggestion);
+				break;
+			}
+		}
+	}
+}
+
+const FCaseReachability& UABELSystem::GetHintReachability()
+{
+	const FCaseProgress& Progress = CaseState->GetProgress();
+	if (!HintProgress.IsSet() || !HintProgress->SharesStateWith(Progress))
+	{
+		HintReachability = CaseState->AnalyzeReachability(true);
+		HintProgress = Progress;
+	}
+	return HintReachability;
+}
+
+FText UABELSystem::DescribeSolutionStep(const FCaseSolutionStep& Step) const
+{
+	const TSharedPtr<const FCaseDefinition> Definition = CaseState->GetDefinition();
+	if (!Definition.IsValid())
+	{
+		return FText::GetEmpty();
+	}
+
+	// 手順は ID で返るので、ここで一度だけハンドルに変換して作成データを直接参照する
+	const FLocationHandle Location = Definition->FindLocation(Step.Location);
+	const FText LocationName = Location ? Definition->GetLocation(Location).DisplayName : FText::GetEmpty();
+
+	switch (Step.Action)
+	{
+	case ECaseSolutionAction::CollectEvidence:
+		{
+			const FEvidenceHandle Evidence = Definition->FindEvidence(Step.TargetId);
+			if (Evidence)
+			{
+				return FText::Format(
+					NSLOCTEXT("ABEL", "SolverCollectSuggestion", "{0}をもう一度調べてください。「{1}」が見落とされている可能性があります。"),
+					LocationName, Definition->GetEvidence(Evidence).DisplayName);
+			}
+			break;
+		}
+	case ECaseSolutionAction::TalkTo:
+		{
+			const FCharacterHandle Character = Definition->FindCharacter(Step.TargetId);
+			if (!Character)
+			{
+				break;
+			}
+
+			// 手順の場所は予定やトリガーで移動した後の居場所の場合があるため、ここでは今いる場所を示す
+			const FText& CharacterName = Definition->GetCharacter(Character).DisplayName;
+			ELocation CurrentLocation;
+			const FLocationHandle CurrentHandle = CaseState->GetCharacterLocation(Step.TargetId, CurrentLocation)
+				? Definition->FindLocation(CurrentLocation) : FLocationHandle();
+			if (!CurrentHandle)
+			{
+				return FText::Format(
+					NSLOCTEXT("ABEL", "SolverTalkSuggestionNoLocation", "{0}から、まだ引き出せる情報があると推定されます。"),
+					CharacterName);
+			}
+			return FText::Format(
+				NSLOCTEXT("ABEL", "SolverTalkSuggestion", "{0}にいる{1}から、まだ引き出せる情報があると推定されます。"),
+				Definition->GetLocation(CurrentHandle).DisplayName, CharacterName);
+		}
+	case ECaseSolutionAction::TryDeduction:
+		return NSLOCTEXT("ABEL", "SolverDeductionSuggestion", "手元の証拠だけで成立する推理が残っています。推理ボードを確認してください。");
+	case ECaseSolutionAction::WaitForCharacter:
+		{
+			const FCharacterHandle Character = Definition->FindCharacter(Step.TargetId);
+			if (Character && Location)
+			{
+				return FText::Format(
+					NSLOCTEXT("ABEL", "SolverWaitSuggestion", "{1}は後ほど{0}に現れる予定です。それまで他の調査を進めてください。"),
+					LocationName, Definition->GetCharacter(Character).DisplayName);
+			}
+			break;
+		}
+	default:
+		break;
+	}
+	return FText::GetEmpty();
 }
 
 void UABELSystem::OnSuggestionFollowed(FName SuggestionId)
@@ -419,14 +558,19 @@ void UABELSystem::OnLocationChanged(ELocation NewLocation)
 
 void UABELSystem::OnDialogueStarted(FName CharacterId)
 {
-	FCharacterData Character;
-	if (CaseState && CaseState->GetCharacterById(CharacterId, Character))
+	const TSharedPtr<const FCaseDefinition> Definition = CaseState ? CaseState->GetDefinition() : TSharedPtr<const FCaseDefinition>();
+	const FCharacterHandle Character = Definition ? Definition->FindCharacter(CharacterId) : FCharacterHandle();
+	if (!Character)
 	{
-		// 対話開始時の観察
-		if (Character.EmotionalState != EEmotionalState::Neutral)
-		{
-			QueueComment(AnalyzeCharacter(Character));
-		}
+		return;
+	}
+
+	// 対話開始時の観察（感情が平静なら分析用のスナップショットは作らない）
+	if (CaseState->GetCharacterEmotionalState(Character) != EEmotionalState::Neutral)
+	{
+		FCharacterData Snapshot;
+		CaseState->GetCharacterById(CharacterId, Snapshot);
+		QueueComment(AnalyzeCharacter(Snapshot));
 	}
 }
 
@@ -454,6 +598,12 @@ FText UABELSystem::GetAndClearPendingComment()
 	return Comment;
 }
 
+void UABELSystem::RestoreRelationshipValue(int32 InRelationshipValue)
+{
+	// 性格傾向は関係値から決まるため、差分として適用すれば両方が揃う
+	UpdateDisposition(InRelationshipValue - RelationshipValue);
+}
+
 void UABELSystem::UpdateDisposition(int32 RelationshipDelta)
 {
 	RelationshipValue = FMath::Clamp(RelationshipValue + RelationshipDelta, -100, 100);
@@ -480,6 +630,7 @@ void UABELSystem::UpdateDisposition(int32 RelationshipDelta)
 
 	if (OldDisposition != CurrentDisposition)
 	{
+		OnDispositionChangedNative.Broadcast(CurrentDisposition);
 		OnDispositionChanged.Broadcast(CurrentDisposition);
 
 		UE_LOG(LogLastWitness, Log, TEXT("[ABELSystem] 性格傾向が変化しました: %d -> %d"),
@@ -492,11 +643,19 @@ void UABELSystem::QueueComment(const FText& Comment)
 	PendingComment = Comment;
 	bHasPendingComment = true;
 
+	OnABELSpeaksNative.Broadcast(Comment);
 	OnABELSpeaks.Broadcast(Comment);
 }
 
 FName UABELSystem::GenerateSuggestionId()
 {
 	SuggestionCounter++;
-	return FName(*FString::Printf(TEXT("Suggestion_%d"), SuggestionCounter));
+	// 文字列を組み立てずに、登録済みの基底名に番号を付ける（表記は従来通り Suggestion_N）
+	return FName(FWitnessIds::Suggestion, NAME_EXTERNAL_TO_INTERNAL(SuggestionCounter));
+}
+
+void UABELSystem::HandleEvidenceCollected(int32 EvidenceIndex)
+{
+	// 作成済みデータを参照するだけで、証拠のスナップショットは作らない
+	OnEvidenceCollected(CaseState->GetCaseData().AllEvidence[EvidenceIndex]);
 }
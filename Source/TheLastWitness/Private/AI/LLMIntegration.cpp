@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AI/LLMIntegration.h"
+#include "Core/CaseSnapshot.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Dom/JsonObject.h"
@@ -65,6 +66,44 @@ FString ULLMIntegration::GetABELSystemPrompt()
 	);
 }
 
+FString ULLMIntegration::BuildCaseContextPrompt(const FCaseSnapshot& Snapshot)
+{
+	const FCaseData& CaseData = Snapshot.GetCaseData();
+	const FCaseProgress& Progress = Snapshot.Progress;
+
+	TStringBuilder<2048> Builder;
+	Builder.Appendf(TEXT("Case: %s\n"), *CaseData.Title.ToString());
+
+	const int32 LocationIndex = Snapshot.Definition->FindLocationIndex(Progress.CurrentLocation);
+	if (LocationIndex != INDEX_NONE)
+	{
+		Builder.Appendf(TEXT("Current location: %s\n"), *CaseData.AllLocations[LocationIndex].DisplayName.ToString());
+	}
+
+	Builder.Append(TEXT("Collected evidence:\n"));
+	Snapshot.ForEachCollectedEvidence([&Builder](int32 Index, const FEvidence& Evidence)
+	{
+		Builder.Appendf(TEXT("- %s: %s\n"), *Evidence.DisplayName.ToString(), *Evidence.Description.ToString());
+	});
+
+	Builder.Append(TEXT("Established deductions:\n"));
+	for (TConstSetBitIterator<> It(Progress.Deductions->Unlocked); It; ++It)
+	{
+		const FDeduction& Deduction = CaseData.AllDeductions[It.GetIndex()];
+		Builder.Appendf(TEXT("- %s: %s\n"), *Deduction.Title.ToString(), *Deduction.Description.ToString());
+	}
+
+	Builder.Append(TEXT("Interviewed people (trust 0-100):\n"));
+	for (TConstSetBitIterator<> It(Progress.Characters->Interviewed); It; ++It)
+	{
+		const FCharacterData& Character = CaseData.AllCharacters[It.GetIndex()];
+		Builder.Appendf(TEXT("- %s (%s): %d\n"), *Character.DisplayName.ToString(), *Character.Role.ToString(),
+			static_cast<int32>(Progress.Characters->TrustLevels[It.GetIndex()]));
+	}
+
+	return Builder.ToString();
+}
+
 void ULLMIntegration::TestConnection(const FOnLLMResponseReceived& OnComplete)
 {
 	RequestGeneration(
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/CaseCookCommandlet.h"
+#include "Core/CookedCase.h"
+#include "Data/TheLastWitnessCaseData.h"
+#include "TheLastWitness.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UCaseCookCommandlet::UCaseCookCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UCaseCookCommandlet::Main(const FString& Params)
+{
+	FString OutputDir;
+	FParse::Value(*Params, TEXT("Output="), OutputDir);
+
+	// 事件データと、その作成元のハッシュ
+	TArray<TPair<FCaseData, uint32>> Cases;
+	Cases.Emplace(UTheLastWitnessCaseData::CreateCaseData(), UTheLastWitnessCaseData::GetSourceHash());
+
+	int32 FailedCount = 0;
+	for (const TPair<FCaseData, uint32>& Case : Cases)
+	{
+		const FCaseData& CaseData = Case.Key;
+		const FString Path = OutputDir.IsEmpty()
+			? FCookedCase::GetCookedPath(CaseData.CaseId)
+			: OutputDir / CaseData.CaseId.ToString() + TEXT(".lwcase");
+
+		TArray<uint8> Bytes;
+		FCookedCase::Cook(CaseData, Case.Value, Bytes);
+
+		// 書き出す前に読み戻し、展開結果の要素数が元と一致するか確認する
+		const int32 NumBytes = Bytes.Num();
+		const TSharedPtr<const FCookedCase> Cooked = FCookedCase::FromBytes(Bytes);
+		const FCaseData RoundTrip = Cooked.IsValid() ? Cooked->ToCaseData() : FCaseData();
+		if (!Cooked.IsValid()
+			|| RoundTrip.CaseId != CaseData.CaseId
+			|| RoundTrip.AllEvidence.Num() != CaseData.AllEvidence.Num()
+			|| RoundTrip.AllCharacters.Num() != CaseData.AllCharacters.Num()
+			|| RoundTrip.AllLocations.Num() != CaseData.AllLocations.Num()
+			|| RoundTrip.AllDialogues.Num() != CaseData.AllDialogues.Num()
+			|| RoundTrip.AllDeductions.Num() != CaseData.AllDeductions.Num()
+			|| RoundTrip.CharacterSchedule.Num() != CaseData.CharacterSchedule.Num()
+			|| RoundTrip.Triggers.Num() != CaseData.Triggers.Num())
+		{
+			UE_LOG(LogLastWitness, Error, TEXT("[CaseCook] %s: クック結果を読み戻せません"), *CaseData.CaseId.ToString());
+			FailedCount++;
+			continue;
+		}
+
+		if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+		{
+			UE_LOG(LogLastWitness, Error, TEXT("[CaseCook] %s: 書き込みに失敗しました: %s"), *CaseData.CaseId.ToString(), *Path);
+			FailedCount++;
+			continue;
+		}
+
+		UE_LOG(LogLastWitness, Display, TEXT("[CaseCook] %s: %d バイト -> %s"), *CaseData.CaseId.ToString(), NumBytes, *Path);
+	}
+
+	return FailedCount > 0 ? 1 : 0;
+}
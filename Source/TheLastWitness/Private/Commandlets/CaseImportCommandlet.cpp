@@ -0,0 +1,562 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/CaseImportCommandlet.h"
+#include "Core/CaseDefinition.h"
+#include "Core/CaseProgress.h"
+#include "Data/CaseDataAsset.h"
+#include "Data/TheLastWitnessCaseData.h"
+#include "TheLastWitness.h"
+#include "JsonObjectConverter.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/Csv/CsvParser.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+/// <summary>
+/// インポート処理のバージョン（変換内容を変えたら上げ、既存アセットを全て再インポートさせる）
+/// </summary>
+static constexpr int32 CaseImporterVersion = 2;
+
+const TCHAR* UCaseImportCommandlet::AssetRoot = TEXT("/Game/TheLastWitness/Cases");
+
+UCaseImportCommandlet::UCaseImportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UCaseImportCommandlet::Main(const FString& Params)
+{
+#if !WITH_EDITOR
+	UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] アセットの保存にはエディタが必要です"));
+	return 1;
+#else
+	FString SourceDir = FPaths::ProjectDir() / TEXT("CaseSources");
+	FParse::Value(*Params, TEXT("Source="), SourceDir);
+	const bool bForce = FParse::Param(*Params, TEXT("Force"));
+
+	if (FParse::Param(*Params, TEXT("Export")))
+	{
+		return ExportBuiltInCases(SourceDir) ? 0 : 1;
+	}
+
+	TArray<FString> JsonFiles;
+	IFileManager::Get().FindFiles(JsonFiles, *(SourceDir / TEXT("*.json")), true, false);
+	JsonFiles.Sort();
+
+	int32 FailedCount = 0;
+	for (const FString& FileName : JsonFiles)
+	{
+		if (!ImportCase(SourceDir / FileName, bForce))
+		{
+			FailedCount++;
+		}
+	}
+
+	UE_LOG(LogLastWitness, Display, TEXT("[CaseImport] %d 件中 %d 件のインポートに失敗しました"), JsonFiles.Num(), FailedCount);
+	return FailedCount > 0 ? 1 : 0;
+#endif
+}
+
+bool UCaseImportCommandlet::ImportCase(const FString& JsonPath, bool bForce) const
+{
+#if !WITH_EDITOR
+	return false;
+#else
+	const FString BaseName = FPaths::GetBaseFilename(JsonPath);
+	const FString CsvPath = FPaths::GetPath(JsonPath) / BaseName + TEXT(".dialogue.csv");
+
+	TArray<uint8> JsonBytes;
+	if (!FFileHelper::LoadFileToArray(JsonBytes, *JsonPath))
+	{
+		UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] %s: 読み込めません"), *JsonPath);
+		return false;
+	}
+	TArray<uint8> CsvBytes;
+	const bool bHasCsv = FFileHelper::LoadFileToArray(CsvBytes, *CsvPath, FILEREAD_Silent);
+
+	// 変更の有無はファイルの時刻ではなく内容で判定する（チェックアウトし直しても再処理しない）
+	FMD5 Md5;
+	Md5.Update(reinterpret_cast<const uint8*>(&CaseImporterVersion), sizeof(CaseImporterVersion));
+	Md5.Update(JsonBytes.GetData(), JsonBytes.Num());
+	Md5.Update(CsvBytes.GetData(), CsvBytes.Num());
+	FMD5Hash Hash;
+	Hash.Set(Md5);
+	const FString SourceHash = LexToString(Hash);
+
+	const FString AssetName = TEXT("DA_Case_") + BaseName;
+	const FString PackageName = FString(AssetRoot) / AssetName;
+	UCaseDataAsset* Asset = LoadObject<UCaseDataAsset>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+
+#if WITH_EDITORONLY_DATA
+	if (Asset && !bForce && Asset->SourceHash == SourceHash)
+	{
+		UE_LOG(LogLastWitness, Display, TEXT("[CaseImport] %s: 変更なし"), *BaseName);
+		return true;
+	}
+#endif
+
+	FString JsonText;
+	FFileHelper::BufferToString(JsonText, JsonBytes.GetData(), JsonBytes.Num());
+
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonText), JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] %s: JSONとして読み込めません"), *JsonPath);
+		return false;
+	}
+
+	// 綴りを間違えたキーは変換時に黙って無視されるため、事件データの構造に無いキーは先にエラーにする
+	TArray<FString> Errors;
+	TArray<FString> Warnings;
+	CheckJsonKeys(*JsonObject, FCaseData::StaticStruct(), FString(), Errors);
+
+	FCaseData CaseData;
+	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), &CaseData, 0, 0))
+	{
+		UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] %s: JSONを事件データに変換できません"), *JsonPath);
+		return false;
+	}
+
+	if (bHasCsv)
+	{
+		FString CsvText;
+		FFileHelper::BufferToString(CsvText, CsvBytes.GetData(), CsvBytes.Num());
+		ApplyDialogueCsv(CsvText, CaseData, Errors);
+	}
+	ValidateReferences(CaseData, Errors, Warnings);
+
+	for (const FString& Warning : Warnings)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseImport] %s: %s"), *BaseName, *Warning);
+	}
+
+	if (Errors.Num() > 0)
+	{
+		for (const FString& Error : Errors)
+		{
+			UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] %s: %s"), *BaseName, *Error);
+		}
+		return false;
+	}
+
+	// 参照が正しくても解決できない事件はありうるので、ソルバーで確認して警告する（執筆途中の事件も保存できるように）
+	{
+		const TSharedRef<const FCaseDefinition> Definition = FCaseDefinition::Create(CaseData);
+		FCaseProgress Progress;
+		Progress.Initialize(*Definition);
+		const FCaseSolvabilityReport Report = Definition->GetSolver().MakeReport(*Definition, Definition->GetSolver().Solve(*Definition, Progress));
+		if (!Report.bSolvable)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseImport] %s: 告発条件を満たせません（詳細は -run=CaseValidation で確認してください）"), *BaseName);
+		}
+	}
+
+	if (!Asset)
+	{
+		UPackage* Package = CreatePackage(*PackageName);
+		Asset = NewObject<UCaseDataAsset>(Package, *AssetName, RF_Public | RF_Standalone);
+	}
+
+	Asset->CaseData = MoveTemp(CaseData);
+#if WITH_EDITORONLY_DATA
+	Asset->SourceHash = SourceHash;
+#endif
+	Asset->MarkPackageDirty();
+
+	const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!UPackage::SavePackage(Asset->GetPackage(), Asset, *PackageFileName, SaveArgs))
+	{
+		UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] %s: 保存に失敗しました: %s"), *BaseName, *PackageFileName);
+		return false;
+	}
+
+	UE_LOG(LogLastWitness, Display, TEXT("[CaseImport] %s: インポートしました -> %s"), *BaseName, *PackageName);
+	return true;
+#endif
+}
+
+bool UCaseImportCommandlet::ApplyDialogueCsv(const FString& CsvText, FCaseData& CaseData, TArray<FString>& OutErrors)
+{
+	const FCsvParser Parser(CsvText);
+	const FCsvParser::FRows& Rows = Parser.GetRows();
+	const int32 NumErrors = OutErrors.Num();
+
+	// 1行目は見出し
+	for (int32 RowIndex = 1; RowIndex < Rows.Num(); RowIndex++)
+	{
+		const TArray<const TCHAR*>& Row = Rows[RowIndex];
+		if (Row.Num() < 4)
+		{
+			if (Row.Num() > 1 || (Row.Num() == 1 && *Row[0] != TEXT('\0')))
+			{
+				OutErrors.Add(FString::Printf(TEXT("dialogue.csv %d 行目: 列が足りません"), RowIndex + 1));
+			}
+			continue;
+		}
+
+		const FName TreeId(Row[0]);
+		const FName NodeId(Row[1]);
+		const FName ChoiceId(Row[2]);
+		const FText Text = FText::FromString(Row[3]);
+
+		FDialogueTree* Tree = CaseData.AllDialogues.FindByPredicate([TreeId](const FDialogueTree& Candidate) { return Candidate.TreeId == TreeId; });
+		FDialogueNode* Node = Tree ? Tree->Nodes.FindByPredicate([NodeId](const FDialogueNode& Candidate) { return Candidate.NodeId == NodeId; }) : nullptr;
+		if (!Node)
+		{
+			OutErrors.Add(FString::Printf(TEXT("dialogue.csv %d 行目: 存在しない対話ノード %s/%s"), RowIndex + 1, Row[0], Row[1]));
+			continue;
+		}
+
+		if (ChoiceId.IsNone())
+		{
+			Node->Text = Text;
+			continue;
+		}
+
+		FDialogueChoice* Choice = Node->Choices.FindByPredicate([ChoiceId](const FDialogueChoice& Candidate) { return Candidate.ChoiceId == ChoiceId; });
+		if (!Choice)
+		{
+			OutErrors.Add(FString::Printf(TEXT("dialogue.csv %d 行目: 存在しない選択肢 %s/%s/%s"), RowIndex + 1, Row[0], Row[1], Row[2]));
+			continue;
+		}
+		Choice->DisplayText = Text;
+	}
+
+	return OutErrors.Num() == NumErrors;
+}
+
+void UCaseImportCommandlet::CheckJsonKeys(const FJsonObject& Object, const UStruct* Struct, const FString& Path, TArray<FString>& OutErrors)
+{
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+	{
+		const FString FieldPath = Path.IsEmpty() ? Field.Key : Path + TEXT(".") + Field.Key;
+
+		// FJsonObjectConverter と同じく、大文字小文字を区別せずにプロパティ名と照合する
+		const FProperty* Property = nullptr;
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			if (It->GetName().Equals(Field.Key, ESearchCase::IgnoreCase))
+			{
+				Property = *It;
+				break;
+			}
+		}
+		if (!Property)
+		{
+			OutErrors.Add(FString::Printf(TEXT("事件データに無いキー %s"), *FieldPath));
+			continue;
+		}
+
+		const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property);
+		const FStructProperty* StructProperty = CastField<FStructProperty>(ArrayProperty ? ArrayProperty->Inner : Property);
+		if (!StructProperty || !Field.Value.IsValid())
+		{
+			continue;
+		}
+
+		if (Field.Value->Type == EJson::Object)
+		{
+			CheckJsonKeys(*Field.Value->AsObject(), StructProperty->Struct, FieldPath, OutErrors);
+		}
+		else if (Field.Value->Type == EJson::Array)
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Elements = Field.Value->AsArray();
+			for (int32 i = 0; i < Elements.Num(); i++)
+			{
+				if (Elements[i].IsValid() && Elements[i]->Type == EJson::Object)
+				{
+					CheckJsonKeys(*Elements[i]->AsObject(), StructProperty->Struct, FString::Printf(TEXT("%s[%d]"), *FieldPath, i), OutErrors);
+				}
+			}
+		}
+	}
+}
+
+bool UCaseImportCommandlet::ValidateReferences(const FCaseData& CaseData, TArray<FString>& OutErrors, TArray<FString>& OutWarnings)
+{
+	const int32 NumErrors = OutErrors.Num();
+
+	TSet<FName> EvidenceIds;
+	TSet<FName> CharacterIds;
+	TSet<FName> DeductionIds;
+	TSet<FName> ProducedFlags;
+	TSet<ELocation> Locations;
+
+	auto AddUniqueId = [&OutErrors](TSet<FName>& Ids, FName Id, const TCHAR* Kind)
+	{
+		bool bAlreadyInSet = false;
+		Ids.Add(Id, &bAlreadyInSet);
+		if (Id.IsNone() || bAlreadyInSet)
+		{
+			OutErrors.Add(FString::Printf(TEXT("%sのIDが空か重複しています: %s"), Kind, *Id.ToString()));
+		}
+	};
+
+	auto Require = [&OutErrors](const TSet<FName>& Ids, FName Id, const TCHAR* Kind, const FString& Context)
+	{
+		if (!Ids.Contains(Id))
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: 存在しない%s %s"), *Context, Kind, *Id.ToString()));
+		}
+	};
+
+	auto RequireAll = [&Require](const TSet<FName>& Ids, const TArray<FName>& List, const TCHAR* Kind, const FString& Context)
+	{
+		for (const FName& Id : List)
+		{
+			Require(Ids, Id, Kind, Context);
+		}
+	};
+
+	// Blueprint から設定されるフラグもあるため、事件データ内で設定されないフラグは警告に留める
+	auto WarnUnproducedFlags = [&OutWarnings, &ProducedFlags](const TArray<FName>& Flags, const FString& Context)
+	{
+		for (const FName& Flag : Flags)
+		{
+			if (!ProducedFlags.Contains(Flag))
+			{
+				OutWarnings.Add(FString::Printf(TEXT("%s: 事件データ内で設定されないフラグ %s（Blueprint から設定しない限り満たせません）"), *Context, *Flag.ToString()));
+			}
+		}
+	};
+
+	// JSON では列挙値を数値でも書けるため、範囲外の値をここで弾く（自動生成される _MAX も無効）
+	auto RequireEnum = [&OutErrors](const UEnum* Enum, int64 Value, const FString& Context)
+	{
+		const bool bIsMax = Enum->ContainsExistingMax() && Value == Enum->GetValueByIndex(Enum->NumEnums() - 1);
+		if (!Enum->IsValidEnumValue(Value) || bIsMax)
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: %s の範囲外の値 %lld"), *Context, *Enum->GetName(), Value));
+		}
+	};
+
+	auto RequireLocation = [&OutErrors, &Locations, &RequireEnum](ELocation Location, const FString& Context)
+	{
+		const UEnum* LocationEnum = StaticEnum<ELocation>();
+		if (!LocationEnum->IsValidEnumValue(static_cast<int64>(Location)))
+		{
+			RequireEnum(LocationEnum, static_cast<int64>(Location), Context);
+			return;
+		}
+		if (!Locations.Contains(Location))
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s: 存在しないロケーション %s"), *Context, *UEnum::GetValueAsString(Location)));
+		}
+	};
+
+	// ========================================================================
+	// IDの収集
+	// ========================================================================
+
+	for (const FEvidence& Evidence : CaseData.AllEvidence)
+	{
+		AddUniqueId(EvidenceIds, Evidence.EvidenceId, TEXT("証拠"));
+	}
+	for (const FCharacterData& Character : CaseData.AllCharacters)
+	{
+		AddUniqueId(CharacterIds, Character.CharacterId, TEXT("キャラクター"));
+	}
+	for (const FDeduction& Deduction : CaseData.AllDeductions)
+	{
+		AddUniqueId(DeductionIds, Deduction.DeductionId, TEXT("推理"));
+		ProducedFlags.Append(Deduction.UnlocksFlags);
+	}
+	for (const FLocationData& Location : CaseData.AllLocations)
+	{
+		RequireEnum(StaticEnum<ELocation>(), static_cast<int64>(Location.Location), TEXT("ロケーション"));
+		bool bAlreadyInSet = false;
+		Locations.Add(Location.Location, &bAlreadyInSet);
+		if (bAlreadyInSet)
+		{
+			OutErrors.Add(FString::Printf(TEXT("ロケーションが重複しています: %s"), *UEnum::GetValueAsString(Location.Location)));
+		}
+	}
+	// 同じキャラクターのツリーは後に登録されたものだけが開始される（FCaseDefinition と同じ）
+	TMap<FName, FName> ActiveTreeByCharacter;
+	for (const FDialogueTree& Tree : CaseData.AllDialogues)
+	{
+		ActiveTreeByCharacter.Add(Tree.CharacterId, Tree.TreeId);
+		for (const FDialogueNode& Node : Tree.Nodes)
+		{
+			ProducedFlags.Append(Node.SetsFlags);
+			for (const FDialogueChoice& Choice : Node.Choices)
+			{
+				ProducedFlags.Append(Choice.SetsFlags);
+			}
+		}
+	}
+
+	// ========================================================================
+	// 参照の検証
+	// ========================================================================
+
+	Require(CharacterIds, CaseData.VictimId, TEXT("キャラクター"), TEXT("被害者"));
+	Require(CharacterIds, CaseData.TrueCulpritId, TEXT("キャラクター"), TEXT("真犯人"));
+	RequireAll(EvidenceIds, CaseData.RequiredEvidenceForAccusation, TEXT("証拠"), TEXT("告発条件"));
+
+	for (const FEvidence& Evidence : CaseData.AllEvidence)
+	{
+		const FString Context = TEXT("証拠 ") + Evidence.EvidenceId.ToString();
+		RequireAll(CharacterIds, Evidence.RelatedCharacters, TEXT("キャラクター"), Context);
+		RequireAll(EvidenceIds, Evidence.RelatedEvidence, TEXT("証拠"), Context);
+		RequireLocation(Evidence.FoundAt, Context);
+		RequireEnum(StaticEnum<EEvidenceType>(), static_cast<int64>(Evidence.Type), Context);
+		RequireEnum(StaticEnum<EEvidenceImportance>(), static_cast<int64>(Evidence.Importance), Context);
+	}
+
+	for (const FCharacterData& Character : CaseData.AllCharacters)
+	{
+		const FString Context = TEXT("キャラクター ") + Character.CharacterId.ToString();
+		RequireEnum(StaticEnum<EEmotionalState>(), static_cast<int64>(Character.EmotionalState), Context);
+		RequireEnum(StaticEnum<ELocation>(), static_cast<int64>(Character.CurrentLocation), Context);
+	}
+
+	for (const FLocationData& Location : CaseData.AllLocations)
+	{
+		const FString Context = TEXT("ロケーション ") + UEnum::GetValueAsString(Location.Location);
+		RequireAll(EvidenceIds, Location.AvailableEvidence, TEXT("証拠"), Context);
+		RequireAll(CharacterIds, Location.CharactersPresent, TEXT("キャラクター"), Context);
+	}
+
+	TSet<FName> TreeIds;
+	TSet<FName> NodeIds;
+	for (const FDialogueTree& Tree : CaseData.AllDialogues)
+	{
+		const FString TreeContext = TEXT("対話 ") + Tree.TreeId.ToString();
+		AddUniqueId(TreeIds, Tree.TreeId, TEXT("対話ツリー"));
+		Require(CharacterIds, Tree.CharacterId, TEXT("キャラクター"), TreeContext);
+
+		NodeIds.Reset();
+		for (const FDialogueNode& Node : Tree.Nodes)
+		{
+			AddUniqueId(NodeIds, Node.NodeId, TEXT("対話ノード"));
+		}
+		Require(NodeIds, Tree.StartNodeId, TEXT("ノード"), TreeContext);
+
+		for (const FDialogueNode& Node : Tree.Nodes)
+		{
+			const FString NodeContext = TreeContext + TEXT("/") + Node.NodeId.ToString();
+			if (!Node.SpeakerId.IsNone())
+			{
+				Require(CharacterIds, Node.SpeakerId, TEXT("キャラクター"), NodeContext);
+			}
+			if (!Node.NextNodeId.IsNone())
+			{
+				Require(NodeIds, Node.NextNodeId, TEXT("ノード"), NodeContext);
+			}
+			RequireAll(EvidenceIds, Node.GainsEvidence, TEXT("証拠"), NodeContext);
+			RequireEnum(StaticEnum<EEmotionalState>(), static_cast<int64>(Node.Emotion), NodeContext);
+
+			for (const FDialogueChoice& Choice : Node.Choices)
+			{
+				const FString ChoiceContext = NodeContext + TEXT("/") + Choice.ChoiceId.ToString();
+				if (!Choice.NextNodeId.IsNone())
+				{
+					Require(NodeIds, Choice.NextNodeId, TEXT("ノード"), ChoiceContext);
+				}
+				RequireAll(EvidenceIds, Choice.RequiredEvidence, TEXT("証拠"), ChoiceContext);
+				WarnUnproducedFlags(Choice.RequiredFlags, ChoiceContext);
+				RequireEnum(StaticEnum<EDialogueTone>(), static_cast<int64>(Choice.Tone), ChoiceContext);
+			}
+		}
+	}
+
+	for (const FDeduction& Deduction : CaseData.AllDeductions)
+	{
+		const FString Context = TEXT("推理 ") + Deduction.DeductionId.ToString();
+		if (!Deduction.IsDerived())
+		{
+			Require(EvidenceIds, Deduction.EvidenceA, TEXT("証拠"), Context);
+			Require(EvidenceIds, Deduction.EvidenceB, TEXT("証拠"), Context);
+		}
+		RequireAll(EvidenceIds, Deduction.PremiseEvidence, TEXT("証拠"), Context);
+		RequireAll(DeductionIds, Deduction.PremiseDeductions, TEXT("推理"), Context);
+
+		// 対話はキャラクターごとのツリー単位で開始されるため、解放する対話はツリーIDで指定する
+		for (const FName& TreeId : Deduction.UnlocksDialogue)
+		{
+			const FDialogueTree* Tree = CaseData.AllDialogues.FindByPredicate([TreeId](const FDialogueTree& Candidate) { return Candidate.TreeId == TreeId; });
+			if (!Tree)
+			{
+				OutErrors.Add(FString::Printf(TEXT("%s: 存在しない対話ツリー %s"), *Context, *TreeId.ToString()));
+			}
+			else if (ActiveTreeByCharacter.FindRef(Tree->CharacterId) != TreeId)
+			{
+				OutErrors.Add(FString::Printf(TEXT("%s: 対話ツリー %s は同じキャラクターの後のツリーに置き換えられるため開始されません"), *Context, *TreeId.ToString()));
+			}
+		}
+	}
+
+	for (const FCharacterScheduleEntry& Entry : CaseData.CharacterSchedule)
+	{
+		const FString Context = FString::Printf(TEXT("移動予定 %s (%d 分)"), *Entry.CharacterId.ToString(), Entry.AtMinute);
+		Require(CharacterIds, Entry.CharacterId, TEXT("キャラクター"), Context);
+		RequireLocation(Entry.Location, Context);
+	}
+
+	TSet<FName> TriggerIds;
+	for (const FCaseTrigger& Trigger : CaseData.Triggers)
+	{
+		const FString Context = TEXT("トリガー ") + Trigger.TriggerId.ToString();
+		AddUniqueId(TriggerIds, Trigger.TriggerId, TEXT("トリガー"));
+		WarnUnproducedFlags(Trigger.RequiredFlags, Context);
+		RequireAll(EvidenceIds, Trigger.RequiredEvidence, TEXT("証拠"), Context);
+		RequireAll(DeductionIds, Trigger.RequiredDeductions, TEXT("推理"), Context);
+		for (const FTriggerTrustCondition& Condition : Trigger.TrustConditions)
+		{
+			Require(CharacterIds, Condition.CharacterId, TEXT("キャラクター"), Context);
+		}
+		for (const FTriggerAction& Action : Trigger.Actions)
+		{
+			RequireEnum(StaticEnum<ETriggerActionType>(), static_cast<int64>(Action.Type), Context);
+			if (Action.Type == ETriggerActionType::SetEmotionalState)
+			{
+				RequireEnum(StaticEnum<EEmotionalState>(), static_cast<int64>(Action.EmotionalState), Context);
+			}
+			if (Action.Type != ETriggerActionType::SetLocationAccessible)
+			{
+				Require(CharacterIds, Action.CharacterId, TEXT("キャラクター"), Context);
+			}
+			if (Action.Type != ETriggerActionType::SetEmotionalState)
+			{
+				RequireLocation(Action.Location, Context);
+			}
+		}
+	}
+
+	return OutErrors.Num() == NumErrors;
+}
+
+bool UCaseImportCommandlet::ExportBuiltInCases(const FString& SourceDir) const
+{
+	TArray<FCaseData> Cases;
+	Cases.Add(UTheLastWitnessCaseData::CreateCaseData());
+
+	bool bAllSaved = true;
+	for (const FCaseData& CaseData : Cases)
+	{
+		FString JsonText;
+		const FString Path = SourceDir / CaseData.CaseId.ToString() + TEXT(".json");
+		if (!FJsonObjectConverter::UStructToJsonObjectString(CaseData, JsonText)
+			|| !FFileHelper::SaveStringToFile(JsonText, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogLastWitness, Error, TEXT("[CaseImport] %s: 書き出しに失敗しました"), *CaseData.CaseId.ToString());
+			bAllSaved = false;
+			continue;
+		}
+		UE_LOG(LogLastWitness, Display, TEXT("[CaseImport] %s: 書き出しました -> %s"), *CaseData.CaseId.ToString(), *Path);
+	}
+	return bAllSaved;
+}
@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Commandlets/CaseValidationCommandlet.h"
+#include "Core/CaseDefinition.h"
+#include "Core/CaseProgress.h"
+#include "Data/CaseDataAsset.h"
+#include "Data/StressCaseGenerator.h"
+#include "Data/TheLastWitnessCaseData.h"
+#include "TheLastWitness.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/AssetManager.h"
+
+UCaseValidationCommandlet::UCaseValidationCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UCaseValidationCommandlet::Main(const FString& Params)
+{
+	const bool bShowPlan = FParse::Param(*Params, TEXT("ShowPlan"));
+
+	TArray<FCaseData> Cases;
+	Cases.Add(UTheLastWitnessCaseData::CreateCaseData());
+
+	// インポートした事件も、読み込めなければ検証できなかったものとして失敗に数える
+	int32 FailedCount = 0;
+	if (!CollectCaseAssets(Cases))
+	{
+		FailedCount++;
+	}
+
+	int32 StressScale = 0;
+	if (FParse::Value(*Params, TEXT("Stress="), StressScale) && StressScale > 0)
+	{
+		int32 Seed = 1;
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+		Cases.Add(UStressCaseGenerator::Generate(UStressCaseGenerator::MakeScaledParams(StressScale, Seed)));
+	}
+
+	for (FCaseData& CaseData : Cases)
+	{
+		if (!ValidateCase(MoveTemp(CaseData), bShowPlan))
+		{
+			FailedCount++;
+		}
+	}
+
+	UE_LOG(LogLastWitness, Display, TEXT("[CaseValidation] %d 件中 %d 件の事件が解決できません"), Cases.Num(), FailedCount);
+	return FailedCount > 0 ? 1 : 0;
+}
+
+bool UCaseValidationCommandlet::CollectCaseAssets(TArray<FCaseData>& OutCases) const
+{
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		UE_LOG(LogLastWitness, Error, TEXT("[CaseValidation] アセットマネージャーが初期化されていないため、事件データアセットを検証できません"));
+		return false;
+	}
+
+	// コマンドレットではアセットレジストリの探索が終わっていないため、完了を待ってから一覧を作り直す
+	UAssetManager::GetAssetRegistry().SearchAllAssets(true);
+#if WITH_EDITOR
+	AssetManager->RefreshPrimaryAssetDirectory();
+#endif
+
+	TArray<FPrimaryAssetId> AssetIds;
+	AssetManager->GetPrimaryAssetIdList(UCaseDataAsset::PrimaryAssetType, AssetIds);
+
+	bool bAllLoaded = true;
+	for (const FPrimaryAssetId& AssetId : AssetIds)
+	{
+		const UCaseDataAsset* Asset = Cast<UCaseDataAsset>(AssetManager->GetPrimaryAssetPath(AssetId).TryLoad());
+		if (!Asset)
+		{
+			UE_LOG(LogLastWitness, Error, TEXT("[CaseValidation] 事件データアセットを読み込めません: %s"), *AssetId.ToString());
+			bAllLoaded = false;
+			continue;
+		}
+		OutCases.Add(Asset->CaseData);
+	}
+
+	UE_LOG(LogLastWitness, Display, TEXT("[CaseValidation] 事件データアセット: %d 件"), AssetIds.Num());
+	return bAllLoaded;
+}
+
+bool UCaseValidationCommandlet::ValidateCase(FCaseData CaseData, bool bShowPlan) const
+{
+	const double CreateStartTime = FPlatformTime::Seconds();
+	const TSharedRef<const FCaseDefinition> Definition = FCaseDefinition::Create(MoveTemp(CaseData));
+	const double CreateMs = (FPlatformTime::Seconds() - CreateStartTime) * 1000.0;
+	const FString CaseName = Definition->GetData().CaseId.ToString();
+
+	UE_LOG(LogLastWitness, Display, TEXT("[CaseValidation] %s: 証拠 %d, キャラクター %d, 推理 %d, フラグ %d（定義の構築 %.3f ms）"),
+		*CaseName, Definition->NumEvidence(), Definition->NumCharacters(), Definition->NumDeductions(), Definition->NumFlags(), CreateMs);
+
+	FCaseProgress Progress;
+	Progress.Initialize(*Definition);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FCaseReachability Reachability = Definition->GetSolver().Solve(*Definition, Progress);
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	const FCaseSolvabilityReport Report = Definition->GetSolver().MakeReport(*Definition, MoveTemp(Reachability));
+
+	for (const FName& EvidenceId : Report.UnreachableEvidence)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseValidation] %s: 入手できない証拠 %s"), *CaseName, *EvidenceId.ToString());
+	}
+	for (const FName& FlagName : Report.UnreachableFlags)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseValidation] %s: 設定できないフラグ %s"), *CaseName, *FlagName.ToString());
+	}
+	for (const FName& DeductionId : Report.UnreachableDeductions)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseValidation] %s: 解放できない推理 %s"), *CaseName, *DeductionId.ToString());
+	}
+	for (const FString& NodeName : Report.UnreachableDialogueNodes)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseValidation] %s: 到達できない対話ノード %s"), *CaseName, *NodeName);
+	}
+
+	if (!Report.bSolvable)
+	{
+		UE_LOG(LogLastWitness, Error, TEXT("[CaseValidation] %s: 告発条件を満たせません (%.3f ms)"), *CaseName, ElapsedMs);
+		return false;
+	}
+
+	UE_LOG(LogLastWitness, Display, TEXT("[CaseValidation] %s: 解決可能 (%d 手, %.3f ms)"), *CaseName, Report.Steps.Num(), ElapsedMs);
+
+	if (bShowPlan)
+	{
+		const UEnum* ActionEnum = StaticEnum<ECaseSolutionAction>();
+		for (int32 i = 0; i < Report.Steps.Num(); i++)
+		{
+			const FCaseSolutionStep& Step = Report.Steps[i];
+			UE_LOG(LogLastWitness, Display, TEXT("[CaseValidation]   %3d. %s %s"), i + 1,
+				*ActionEnum->GetNameStringByValue(static_cast<int64>(Step.Action)),
+				Step.Action == ECaseSolutionAction::TravelTo ? *UEnum::GetValueAsString(Step.Location) : *Step.TargetId.ToString());
+		}
+	}
+
+	return true;
+}
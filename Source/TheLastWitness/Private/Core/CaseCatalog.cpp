@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseCatalog.h"
+#include "Core/CaseDefinition.h"
+#include "Data/CaseDataAsset.h"
+#include "TheLastWitness.h"
+#include "Async/Async.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Internationalization/TextStringHelper.h"
+
+void UCaseCatalog::Deinitialize()
+{
+	CancelPendingLoad();
+	Entries.Empty();
+	bEntriesValid = false;
+
+	Super::Deinitialize();
+}
+
+// ============================================================================
+// カタログ
+// ============================================================================
+
+void UCaseCatalog::Refresh()
+{
+	Entries.Reset();
+	bEntriesValid = true;
+
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseCatalog] アセットマネージャーが初期化されていません"));
+		return;
+	}
+
+	TArray<FAssetData> AssetDataList;
+	AssetManager->GetPrimaryAssetDataList(UCaseDataAsset::PrimaryAssetType, AssetDataList);
+
+	Entries.Reserve(AssetDataList.Num());
+	for (const FAssetData& AssetData : AssetDataList)
+	{
+		FCaseCatalogEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.AssetId = AssetManager->GetPrimaryAssetIdForData(AssetData);
+		Entry.CaseId = Entry.AssetId.PrimaryAssetName;
+
+		// タグにはローカライズ情報ごと書き出してあるので、現在の言語で解決される
+		FString Text;
+		if (AssetData.GetTagValue(UCaseDataAsset::TitleTag, Text))
+		{
+			FTextStringHelper::ReadFromBuffer(*Text, Entry.Title);
+		}
+		if (AssetData.GetTagValue(UCaseDataAsset::SynopsisTag, Text))
+		{
+			FTextStringHelper::ReadFromBuffer(*Text, Entry.Synopsis);
+		}
+		AssetData.GetTagValue(UCaseDataAsset::NumCharactersTag, Entry.NumCharacters);
+		AssetData.GetTagValue(UCaseDataAsset::NumEvidenceTag, Entry.NumEvidence);
+		AssetData.GetTagValue(UCaseDataAsset::NumDeductionsTag, Entry.NumDeductions);
+	}
+
+	Entries.Sort([](const FCaseCatalogEntry& A, const FCaseCatalogEntry& B) { return A.CaseId.LexicalLess(B.CaseId); });
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseCatalog] %d 件の事件を登録しました"), Entries.Num());
+}
+
+const TArray<FCaseCatalogEntry>& UCaseCatalog::GetEntries()
+{
+	if (!bEntriesValid)
+	{
+		Refresh();
+	}
+	return Entries;
+}
+
+bool UCaseCatalog::FindEntry(FName CaseId, FCaseCatalogEntry& OutEntry)
+{
+	const FCaseCatalogEntry* Found = GetEntries().FindByPredicate([CaseId](const FCaseCatalogEntry& Entry) { return Entry.CaseId == CaseId; });
+	if (!Found)
+	{
+		return false;
+	}
+
+	OutEntry = *Found;
+	return true;
+}
+
+void UCaseCatalog::AddSearchPath(const FString& Path)
+{
+	UAssetManager* AssetManager = UAssetManager::GetIfInitialized();
+	if (!AssetManager)
+	{
+		return;
+	}
+
+	AssetManager->ScanPathForPrimaryAssets(UCaseDataAsset::PrimaryAssetType, Path, UCaseDataAsset::StaticClass(), false);
+	Refresh();
+}
+
+FPrimaryAssetId UCaseCatalog::FindAssetId(FName CaseId)
+{
+	FCaseCatalogEntry Entry;
+	return FindEntry(CaseId, Entry) ? Entry.AssetId : FPrimaryAssetId();
+}
+
+// ============================================================================
+// 読み込み
+// ============================================================================
+
+bool UCaseCatalog::LoadCaseAsync(FName CaseId, FOnCaseDefinitionLoaded OnLoaded)
+{
+	const FPrimaryAssetId AssetId = FindAssetId(CaseId);
+	if (!AssetId.IsValid())
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseCatalog] カタログに無い事件です: %s"), *CaseId.ToString());
+		return false;
+	}
+
+	CancelPendingLoad();
+	PendingCallback = MoveTemp(OnLoaded);
+	const uint32 Serial = ++LoadSerial;
+
+	// 読み込み済みの場合は LoadPrimaryAsset の中で完了通知が呼ばれることがある
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().LoadPrimaryAsset(AssetId, TArray<FName>(),
+		FStreamableDelegate::CreateUObject(this, &UCaseCatalog::HandleAssetLoaded, AssetId, Serial));
+	if (Serial == LoadSerial && IsLoading())
+	{
+		PendingHandle = MoveTemp(Handle);
+	}
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseCatalog] 事件の読み込みを開始しました: %s"), *CaseId.ToString());
+	return true;
+}
+
+TSharedPtr<const FCaseDefinition> UCaseCatalog::LoadCaseSynchronous(FName CaseId)
+{
+	CancelPendingLoad();
+
+	const FPrimaryAssetId AssetId = FindAssetId(CaseId);
+	if (!AssetId.IsValid())
+	{
+		return nullptr;
+	}
+
+	UAssetManager::Get().GetPrimaryAssetPath(AssetId).TryLoad();
+
+	FCaseData CaseData;
+	if (!TakeCaseData(AssetId, CaseData))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseCatalog] 事件を読み込めません: %s"), *CaseId.ToString());
+		return nullptr;
+	}
+	return FCaseDefinition::Create(MoveTemp(CaseData));
+}
+
+void UCaseCatalog::CancelPendingLoad()
+{
+	if (!IsLoading())
+	{
+		return;
+	}
+
+	// 通し番号を進めておけば、ワーカースレッドで構築中の事件定義も完了時に破棄される
+	LoadSerial++;
+	PendingCallback.Unbind();
+	if (PendingHandle.IsValid())
+	{
+		PendingHandle->CancelHandle();
+		PendingHandle.Reset();
+	}
+}
+
+void UCaseCatalog::HandleAssetLoaded(FPrimaryAssetId AssetId, uint32 Serial)
+{
+	if (Serial != LoadSerial)
+	{
+		return;
+	}
+	PendingHandle.Reset();
+
+	FCaseData CaseData;
+	if (!TakeCaseData(AssetId, CaseData))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseCatalog] 事件を読み込めません: %s"), *AssetId.ToString());
+		FOnCaseDefinitionLoaded Callback = MoveTemp(PendingCallback);
+		PendingCallback.Unbind();
+		Callback.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	// 事件定義は不変でUObjectを参照しないので、構築はワーカースレッドに任せる
+	TWeakObjectPtr<UCaseCatalog> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Serial, CaseData = MoveTemp(CaseData)]() mutable
+	{
+		TSharedPtr<const FCaseDefinition> Definition = FCaseDefinition::Create(MoveTemp(CaseData));
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Definition = MoveTemp(Definition)]()
+		{
+			UCaseCatalog* This = WeakThis.Get();
+			if (!This || Serial != This->LoadSerial || !This->IsLoading())
+			{
+				return;
+			}
+
+			FOnCaseDefinitionLoaded Callback = MoveTemp(This->PendingCallback);
+			This->PendingCallback.Unbind();
+
+			UE_LOG(LogLastWitness, Log, TEXT("[CaseCatalog] 事件を読み込みました: %s"), *Definition->GetData().CaseId.ToString());
+			Callback.ExecuteIfBound(Definition);
+		});
+	});
+}
+
+bool UCaseCatalog::TakeCaseData(FPrimaryAssetId AssetId, FCaseData& OutCaseData)
+{
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const UCaseDataAsset* Asset = AssetManager.GetPrimaryAssetObject<UCaseDataAsset>(AssetId);
+	if (!Asset)
+	{
+		return false;
+	}
+
+	// 事件定義は事件データの複製を持つので、アセット自体はここで手放してよい
+	OutCaseData = Asset->CaseData;
+	AssetManager.UnloadPrimaryAsset(AssetId);
+	return true;
+}
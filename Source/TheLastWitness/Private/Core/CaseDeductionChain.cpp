@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseDeductionChain.h"
+#include "Core/CaseDefinition.h"
+#include "TheLastWitness.h"
+
+namespace
+{
+	/// <summary>
+	/// 規則 → 前提の CSR を反転し、前提 → 規則の CSR を作ります（各行の規則は昇順）
+	/// </summary>
+	void InvertPremises(int32 NumFacts, const TArray<int32>& RowStart, const TArray<int32>& Premises,
+		TArray<int32>& OutFactStart, TArray<int32>& OutFactRules)
+	{
+		OutFactStart.Init(0, NumFacts + 1);
+		for (const int32 Fact : Premises)
+		{
+			OutFactStart[Fact + 1]++;
+		}
+		for (int32 Fact = 0; Fact < NumFacts; Fact++)
+		{
+			OutFactStart[Fact + 1] += OutFactStart[Fact];
+		}
+
+		TArray<int32> Cursor(OutFactStart.GetData(), NumFacts);
+		OutFactRules.SetNumUninitialized(Premises.Num());
+		for (int32 Rule = 0; Rule + 1 < RowStart.Num(); Rule++)
+		{
+			for (int32 i = RowStart[Rule]; i < RowStart[Rule + 1]; i++)
+			{
+				OutFactRules[Cursor[Premises[i]]++] = Rule;
+			}
+		}
+	}
+}
+
+void FCaseDeductionChain::Build(const FCaseDefinition& Definition)
+{
+	const TArray<FDeduction>& AllDeductions = Definition.GetData().AllDeductions;
+
+	RuleDeduction.Reset();
+	DeductionRule.Init(INDEX_NONE, AllDeductions.Num());
+	PremiseEvidenceStart.Reset();
+	PremiseEvidence.Reset();
+	PremiseDeductionStart.Reset();
+	PremiseDeductions.Reset();
+
+	TArray<int32, TInlineAllocator<8>> RuleEvidence;
+	TArray<int32, TInlineAllocator<8>> RuleDeductions;
+
+	for (int32 DeductionIndex = 0; DeductionIndex < AllDeductions.Num(); DeductionIndex++)
+	{
+		const FDeduction& Deduction = AllDeductions[DeductionIndex];
+		const bool bHasPremises = Deduction.PremiseEvidence.Num() > 0 || Deduction.PremiseDeductions.Num() > 0;
+
+		if (!Deduction.IsDerived())
+		{
+			if (bHasPremises)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseDeductionChain] 推理 %s は証拠の組み合わせで成立するため、前提の指定は無視されます"),
+					*Deduction.DeductionId.ToString());
+			}
+			continue;
+		}
+
+		// 重複IDは先に定義されたものだけが推理として引けるので、後のものは規則にしない
+		if (Definition.FindDeductionIndex(Deduction.DeductionId) != DeductionIndex)
+		{
+			continue;
+		}
+
+		if (!bHasPremises)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseDeductionChain] 推理 %s には証拠の組も前提もありません"), *Deduction.DeductionId.ToString());
+			continue;
+		}
+
+		bool bValid = true;
+		RuleEvidence.Reset();
+		RuleDeductions.Reset();
+
+		for (const FName& EvidenceId : Deduction.PremiseEvidence)
+		{
+			const int32 EvidenceIndex = Definition.FindEvidenceIndex(EvidenceId);
+			if (EvidenceIndex == INDEX_NONE)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseDeductionChain] 推理 %s が存在しない証拠を前提にしています: %s"),
+					*Deduction.DeductionId.ToString(), *EvidenceId.ToString());
+				bValid = false;
+				continue;
+			}
+			RuleEvidence.AddUnique(EvidenceIndex);
+		}
+
+		for (const FName& PremiseId : Deduction.PremiseDeductions)
+		{
+			const int32 PremiseIndex = Definition.FindDeductionIndex(PremiseId);
+			if (PremiseIndex == INDEX_NONE || PremiseIndex == DeductionIndex)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseDeductionChain] 推理 %s の前提となる推理が不正です: %s"),
+					*Deduction.DeductionId.ToString(), *PremiseId.ToString());
+				bValid = false;
+				continue;
+			}
+			RuleDeductions.AddUnique(PremiseIndex);
+		}
+
+		if (!bValid)
+		{
+			continue;
+		}
+
+		DeductionRule[DeductionIndex] = RuleDeduction.Add(DeductionIndex);
+		PremiseEvidenceStart.Add(PremiseEvidence.Num());
+		PremiseEvidence.Append(RuleEvidence);
+		PremiseDeductionStart.Add(PremiseDeductions.Num());
+		PremiseDeductions.Append(RuleDeductions);
+	}
+	PremiseEvidenceStart.Add(PremiseEvidence.Num());
+	PremiseDeductionStart.Add(PremiseDeductions.Num());
+
+	InvertPremises(Definition.NumEvidence(), PremiseEvidenceStart, PremiseEvidence, EvidenceRuleStart, EvidenceRules);
+	InvertPremises(AllDeductions.Num(), PremiseDeductionStart, PremiseDeductions, DeductionRuleStart, DeductionRules);
+}
+
+SIZE_T FCaseDeductionChain::GetAllocatedSize() const
+{
+	return RuleDeduction.GetAllocatedSize()
+		+ DeductionRule.GetAllocatedSize()
+		+ PremiseEvidenceStart.GetAllocatedSize()
+		+ PremiseEvidence.GetAllocatedSize()
+		+ PremiseDeductionStart.GetAllocatedSize()
+		+ PremiseDeductions.GetAllocatedSize()
+		+ EvidenceRuleStart.GetAllocatedSize()
+		+ EvidenceRules.GetAllocatedSize()
+		+ DeductionRuleStart.GetAllocatedSize()
+		+ DeductionRules.GetAllocatedSize();
+}
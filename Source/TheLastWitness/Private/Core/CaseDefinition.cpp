@@ -0,0 +1,529 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseDefinition.h"
+#include "TheLastWitness.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+
+TSharedRef<const FCaseDefinition> FCaseDefinition::Create(FCaseData InData)
+{
+	TSharedRef<FCaseDefinition> Definition = MakeShareable(new FCaseDefinition());
+	Definition->Data = MoveTemp(InData);
+	Definition->BuildLookupTables();
+	Definition->CompileFlagsAndRequirements();
+	Definition->BuildAggregateTables();
+	Definition->BuildEvidenceIndices();
+	Definition->CompileSchedule();
+	Definition->RelationGraph.Build(*Definition);
+	Definition->DeductionChain.Build(*Definition);
+	Definition->TriggerIndex.Build(*Definition);
+	Definition->Solver.Build(*Definition);
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseDefinition] 事件定義を作成しました: %s (証拠 %d, キャラクター %d, 推理 %d (導出 %d), フラグ %d, トリガー %d, 関係 %d)"),
+		*Definition->Data.CaseId.ToString(),
+		Definition->NumEvidence(),
+		Definition->NumCharacters(),
+		Definition->NumDeductions(),
+		Definition->DeductionChain.NumRules(),
+		Definition->NumFlags(),
+		Definition->TriggerIndex.NumTriggers(),
+		Definition->RelationGraph.NumEdges());
+
+	return Definition;
+}
+
+// ============================================================================
+// ID検索
+// ============================================================================
+
+int32 FCaseDefinition::FindEvidenceIndex(FName EvidenceId) const
+{
+	const int32* Found = EvidenceIndexMap.Find(EvidenceId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FCaseDefinition::FindCharacterIndex(FName CharacterId) const
+{
+	const int32* Found = CharacterIndexMap.Find(CharacterId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FCaseDefinition::FindLocationIndex(ELocation Location) const
+{
+	const int32* Found = LocationIndexMap.Find(Location);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FCaseDefinition::FindDeductionIndex(FName DeductionId) const
+{
+	const int32* Found = DeductionIndexMap.Find(DeductionId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FCaseDefinition::FindDeductionByEvidencePair(int32 EvidenceIndexA, int32 EvidenceIndexB) const
+{
+	const int32* Found = DeductionPairIndex.Find(MakeEvidencePairKey(EvidenceIndexA, EvidenceIndexB));
+	return Found ? *Found : INDEX_NONE;
+}
+
+uint64 FCaseDefinition::MakeEvidencePairKey(int32 EvidenceIndexA, int32 EvidenceIndexB)
+{
+	const uint32 Low = static_cast<uint32>(FMath::Min(EvidenceIndexA, EvidenceIndexB));
+	const uint32 High = static_cast<uint32>(FMath::Max(EvidenceIndexA, EvidenceIndexB));
+	return (static_cast<uint64>(Low) << 32) | High;
+}
+
+// ============================================================================
+// フラグ
+// ============================================================================
+
+int32 FCaseDefinition::FindFlagIndex(FName FlagName) const
+{
+	const int32* Found = FlagIndexMap.Find(FlagName);
+	return Found ? *Found : INDEX_NONE;
+}
+
+bool FCaseDefinition::ContainsAllFlags(const TBitArray<>& FlagBits, FCompiledMask Mask) const
+{
+	return Mask.IsEmpty() || ContainsAllWords(FlagBits.GetData(), GetMaskWords(Mask), NumFlagWords());
+}
+
+bool FCaseDefinition::ContainsAllEvidence(const TBitArray<>& EvidenceBits, FCompiledMask Mask) const
+{
+	return Mask.IsEmpty() || ContainsAllWords(EvidenceBits.GetData(), GetMaskWords(Mask), NumEvidenceWords());
+}
+
+// ============================================================================
+// キャラクターの予定
+// ============================================================================
+
+int32 FCaseDefinition::FindFirstScheduleEntryAfter(int32 Minute) const
+{
+	return Algo::UpperBoundBy(Schedule, Minute, &FCompiledScheduleEntry::AtMinute);
+}
+
+// ============================================================================
+// 対話
+// ============================================================================
+
+int32 FCaseDefinition::FindDialogueTreeIndex(FName CharacterId) const
+{
+	const int32* Found = DialogueTreeIndexMap.Find(CharacterId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FCaseDefinition::FindDialogueNodeIndex(int32 TreeIndex, FName NodeId) const
+{
+	const int32* Found = TreeData[TreeIndex].NodeIndexMap.Find(NodeId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+const FCompiledDialogueNode& FCaseDefinition::GetCompiledNode(int32 TreeIndex, int32 NodeIndex) const
+{
+	return NodeData[TreeData[TreeIndex].FirstNode + NodeIndex];
+}
+
+const FCompiledDialogueChoice& FCaseDefinition::GetCompiledChoice(int32 TreeIndex, int32 NodeIndex, int32 ChoiceIndex) const
+{
+	return ChoiceData[GetCompiledNode(TreeIndex, NodeIndex).FirstChoice + ChoiceIndex];
+}
+
+// ============================================================================
+// Private
+// ============================================================================
+
+void FCaseDefinition::BuildLookupTables()
+{
+	EvidenceIndexMap.Empty(Data.AllEvidence.Num());
+	for (int32 i = 0; i < Data.AllEvidence.Num(); i++)
+	{
+		// 重複IDは先に定義されたものを優先（従来の線形探索と同じ結果）
+		if (!EvidenceIndexMap.Contains(Data.AllEvidence[i].EvidenceId))
+		{
+			EvidenceIndexMap.Add(Data.AllEvidence[i].EvidenceId, i);
+		}
+	}
+
+	CharacterIndexMap.Empty(Data.AllCharacters.Num());
+	for (int32 i = 0; i < Data.AllCharacters.Num(); i++)
+	{
+		if (!CharacterIndexMap.Contains(Data.AllCharacters[i].CharacterId))
+		{
+			CharacterIndexMap.Add(Data.AllCharacters[i].CharacterId, i);
+		}
+	}
+
+	DeductionIndexMap.Empty(Data.AllDeductions.Num());
+	for (int32 i = 0; i < Data.AllDeductions.Num(); i++)
+	{
+		if (!DeductionIndexMap.Contains(Data.AllDeductions[i].DeductionId))
+		{
+			DeductionIndexMap.Add(Data.AllDeductions[i].DeductionId, i);
+		}
+	}
+
+	LocationIndexMap.Empty(Data.AllLocations.Num());
+	for (int32 i = 0; i < Data.AllLocations.Num(); i++)
+	{
+		if (!LocationIndexMap.Contains(Data.AllLocations[i].Location))
+		{
+			LocationIndexMap.Add(Data.AllLocations[i].Location, i);
+		}
+	}
+
+	// 推理を証拠ペアで引けるようにする（証拠の並び順は問わない）
+	DeductionPairIndex.Empty(Data.AllDeductions.Num());
+	for (int32 i = 0; i < Data.AllDeductions.Num(); i++)
+	{
+		const FDeduction& Deduction = Data.AllDeductions[i];
+		if (Deduction.IsDerived())
+		{
+			continue; // 前提から導かれる推理は証拠の組では引かない
+		}
+
+		const int32 IndexA = FindEvidenceIndex(Deduction.EvidenceA);
+		const int32 IndexB = FindEvidenceIndex(Deduction.EvidenceB);
+
+		if (IndexA == INDEX_NONE || IndexB == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseDefinition] 推理 %s が存在しない証拠を参照しています (%s + %s)"),
+				*Deduction.DeductionId.ToString(), *Deduction.EvidenceA.ToString(), *Deduction.EvidenceB.ToString());
+			continue;
+		}
+
+		const uint64 PairKey = MakeEvidencePairKey(IndexA, IndexB);
+		if (!DeductionPairIndex.Contains(PairKey))
+		{
+			DeductionPairIndex.Add(PairKey, i);
+		}
+	}
+}
+
+void FCaseDefinition::CompileFlagsAndRequirements()
+{
+	// 1. 事件内で参照される全フラグを出現順に登録する
+	FlagIndexMap.Reset();
+	FlagNames.Reset();
+
+	for (const FDialogueTree& Tree : Data.AllDialogues)
+	{
+		for (const FDialogueNode& Node : Tree.Nodes)
+		{
+			for (const FName& Flag : Node.SetsFlags)
+			{
+				InternFlag(Flag);
+			}
+			for (const FDialogueChoice& Choice : Node.Choices)
+			{
+				for (const FName& Flag : Choice.RequiredFlags)
+				{
+					InternFlag(Flag);
+				}
+				for (const FName& Flag : Choice.SetsFlags)
+				{
+					InternFlag(Flag);
+				}
+			}
+		}
+	}
+
+	for (const FDeduction& Deduction : Data.AllDeductions)
+	{
+		for (const FName& Flag : Deduction.UnlocksFlags)
+		{
+			InternFlag(Flag);
+		}
+	}
+
+	// トリガーの条件にだけ登場するフラグ（Blueprint から設定されるもの）も依存関係を索引できるよう登録する
+	for (const FCaseTrigger& Trigger : Data.Triggers)
+	{
+		for (const FName& Flag : Trigger.RequiredFlags)
+		{
+			InternFlag(Flag);
+		}
+	}
+
+	// 2. フラグ数が確定したのでマスクを構築する
+	MaskWords.Reset();
+
+	DeductionFlagMasks.Reset(Data.AllDeductions.Num());
+	for (const FDeduction& Deduction : Data.AllDeductions)
+	{
+		DeductionFlagMasks.Add(CompileFlagMask(Deduction.UnlocksFlags));
+	}
+
+	DialogueTreeIndexMap.Empty(Data.AllDialogues.Num());
+	TreeData.Reset(Data.AllDialogues.Num());
+	NodeData.Reset();
+	ChoiceData.Reset();
+	NodeGainedEvidence.Reset();
+
+	for (int32 TreeIndex = 0; TreeIndex < Data.AllDialogues.Num(); TreeIndex++)
+	{
+		const FDialogueTree& Tree = Data.AllDialogues[TreeIndex];
+
+		// 同じキャラクターのツリーは後に登録されたものが有効（UDialogueManager と同じ）
+		DialogueTreeIndexMap.Add(Tree.CharacterId, TreeIndex);
+
+		FCompiledDialogueTree& CompiledTree = TreeData.AddDefaulted_GetRef();
+		CompiledTree.FirstNode = NodeData.Num();
+		CompiledTree.NodeIndexMap.Reserve(Tree.Nodes.Num());
+
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); NodeIndex++)
+		{
+			const FDialogueNode& Node = Tree.Nodes[NodeIndex];
+
+			// 重複ノードIDは先に定義されたものを優先（従来の線形探索と同じ結果）
+			if (!CompiledTree.NodeIndexMap.Contains(Node.NodeId))
+			{
+				CompiledTree.NodeIndexMap.Add(Node.NodeId, NodeIndex);
+			}
+
+			FCompiledDialogueNode& CompiledNode = NodeData.AddDefaulted_GetRef();
+			CompiledNode.SetsFlags = CompileFlagMask(Node.SetsFlags);
+			CompiledNode.FirstChoice = ChoiceData.Num();
+			CompiledNode.FirstGainedEvidence = NodeGainedEvidence.Num();
+
+			for (const FName& EvidenceId : Node.GainsEvidence)
+			{
+				const FEvidenceHandle Evidence = FindEvidence(EvidenceId);
+				if (!Evidence)
+				{
+					UE_LOG(LogLastWitness, Warning, TEXT("[CaseDefinition] 対話ノード %s が存在しない証拠を与えています: %s"),
+						*Node.NodeId.ToString(), *EvidenceId.ToString());
+					continue;
+				}
+				NodeGainedEvidence.Add(Evidence);
+				CompiledNode.NumGainedEvidence++;
+			}
+
+			for (const FDialogueChoice& Choice : Node.Choices)
+			{
+				FCompiledDialogueChoice& CompiledChoice = ChoiceData.AddDefaulted_GetRef();
+				CompiledChoice.RequiredFlags = CompileFlagMask(Choice.RequiredFlags);
+				CompiledChoice.RequiredEvidence = CompileEvidenceMask(Choice.RequiredEvidence, CompiledChoice.bUnsatisfiable);
+				CompiledChoice.SetsFlags = CompileFlagMask(Choice.SetsFlags);
+			}
+		}
+
+		// ツリー内の全ノードIDが揃ったので、遷移先をインデックスに解決する
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); NodeIndex++)
+		{
+			const FDialogueNode& Node = Tree.Nodes[NodeIndex];
+			FCompiledDialogueNode& CompiledNode = NodeData[CompiledTree.FirstNode + NodeIndex];
+			CompiledNode.NextNode = FindDialogueNodeIndex(TreeIndex, Node.NextNodeId);
+
+			for (int32 ChoiceIndex = 0; ChoiceIndex < Node.Choices.Num(); ChoiceIndex++)
+			{
+				ChoiceData[CompiledNode.FirstChoice + ChoiceIndex].NextNode = FindDialogueNodeIndex(TreeIndex, Node.Choices[ChoiceIndex].NextNodeId);
+			}
+		}
+	}
+}
+
+void FCaseDefinition::InternFlag(FName FlagName)
+{
+	if (!FlagIndexMap.Contains(FlagName))
+	{
+		FlagIndexMap.Add(FlagName, FlagNames.Add(FlagName));
+	}
+}
+
+FCompiledMask FCaseDefinition::CompileFlagMask(const TArray<FName>& Flags)
+{
+	FCompiledMask Mask;
+	if (Flags.Num() == 0)
+	{
+		return Mask;
+	}
+
+	Mask.Offset = MaskWords.AddZeroed(NumFlagWords());
+	for (const FName& Flag : Flags)
+	{
+		const int32 FlagIndex = FindFlagIndex(Flag);
+		MaskWords[Mask.Offset + FlagIndex / NumBitsPerDWORD] |= 1u << (FlagIndex % NumBitsPerDWORD);
+	}
+	return Mask;
+}
+
+FCompiledMask FCaseDefinition::CompileEvidenceMask(const TArray<FName>& EvidenceIds, bool& bOutHasUnknown)
+{
+	FCompiledMask Mask;
+	if (EvidenceIds.Num() == 0)
+	{
+		return Mask;
+	}
+
+	Mask.Offset = MaskWords.AddZeroed(NumEvidenceWords());
+	for (const FName& EvidenceId : EvidenceIds)
+	{
+		const int32 EvidenceIndex = FindEvidenceIndex(EvidenceId);
+		if (EvidenceIndex == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseDefinition] 選択肢が存在しない証拠を要求しています: %s"), *EvidenceId.ToString());
+			bOutHasUnknown = true;
+			continue;
+		}
+		MaskWords[Mask.Offset + EvidenceIndex / NumBitsPerDWORD] |= 1u << (EvidenceIndex % NumBitsPerDWORD);
+	}
+	return Mask;
+}
+
+bool FCaseDefinition::ContainsAllWords(const uint32* StateWords, const uint32* MaskWordData, int32 NumWords)
+{
+	// 分岐なしで不足ビットを集約する（数ワードなのでループはベクトル化される）
+	uint32 Missing = 0;
+	for (int32 i = 0; i < NumWords; i++)
+	{
+		Missing |= MaskWordData[i] & ~StateWords[i];
+	}
+	return Missing == 0;
+}
+
+void FCaseDefinition::BuildAggregateTables()
+{
+	// ロケーションごとの証拠（重複と存在しないIDを除く）
+	TArray<TArray<int32>> LocationsPerEvidence;
+	LocationsPerEvidence.SetNum(Data.AllEvidence.Num());
+	LocationEvidenceCounts.Init(0, Data.AllLocations.Num());
+
+	for (int32 LocationIndex = 0; LocationIndex < Data.AllLocations.Num(); LocationIndex++)
+	{
+		for (const FName& EvidenceId : Data.AllLocations[LocationIndex].AvailableEvidence)
+		{
+			const int32 EvidenceIndex = FindEvidenceIndex(EvidenceId);
+			if (EvidenceIndex != INDEX_NONE && !LocationsPerEvidence[EvidenceIndex].Contains(LocationIndex))
+			{
+				LocationsPerEvidence[EvidenceIndex].Add(LocationIndex);
+				LocationEvidenceCounts[LocationIndex]++;
+			}
+		}
+	}
+
+	// 証拠 → ロケーション一覧を連続した配列に詰める
+	EvidenceLocationStart.Reset(Data.AllEvidence.Num() + 1);
+	EvidenceLocationList.Reset();
+	for (const TArray<int32>& Locations : LocationsPerEvidence)
+	{
+		EvidenceLocationStart.Add(EvidenceLocationList.Num());
+		EvidenceLocationList.Append(Locations);
+	}
+	EvidenceLocationStart.Add(EvidenceLocationList.Num());
+
+	// 告発条件
+	RequiredForAccusation.Init(false, Data.AllEvidence.Num());
+	AccusationRequirementCount = 0;
+	for (const FName& RequiredId : Data.RequiredEvidenceForAccusation)
+	{
+		const int32 EvidenceIndex = FindEvidenceIndex(RequiredId);
+		if (EvidenceIndex == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseDefinition] 告発条件が存在しない証拠を参照しています: %s"), *RequiredId.ToString());
+			AccusationRequirementCount++;
+			continue;
+		}
+
+		if (!RequiredForAccusation[EvidenceIndex])
+		{
+			RequiredForAccusation[EvidenceIndex] = true;
+			AccusationRequirementCount++;
+		}
+	}
+}
+
+void FCaseDefinition::BuildEvidenceIndices()
+{
+	const int32 NumWords = NumEvidenceWords();
+	const int32 NumSlots = NumEvidenceTypes + NumEvidenceImportances + NumLocations() + NumCharacters();
+	EvidenceIndexWords.Reset();
+	EvidenceIndexWords.AddZeroed(NumSlots * NumWords);
+
+	auto SetBit = [this, NumWords](int32 Slot, int32 EvidenceIndex)
+	{
+		EvidenceIndexWords[Slot * NumWords + EvidenceIndex / NumBitsPerDWORD] |= 1u << (EvidenceIndex % NumBitsPerDWORD);
+	};
+
+	const int32 LocationSlotBase = NumEvidenceTypes + NumEvidenceImportances;
+	const int32 CharacterSlotBase = LocationSlotBase + NumLocations();
+
+	for (int32 EvidenceIndex = 0; EvidenceIndex < Data.AllEvidence.Num(); EvidenceIndex++)
+	{
+		const FEvidence& Evidence = Data.AllEvidence[EvidenceIndex];
+		SetBit(static_cast<int32>(Evidence.Type), EvidenceIndex);
+
+		// 「指定した重要度以上」を1回の AND で引けるよう、下位の段階にもビットを立てる
+		for (int32 Level = 0; Level <= static_cast<int32>(Evidence.Importance); Level++)
+		{
+			SetBit(NumEvidenceTypes + Level, EvidenceIndex);
+		}
+
+		for (const int32 LocationIndex : GetLocationsListingEvidence(EvidenceIndex))
+		{
+			SetBit(LocationSlotBase + LocationIndex, EvidenceIndex);
+		}
+
+		for (const FName& CharacterId : Evidence.RelatedCharacters)
+		{
+			const int32 CharacterIndex = FindCharacterIndex(CharacterId);
+			if (CharacterIndex != INDEX_NONE)
+			{
+				SetBit(CharacterSlotBase + CharacterIndex, EvidenceIndex);
+			}
+		}
+	}
+}
+
+void FCaseDefinition::CompileSchedule()
+{
+	// 初期位置は最初に載っているロケーション（従来の CharactersPresent と同じ場所に現れる）
+	InitialCharacterLocations.Init(INDEX_NONE, NumCharacters());
+	for (int32 LocationIndex = 0; LocationIndex < Data.AllLocations.Num(); LocationIndex++)
+	{
+		for (const FName& CharacterId : Data.AllLocations[LocationIndex].CharactersPresent)
+		{
+			const int32 CharacterIndex = FindCharacterIndex(CharacterId);
+			if (CharacterIndex == INDEX_NONE)
+			{
+				continue;
+			}
+			if (InitialCharacterLocations[CharacterIndex] == INDEX_NONE)
+			{
+				InitialCharacterLocations[CharacterIndex] = LocationIndex;
+			}
+			else if (InitialCharacterLocations[CharacterIndex] != LocationIndex)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseDefinition] キャラクター %s が複数のロケーションに配置されています。最初の場所のみ使用します"),
+					*CharacterId.ToString());
+			}
+		}
+	}
+
+	Schedule.Reset(Data.CharacterSchedule.Num());
+	for (const FCharacterScheduleEntry& Entry : Data.CharacterSchedule)
+	{
+		FCompiledScheduleEntry Compiled;
+		Compiled.AtMinute = FMath::Max(Entry.AtMinute, 0);
+		Compiled.CharacterIndex = FindCharacterIndex(Entry.CharacterId);
+		Compiled.LocationIndex = FindLocationIndex(Entry.Location);
+		if (Compiled.CharacterIndex == INDEX_NONE || Compiled.LocationIndex == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseDefinition] 移動予定が存在しないキャラクターまたはロケーションを参照しています: %s (%d 分)"),
+				*Entry.CharacterId.ToString(), Entry.AtMinute);
+			continue;
+		}
+		Schedule.Add(Compiled);
+	}
+
+	// 同時刻の予定は定義順に適用されるよう安定ソートする
+	Algo::StableSortBy(Schedule, &FCompiledScheduleEntry::AtMinute);
+
+	// 0分以前の予定は初期位置に畳み込む
+	int32 FirstLater = 0;
+	while (FirstLater < Schedule.Num() && Schedule[FirstLater].AtMinute <= 0)
+	{
+		InitialCharacterLocations[Schedule[FirstLater].CharacterIndex] = Schedule[FirstLater].LocationIndex;
+		FirstLater++;
+	}
+	Schedule.RemoveAt(0, FirstLater);
+}
@@ -0,0 +1,214 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseJournal.h"
+#include "TheLastWitness.h"
+
+void FCaseJournal::Reset(FName InCaseId)
+{
+	CaseId = InCaseId;
+	Bytes.Reset();
+	RecordCount = 0;
+	Names.Reset();
+	NameIndexMap.Reset();
+	StartLineage();
+}
+
+void FCaseJournal::Truncate(int32 ByteLength)
+{
+	if (ByteLength >= Bytes.Num())
+	{
+		return;
+	}
+
+	Bytes.SetNum(ByteLength, EAllowShrinking::No);
+
+	// レコード数は先頭から数え直す（名前テーブルは残しても害はない）
+	RecordCount = 0;
+	ForEachRecord([this](const FCaseJournalRecord&) { RecordCount++; });
+	Crc = ComputePrefixCrc(ByteLength);
+}
+
+void FCaseJournal::Append(ECaseJournalOp Op)
+{
+	checkSlow(GetOperandCount(Op) == 0);
+	const int32 RecordStart = Bytes.Add(static_cast<uint8>(Op));
+	FinishRecord(RecordStart);
+}
+
+void FCaseJournal::Append(ECaseJournalOp Op, int32 A)
+{
+	checkSlow(GetOperandCount(Op) == 1);
+	const int32 RecordStart = Bytes.Add(static_cast<uint8>(Op));
+	WriteVarInt(A);
+	FinishRecord(RecordStart);
+}
+
+void FCaseJournal::Append(ECaseJournalOp Op, int32 A, int32 B)
+{
+	checkSlow(GetOperandCount(Op) == 2);
+	const int32 RecordStart = Bytes.Add(static_cast<uint8>(Op));
+	WriteVarInt(A);
+	WriteVarInt(B);
+	FinishRecord(RecordStart);
+}
+
+uint32 FCaseJournal::ComputePrefixCrc(int32 ByteLength) const
+{
+	check(ByteLength >= 0 && ByteLength <= Bytes.Num());
+	return FCrc::MemCrc32(Bytes.GetData(), ByteLength, Lineage);
+}
+
+void FCaseJournal::AppendName(ECaseJournalOp Op, FName Name)
+{
+	Append(Op, InternName(Name));
+}
+
+bool FCaseJournal::ForEachRecord(TFunctionRef<void(const FCaseJournalRecord&)> Visitor) const
+{
+	int32 Offset = 0;
+	while (Offset < Bytes.Num())
+	{
+		FCaseJournalRecord Record;
+		const uint8 RawOp = Bytes[Offset++];
+		if (RawOp >= static_cast<uint8>(ECaseJournalOp::Count))
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseJournal] 不明な操作コードです: %d (オフセット %d)"), RawOp, Offset - 1);
+			return false;
+		}
+		Record.Op = static_cast<ECaseJournalOp>(RawOp);
+
+		const int32 OperandCount = GetOperandCount(Record.Op);
+		if ((OperandCount >= 1 && !ReadVarInt(Bytes, Offset, Record.A))
+			|| (OperandCount >= 2 && !ReadVarInt(Bytes, Offset, Record.B)))
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseJournal] レコードが途中で途切れています (オフセット %d)"), Offset);
+			return false;
+		}
+
+		if (Record.Op == ECaseJournalOp::SetExtraFlag || Record.Op == ECaseJournalOp::MakeAccusation)
+		{
+			if (!Names.IsValidIndex(Record.A))
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseJournal] 名前テーブルの範囲外です: %d"), Record.A);
+				return false;
+			}
+			Record.Name = Names[Record.A];
+		}
+
+		Visitor(Record);
+	}
+	return true;
+}
+
+FArchive& operator<<(FArchive& Ar, FCaseJournal& Journal)
+{
+	int32 SavedVersion = FCaseJournal::Version;
+	Ar << SavedVersion;
+	if (SavedVersion != FCaseJournal::Version)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseJournal] 対応していないバージョンです: %d"), SavedVersion);
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Journal.CaseId;
+	Ar << Journal.RecordCount;
+	Ar << Journal.Names;
+	Ar << Journal.Bytes;
+
+	if (Ar.IsLoading())
+	{
+		Journal.NameIndexMap.Reset();
+		for (int32 i = 0; i < Journal.Names.Num(); i++)
+		{
+			Journal.NameIndexMap.Add(Journal.Names[i], i);
+		}
+
+		// 読み込んだ記録は既存のチェックポイントと履歴が繋がらない
+		Journal.StartLineage();
+	}
+	return Ar;
+}
+
+// ============================================================================
+// Private
+// ============================================================================
+
+int32 FCaseJournal::GetOperandCount(ECaseJournalOp Op)
+{
+	switch (Op)
+	{
+	case ECaseJournalOp::CollectEvidence:
+	case ECaseJournalOp::ExamineEvidence:
+	case ECaseJournalOp::SetFlag:
+	case ECaseJournalOp::SetExtraFlag:
+	case ECaseJournalOp::MarkInterviewed:
+	case ECaseJournalOp::TravelToLocation:
+	case ECaseJournalOp::MakeAccusation:
+	case ECaseJournalOp::AdvanceClock:
+		return 1;
+
+	case ECaseJournalOp::UnlockDeduction:
+	case ECaseJournalOp::ModifyTrust:
+		return 2;
+
+	default:
+		return 0;
+	}
+}
+
+int32 FCaseJournal::InternName(FName Name)
+{
+	if (const int32* Found = NameIndexMap.Find(Name))
+	{
+		return *Found;
+	}
+	const int32 Index = Names.Add(Name);
+	NameIndexMap.Add(Name, Index);
+	return Index;
+}
+
+void FCaseJournal::StartLineage()
+{
+	static int32 NextLineage = 0;
+	Lineage = static_cast<uint32>(FPlatformAtomics::InterlockedIncrement(&NextLineage));
+	Crc = ComputePrefixCrc(Bytes.Num());
+}
+
+void FCaseJournal::FinishRecord(int32 RecordStart)
+{
+	Crc = FCrc::MemCrc32(Bytes.GetData() + RecordStart, Bytes.Num() - RecordStart, Crc);
+	RecordCount++;
+}
+
+void FCaseJournal::WriteVarInt(int32 Value)
+{
+	// ZigZag 変換で負の値（信頼度の減少など）も短く表現する
+	uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	while (Encoded >= 0x80)
+	{
+		Bytes.Add(static_cast<uint8>(Encoded | 0x80));
+		Encoded >>= 7;
+	}
+	Bytes.Add(static_cast<uint8>(Encoded));
+}
+
+bool FCaseJournal::ReadVarInt(const TArray<uint8>& Data, int32& InOutOffset, int32& OutValue)
+{
+	uint32 Encoded = 0;
+	for (int32 Shift = 0; Shift < 35; Shift += 7)
+	{
+		if (InOutOffset >= Data.Num())
+		{
+			return false;
+		}
+		const uint8 Byte = Data[InOutOffset++];
+		Encoded |= static_cast<uint32>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			OutValue = static_cast<int32>((Encoded >> 1) ^ (~(Encoded & 1) + 1));
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,553 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseProgress.h"
+#include "Core/CaseDefinition.h"
+#include "TheLastWitness.h"
+#include "Algo/Transform.h"
+
+static_assert(static_cast<uint8>(EEmotionalState::Neutral) == 0, "Reset はゼロクリアで Neutral になることを前提としています");
+
+namespace
+{
+	/// <summary>セーブデータ上で「どこにもいない」を表すロケーション値</summary>
+	constexpr uint8 NoCharacterLocation = 0xFF;
+
+	/// <summary>
+	/// 保存時のインデックスから現在の事件定義のインデックスへの対応表を作ります
+	/// </summary>
+	/// <remarks>
+	/// 事件定義に存在しなくなった要素は INDEX_NONE になります。
+	/// </remarks>
+	template <typename IdType, typename FindFunc>
+	TArray<int32> MakeIdRemap(const TArray<IdType>& SavedIds, FindFunc&& FindIndex)
+	{
+		TArray<int32> Remap;
+		Remap.Reserve(SavedIds.Num());
+		for (const IdType& Id : SavedIds)
+		{
+			Remap.Add(FindIndex(Id));
+		}
+		return Remap;
+	}
+
+	/// <summary>
+	/// IDを保存していないバージョン3以前のデータ用に、重なる範囲を同じインデックスに対応させます
+	/// </summary>
+	TArray<int32> MakeIdentityRemap(int32 SavedNum, int32 CurrentNum)
+	{
+		TArray<int32> Remap;
+		Remap.SetNumUninitialized(SavedNum);
+		for (int32 i = 0; i < SavedNum; i++)
+		{
+			Remap[i] = i < CurrentNum ? i : INDEX_NONE;
+		}
+		return Remap;
+	}
+
+	/// <summary>
+	/// 保存時の全要素が現在の事件定義に過不足なく対応しているか確認します
+	/// </summary>
+	bool IsCompleteRemap(const TArray<int32>& Remap, int32 CurrentNum)
+	{
+		return Remap.Num() == CurrentNum && !Remap.Contains(INDEX_NONE);
+	}
+
+	/// <summary>
+	/// 立っているビットを対応表に従って写します（対応先の無いビットは捨てます）
+	/// </summary>
+	void CopyRemappedBits(TBitArray<>& Dest, const TBitArray<>& Source, const TArray<int32>& Remap)
+	{
+		for (TConstSetBitIterator<> It(Source); It && It.GetIndex() < Remap.Num(); ++It)
+		{
+			const int32 DestIndex = Remap[It.GetIndex()];
+			if (DestIndex != INDEX_NONE)
+			{
+				Dest[DestIndex] = true;
+			}
+		}
+	}
+}
+
+void FCaseProgress::Initialize(const FCaseDefinition& Definition)
+{
+	// 既存のチェックポイントと共有しないよう、全セクションを新しく作り直す
+	*this = FCaseProgress();
+
+	FEvidenceProgress& EvidenceData = Evidence.Edit();
+	EvidenceData.Collected.Init(false, Definition.NumEvidence());
+	EvidenceData.Examined.Init(false, Definition.NumEvidence());
+	EvidenceData.UncollectedPerLocation.SetNumUninitialized(Definition.NumLocations());
+
+	FCharacterProgress& CharacterData = Characters.Edit();
+	CharacterData.TrustLevels.SetNumUninitialized(Definition.NumCharacters());
+	CharacterData.EmotionalStates.SetNumUninitialized(Definition.NumCharacters());
+	CharacterData.Interviewed.Init(false, Definition.NumCharacters());
+	CharacterData.CurrentLocations.SetNumUninitialized(Definition.NumCharacters());
+
+	FLocationProgress& LocationData = Locations.Edit();
+	LocationData.Visited.Init(false, Definition.NumLocations());
+	LocationData.Accessible.Init(false, Definition.NumLocations());
+
+	Deductions.Edit().Unlocked.Init(false, Definition.NumDeductions());
+
+	Flags.Edit().Set.Init(false, Definition.NumFlags());
+
+	Triggers.Edit().Fired.Init(false, Definition.NumTriggers());
+
+	Reset(Definition);
+}
+
+void FCaseProgress::Reset(const FCaseDefinition& Definition)
+{
+	FEvidenceProgress& EvidenceData = Evidence.Edit();
+	EvidenceData.Collected.SetRange(0, EvidenceData.Collected.Num(), false);
+	EvidenceData.Examined.SetRange(0, EvidenceData.Examined.Num(), false);
+	for (int32 i = 0; i < EvidenceData.UncollectedPerLocation.Num(); i++)
+	{
+		EvidenceData.UncollectedPerLocation[i] = Definition.GetEvidenceCountAt(i);
+	}
+
+	FCharacterProgress& CharacterData = Characters.Edit();
+	FMemory::Memset(CharacterData.TrustLevels.GetData(), DefaultTrustLevel, CharacterData.TrustLevels.Num());
+	FMemory::Memzero(CharacterData.EmotionalStates.GetData(), CharacterData.EmotionalStates.Num() * sizeof(EEmotionalState));
+	CharacterData.Interviewed.SetRange(0, CharacterData.Interviewed.Num(), false);
+	for (int32 i = 0; i < CharacterData.CurrentLocations.Num(); i++)
+	{
+		CharacterData.CurrentLocations[i] = Definition.GetInitialCharacterLocation(i);
+	}
+
+	FLocationProgress& LocationData = Locations.Edit();
+	LocationData.Visited.SetRange(0, LocationData.Visited.Num(), false);
+	const TArray<FLocationData>& AllLocations = Definition.GetData().AllLocations;
+	for (int32 i = 0; i < LocationData.Accessible.Num(); i++)
+	{
+		LocationData.Accessible[i] = AllLocations[i].bIsAccessible;
+	}
+
+	FDeductionProgress& DeductionData = Deductions.Edit();
+	DeductionData.Unlocked.SetRange(0, DeductionData.Unlocked.Num(), false);
+
+	FFlagProgress& FlagData = Flags.Edit();
+	FlagData.Set.SetRange(0, FlagData.Set.Num(), false);
+	FlagData.Extra.Reset();
+
+	FTriggerProgress& TriggerData = Triggers.Edit();
+	TriggerData.Fired.SetRange(0, TriggerData.Fired.Num(), false);
+
+	Counters = FProgressCounters();
+	Counters.UnmetAccusationRequirements = Definition.NumAccusationRequirements();
+
+	CurrentLocation = ELocation::Office;
+	ClockMinutes = 0;
+	ABELSuggestionsFollowed = 0;
+	ABELSuggestionsIgnored = 0;
+	EthicalViolations = 0;
+}
+
+bool FCaseProgress::MarkEvidenceCollected(const FCaseDefinition& Definition, int32 EvidenceIndex)
+{
+	if (Evidence->Collected[EvidenceIndex])
+	{
+		return false;
+	}
+
+	FEvidenceProgress& EvidenceData = Evidence.Edit();
+	EvidenceData.Collected[EvidenceIndex] = true;
+
+	Counters.CollectedEvidence++;
+	for (const int32 LocationIndex : Definition.GetLocationsListingEvidence(EvidenceIndex))
+	{
+		EvidenceData.UncollectedPerLocation[LocationIndex]--;
+	}
+	if (Definition.IsRequiredForAccusation(EvidenceIndex))
+	{
+		Counters.UnmetAccusationRequirements--;
+	}
+	return true;
+}
+
+bool FCaseProgress::MarkCharacterInterviewed(int32 CharacterIndex)
+{
+	if (Characters->Interviewed[CharacterIndex])
+	{
+		return false;
+	}
+	Characters.Edit().Interviewed[CharacterIndex] = true;
+
+	Counters.InterviewedCharacters++;
+	return true;
+}
+
+bool FCaseProgress::MarkDeductionUnlocked(int32 DeductionIndex)
+{
+	if (Deductions->Unlocked[DeductionIndex])
+	{
+		return false;
+	}
+	Deductions.Edit().Unlocked[DeductionIndex] = true;
+
+	Counters.UnlockedDeductions++;
+	return true;
+}
+
+bool FCaseProgress::MoveCharacter(int32 CharacterIndex, int32 LocationIndex)
+{
+	if (Characters->CurrentLocations[CharacterIndex] == LocationIndex)
+	{
+		return false;
+	}
+	Characters.Edit().CurrentLocations[CharacterIndex] = LocationIndex;
+	return true;
+}
+
+void FCaseProgress::RebuildCounters(const FCaseDefinition& Definition)
+{
+	FEvidenceProgress& EvidenceData = Evidence.Edit();
+	for (int32 i = 0; i < EvidenceData.UncollectedPerLocation.Num(); i++)
+	{
+		EvidenceData.UncollectedPerLocation[i] = Definition.GetEvidenceCountAt(i);
+	}
+
+	Counters = FProgressCounters();
+	Counters.UnmetAccusationRequirements = Definition.NumAccusationRequirements();
+
+	for (TConstSetBitIterator<> It(EvidenceData.Collected); It; ++It)
+	{
+		const int32 EvidenceIndex = It.GetIndex();
+		Counters.CollectedEvidence++;
+		for (const int32 LocationIndex : Definition.GetLocationsListingEvidence(EvidenceIndex))
+		{
+			EvidenceData.UncollectedPerLocation[LocationIndex]--;
+		}
+		if (Definition.IsRequiredForAccusation(EvidenceIndex))
+		{
+			Counters.UnmetAccusationRequirements--;
+		}
+	}
+
+	Counters.InterviewedCharacters = Characters->Interviewed.CountSetBits();
+	Counters.UnlockedDeductions = Deductions->Unlocked.CountSetBits();
+}
+
+void FCaseProgress::Save(FArchive& Ar, const FCaseDefinition& Definition) const
+{
+	check(Ar.IsSaving());
+
+	int32 Version = SaveVersion;
+	Ar << Version;
+
+	// FArchive は非 const 参照を要求するため、小さな配列を一時的に複製して書き出す
+	TBitArray<> Collected = Evidence->Collected;
+	TBitArray<> Examined = Evidence->Examined;
+	Ar << Collected;
+	Ar << Examined;
+
+	TArray<uint8> TrustLevels = Characters->TrustLevels;
+	TArray<uint8> EmotionalStates;
+	EmotionalStates.Reserve(Characters->EmotionalStates.Num());
+	for (const EEmotionalState State : Characters->EmotionalStates)
+	{
+		EmotionalStates.Add(static_cast<uint8>(State));
+	}
+	TBitArray<> Interviewed = Characters->Interviewed;
+	Ar << TrustLevels;
+	Ar << EmotionalStates;
+	Ar << Interviewed;
+
+	TBitArray<> Visited = Locations->Visited;
+	Ar << Visited;
+
+	TBitArray<> Unlocked = Deductions->Unlocked;
+	Ar << Unlocked;
+
+	// フラグIDは事件定義の並びに依存するため、名前で保存する
+	TArray<FName> FlagNames;
+	FlagNames.Reserve(Flags->Set.CountSetBits() + Flags->Extra.Num());
+	for (TConstSetBitIterator<> It(Flags->Set); It; ++It)
+	{
+		FlagNames.Add(Definition.GetFlagName(It.GetIndex()));
+	}
+	for (const FName& ExtraFlag : Flags->Extra)
+	{
+		FlagNames.Add(ExtraFlag);
+	}
+	Ar << FlagNames;
+
+	uint8 Location = static_cast<uint8>(CurrentLocation);
+	int32 Followed = ABELSuggestionsFollowed;
+	int32 Ignored = ABELSuggestionsIgnored;
+	int32 Violations = EthicalViolations;
+	Ar << Location;
+	Ar << Followed;
+	Ar << Ignored;
+	Ar << Violations;
+
+	// バージョン2: ゲーム内時刻とキャラクターの居場所（ロケーションは並びに依存しないよう列挙値で保存する）
+	int32 Clock = ClockMinutes;
+	TArray<uint8> CharacterLocations;
+	CharacterLocations.Reserve(Characters->CurrentLocations.Num());
+	for (const int32 LocationIndex : Characters->CurrentLocations)
+	{
+		CharacterLocations.Add(LocationIndex != INDEX_NONE
+			? static_cast<uint8>(Definition.GetData().AllLocations[LocationIndex].Location)
+			: NoCharacterLocation);
+	}
+	Ar << Clock;
+	Ar << CharacterLocations;
+
+	// バージョン3: トリガーで変化したアクセス可否と発火済みのトリガー
+	TBitArray<> Accessible = Locations->Accessible;
+	TBitArray<> Fired = Triggers->Fired;
+	Ar << Accessible;
+	Ar << Fired;
+
+	// バージョン4: 各セクションの要素ID（事件定義の並びが変わっても ID で対応させる）
+	const FCaseData& Data = Definition.GetData();
+	TArray<FName> EvidenceIds, CharacterIds, DeductionIds, TriggerIds;
+	TArray<uint8> LocationIds;
+	Algo::Transform(Data.AllEvidence, EvidenceIds, [](const FEvidence& Item) { return Item.EvidenceId; });
+	Algo::Transform(Data.AllCharacters, CharacterIds, [](const FCharacterData& Item) { return Item.CharacterId; });
+	Algo::Transform(Data.AllLocations, LocationIds, [](const FLocationData& Item) { return static_cast<uint8>(Item.Location); });
+	Algo::Transform(Data.AllDeductions, DeductionIds, [](const FDeduction& Item) { return Item.DeductionId; });
+	Algo::Transform(Data.Triggers, TriggerIds, [](const FCaseTrigger& Item) { return Item.TriggerId; });
+	Ar << EvidenceIds;
+	Ar << CharacterIds;
+	Ar << LocationIds;
+	Ar << DeductionIds;
+	Ar << TriggerIds;
+}
+
+bool FCaseProgress::Load(FArchive& Ar, const FCaseDefinition& Definition)
+{
+	check(Ar.IsLoading());
+
+	int32 Version = 0;
+	Ar << Version;
+	if (Version < 1 || Version > SaveVersion)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseProgress] 対応していないセーブデータのバージョンです: %d"), Version);
+		Ar.SetError();
+		return false;
+	}
+
+	TBitArray<> Collected, Examined, Interviewed, Visited, Unlocked;
+	TArray<uint8> TrustLevels, EmotionalStates;
+	TArray<FName> FlagNames;
+	uint8 Location = 0;
+	int32 Followed = 0;
+	int32 Ignored = 0;
+	int32 Violations = 0;
+
+	Ar << Collected;
+	Ar << Examined;
+	Ar << TrustLevels;
+	Ar << EmotionalStates;
+	Ar << Interviewed;
+	Ar << Visited;
+	Ar << Unlocked;
+	Ar << FlagNames;
+	Ar << Location;
+	Ar << Followed;
+	Ar << Ignored;
+	Ar << Violations;
+
+	int32 Clock = 0;
+	TArray<uint8> CharacterLocations;
+	if (Version >= 2)
+	{
+		Ar << Clock;
+		Ar << CharacterLocations;
+	}
+
+	TBitArray<> Accessible, Fired;
+	if (Version >= 3)
+	{
+		Ar << Accessible;
+		Ar << Fired;
+	}
+
+	TArray<FName> EvidenceIds, CharacterIds, DeductionIds, TriggerIds;
+	TArray<uint8> LocationIds;
+	if (Version >= 4)
+	{
+		Ar << EvidenceIds;
+		Ar << CharacterIds;
+		Ar << LocationIds;
+		Ar << DeductionIds;
+		Ar << TriggerIds;
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseProgress] セーブデータが途中で途切れています"));
+		return false;
+	}
+
+	// 保存時のインデックスから現在のインデックスへの対応表
+	TArray<int32> EvidenceRemap, CharacterRemap, LocationRemap, DeductionRemap, TriggerRemap;
+	if (Version >= 4)
+	{
+		// ID表と各セクションの要素数が食い違うデータは、どの要素のビットか判断できない
+		const bool bConsistent = Collected.Num() == EvidenceIds.Num() && Examined.Num() == EvidenceIds.Num()
+			&& Interviewed.Num() == CharacterIds.Num() && TrustLevels.Num() == CharacterIds.Num()
+			&& EmotionalStates.Num() == CharacterIds.Num() && CharacterLocations.Num() == CharacterIds.Num()
+			&& Visited.Num() == LocationIds.Num() && Accessible.Num() == LocationIds.Num()
+			&& Unlocked.Num() == DeductionIds.Num() && Fired.Num() == TriggerIds.Num();
+		if (!bConsistent)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseProgress] セーブデータの要素数がID表と一致しません"));
+			Ar.SetError();
+			return false;
+		}
+
+		const FCaseTriggerIndex& TriggerIndex = Definition.GetTriggerIndex();
+		EvidenceRemap = MakeIdRemap(EvidenceIds, [&Definition](FName Id) { return Definition.FindEvidenceIndex(Id); });
+		CharacterRemap = MakeIdRemap(CharacterIds, [&Definition](FName Id) { return Definition.FindCharacterIndex(Id); });
+		LocationRemap = MakeIdRemap(LocationIds, [&Definition](uint8 Id)
+		{
+			return StaticEnum<ELocation>()->IsValidEnumValue(Id) ? Definition.FindLocationIndex(static_cast<ELocation>(Id)) : INDEX_NONE;
+		});
+		DeductionRemap = MakeIdRemap(DeductionIds, [&Definition](FName Id) { return Definition.FindDeductionIndex(Id); });
+		TriggerRemap = MakeIdRemap(TriggerIds, [&TriggerIndex](FName Id) { return TriggerIndex.FindTriggerIndex(Id); });
+	}
+	else
+	{
+		// バージョン3以前は並びが保存時と同じ前提で、重なる範囲だけを読み込む
+		EvidenceRemap = MakeIdentityRemap(Collected.Num(), Definition.NumEvidence());
+		CharacterRemap = MakeIdentityRemap(TrustLevels.Num(), Definition.NumCharacters());
+		LocationRemap = MakeIdentityRemap(Visited.Num(), Definition.NumLocations());
+		DeductionRemap = MakeIdentityRemap(Unlocked.Num(), Definition.NumDeductions());
+		TriggerRemap = MakeIdentityRemap(Fired.Num(), Definition.NumTriggers());
+	}
+
+	// 失敗しても自身を壊さないよう、別の状態に組み立ててから置き換える
+	FCaseProgress Loaded;
+	Loaded.Initialize(Definition);
+
+	bool bSameShape = IsCompleteRemap(EvidenceRemap, Definition.NumEvidence())
+		&& IsCompleteRemap(CharacterRemap, Definition.NumCharacters())
+		&& IsCompleteRemap(LocationRemap, Definition.NumLocations())
+		&& IsCompleteRemap(DeductionRemap, Definition.NumDeductions())
+		&& (Version < 3 || IsCompleteRemap(TriggerRemap, Definition.NumTriggers()));
+
+	FEvidenceProgress& EvidenceData = Loaded.Evidence.Edit();
+	CopyRemappedBits(EvidenceData.Collected, Collected, EvidenceRemap);
+	CopyRemappedBits(EvidenceData.Examined, Examined, EvidenceRemap);
+
+	FCharacterProgress& CharacterData = Loaded.Characters.Edit();
+	CopyRemappedBits(CharacterData.Interviewed, Interviewed, CharacterRemap);
+	const UEnum* EmotionalStateEnum = StaticEnum<EEmotionalState>();
+	for (int32 i = 0; i < CharacterRemap.Num(); i++)
+	{
+		const int32 CharacterIndex = CharacterRemap[i];
+		if (CharacterIndex == INDEX_NONE)
+		{
+			continue;
+		}
+		if (TrustLevels.IsValidIndex(i))
+		{
+			CharacterData.TrustLevels[CharacterIndex] = FMath::Min<uint8>(TrustLevels[i], 100);
+		}
+		if (EmotionalStates.IsValidIndex(i) && EmotionalStateEnum->IsValidEnumValue(EmotionalStates[i]))
+		{
+			CharacterData.EmotionalStates[CharacterIndex] = static_cast<EEmotionalState>(EmotionalStates[i]);
+		}
+		// バージョン1のデータは事件開始時の居場所のまま（Initialize 済み）
+		if (CharacterLocations.IsValidIndex(i))
+		{
+			CharacterData.CurrentLocations[CharacterIndex] = CharacterLocations[i] != NoCharacterLocation
+				? Definition.FindLocationIndex(static_cast<ELocation>(CharacterLocations[i]))
+				: INDEX_NONE;
+		}
+	}
+
+	FLocationProgress& LocationData = Loaded.Locations.Edit();
+	CopyRemappedBits(LocationData.Visited, Visited, LocationRemap);
+	if (Version >= 3)
+	{
+		// 初期値が立っているビットもあるため、対応する要素は保存された値で上書きする
+		for (int32 i = 0; i < FMath::Min(Accessible.Num(), LocationRemap.Num()); i++)
+		{
+			if (LocationRemap[i] != INDEX_NONE)
+			{
+				LocationData.Accessible[LocationRemap[i]] = Accessible[i];
+			}
+		}
+		CopyRemappedBits(Loaded.Triggers.Edit().Fired, Fired, TriggerRemap);
+	}
+	// バージョン2以前のデータは作成時のアクセス可否のまま（条件を満たすトリガーは読み込み後に発火する）
+	CopyRemappedBits(Loaded.Deductions.Edit().Unlocked, Unlocked, DeductionRemap);
+
+	FFlagProgress& FlagData = Loaded.Flags.Edit();
+	for (const FName& FlagName : FlagNames)
+	{
+		const int32 FlagIndex = Definition.FindFlagIndex(FlagName);
+		if (FlagIndex != INDEX_NONE)
+		{
+			FlagData.Set[FlagIndex] = true;
+		}
+		else
+		{
+			FlagData.Extra.Add(FlagName);
+		}
+	}
+
+	if (StaticEnum<ELocation>()->IsValidEnumValue(Location))
+	{
+		Loaded.CurrentLocation = static_cast<ELocation>(Location);
+	}
+	Loaded.ClockMinutes = FMath::Max(Clock, 0);
+
+	Loaded.ABELSuggestionsFollowed = Followed;
+	Loaded.ABELSuggestionsIgnored = Ignored;
+	Loaded.EthicalViolations = Violations;
+
+	Loaded.RebuildCounters(Definition);
+
+	if (!bSameShape)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseProgress] 保存時の要素の一部が事件定義に無いため、対応する要素のみ読み込みました"));
+	}
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FCaseProgress::IsCompatibleWith(const FCaseDefinition& Definition) const
+{
+	return Evidence->Collected.Num() == Definition.NumEvidence()
+		&& Characters->TrustLevels.Num() == Definition.NumCharacters()
+		&& Locations->Visited.Num() == Definition.NumLocations()
+		&& Deductions->Unlocked.Num() == Definition.NumDeductions()
+		&& Flags->Set.Num() == Definition.NumFlags()
+		&& Triggers->Fired.Num() == Definition.NumTriggers();
+}
+
+bool FCaseProgress::SharesStateWith(const FCaseProgress& Other) const
+{
+	return Evidence.IsSharedWith(Other.Evidence)
+		&& Characters.IsSharedWith(Other.Characters)
+		&& Locations.IsSharedWith(Other.Locations)
+		&& Deductions.IsSharedWith(Other.Deductions)
+		&& Flags.IsSharedWith(Other.Flags)
+		&& Triggers.IsSharedWith(Other.Triggers)
+		&& CurrentLocation == Other.CurrentLocation
+		&& ClockMinutes == Other.ClockMinutes;
+}
+
+SIZE_T FCaseProgress::GetAllocatedSize() const
+{
+	return Evidence->Collected.GetAllocatedSize()
+		+ Evidence->Examined.GetAllocatedSize()
+		+ Evidence->UncollectedPerLocation.GetAllocatedSize()
+		+ Characters->TrustLevels.GetAllocatedSize()
+		+ Characters->EmotionalStates.GetAllocatedSize()
+		+ Characters->Interviewed.GetAllocatedSize()
+		+ Characters->CurrentLocations.GetAllocatedSize()
+		+ Locations->Visited.GetAllocatedSize()
+		+ Locations->Accessible.GetAllocatedSize()
+		+ Deductions->Unlocked.GetAllocatedSize()
+		+ Flags->Set.GetAllocatedSize()
+		+ Flags->Extra.GetAllocatedSize()
+		+ Triggers->Fired.GetAllocatedSize();
+}
@@ -0,0 +1,130 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseRelationGraph.h"
+#include "Core/CaseDefinition.h"
+#include "TheLastWitness.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+
+void FCaseRelationGraph::Build(const FCaseDefinition& Definition)
+{
+	const FCaseData& Data = Definition.GetData();
+	CharacterBase = Definition.NumEvidence();
+	LocationBase = CharacterBase + Definition.NumCharacters();
+	NodeCount = LocationBase + Definition.NumLocations();
+
+	// (始点, 終点) を64ビットのキーに詰めて両方向分を集め、整列と重複除去で CSR を作る
+	TArray<uint64> Edges;
+	auto AddEdge = [&Edges](int32 NodeA, int32 NodeB)
+	{
+		if (NodeA != NodeB)
+		{
+			Edges.Add((static_cast<uint64>(NodeA) << 32) | static_cast<uint32>(NodeB));
+			Edges.Add((static_cast<uint64>(NodeB) << 32) | static_cast<uint32>(NodeA));
+		}
+	};
+
+	auto ResolveEvidence = [&Definition](FName EvidenceId, const FString& Owner)
+	{
+		const int32 Index = Definition.FindEvidenceIndex(EvidenceId);
+		if (Index == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseRelationGraph] %s が存在しない証拠を参照しています: %s"), *Owner, *EvidenceId.ToString());
+		}
+		return Index;
+	};
+
+	auto ResolveCharacter = [&Definition](FName CharacterId, const FString& Owner)
+	{
+		const int32 Index = Definition.FindCharacterIndex(CharacterId);
+		if (Index == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseRelationGraph] %s が存在しないキャラクターを参照しています: %s"), *Owner, *CharacterId.ToString());
+		}
+		return Index;
+	};
+
+	for (int32 EvidenceIndex = 0; EvidenceIndex < Data.AllEvidence.Num(); EvidenceIndex++)
+	{
+		const FEvidence& Evidence = Data.AllEvidence[EvidenceIndex];
+		const FString Owner = Evidence.EvidenceId.ToString();
+		for (const FName& OtherId : Evidence.RelatedEvidence)
+		{
+			const int32 OtherIndex = ResolveEvidence(OtherId, Owner);
+			if (OtherIndex != INDEX_NONE)
+			{
+				AddEdge(EvidenceNode(EvidenceIndex), EvidenceNode(OtherIndex));
+			}
+		}
+		for (const FName& CharacterId : Evidence.RelatedCharacters)
+		{
+			const int32 CharacterIndex = ResolveCharacter(CharacterId, Owner);
+			if (CharacterIndex != INDEX_NONE)
+			{
+				AddEdge(EvidenceNode(EvidenceIndex), CharacterNode(CharacterIndex));
+			}
+		}
+	}
+
+	for (int32 LocationIndex = 0; LocationIndex < Data.AllLocations.Num(); LocationIndex++)
+	{
+		const FLocationData& Location = Data.AllLocations[LocationIndex];
+		const FString Owner = UEnum::GetValueAsString(Location.Location);
+		for (const FName& EvidenceId : Location.AvailableEvidence)
+		{
+			const int32 EvidenceIndex = ResolveEvidence(EvidenceId, Owner);
+			if (EvidenceIndex != INDEX_NONE)
+			{
+				AddEdge(LocationNode(LocationIndex), EvidenceNode(EvidenceIndex));
+			}
+		}
+		for (const FName& CharacterId : Location.CharactersPresent)
+		{
+			const int32 CharacterIndex = ResolveCharacter(CharacterId, Owner);
+			if (CharacterIndex != INDEX_NONE)
+			{
+				AddEdge(LocationNode(LocationIndex), CharacterNode(CharacterIndex));
+			}
+		}
+	}
+
+	Algo::Sort(Edges);
+	Edges.SetNum(Algo::Unique(Edges));
+
+	RowStart.Reset(NodeCount + 1);
+	Neighbors.Reset(Edges.Num());
+	int32 EdgeCursor = 0;
+	for (int32 Node = 0; Node < NodeCount; Node++)
+	{
+		RowStart.Add(Neighbors.Num());
+		while (EdgeCursor < Edges.Num() && static_cast<int32>(Edges[EdgeCursor] >> 32) == Node)
+		{
+			Neighbors.Add(static_cast<int32>(Edges[EdgeCursor] & 0xFFFFFFFFu));
+			EdgeCursor++;
+		}
+	}
+	RowStart.Add(Neighbors.Num());
+}
+
+TConstArrayView<int32> FCaseRelationGraph::GetNeighborsOfKind(int32 Node, ECaseNodeKind Kind) const
+{
+	const TConstArrayView<int32> Row = GetNeighbors(Node);
+	const int32 Base = GetKindBase(Kind);
+	const int32 End = Kind == ECaseNodeKind::Evidence ? CharacterBase
+		: Kind == ECaseNodeKind::Character ? LocationBase
+		: NodeCount;
+
+	const int32 First = Algo::LowerBound(Row, Base);
+	const int32 Last = Algo::LowerBound(Row, End);
+	return Row.Slice(First, Last - First);
+}
+
+bool FCaseRelationGraph::HasEdge(int32 NodeA, int32 NodeB) const
+{
+	const TConstArrayView<int32> RowA = GetNeighbors(NodeA);
+	const TConstArrayView<int32> RowB = GetNeighbors(NodeB);
+	return RowA.Num() <= RowB.Num()
+		? Algo::BinarySearch(RowA, NodeB) != INDEX_NONE
+		: Algo::BinarySearch(RowB, NodeA) != INDEX_NONE;
+}
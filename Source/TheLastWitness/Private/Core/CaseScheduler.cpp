@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseScheduler.h"
+
+FCaseScheduler::FCaseScheduler()
+{
+	Reset(0);
+}
+
+void FCaseScheduler::Reset(int32 StartMinute)
+{
+	Entries.Reset();
+	FreeHead = INDEX_NONE;
+	for (FList& Slot : Slots)
+	{
+		Slot = FList();
+	}
+	FMemory::Memzero(Occupied, sizeof(Occupied));
+	Ready = FList();
+	Now = FMath::Clamp(StartMinute, 0, MaxMinute);
+	Count = 0;
+}
+
+void FCaseScheduler::Schedule(int32 DueMinute, int32 Payload)
+{
+	int32 EntryIndex = FreeHead;
+	if (EntryIndex != INDEX_NONE)
+	{
+		FreeHead = Entries[EntryIndex].Next;
+	}
+	else
+	{
+		EntryIndex = Entries.AddUninitialized();
+	}
+
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Due = FMath::Min(DueMinute, MaxMinute);
+	Entry.Payload = Payload;
+	Entry.Next = INDEX_NONE;
+
+	Link(EntryIndex);
+	Count++;
+}
+
+int32 FCaseScheduler::Advance(int32 ToMinute, TFunctionRef<void(int32 Payload, int32 DueMinute)> OnFire)
+{
+	ToMinute = FMath::Min(ToMinute, MaxMinute);
+	int32 Fired = 0;
+
+	// 取り外したリストを発火する（コールバック中の Schedule で配列が再確保されても良いよう、値を写してから呼ぶ）
+	auto FireList = [this, &Fired, &OnFire](FList List)
+	{
+		for (int32 EntryIndex = List.Head; EntryIndex != INDEX_NONE;)
+		{
+			const FEntry Entry = Entries[EntryIndex];
+			Entries[EntryIndex].Next = FreeHead;
+			FreeHead = EntryIndex;
+			Count--;
+			Fired++;
+
+			OnFire(Entry.Payload, Entry.Due);
+			EntryIndex = Entry.Next;
+		}
+	};
+
+	while (true)
+	{
+		if (Ready.Head != INDEX_NONE)
+		{
+			const FList List = Ready;
+			Ready = FList();
+			FireList(List);
+			continue;
+		}
+
+		if (Now >= ToMinute)
+		{
+			break;
+		}
+
+		// 下の段から順に、現在のスロットより後で最初に使われているスロットを探す。
+		// 下の段が空なら、上の段の次のスロットが次に到来する予定を含んでいる
+		bool bFound = false;
+		for (int32 Level = 0; Level < NumLevels; Level++)
+		{
+			const int32 Shift = Level * SlotBits;
+			const int32 Current = (Now >> Shift) & (NumSlots - 1);
+			const uint64 Later = Current == NumSlots - 1 ? 0 : Occupied[Level] & (~0ull << (Current + 1));
+			if (Later == 0)
+			{
+				continue;
+			}
+
+			const int32 Slot = static_cast<int32>(FMath::CountTrailingZeros64(Later));
+			const int32 SlotStart = ((Now >> (Shift + SlotBits)) << (Shift + SlotBits)) | (Slot << Shift);
+			if (SlotStart > ToMinute)
+			{
+				break;
+			}
+
+			Now = SlotStart;
+			FList& SlotList = Slots[Level * NumSlots + Slot];
+			const FList List = SlotList;
+			SlotList = FList();
+			Occupied[Level] &= ~(1ull << Slot);
+
+			if (Level == 0)
+			{
+				// 最下段のスロットの予定は全てちょうど現在時刻
+				FireList(List);
+			}
+			else
+			{
+				// 上の段のスロットに入ったので、中身を下の段へ繰り下げる（ちょうど現在時刻のものは発火待ちへ）
+				for (int32 EntryIndex = List.Head; EntryIndex != INDEX_NONE;)
+				{
+					const int32 Next = Entries[EntryIndex].Next;
+					Entries[EntryIndex].Next = INDEX_NONE;
+					Link(EntryIndex);
+					EntryIndex = Next;
+				}
+			}
+
+			bFound = true;
+			break;
+		}
+
+		if (!bFound)
+		{
+			Now = ToMinute;
+		}
+	}
+
+	return Fired;
+}
+
+void FCaseScheduler::Link(int32 EntryIndex)
+{
+	const int32 Due = Entries[EntryIndex].Due;
+	if (Due <= Now)
+	{
+		PushBack(Ready, EntryIndex);
+		return;
+	}
+
+	// 現在時刻と最初に異なる桁の段に置くと、そのスロットは必ず現在のスロットより後になる
+	const int32 Level = FMath::FloorLog2(static_cast<uint32>(Due ^ Now)) / SlotBits;
+	const int32 Slot = (Due >> (Level * SlotBits)) & (NumSlots - 1);
+	PushBack(Slots[Level * NumSlots + Slot], EntryIndex);
+	Occupied[Level] |= 1ull << Slot;
+}
+
+void FCaseScheduler::PushBack(FList& List, int32 EntryIndex)
+{
+	if (List.Tail == INDEX_NONE)
+	{
+		List.Head = EntryIndex;
+	}
+	else
+	{
+		Entries[List.Tail].Next = EntryIndex;
+	}
+	List.Tail = EntryIndex;
+}
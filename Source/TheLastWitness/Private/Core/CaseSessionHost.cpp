@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseSessionHost.h"
+#include "Core/CaseState.h"
+#include "Core/CaseDefinition.h"
+#include "Data/TheLastWitnessCaseData.h"
+#include "TheLastWitness.h"
+
+void UCaseSessionHost::Deinitialize()
+{
+	for (UCaseState* Session : ActiveSessions)
+	{
+		Session->ReleaseForReuse();
+	}
+	ActiveSessions.Empty();
+	PooledSessions.Empty();
+	Definition.Reset();
+
+	Super::Deinitialize();
+}
+
+// ============================================================================
+// 事件定義
+// ============================================================================
+
+bool UCaseSessionHost::LoadCase(const FCaseData& CaseData)
+{
+	if (ActiveSessions.Num() > 0)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseSessionHost] セッションが開いている間は事件を変更できません"));
+		return false;
+	}
+
+	// プール済みのセッションは古い定義の領域を持つため作り直す
+	PooledSessions.Empty();
+	BytesPerSession = 0;
+	Definition = FCaseDefinition::Create(CaseData);
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseSessionHost] 事件を読み込みました: %s"), *CaseData.CaseId.ToString());
+	return true;
+}
+
+TSharedRef<const FCaseDefinition> UCaseSessionHost::GetDefinition()
+{
+	if (!Definition.IsValid())
+	{
+		Definition = FCaseDefinition::Create(UTheLastWitnessCaseData::LoadCaseData());
+	}
+	return Definition.ToSharedRef();
+}
+
+// ============================================================================
+// セッション
+// ============================================================================
+
+UCaseState* UCaseSessionHost::OpenSession()
+{
+	// ジャーナル等は開いた後も伸びるため、見積もりではなく開いているセッションの実際のサイズで判定する
+	if (MemoryBudgetBytes > 0)
+	{
+		const int64 UsedBytes = CalculateActiveMemoryUsage();
+		if (UsedBytes + BytesPerSession > MemoryBudgetBytes)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseSessionHost] メモリ予算の上限に達しました (%d セッション, %lld / %lld バイト)"),
+				ActiveSessions.Num(), UsedBytes, MemoryBudgetBytes);
+			return nullptr;
+		}
+	}
+
+	UCaseState* Session = AcquireSession();
+	ActiveSessions.Add(Session);
+	return Session;
+}
+
+void UCaseSessionHost::CloseSession(UCaseState* Session)
+{
+	if (!Session || ActiveSessions.Remove(Session) == 0)
+	{
+		return;
+	}
+
+	Session->ReleaseForReuse();
+	PooledSessions.Add(Session);
+}
+
+// ============================================================================
+// メモリ予算
+// ============================================================================
+
+void UCaseSessionHost::SetMemoryBudget(int64 InBudgetBytes)
+{
+	MemoryBudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+}
+
+int32 UCaseSessionHost::GetMaxSessions() const
+{
+	if (MemoryBudgetBytes <= 0 || BytesPerSession <= 0)
+	{
+		return MAX_int32;
+	}
+	const int64 RemainingBytes = FMath::Max<int64>(MemoryBudgetBytes - CalculateActiveMemoryUsage(), 0);
+	return static_cast<int32>(FMath::Min<int64>(ActiveSessions.Num() + RemainingBytes / BytesPerSession, MAX_int32));
+}
+
+int64 UCaseSessionHost::CalculateActiveMemoryUsage() const
+{
+	int64 Total = 0;
+	for (const UCaseState* Session : ActiveSessions)
+	{
+		Total += Session->GetSessionMemorySize();
+	}
+	return Total;
+}
+
+int64 UCaseSessionHost::CalculateMemoryUsage() const
+{
+	int64 Total = CalculateActiveMemoryUsage();
+	for (const UCaseState* Session : PooledSessions)
+	{
+		Total += Session->GetSessionMemorySize();
+	}
+	return Total;
+}
+
+// ============================================================================
+// Private
+// ============================================================================
+
+UCaseState* UCaseSessionHost::AcquireSession()
+{
+	const TSharedRef<const FCaseDefinition> SharedDefinition = GetDefinition();
+
+	UCaseState* Session = nullptr;
+	if (PooledSessions.Num() > 0)
+	{
+		Session = PooledSessions.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Session = NewObject<UCaseState>(this);
+	}
+
+	// 同じ定義での再初期化は確保済みの領域を使い回す
+	Session->InitializeFromDefinition(SharedDefinition);
+
+	if (BytesPerSession == 0)
+	{
+		BytesPerSession = static_cast<int64>(Session->GetSessionMemorySize());
+
+		UE_LOG(LogLastWitness, Log, TEXT("[CaseSessionHost] セッション1つあたりの見積もり: %lld バイト"), BytesPerSession);
+	}
+
+	return Session;
+}
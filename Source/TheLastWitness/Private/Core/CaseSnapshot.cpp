@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseSnapshot.h"
+
+bool FCaseSnapshot::HasEvidence(FName EvidenceId) const
+{
+	const int32 Index = Definition->FindEvidenceIndex(EvidenceId);
+	return Index != INDEX_NONE && Progress.Evidence->Collected[Index];
+}
+
+bool FCaseSnapshot::HasFlag(FName FlagName) const
+{
+	const int32 FlagIndex = Definition->FindFlagIndex(FlagName);
+	if (FlagIndex != INDEX_NONE)
+	{
+		return Progress.Flags->Set[FlagIndex];
+	}
+	return Progress.Flags->Extra.Contains(FlagName);
+}
+
+int32 FCaseSnapshot::GetTrustLevel(FName CharacterId) const
+{
+	const int32 Index = Definition->FindCharacterIndex(CharacterId);
+	return Index != INDEX_NONE ? Progress.Characters->TrustLevels[Index] : INDEX_NONE;
+}
@@ -0,0 +1,762 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseSolver.h"
+#include "Core/CaseDefinition.h"
+#include "Core/CaseProgress.h"
+#include "TheLastWitness.h"
+#include "Algo/AnyOf.h"
+
+namespace
+{
+	/// <summary>
+	/// マスクの立っているビットを列挙します
+	/// </summary>
+	template <typename VisitorType>
+	void ForEachMaskBit(const FCaseDefinition& Definition, FCompiledMask Mask, int32 NumWords, VisitorType&& Visitor)
+	{
+		if (Mask.IsEmpty())
+		{
+			return;
+		}
+
+		const uint32* Words = Definition.GetMaskWords(Mask);
+		for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+		{
+			for (uint32 Word = Words[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				Visitor(WordIndex * NumBitsPerDWORD + FMath::CountTrailingZeros(Word));
+			}
+		}
+	}
+}
+
+// ============================================================================
+// 構築
+// ============================================================================
+
+void FCaseSolver::Build(const FCaseDefinition& Definition)
+{
+	const FCaseData& Data = Definition.GetData();
+
+	// 1. ノードに通し番号を振る（遷移先の解決に全ツリーの先頭位置が必要）
+	TreeFirstNode.Reset(Data.AllDialogues.Num());
+	int32 TotalNodes = 0;
+	for (const FDialogueTree& Tree : Data.AllDialogues)
+	{
+		TreeFirstNode.Add(TotalNodes);
+		TotalNodes += Tree.Nodes.Num();
+	}
+
+	// 2. ノード・選択肢・獲得証拠をインデックスに変換する
+	Nodes.Reset(TotalNodes);
+	Choices.Reset();
+	GainedEvidence.Reset();
+	TreeStartNode.Init(INDEX_NONE, Data.AllDialogues.Num());
+	TreeCharacter.Init(INDEX_NONE, Data.AllDialogues.Num());
+
+	auto ResolveNode = [this, &Definition](int32 TreeIndex, FName NodeId)
+	{
+		const int32 NodeIndex = NodeId.IsNone() ? INDEX_NONE : Definition.FindDialogueNodeIndex(TreeIndex, NodeId);
+		return NodeIndex == INDEX_NONE ? INDEX_NONE : GetGlobalNodeIndex(TreeIndex, NodeIndex);
+	};
+
+	for (int32 TreeIndex = 0; TreeIndex < Data.AllDialogues.Num(); TreeIndex++)
+	{
+		const FDialogueTree& Tree = Data.AllDialogues[TreeIndex];
+		for (int32 NodeIndex = 0; NodeIndex < Tree.Nodes.Num(); NodeIndex++)
+		{
+			const FDialogueNode& Node = Tree.Nodes[NodeIndex];
+			const int32 GlobalIndex = Nodes.Num();
+
+			FSolverNode& SolverNode = Nodes.AddDefaulted_GetRef();
+			SolverNode.Tree = TreeIndex;
+			SolverNode.LocalIndex = NodeIndex;
+
+			// 選択肢がなく終了ノードでもない場合のみ自動で次へ進む（UDialogueManager::AdvanceDialogue と同じ）
+			if (!Node.bIsEndNode && Node.Choices.Num() == 0)
+			{
+				SolverNode.AutoNext = ResolveNode(TreeIndex, Node.NextNodeId);
+			}
+
+			SolverNode.FirstGain = GainedEvidence.Num();
+			for (const FName& EvidenceId : Node.GainsEvidence)
+			{
+				const int32 EvidenceIndex = Definition.FindEvidenceIndex(EvidenceId);
+				if (EvidenceIndex != INDEX_NONE)
+				{
+					GainedEvidence.Add(EvidenceIndex);
+				}
+			}
+			SolverNode.NumGains = GainedEvidence.Num() - SolverNode.FirstGain;
+
+			SolverNode.FirstChoice = Choices.Num();
+			SolverNode.NumChoices = Node.Choices.Num();
+			for (int32 ChoiceIndex = 0; ChoiceIndex < Node.Choices.Num(); ChoiceIndex++)
+			{
+				FSolverChoice& SolverChoice = Choices.AddDefaulted_GetRef();
+				SolverChoice.OwnerNode = GlobalIndex;
+				SolverChoice.ChoiceIndex = ChoiceIndex;
+				SolverChoice.TargetNode = ResolveNode(TreeIndex, Node.Choices[ChoiceIndex].NextNodeId);
+			}
+		}
+
+		// 3. 対話を開始できるのはそのキャラクターの有効なツリーのみ（相手の居場所は進行状態に依存するため解析時に判定する）
+		const int32 CharacterIndex = Definition.FindCharacterIndex(Tree.CharacterId);
+		if (CharacterIndex == INDEX_NONE || Definition.FindDialogueTreeIndex(Tree.CharacterId) != TreeIndex)
+		{
+			continue;
+		}
+
+		const int32 StartNode = ResolveNode(TreeIndex, Tree.StartNodeId);
+		if (StartNode == INDEX_NONE)
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseSolver] 開始ノードが見つかりません: %s.%s"),
+				*Tree.CharacterId.ToString(), *Tree.StartNodeId.ToString());
+			continue;
+		}
+
+		TreeStartNode[TreeIndex] = StartNode;
+		TreeCharacter[TreeIndex] = CharacterIndex;
+	}
+
+	DeductionEvidence.Reset(Data.AllDeductions.Num());
+	for (const FDeduction& Deduction : Data.AllDeductions)
+	{
+		DeductionEvidence.Emplace(Definition.FindEvidenceIndex(Deduction.EvidenceA), Definition.FindEvidenceIndex(Deduction.EvidenceB));
+	}
+}
+
+// ============================================================================
+// 手順の組み立て
+// ============================================================================
+
+/// <summary>
+/// 各要素を最初に得た操作を逆にたどり、依存する操作から順に手順を並べます
+/// </summary>
+/// <remarks>
+/// 要素の記録は得られた順なので、ある要素の操作が要求する要素は必ずそれより前に得られており、
+/// 再帰は必ず終わります。既に手順に含めた（または最初から持っている）要素は再度たどりません。
+/// </remarks>
+class FCaseSolver::FPlanBuilder
+{
+public:
+	FPlanBuilder(const FCaseSolver& InSolver, const FCaseDefinition& InDefinition, const FCaseProgress& Progress,
+		const FSolveCauses& InCauses, TArray<FCaseSolutionStep>& OutSteps)
+		: Solver(InSolver)
+		, Definition(InDefinition)
+		, Data(InDefinition.GetData())
+		, Causes(InCauses)
+		, Steps(OutSteps)
+		, PlannedEvidence(Progress.Evidence->Collected)
+		, PlannedFlags(Progress.Flags->Set)
+		, PlannedDeductions(Progress.Deductions->Unlocked)
+		, PlannedTriggers(Progress.Triggers->Fired)
+		, PlannedPresence(false, InCauses.Presence.Num())
+		, PlanLocation(InDefinition.FindLocationIndex(Progress.CurrentLocation))
+	{
+	}
+
+	void NeedEvidence(int32 EvidenceIndex)
+	{
+		if (PlannedEvidence[EvidenceIndex])
+		{
+			return;
+		}
+
+		const FCause Cause = Causes.Evidence[EvidenceIndex];
+		switch (Cause.Kind)
+		{
+		case ECause::Location:
+			NeedLocation(Cause.Index);
+			TravelTo(Cause.Index);
+			AddStep(ECaseSolutionAction::CollectEvidence, Data.AllEvidence[EvidenceIndex].EvidenceId);
+			break;
+		case ECause::Node:
+			EmitDialogue(Cause.Index, INDEX_NONE);
+			break;
+		default:
+			checkNoEntry();
+			break;
+		}
+		PlannedEvidence[EvidenceIndex] = true;
+	}
+
+	void NeedFlag(int32 FlagIndex)
+	{
+		if (PlannedFlags[FlagIndex])
+		{
+			return;
+		}
+
+		const FCause Cause = Causes.Flags[FlagIndex];
+		switch (Cause.Kind)
+		{
+		case ECause::Node:
+			EmitDialogue(Cause.Index, INDEX_NONE);
+			break;
+		case ECause::Choice:
+			EmitDialogue(Solver.Choices[Cause.Index].OwnerNode, Cause.Index);
+			break;
+		case ECause::Deduction:
+			NeedDeduction(Cause.Index);
+			break;
+		default:
+			checkNoEntry();
+			break;
+		}
+		PlannedFlags[FlagIndex] = true;
+	}
+
+	void NeedDeduction(int32 DeductionIndex)
+	{
+		if (PlannedDeductions[DeductionIndex])
+		{
+			return;
+		}
+
+		const FCaseDeductionChain& Chain = Definition.GetDeductionChain();
+		const int32 Rule = Chain.FindRuleForDeduction(DeductionIndex);
+		if (Rule != INDEX_NONE)
+		{
+			// 導出される推理は前提が揃った時点で自動的に成立するため、前提を得る手順だけを並べる
+			for (const int32 EvidenceIndex : Chain.GetPremiseEvidence(Rule))
+			{
+				NeedEvidence(EvidenceIndex);
+			}
+			for (const int32 PremiseIndex : Chain.GetPremiseDeductions(Rule))
+			{
+				NeedDeduction(PremiseIndex);
+			}
+		}
+		else
+		{
+			NeedEvidence(Solver.DeductionEvidence[DeductionIndex].Key);
+			NeedEvidence(Solver.DeductionEvidence[DeductionIndex].Value);
+			AddStep(ECaseSolutionAction::TryDeduction, Data.AllDeductions[DeductionIndex].DeductionId);
+		}
+
+		PlannedDeductions[DeductionIndex] = true;
+		ForEachMaskBit(Definition, Definition.GetDeductionFlagMask(DeductionIndex), Definition.NumFlagWords(),
+			[this](int32 FlagIndex) { PlannedFlags[FlagIndex] = true; });
+	}
+
+private:
+	/// <summary>
+	/// ロケーションを開くトリガーの条件を揃えます（最初から開いていれば何もしません）
+	/// </summary>
+	void NeedLocation(int32 LocationIndex)
+	{
+		const FCause Cause = Causes.Locations[LocationIndex];
+		if (Cause.Kind == ECause::Trigger)
+		{
+			NeedTrigger(Cause.Index);
+		}
+	}
+
+	/// <summary>
+	/// キャラクターがロケーションにいる状態にします（トリガーの条件を揃えるか、移動予定を待ちます）
+	/// </summary>
+	void NeedPresence(int32 CharacterIndex, int32 LocationIndex)
+	{
+		const int32 PresenceIndex = CharacterIndex * Definition.NumLocations() + LocationIndex;
+		if (PlannedPresence[PresenceIndex])
+		{
+			return;
+		}
+
+		const FCause Cause = Causes.Presence[PresenceIndex];
+		if (Cause.Kind == ECause::Trigger)
+		{
+			NeedTrigger(Cause.Index);
+		}
+		else if (Cause.Kind == ECause::Schedule)
+		{
+			FCaseSolutionStep& Step = Steps.AddDefaulted_GetRef();
+			Step.Action = ECaseSolutionAction::WaitForCharacter;
+			Step.Location = Data.AllLocations[LocationIndex].Location;
+			Step.TargetId = Data.AllCharacters[CharacterIndex].CharacterId;
+		}
+		PlannedPresence[PresenceIndex] = true;
+	}
+
+	/// <summary>
+	/// トリガーの条件のフラグ・証拠・推理を揃えます（条件が揃えばトリガーは自動で発火する）
+	/// </summary>
+	void NeedTrigger(int32 Trigger)
+	{
+		if (PlannedTriggers[Trigger])
+		{
+			return;
+		}
+
+		const FCaseTriggerIndex& Triggers = Definition.GetTriggerIndex();
+		for (const int32 EvidenceIndex : Triggers.GetRequiredEvidence(Trigger))
+		{
+			NeedEvidence(EvidenceIndex);
+		}
+		for (const int32 FlagIndex : Triggers.GetRequiredFlags(Trigger))
+		{
+			NeedFlag(FlagIndex);
+		}
+		for (const int32 DeductionIndex : Triggers.GetRequiredDeductions(Trigger))
+		{
+			NeedDeduction(DeductionIndex);
+		}
+		PlannedTriggers[Trigger] = true;
+	}
+
+	/// <summary>
+	/// 開始ノードから目的のノードまでの対話を1回分出力します（FinalChoice があれば最後に選択します）
+	/// </summary>
+	void EmitDialogue(int32 TargetNode, int32 FinalChoice)
+	{
+		// 目的のノードから開始ノードまで、到達時の遷移を逆にたどる
+		TArray<TPair<FCause, int32>, TInlineAllocator<16>> Path;
+		int32 Node = TargetNode;
+		while (Causes.Nodes[Node].Kind != ECause::Start)
+		{
+			const FCause Cause = Causes.Nodes[Node];
+			Path.Emplace(Cause, Node);
+			Node = Cause.Kind == ECause::AutoNext ? Cause.Index : Solver.Choices[Cause.Index].OwnerNode;
+		}
+		const int32 TreeIndex = Causes.Nodes[Node].Index;
+
+		// 経路上の選択肢が要求する証拠・フラグを先に揃える
+		for (const TPair<FCause, int32>& Edge : Path)
+		{
+			if (Edge.Key.Kind == ECause::Choice)
+			{
+				NeedChoiceRequirements(Edge.Key.Index);
+			}
+		}
+		if (FinalChoice != INDEX_NONE)
+		{
+			NeedChoiceRequirements(FinalChoice);
+		}
+
+		const int32 TreeLocation = Causes.TreeLocations[TreeIndex];
+		NeedPresence(Solver.TreeCharacter[TreeIndex], TreeLocation);
+		NeedLocation(TreeLocation);
+		TravelTo(TreeLocation);
+		AddStep(ECaseSolutionAction::TalkTo, Data.AllDialogues[TreeIndex].CharacterId);
+		MarkNodeEffects(Node);
+
+		for (int32 i = Path.Num() - 1; i >= 0; i--)
+		{
+			const FCause Cause = Path[i].Key;
+			if (Cause.Kind == ECause::AutoNext)
+			{
+				AddStep(ECaseSolutionAction::AdvanceDialogue, GetNodeData(Cause.Index).NodeId);
+			}
+			else
+			{
+				SelectChoice(Cause.Index);
+			}
+			MarkNodeEffects(Path[i].Value);
+		}
+
+		if (FinalChoice != INDEX_NONE)
+		{
+			SelectChoice(FinalChoice);
+			if (Solver.Choices[FinalChoice].TargetNode != INDEX_NONE)
+			{
+				MarkNodeEffects(Solver.Choices[FinalChoice].TargetNode);
+			}
+		}
+	}
+
+	void NeedChoiceRequirements(int32 Choice)
+	{
+		const FCompiledDialogueChoice& Compiled = GetCompiledChoice(Choice);
+		ForEachMaskBit(Definition, Compiled.RequiredEvidence, Definition.NumEvidenceWords(),
+			[this](int32 EvidenceIndex) { NeedEvidence(EvidenceIndex); });
+		ForEachMaskBit(Definition, Compiled.RequiredFlags, Definition.NumFlagWords(),
+			[this](int32 FlagIndex) { NeedFlag(FlagIndex); });
+	}
+
+	void SelectChoice(int32 Choice)
+	{
+		const FSolverChoice& SolverChoice = Solver.Choices[Choice];
+		AddStep(ECaseSolutionAction::SelectChoice, GetNodeData(SolverChoice.OwnerNode).Choices[SolverChoice.ChoiceIndex].ChoiceId);
+		ForEachMaskBit(Definition, GetCompiledChoice(Choice).SetsFlags, Definition.NumFlagWords(),
+			[this](int32 FlagIndex) { PlannedFlags[FlagIndex] = true; });
+	}
+
+	/// <summary>
+	/// ノード到達で得られる証拠・フラグを手順に含めたものとして記録します
+	/// </summary>
+	void MarkNodeEffects(int32 Node)
+	{
+		const FSolverNode& SolverNode = Solver.Nodes[Node];
+		for (int32 i = 0; i < SolverNode.NumGains; i++)
+		{
+			PlannedEvidence[Solver.GainedEvidence[SolverNode.FirstGain + i]] = true;
+		}
+		ForEachMaskBit(Definition, Definition.GetCompiledNode(SolverNode.Tree, SolverNode.LocalIndex).SetsFlags, Definition.NumFlagWords(),
+			[this](int32 FlagIndex) { PlannedFlags[FlagIndex] = true; });
+	}
+
+	void TravelTo(int32 LocationIndex)
+	{
+		if (LocationIndex != PlanLocation)
+		{
+			FCaseSolutionStep& Step = Steps.AddDefaulted_GetRef();
+			Step.Action = ECaseSolutionAction::TravelTo;
+			Step.Location = Data.AllLocations[LocationIndex].Location;
+			PlanLocation = LocationIndex;
+		}
+	}
+
+	void AddStep(ECaseSolutionAction Action, FName TargetId)
+	{
+		FCaseSolutionStep& Step = Steps.AddDefaulted_GetRef();
+		Step.Action = Action;
+		Step.Location = PlanLocation != INDEX_NONE ? Data.AllLocations[PlanLocation].Location : ELocation::Office;
+		Step.TargetId = TargetId;
+	}
+
+	const FDialogueNode& GetNodeData(int32 Node) const
+	{
+		const FSolverNode& SolverNode = Solver.Nodes[Node];
+		return Data.AllDialogues[SolverNode.Tree].Nodes[SolverNode.LocalIndex];
+	}
+
+	const FCompiledDialogueChoice& GetCompiledChoice(int32 Choice) const
+	{
+		const FSolverNode& Owner = Solver.Nodes[Solver.Choices[Choice].OwnerNode];
+		return Definition.GetCompiledChoice(Owner.Tree, Owner.LocalIndex, Solver.Choices[Choice].ChoiceIndex);
+	}
+
+	const FCaseSolver& Solver;
+	const FCaseDefinition& Definition;
+	const FCaseData& Data;
+	const FSolveCauses& Causes;
+	TArray<FCaseSolutionStep>& Steps;
+
+	TBitArray<> PlannedEvidence;
+	TBitArray<> PlannedFlags;
+	TBitArray<> PlannedDeductions;
+	TBitArray<> PlannedTriggers;
+	TBitArray<> PlannedPresence;
+
+	/// <summary>手順を実行した時点での現在地</summary>
+	int32 PlanLocation;
+};
+
+// ============================================================================
+// 解析
+// ============================================================================
+
+FCaseReachability FCaseSolver::Solve(const FCaseDefinition& Definition, const FCaseProgress& Progress, bool bBuildPlan) const
+{
+	FCaseReachability Result;
+	if (!Progress.IsCompatibleWith(Definition))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseSolver] 進行状態が事件定義と一致しません: %s"), *Definition.GetData().CaseId.ToString());
+		return Result;
+	}
+
+	Result.Evidence = Progress.Evidence->Collected;
+	Result.Flags = Progress.Flags->Set;
+	Result.Deductions = Progress.Deductions->Unlocked;
+	Result.DialogueNodes.Init(false, Nodes.Num());
+
+	const int32 NumLocations = Definition.NumLocations();
+	FSolveCauses Causes;
+	Causes.Evidence.SetNum(Definition.NumEvidence());
+	Causes.Flags.SetNum(Definition.NumFlags());
+	Causes.Nodes.SetNum(Nodes.Num());
+	Causes.Locations.SetNum(NumLocations);
+	Causes.Presence.SetNum(Definition.NumCharacters() * NumLocations);
+	Causes.TreeLocations.Init(INDEX_NONE, TreeStartNode.Num());
+
+	TBitArray<> ChoiceTaken(false, Choices.Num());
+	bool bChanged = false;
+
+	auto GainEvidence = [&](int32 EvidenceIndex, FCause Cause)
+	{
+		if (!Result.Evidence[EvidenceIndex])
+		{
+			Result.Evidence[EvidenceIndex] = true;
+			Causes.Evidence[EvidenceIndex] = Cause;
+			bChanged = true;
+		}
+	};
+
+	auto SetFlags = [&](FCompiledMask Mask, FCause Cause)
+	{
+		ForEachMaskBit(Definition, Mask, Definition.NumFlagWords(), [&](int32 FlagIndex)
+		{
+			if (!Result.Flags[FlagIndex])
+			{
+				Result.Flags[FlagIndex] = true;
+				Causes.Flags[FlagIndex] = Cause;
+				bChanged = true;
+			}
+		});
+	};
+
+	auto ReachNode = [&](int32 Node, FCause Cause)
+	{
+		if (Node == INDEX_NONE || Result.DialogueNodes[Node])
+		{
+			return;
+		}
+		Result.DialogueNodes[Node] = true;
+		Causes.Nodes[Node] = Cause;
+		bChanged = true;
+
+		const FSolverNode& SolverNode = Nodes[Node];
+		for (int32 i = 0; i < SolverNode.NumGains; i++)
+		{
+			GainEvidence(GainedEvidence[SolverNode.FirstGain + i], { ECause::Node, Node });
+		}
+		SetFlags(Definition.GetCompiledNode(SolverNode.Tree, SolverNode.LocalIndex).SetsFlags, { ECause::Node, Node });
+	};
+
+	// ロケーションのアクセス可否とキャラクターの居場所は現在の進行状態から始める
+	TBitArray<> OpenLocations = Progress.Locations->Accessible;
+	TBitArray<> Presence(false, Causes.Presence.Num());
+	for (int32 CharacterIndex = 0; CharacterIndex < Definition.NumCharacters(); CharacterIndex++)
+	{
+		const int32 LocationIndex = Progress.Characters->CurrentLocations[CharacterIndex];
+		if (LocationIndex != INDEX_NONE)
+		{
+			Presence[CharacterIndex * NumLocations + LocationIndex] = true;
+		}
+	}
+
+	auto OpenLocation = [&](int32 LocationIndex, FCause Cause)
+	{
+		if (!OpenLocations[LocationIndex])
+		{
+			OpenLocations[LocationIndex] = true;
+			Causes.Locations[LocationIndex] = Cause;
+			bChanged = true;
+		}
+	};
+
+	auto AddPresence = [&](int32 CharacterIndex, int32 LocationIndex, FCause Cause)
+	{
+		const int32 PresenceIndex = CharacterIndex * NumLocations + LocationIndex;
+		if (!Presence[PresenceIndex])
+		{
+			Presence[PresenceIndex] = true;
+			Causes.Presence[PresenceIndex] = Cause;
+			bChanged = true;
+		}
+	};
+
+	// 今後の移動予定は時間を進めるだけで起きる
+	const TArrayView<const FCompiledScheduleEntry> Schedule = Definition.GetSchedule();
+	for (int32 Entry = Definition.FindFirstScheduleEntryAfter(Progress.ClockMinutes); Entry < Schedule.Num(); Entry++)
+	{
+		if (Schedule[Entry].CharacterIndex != INDEX_NONE && Schedule[Entry].LocationIndex != INDEX_NONE)
+		{
+			AddPresence(Schedule[Entry].CharacterIndex, Schedule[Entry].LocationIndex, { ECause::Schedule, Entry });
+		}
+	}
+
+	const FCaseRelationGraph& Graph = Definition.GetRelationGraph();
+	const FCaseDeductionChain& Chain = Definition.GetDeductionChain();
+	const FCaseTriggerIndex& Triggers = Definition.GetTriggerIndex();
+	TBitArray<> LocationSearched(false, NumLocations);
+	TBitArray<> TriggerApplied = Progress.Triggers->Fired;
+
+	// 何も増えなくなるまで掃引する
+	bChanged = true;
+	while (bChanged)
+	{
+		bChanged = false;
+
+		// 開いているロケーションでの収集
+		for (TConstSetBitIterator<> It(OpenLocations); It; ++It)
+		{
+			const int32 LocationIndex = It.GetIndex();
+			if (LocationSearched[LocationIndex])
+			{
+				continue;
+			}
+			LocationSearched[LocationIndex] = true;
+			Graph.ForEachNeighbor(Graph.LocationNode(LocationIndex), ECaseNodeKind::Evidence, [&](int32 EvidenceIndex)
+			{
+				GainEvidence(EvidenceIndex, { ECause::Location, LocationIndex });
+			});
+		}
+
+		// 相手が開いているロケーションにいられる対話の開始
+		for (int32 TreeIndex = 0; TreeIndex < TreeStartNode.Num(); TreeIndex++)
+		{
+			if (TreeStartNode[TreeIndex] == INDEX_NONE || Causes.TreeLocations[TreeIndex] != INDEX_NONE)
+			{
+				continue;
+			}
+			const int32 FirstPresence = TreeCharacter[TreeIndex] * NumLocations;
+			for (int32 LocationIndex = 0; LocationIndex < NumLocations; LocationIndex++)
+			{
+				if (Presence[FirstPresence + LocationIndex] && OpenLocations[LocationIndex])
+				{
+					Causes.TreeLocations[TreeIndex] = LocationIndex;
+					ReachNode(TreeStartNode[TreeIndex], { ECause::Start, TreeIndex });
+					break;
+				}
+			}
+		}
+
+		// 条件のフラグ・証拠・推理が揃った未発火のトリガー（信頼度の条件は対話で変えられるものとみなす）
+		for (int32 Trigger = 0; Trigger < Triggers.NumTriggers(); Trigger++)
+		{
+			if (TriggerApplied[Trigger]
+				|| Triggers.IsUnsatisfiable(Trigger)
+				|| Algo::AnyOf(Triggers.GetRequiredFlags(Trigger), [&Result](int32 FlagIndex) { return !Result.Flags[FlagIndex]; })
+				|| Algo::AnyOf(Triggers.GetRequiredEvidence(Trigger), [&Result](int32 EvidenceIndex) { return !Result.Evidence[EvidenceIndex]; })
+				|| Algo::AnyOf(Triggers.GetRequiredDeductions(Trigger), [&Result](int32 DeductionIndex) { return !Result.Deductions[DeductionIndex]; }))
+			{
+				continue;
+			}
+
+			TriggerApplied[Trigger] = true;
+			bChanged = true;
+			for (const FCompiledTriggerAction& Action : Triggers.GetActions(Trigger))
+			{
+				if (Action.Type == ETriggerActionType::SetLocationAccessible && Action.Value != 0)
+				{
+					OpenLocation(Action.Target, { ECause::Trigger, Trigger });
+				}
+				else if (Action.Type == ETriggerActionType::MoveCharacter)
+				{
+					AddPresence(Action.Target, Action.LocationIndex, { ECause::Trigger, Trigger });
+				}
+			}
+		}
+
+		for (int32 Node = 0; Node < Nodes.Num(); Node++)
+		{
+			if (!Result.DialogueNodes[Node])
+			{
+				continue;
+			}
+
+			const FSolverNode& SolverNode = Nodes[Node];
+			ReachNode(SolverNode.AutoNext, { ECause::AutoNext, Node });
+
+			for (int32 Choice = SolverNode.FirstChoice; Choice < SolverNode.FirstChoice + SolverNode.NumChoices; Choice++)
+			{
+				if (ChoiceTaken[Choice])
+				{
+					continue;
+				}
+
+				const FCompiledDialogueChoice& Compiled = Definition.GetCompiledChoice(SolverNode.Tree, SolverNode.LocalIndex, Choices[Choice].ChoiceIndex);
+				if (Compiled.bUnsatisfiable
+					|| !Definition.ContainsAllEvidence(Result.Evidence, Compiled.RequiredEvidence)
+					|| !Definition.ContainsAllFlags(Result.Flags, Compiled.RequiredFlags))
+				{
+					continue;
+				}
+
+				ChoiceTaken[Choice] = true;
+				bChanged = true;
+				SetFlags(Compiled.SetsFlags, { ECause::Choice, Choice });
+				ReachNode(Choices[Choice].TargetNode, { ECause::Choice, Choice });
+			}
+		}
+
+		for (int32 DeductionIndex = 0; DeductionIndex < DeductionEvidence.Num(); DeductionIndex++)
+		{
+			const TPair<int32, int32>& Pair = DeductionEvidence[DeductionIndex];
+			if (Result.Deductions[DeductionIndex] || Pair.Key == INDEX_NONE || Pair.Value == INDEX_NONE
+				|| !Result.Evidence[Pair.Key] || !Result.Evidence[Pair.Value])
+			{
+				continue;
+			}
+
+			Result.Deductions[DeductionIndex] = true;
+			bChanged = true;
+			SetFlags(Definition.GetDeductionFlagMask(DeductionIndex), { ECause::Deduction, DeductionIndex });
+		}
+
+		// 前提が全て到達可能になった導出規則の推理
+		for (int32 Rule = 0; Rule < Chain.NumRules(); Rule++)
+		{
+			const int32 DeductionIndex = Chain.GetRuleDeduction(Rule);
+			if (Result.Deductions[DeductionIndex]
+				|| Algo::AnyOf(Chain.GetPremiseEvidence(Rule), [&Result](int32 EvidenceIndex) { return !Result.Evidence[EvidenceIndex]; })
+				|| Algo::AnyOf(Chain.GetPremiseDeductions(Rule), [&Result](int32 PremiseIndex) { return !Result.Deductions[PremiseIndex]; }))
+			{
+				continue;
+			}
+
+			Result.Deductions[DeductionIndex] = true;
+			bChanged = true;
+			SetFlags(Definition.GetDeductionFlagMask(DeductionIndex), { ECause::Deduction, DeductionIndex });
+		}
+	}
+
+	// 存在しない証拠を要求している場合は NumAccusationRequirements() に届かない
+	int32 ReachableRequirements = 0;
+	for (int32 EvidenceIndex = 0; EvidenceIndex < Definition.NumEvidence(); EvidenceIndex++)
+	{
+		if (Definition.IsRequiredForAccusation(EvidenceIndex) && Result.Evidence[EvidenceIndex])
+		{
+			ReachableRequirements++;
+		}
+	}
+	Result.bAccusationReachable = ReachableRequirements == Definition.NumAccusationRequirements();
+
+	if (bBuildPlan && Result.bAccusationReachable)
+	{
+		FPlanBuilder Builder(*this, Definition, Progress, Causes, Result.Steps);
+		for (int32 EvidenceIndex = 0; EvidenceIndex < Definition.NumEvidence(); EvidenceIndex++)
+		{
+			if (Definition.IsRequiredForAccusation(EvidenceIndex))
+			{
+				Builder.NeedEvidence(EvidenceIndex);
+			}
+		}
+	}
+
+	return Result;
+}
+
+FCaseSolvabilityReport FCaseSolver::MakeReport(const FCaseDefinition& Definition, FCaseReachability&& Reachability) const
+{
+	const FCaseData& Data = Definition.GetData();
+
+	FCaseSolvabilityReport Report;
+	Report.bSolvable = Reachability.bAccusationReachable;
+	Report.Steps = MoveTemp(Reachability.Steps);
+
+	for (int32 i = 0; i < Reachability.Evidence.Num(); i++)
+	{
+		if (!Reachability.Evidence[i])
+		{
+			Report.UnreachableEvidence.Add(Data.AllEvidence[i].EvidenceId);
+		}
+	}
+	for (int32 i = 0; i < Reachability.Flags.Num(); i++)
+	{
+		if (!Reachability.Flags[i])
+		{
+			Report.UnreachableFlags.Add(Definition.GetFlagName(i));
+		}
+	}
+	for (int32 i = 0; i < Reachability.Deductions.Num(); i++)
+	{
+		if (!Reachability.Deductions[i])
+		{
+			Report.UnreachableDeductions.Add(Data.AllDeductions[i].DeductionId);
+		}
+	}
+	for (int32 i = 0; i < Reachability.DialogueNodes.Num(); i++)
+	{
+		if (!Reachability.DialogueNodes[i])
+		{
+			const FDialogueTree& Tree = Data.AllDialogues[Nodes[i].Tree];
+			Report.UnreachableDialogueNodes.Add(FString::Printf(TEXT("%s.%s"),
+				*Tree.CharacterId.ToString(), *Tree.Nodes[Nodes[i].LocalIndex].NodeId.ToString()));
+		}
+	}
+
+	return Report;
+}
@@ -1,56 +1,174 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Core/CaseState.h"
+#include "Core/CaseDefinition.h"
 #include "TheLastWitness.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 UCaseState::UCaseState()
 {
 }
 
+void UCaseState::BeginDestroy()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
 void UCaseState::InitializeCase(const FCaseData& InCaseData)
 {
-	CaseData = InCaseData;
-	ResetState();
+	InitializeFromDefinition(FCaseDefinition::Create(InCaseData));
+}
+
+void UCaseState::InitializeFromDefinition(TSharedRef<const FCaseDefinition> InDefinition)
+{
+	const bool bSameDefinition = Definition == InDefinition;
+	Definition = InDefinition;
+	Checkpoints.Empty();
+
+	// 同じ事件定義での再利用（セッションのプール等）では確保済みの領域をそのまま使う
+	if (bSameDefinition && Progress.IsCompatibleWith(*Definition))
+	{
+		Progress.Reset(*Definition);
+		Progress.JournalLength = 0;
+	}
+	else
+	{
+		Progress.Initialize(*Definition);
+	}
+	Journal.Reset(Definition->GetData().CaseId);
+	Progress.JournalCrc = Journal.GetCrc();
+	bJournalComplete = true;
+	PendingChanges = FCaseChangeSet();
+	RebuildSchedule();
+	RebuildDeductionChain();
+	RebuildTriggers();
+
+	// 事件定義が変わった可能性があるので、古い事件のスナップショットは直ちに差し替える
+	if (bPublishSnapshots)
+	{
+		PublishSnapshot();
+	}
 
-	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 事件を初期化しました: %s"), *CaseData.CaseId.ToString());
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 事件を初期化しました: %s (進行状態 %d バイト)"),
+		*Definition->GetData().CaseId.ToString(),
+		static_cast<int32>(Progress.GetAllocatedSize()));
 }
 
 void UCaseState::ResetState()
 {
-	CurrentLocation = ELocation::Office;
-	SetFlags.Empty();
-	ABELSuggestionsFollowed = 0;
-	ABELSuggestionsIgnored = 0;
-	EthicalViolations = 0;
-
-	// 全証拠を未収集状態にリセット
-	for (FEvidence& Evidence : CaseData.AllEvidence)
+	if (!Definition)
 	{
-		Evidence.bIsCollected = false;
-		Evidence.bIsExamined = false;
+		return;
 	}
 
-	// 全キャラクターをリセット
-	for (FCharacterData& Character : CaseData.AllCharacters)
+	// 定義は共有のまま、進行状態のみをクリア
+	Progress.Reset(*Definition);
+	RebuildSchedule();
+	RebuildDeductionChain();
+	RebuildTriggers();
+	Record(ECaseJournalOp::Reset);
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 状態をリセットしました"));
+}
+
+void UCaseState::ReleaseForReuse()
+{
+	OnEvidenceCollected.Clear();
+	OnDeductionUnlocked.Clear();
+	OnFlagSet.Clear();
+	OnLocationVisited.Clear();
+	OnCharacterTrustChanged.Clear();
+	OnCharacterMoved.Clear();
+	OnLocationAccessChanged.Clear();
+	OnCharacterEmotionChanged.Clear();
+	OnClockAdvanced.Clear();
+	OnProgressRestored.Clear();
+	OnCaseChanged.Clear();
+	OnEvidenceCollectedNative.Clear();
+	OnDeductionUnlockedNative.Clear();
+	OnFlagSetNative.Clear();
+	OnLocationVisitedNative.Clear();
+	OnCharacterTrustChangedNative.Clear();
+	OnCharacterMovedNative.Clear();
+	OnLocationAccessChangedNative.Clear();
+	OnCharacterEmotionChangedNative.Clear();
+	OnClockAdvancedNative.Clear();
+	OnProgressRestoredNative.Clear();
+	OnCaseChangedNative.Clear();
+
+	SetChangeSetMode(false);
+	SetSnapshotPublishing(false);
+	PendingChanges = FCaseChangeSet();
+	Checkpoints.Empty();
+}
+
+// ============================================================================
+// チェックポイント
+// ============================================================================
+
+int32 UCaseState::CreateCheckpoint()
+{
+	const int32 CheckpointId = NextCheckpointId++;
+	Checkpoints.Add(CheckpointId, Progress);
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] チェックポイントを作成しました: %d"), CheckpointId);
+	return CheckpointId;
+}
+
+bool UCaseState::RestoreCheckpoint(int32 CheckpointId)
+{
+	const FCaseProgress* Snapshot = Checkpoints.Find(CheckpointId);
+	if (!Snapshot)
 	{
-		Character.bHasBeenInterviewed = false;
-		Character.TrustLevel = 50;
-		Character.EmotionalState = EEmotionalState::Neutral;
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] チェックポイントが見つかりません: %d"), CheckpointId);
+		return false;
 	}
+	return RestoreProgress(*Snapshot);
+}
 
-	// 全ロケーションをリセット
-	for (FLocationData& Location : CaseData.AllLocations)
+void UCaseState::DiscardCheckpoint(int32 CheckpointId)
+{
+	Checkpoints.Remove(CheckpointId);
+}
+
+bool UCaseState::RestoreProgress(const FCaseProgress& Snapshot)
+{
+	if (!Definition || !Snapshot.IsCompatibleWith(*Definition))
 	{
-		Location.bHasVisited = false;
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 現在の事件と一致しない進行状態は復元できません"));
+		return false;
 	}
 
-	// 全推理をリセット
-	for (FDeduction& Deduction : CaseData.AllDeductions)
+	// セクションを共有するだけなので O(1)。次の変更時に必要な部分だけ複製される
+	Progress = Snapshot;
+	RebuildSchedule();
+	RebuildDeductionChain();
+	RebuildTriggers();
+
+	// ジャーナルも同じ地点まで巻き戻す（現在の履歴上の過去の地点である場合のみ）
+	if (Progress.JournalLength <= Journal.NumBytes() && Journal.ComputePrefixCrc(Progress.JournalLength) == Progress.JournalCrc)
+	{
+		Journal.Truncate(Progress.JournalLength);
+	}
+	else
 	{
-		Deduction.bIsUnlocked = false;
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] ジャーナルに無い地点へ復元したため、以降のジャーナルは再生に使えません"));
+		bJournalComplete = false;
+		Progress.JournalLength = Journal.NumBytes();
+		Progress.JournalCrc = Journal.GetCrc();
 	}
 
-	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 状態をリセットしました"));
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 進行状態を復元しました"));
+
+	BroadcastProgressRestored();
+	return true;
 }
 
 // ============================================================================
@@ -59,59 +177,98 @@ void UCaseState::ResetState()
 
 bool UCaseState::CollectEvidence(FName EvidenceId)
 {
-	const int32 Index = FindEvidenceIndex(EvidenceId);
-	if (Index == INDEX_NONE)
+	const FEvidenceHandle Evidence(FindEvidenceIndex(EvidenceId));
+	if (!Evidence)
 	{
 		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 証拠が見つかりません: %s"), *EvidenceId.ToString());
 		return false;
 	}
+	return CollectEvidence(Evidence);
+}
 
-	if (CaseData.AllEvidence[Index].bIsCollected)
+bool UCaseState::CollectEvidence(FEvidenceHandle Evidence)
+{
+	if (!Definition || !Definition->IsValidHandle(Evidence))
 	{
-		return false; // 既に収集済み
+		return false;
 	}
 
-	CaseData.AllEvidence[Index].bIsCollected = true;
+	const int32 Index = Evidence.GetIndex();
+	if (!Progress.MarkEvidenceCollected(*Definition, Index))
+	{
+		return false; // 既に収集済み
+	}
+	Record(ECaseJournalOp::CollectEvidence, Index);
 
+	const FName EvidenceId = Definition->GetEvidence(Evidence).EvidenceId;
 	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 証拠を収集しました: %s"), *EvidenceId.ToString());
 
-	OnEvidenceCollected.Broadcast(CaseData.AllEvidence[Index]);
+	OnEvidenceCollectedNative.Broadcast(Index);
+	if (DeferChange(ECaseChangeFlags::Evidence))
+	{
+		PendingChanges.CollectedEvidence.Add(EvidenceId);
+	}
+	else if (OnEvidenceCollected.IsBound())
+	{
+		OnEvidenceCollected.Broadcast(MakeEvidenceSnapshot(Index));
+	}
+
+	// この証拠を前提とする推理が導かれる場合は、収集の通知の後に続けて通知する
+	PropagateEvidence(Index, true);
+	EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingEvidence(Index), true);
 
 	return true;
 }
 
-void UCaseState::ExamineEvidence(FName EvidenceId)
+bool UCaseState::ExamineEvidence(FName EvidenceId)
 {
-	const int32 Index = FindEvidenceIndex(EvidenceId);
-	if (Index != INDEX_NONE)
-	{
-		CaseData.AllEvidence[Index].bIsExamined = true;
-	}
+	return ExamineEvidence(FEvidenceHandle(FindEvidenceIndex(EvidenceId)));
 }
 
-bool UCaseState::HasEvidence(FName EvidenceId) const
+bool UCaseState::ExamineEvidence(FEvidenceHandle Evidence)
 {
-	const int32 Index = FindEvidenceIndex(EvidenceId);
-	if (Index == INDEX_NONE)
+	if (!Definition || !Definition->IsValidHandle(Evidence))
 	{
 		return false;
 	}
-	return CaseData.AllEvidence[Index].bIsCollected;
+
+	const int32 Index = Evidence.GetIndex();
+	if (Progress.Evidence->Examined[Index])
+	{
+		return false; // 既に調査済み
+	}
+
+	Progress.Evidence.Edit().Examined[Index] = true;
+	Record(ECaseJournalOp::ExamineEvidence, Index);
+	DeferChange(ECaseChangeFlags::Evidence);
+	return true;
+}
+
+bool UCaseState::HasEvidence(FName EvidenceId) const
+{
+	return HasEvidence(FEvidenceHandle(FindEvidenceIndex(EvidenceId)));
+}
+
+bool UCaseState::HasEvidence(FEvidenceHandle Evidence) const
+{
+	return Definition && Definition->IsValidHandle(Evidence) && Progress.Evidence->Collected[Evidence.GetIndex()];
 }
 
 TArray<FEvidence> UCaseState::GetCollectedEvidence() const
 {
 	TArray<FEvidence> Result;
-	for (const FEvidence& Evidence : CaseData.AllEvidence)
+	for (TConstSetBitIterator<> It(Progress.Evidence->Collected); It; ++It)
 	{
-		if (Evidence.bIsCollected)
-		{
-			Result.Add(Evidence);
-		}
+		Result.Add(MakeEvidenceSnapshot(It.GetIndex()));
 	}
 	return Result;
 }
 
+int32 UCaseState::GetCollectedEvidenceCount() const
+{
+	return Progress.Counters.CollectedEvidence;
+}
+
 bool UCaseState::GetEvidenceById(FName EvidenceId, FEvidence& OutEvidence) const
 {
 	const int32 Index = FindEvidenceIndex(EvidenceId);
@@ -119,100 +276,236 @@ bool UCaseState::GetEvidenceById(FName EvidenceId, FEvidence& OutEvidence) const
 	{
 		return false;
 	}
-	OutEvidence = CaseData.AllEvidence[Index];
+	OutEvidence = MakeEvidenceSnapshot(Index);
 	return true;
 }
 
 // ============================================================================
-// 推理関連
+// 証拠の検索
 // ============================================================================
 
-bool UCaseState::TryDeduction(FName EvidenceA, FName EvidenceB, FDeduction& OutDeduction)
+TArray<FEvidence> UCaseState::QueryEvidence(const FEvidenceQuery& Query) const
 {
-	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] TryDeduction: %s + %s"), *EvidenceA.ToString(), *EvidenceB.ToString());
+	TArray<int32, TInlineAllocator<32>> Indices;
+	QueryEvidenceIndices(Query, Indices);
 
-	// 両方の証拠を持っているか確認
-	const bool bHasA = HasEvidence(EvidenceA);
-	const bool bHasB = HasEvidence(EvidenceB);
+	TArray<FEvidence> Result;
+	Result.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		Result.Add(MakeEvidenceSnapshot(Index));
+	}
+	return Result;
+}
 
-	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 証拠所持確認 - %s: %s, %s: %s"),
-		*EvidenceA.ToString(), bHasA ? TEXT("あり") : TEXT("なし"),
-		*EvidenceB.ToString(), bHasB ? TEXT("あり") : TEXT("なし"));
+TArray<FName> UCaseState::QueryEvidenceIds(const FEvidenceQuery& Query) const
+{
+	TArray<int32, TInlineAllocator<32>> Indices;
+	QueryEvidenceIndices(Query, Indices);
 
-	if (!bHasA || !bHasB)
+	const TArray<FEvidence>& AllEvidence = GetCaseData().AllEvidence;
+	TArray<FName> Result;
+	Result.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
 	{
-		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 証拠が不足しています"));
-		return false;
+		Result.Add(AllEvidence[Index].EvidenceId);
 	}
+	return Result;
+}
 
-	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 推理データ数: %d"), CaseData.AllDeductions.Num());
+int32 UCaseState::CountEvidence(const FEvidenceQuery& Query) const
+{
+	TArray<uint32, TInlineAllocator<4>> Words;
+	const int32 NumWords = ComputeEvidenceQueryWords(Query, Words);
 
-	// 一致する推理を探す
-	for (FDeduction& Deduction : CaseData.AllDeductions)
+	int32 Count = 0;
+	for (int32 i = 0; i < NumWords; i++)
 	{
-		UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 推理チェック: %s (%s + %s) - 解放済み: %s"),
-			*Deduction.DeductionId.ToString(),
-			*Deduction.EvidenceA.ToString(),
-			*Deduction.EvidenceB.ToString(),
-			Deduction.bIsUnlocked ? TEXT("Yes") : TEXT("No"));
+		Count += FMath::CountBits(Words[i]);
+	}
+	return Count;
+}
 
-		// 順番に関係なく一致するかチェック
-		const bool bMatches = (Deduction.EvidenceA == EvidenceA && Deduction.EvidenceB == EvidenceB) ||
-		                      (Deduction.EvidenceA == EvidenceB && Deduction.EvidenceB == EvidenceA);
+int32 UCaseState::ComputeEvidenceQueryWords(const FEvidenceQuery& Query, TArray<uint32, TInlineAllocator<4>>& OutWords) const
+{
+	OutWords.Reset();
+	if (!Definition.IsValid())
+	{
+		return 0;
+	}
 
-		if (bMatches)
-		{
-			OutDeduction = Deduction;
+	const int32 NumWords = Definition->NumEvidenceWords();
+	const int32 NumEvidence = Definition->NumEvidence();
+	OutWords.SetNumUninitialized(NumWords);
 
-			// 既に解放済みの場合は結果のみ返す（フラグは再設定しない）
-			if (Deduction.bIsUnlocked)
-			{
-				UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 既に解放済みの推理を再表示: %s"), *Deduction.DeductionId.ToString());
-				return true;
-			}
+	// 全件から始め、末尾ワードの範囲外ビットは落としておく
+	for (int32 i = 0; i < NumWords; i++)
+	{
+		OutWords[i] = ~0u;
+	}
+	if (NumEvidence % NumBitsPerDWORD != 0)
+	{
+		OutWords[NumWords - 1] = (1u << (NumEvidence % NumBitsPerDWORD)) - 1;
+	}
 
-			// 新規解放
-			Deduction.bIsUnlocked = true;
+	auto AndWords = [&OutWords, NumWords](const uint32* Words, bool bInvert)
+	{
+		const uint32 InvertMask = bInvert ? ~0u : 0u;
+		for (int32 i = 0; i < NumWords; i++)
+		{
+			OutWords[i] &= Words[i] ^ InvertMask;
+		}
+	};
 
-			// フラグを設定
-			for (const FName& FlagName : Deduction.UnlocksFlags)
-			{
-				SetFlag(FlagName);
-			}
+	if (Query.bFilterByType)
+	{
+		AndWords(Definition->GetEvidenceTypeWords(Query.Type), false);
+	}
 
-			UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 推理を解放しました: %s"), *Deduction.DeductionId.ToString());
+	if (Query.bFilterByImportance)
+	{
+		AndWords(Definition->GetEvidenceMinImportanceWords(Query.MinImportance), false);
+	}
 
-			OnDeductionUnlocked.Broadcast(Deduction);
+	if (Query.bFilterByLocation)
+	{
+		const int32 LocationIndex = Definition->FindLocationIndex(Query.Location);
+		if (LocationIndex == INDEX_NONE)
+		{
+			FMemory::Memzero(OutWords.GetData(), NumWords * sizeof(uint32));
+			return NumWords;
+		}
+		AndWords(Definition->GetEvidenceAtLocationWords(LocationIndex), false);
+	}
 
-			return true;
+	if (!Query.RelatedCharacter.IsNone())
+	{
+		const int32 CharacterIndex = Definition->FindCharacterIndex(Query.RelatedCharacter);
+		if (CharacterIndex == INDEX_NONE)
+		{
+			FMemory::Memzero(OutWords.GetData(), NumWords * sizeof(uint32));
+			return NumWords;
 		}
+		AndWords(Definition->GetEvidenceRelatedToCharacterWords(CharacterIndex), false);
 	}
 
-	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 一致する推理が見つかりませんでした"));
-	return false;
+	if (Query.Collected != EEvidenceStateFilter::Any)
+	{
+		AndWords(Progress.Evidence->Collected.GetData(), Query.Collected == EEvidenceStateFilter::No);
+	}
+
+	if (Query.Examined != EEvidenceStateFilter::Any)
+	{
+		AndWords(Progress.Evidence->Examined.GetData(), Query.Examined == EEvidenceStateFilter::No);
+	}
+
+	return NumWords;
+}
+
+// ============================================================================
+// 推理関連
+// ============================================================================
+
+bool UCaseState::TryDeduction(FName EvidenceA, FName EvidenceB, FDeduction& OutDeduction)
+{
+	UE_LOG(LogLastWitness, Verbose, TEXT("[CaseState] TryDeduction: %s + %s"), *EvidenceA.ToString(), *EvidenceB.ToString());
+
+	const FDeductionHandle Deduction = TryDeduction(FEvidenceHandle(FindEvidenceIndex(EvidenceA)), FEvidenceHandle(FindEvidenceIndex(EvidenceB)));
+	if (!Deduction)
+	{
+		return false;
+	}
+
+	OutDeduction = MakeDeductionSnapshot(Deduction.GetIndex());
+	return true;
+}
+
+FDeductionHandle UCaseState::TryDeduction(FEvidenceHandle EvidenceA, FEvidenceHandle EvidenceB)
+{
+	// 両方の証拠を持っているか確認
+	const bool bHasA = HasEvidence(EvidenceA);
+	const bool bHasB = HasEvidence(EvidenceB);
+
+	if (!bHasA || !bHasB)
+	{
+		auto DescribeEvidence = [this](FEvidenceHandle Evidence)
+		{
+			return Definition && Definition->IsValidHandle(Evidence) ? Definition->GetEvidence(Evidence).EvidenceId.ToString() : FString(TEXT("None"));
+		};
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 証拠が不足しています - %s: %s, %s: %s"),
+			*DescribeEvidence(EvidenceA), bHasA ? TEXT("あり") : TEXT("なし"),
+			*DescribeEvidence(EvidenceB), bHasB ? TEXT("あり") : TEXT("なし"));
+		return FDeductionHandle();
+	}
+
+	const int32 IndexA = EvidenceA.GetIndex();
+	const int32 IndexB = EvidenceB.GetIndex();
+
+	// 順番に関係なく一致する推理を探す
+	const int32 DeductionIndex = Definition->FindDeductionByEvidencePair(IndexA, IndexB);
+	if (DeductionIndex == INDEX_NONE)
+	{
+		UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 一致する推理が見つかりませんでした"));
+		return FDeductionHandle();
+	}
+
+	const FDeduction& Deduction = Definition->GetData().AllDeductions[DeductionIndex];
+
+	// 既に解放済みの場合は結果のみ返す（フラグは再設定しない）
+	if (Progress.Deductions->Unlocked[DeductionIndex])
+	{
+		UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 既に解放済みの推理を再表示: %s"), *Deduction.DeductionId.ToString());
+		return FDeductionHandle(DeductionIndex);
+	}
+
+	// 新規解放（付随するフラグは再生時に推理から再現されるので個別には記録しない）
+	Progress.MarkDeductionUnlocked(DeductionIndex);
+	Record(ECaseJournalOp::UnlockDeduction, IndexA, IndexB);
+
+	// フラグを設定
+	SetFlagBits(Definition->GetDeductionFlagMask(DeductionIndex), false, true);
+
+	NotifyDeductionUnlocked(DeductionIndex);
+	EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingDeduction(DeductionIndex), true);
+	PropagateDeduction(DeductionIndex, true);
+
+	return FDeductionHandle(DeductionIndex);
 }
 
 TArray<FDeduction> UCaseState::GetUnlockedDeductions() const
 {
 	TArray<FDeduction> Result;
-	for (const FDeduction& Deduction : CaseData.AllDeductions)
+	for (TConstSetBitIterator<> It(Progress.Deductions->Unlocked); It; ++It)
 	{
-		if (Deduction.bIsUnlocked)
-		{
-			Result.Add(Deduction);
-		}
+		Result.Add(MakeDeductionSnapshot(It.GetIndex()));
 	}
 	return Result;
 }
 
 bool UCaseState::IsDeductionUnlocked(FName DeductionId) const
 {
-	const int32 Index = FindDeductionIndex(DeductionId);
-	if (Index == INDEX_NONE)
+	return IsDeductionUnlocked(FDeductionHandle(FindDeductionIndex(DeductionId)));
+}
+
+bool UCaseState::IsDeductionUnlocked(FDeductionHandle Deduction) const
+{
+	return Definition && Definition->IsValidHandle(Deduction) && Progress.Deductions->Unlocked[Deduction.GetIndex()];
+}
+
+int32 UCaseState::GetUnlockedDeductionCount() const
+{
+	return Progress.Counters.UnlockedDeductions;
+}
+
+bool UCaseState::IsEvidencePairDeduced(int32 EvidenceIndexA, int32 EvidenceIndexB) const
+{
+	if (!Definition)
 	{
 		return false;
 	}
-	return CaseData.AllDeductions[Index].bIsUnlocked;
+
+	const int32 DeductionIndex = Definition->FindDeductionByEvidencePair(EvidenceIndexA, EvidenceIndexB);
+	return DeductionIndex != INDEX_NONE && Progress.Deductions->Unlocked[DeductionIndex];
 }
 
 // ============================================================================
@@ -221,24 +514,68 @@ bool UCaseState::IsDeductionUnlocked(FName DeductionId) const
 
 void UCaseState::SetFlag(FName FlagName)
 {
-	if (!SetFlags.Contains(FlagName))
+	const FFlagHandle Flag = Definition ? Definition->FindFlag(FlagName) : FFlagHandle();
+	if (Flag)
+	{
+		SetFlag(Flag);
+		return;
+	}
+
+	// 事件定義に登場しないフラグは名前のまま保持する
+	if (!Progress.Flags->Extra.Contains(FlagName))
 	{
-		SetFlags.Add(FlagName);
+		Progress.Flags.Edit().Extra.Add(FlagName);
+		RecordName(ECaseJournalOp::SetExtraFlag, FlagName);
 		UE_LOG(LogLastWitness, Log, TEXT("[CaseState] フラグを設定しました: %s"), *FlagName.ToString());
-		OnFlagSet.Broadcast(FlagName);
+		OnFlagSetNative.Broadcast(FlagName);
+		if (DeferChange(ECaseChangeFlags::Flags))
+		{
+			PendingChanges.SetFlags.Add(FlagName);
+		}
+		else
+		{
+			OnFlagSet.Broadcast(FlagName);
+		}
+	}
+}
+
+void UCaseState::SetFlag(FFlagHandle Flag)
+{
+	if (!Definition || !Definition->IsValidHandle(Flag))
+	{
+		return;
+	}
+
+	const int32 FlagIndex = Flag.GetIndex();
+	if (!Progress.Flags->Set[FlagIndex])
+	{
+		Progress.Flags.Edit().Set[FlagIndex] = true;
+		Record(ECaseJournalOp::SetFlag, FlagIndex);
+		NotifyFlagSet(FlagIndex);
+		EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingFlag(FlagIndex), true);
 	}
 }
 
 bool UCaseState::HasFlag(FName FlagName) const
 {
-	return SetFlags.Contains(FlagName);
+	const FFlagHandle Flag = Definition ? Definition->FindFlag(FlagName) : FFlagHandle();
+	if (Flag)
+	{
+		return HasFlag(Flag);
+	}
+	return Progress.Flags->Extra.Contains(FlagName);
+}
+
+bool UCaseState::HasFlag(FFlagHandle Flag) const
+{
+	return Definition && Definition->IsValidHandle(Flag) && Progress.Flags->Set[Flag.GetIndex()];
 }
 
 bool UCaseState::HasAllFlags(const TArray<FName>& FlagNames) const
 {
 	for (const FName& FlagName : FlagNames)
 	{
-		if (!SetFlags.Contains(FlagName))
+		if (!HasFlag(FlagName))
 		{
 			return false;
 		}
@@ -246,6 +583,21 @@ bool UCaseState::HasAllFlags(const TArray<FName>& FlagNames) const
 	return true;
 }
 
+void UCaseState::ApplyFlagMask(const FCompiledMask& Mask)
+{
+	SetFlagBits(Mask, true, true);
+}
+
+bool UCaseState::HasAllFlagsInMask(const FCompiledMask& Mask) const
+{
+	return !Definition || Definition->ContainsAllFlags(Progress.Flags->Set, Mask);
+}
+
+bool UCaseState::HasAllEvidenceInMask(const FCompiledMask& Mask) const
+{
+	return !Definition || Definition->ContainsAllEvidence(Progress.Evidence->Collected, Mask);
+}
+
 // ============================================================================
 // キャラクター関連
 // ============================================================================
@@ -257,44 +609,87 @@ bool UCaseState::GetCharacterById(FName CharacterId, FCharacterData& OutCharacte
 	{
 		return false;
 	}
-	OutCharacter = CaseData.AllCharacters[Index];
+	OutCharacter = MakeCharacterSnapshot(Index);
 	return true;
 }
 
 void UCaseState::ModifyCharacterTrust(FName CharacterId, int32 Delta)
 {
-	const int32 Index = FindCharacterIndex(CharacterId);
-	if (Index == INDEX_NONE)
+	ModifyCharacterTrust(FCharacterHandle(FindCharacterIndex(CharacterId)), Delta);
+}
+
+void UCaseState::ModifyCharacterTrust(FCharacterHandle Character, int32 Delta)
+{
+	if (!Definition || !Definition->IsValidHandle(Character))
 	{
 		return;
 	}
 
-	FCharacterData& Character = CaseData.AllCharacters[Index];
-	Character.TrustLevel = FMath::Clamp(Character.TrustLevel + Delta, 0, 100);
+	const int32 Index = Character.GetIndex();
+	const FName CharacterId = Definition->GetCharacter(Character).CharacterId;
+
+	uint8& TrustLevel = Progress.Characters.Edit().TrustLevels[Index];
+	TrustLevel = static_cast<uint8>(FMath::Clamp(static_cast<int32>(TrustLevel) + Delta, 0, 100));
+	Record(ECaseJournalOp::ModifyTrust, Index, Delta);
 
 	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] %s の信頼度が変化しました: %d"),
-		*CharacterId.ToString(), Character.TrustLevel);
+		*CharacterId.ToString(), static_cast<int32>(TrustLevel));
 
-	OnCharacterTrustChanged.Broadcast(CharacterId, Character.TrustLevel);
+	OnCharacterTrustChangedNative.Broadcast(Index, TrustLevel);
+	if (DeferChange(ECaseChangeFlags::Characters))
+	{
+		PendingChanges.TrustChangedCharacters.AddUnique(CharacterId);
+	}
+	else
+	{
+		OnCharacterTrustChanged.Broadcast(CharacterId, TrustLevel);
+	}
+
+	EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingTrust(Index), true);
 }
 
 void UCaseState::MarkCharacterInterviewed(FName CharacterId)
 {
-	const int32 Index = FindCharacterIndex(CharacterId);
-	if (Index != INDEX_NONE)
+	MarkCharacterInterviewed(FCharacterHandle(FindCharacterIndex(CharacterId)));
+}
+
+void UCaseState::MarkCharacterInterviewed(FCharacterHandle Character)
+{
+	if (Definition && Definition->IsValidHandle(Character) && Progress.MarkCharacterInterviewed(Character.GetIndex()))
+	{
+		Record(ECaseJournalOp::MarkInterviewed, Character.GetIndex());
+		DeferChange(ECaseChangeFlags::Characters);
+	}
+}
+
+bool UCaseState::IsCharacterInterviewed(FCharacterHandle Character) const
+{
+	return Definition && Definition->IsValidHandle(Character) && Progress.Characters->Interviewed[Character.GetIndex()];
+}
+
+EEmotionalState UCaseState::GetCharacterEmotionalState(FCharacterHandle Character) const
+{
+	if (!Definition || !Definition->IsValidHandle(Character))
 	{
-		CaseData.AllCharacters[Index].bHasBeenInterviewed = true;
+		return EEmotionalState::Neutral;
 	}
+	return Progress.Characters->EmotionalStates[Character.GetIndex()];
+}
+
+int32 UCaseState::GetInterviewedCharacterCount() const
+{
+	return Progress.Counters.InterviewedCharacters;
 }
 
 TArray<FCharacterData> UCaseState::GetAllSuspects() const
 {
 	TArray<FCharacterData> Result;
-	for (const FCharacterData& Character : CaseData.AllCharacters)
+	const TArray<FCharacterData>& AllCharacters = GetCaseData().AllCharacters;
+	for (int32 i = 0; i < AllCharacters.Num(); i++)
 	{
-		if (Character.bIsSuspect)
+		if (AllCharacters[i].bIsSuspect)
 		{
-			Result.Add(Character);
+			Result.Add(MakeCharacterSnapshot(i));
 		}
 	}
 	return Result;
@@ -313,18 +708,28 @@ void UCaseState::TravelToLocation(ELocation NewLocation)
 		return;
 	}
 
-	if (!CaseData.AllLocations[Index].bIsAccessible)
+	if (!Progress.Locations->Accessible[Index])
 	{
 		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] ロケーションにアクセスできません"));
 		return;
 	}
 
-	CurrentLocation = NewLocation;
+	Progress.CurrentLocation = NewLocation;
+	Record(ECaseJournalOp::TravelToLocation, static_cast<int32>(NewLocation));
+	const bool bDeferred = DeferChange(ECaseChangeFlags::Location);
 
-	if (!CaseData.AllLocations[Index].bHasVisited)
+	if (!Progress.Locations->Visited[Index])
 	{
-		CaseData.AllLocations[Index].bHasVisited = true;
-		OnLocationVisited.Broadcast(NewLocation);
+		Progress.Locations.Edit().Visited[Index] = true;
+		OnLocationVisitedNative.Broadcast(NewLocation);
+		if (bDeferred)
+		{
+			PendingChanges.VisitedLocations.Add(NewLocation);
+		}
+		else
+		{
+			OnLocationVisited.Broadcast(NewLocation);
+		}
 	}
 
 	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] ロケーションに移動しました: %d"), static_cast<int32>(NewLocation));
@@ -337,57 +742,161 @@ bool UCaseState::GetLocationData(ELocation Location, FLocationData& OutLocation)
 	{
 		return false;
 	}
-	OutLocation = CaseData.AllLocations[Index];
+	OutLocation = MakeLocationSnapshot(Index);
 	return true;
 }
 
 TArray<FLocationData> UCaseState::GetAccessibleLocations() const
 {
 	TArray<FLocationData> Result;
-	for (const FLocationData& Location : CaseData.AllLocations)
+	for (TConstSetBitIterator<> It(Progress.Locations->Accessible); It; ++It)
 	{
-		if (Location.bIsAccessible)
-		{
-			Result.Add(Location);
-		}
+		Result.Add(MakeLocationSnapshot(It.GetIndex()));
 	}
 	return Result;
 }
 
-// ============================================================================
-// 告発関連
-// ============================================================================
-
-bool UCaseState::CanMakeAccusation() const
+bool UCaseState::IsLocationAccessible(ELocation Location) const
+{
+	const int32 Index = FindLocationIndex(Location);
+	return Index != INDEX_NONE && Progress.Locations->Accessible[Index];
+}
+
+int32 UCaseState::GetUncollectedEvidenceCountAt(ELocation Location) const
 {
-	for (const FName& RequiredId : CaseData.RequiredEvidenceForAccusation)
+	const int32 Index = FindLocationIndex(Location);
+	if (Index == INDEX_NONE)
 	{
-		if (!HasEvidence(RequiredId))
-		{
-			return false;
-		}
+		return 0;
+	}
+	return Progress.Evidence->UncollectedPerLocation[Index];
+}
+
+// ============================================================================
+// ゲーム内時刻
+// ============================================================================
+
+void UCaseState::AdvanceClock(int32 Minutes)
+{
+	if (!Definition || Minutes <= 0)
+	{
+		return;
+	}
+
+	const int32 TargetMinute = FMath::Min(Progress.ClockMinutes + FMath::Min(Minutes, FCaseScheduler::MaxMinute), FCaseScheduler::MaxMinute);
+	if (TargetMinute == Progress.ClockMinutes)
+	{
+		return;
 	}
+
+	// 移動の通知を受けたリスナーの操作より前に再生されるよう、先に記録する
+	Record(ECaseJournalOp::AdvanceClock, TargetMinute - Progress.ClockMinutes);
+	AdvanceClockTo(TargetMinute, true);
+
+	UE_LOG(LogLastWitness, Verbose, TEXT("[CaseState] ゲーム内時刻を進めました: %d 分"), Progress.ClockMinutes);
+
+	OnClockAdvancedNative.Broadcast(Progress.ClockMinutes);
+	if (!DeferChange(ECaseChangeFlags::Clock))
+	{
+		OnClockAdvanced.Broadcast(Progress.ClockMinutes);
+	}
+}
+
+TArray<FCharacterData> UCaseState::GetCharactersAtLocation(ELocation Location) const
+{
+	TArray<FCharacterData> Result;
+	const int32 LocationIndex = FindLocationIndex(Location);
+	if (LocationIndex == INDEX_NONE)
+	{
+		return Result;
+	}
+
+	ForEachCharacterAt(LocationIndex, [this, &Result](int32 CharacterIndex)
+	{
+		Result.Add(MakeCharacterSnapshot(CharacterIndex));
+	});
+	return Result;
+}
+
+bool UCaseState::GetCharacterLocation(FName CharacterId, ELocation& OutLocation) const
+{
+	const int32 CharacterIndex = FindCharacterIndex(CharacterId);
+	if (CharacterIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 LocationIndex = Progress.Characters->CurrentLocations[CharacterIndex];
+	if (LocationIndex == INDEX_NONE)
+	{
+		return false;
+	}
+	OutLocation = GetCaseData().AllLocations[LocationIndex].Location;
 	return true;
 }
 
+// ============================================================================
+// トリガー
+// ============================================================================
+
+bool UCaseState::HasTriggerFired(FName TriggerId) const
+{
+	if (!Definition.IsValid())
+	{
+		return false;
+	}
+
+	const int32 TriggerIndex = Definition->GetTriggerIndex().FindTriggerIndex(TriggerId);
+	return TriggerIndex != INDEX_NONE && Progress.Triggers->Fired[TriggerIndex];
+}
+
+// ============================================================================
+// 告発関連
+// ============================================================================
+
+bool UCaseState::CanMakeAccusation() const
+{
+	return Progress.Counters.UnmetAccusationRequirements == 0;
+}
+
+int32 UCaseState::GetUnmetAccusationRequirementCount() const
+{
+	return Progress.Counters.UnmetAccusationRequirements;
+}
+
+FCaseSolvabilityReport UCaseState::AnalyzeSolvability() const
+{
+	if (!Definition.IsValid())
+	{
+		return FCaseSolvabilityReport();
+	}
+	return Definition->GetSolver().MakeReport(*Definition, AnalyzeReachability(true));
+}
+
+FCaseReachability UCaseState::AnalyzeReachability(bool bBuildPlan) const
+{
+	if (!Definition.IsValid())
+	{
+		return FCaseReachability();
+	}
+	return Definition->GetSolver().Solve(*Definition, Progress, bBuildPlan);
+}
+
 FGameResult UCaseState::MakeAccusation(FName CharacterId)
 {
+	const FCaseData& CaseData = GetCaseData();
+
+	RecordName(ECaseJournalOp::MakeAccusation, CharacterId);
+
 	FGameResult Result;
 	Result.AccusedCharacterId = CharacterId;
 	Result.bCorrectCulprit = (CharacterId == CaseData.TrueCulpritId);
-	Result.ABELSuggestionsFollowed = ABELSuggestionsFollowed;
-	Result.ABELSuggestionsIgnored = ABELSuggestionsIgnored;
-	Result.EthicalViolations = EthicalViolations;
+	Result.ABELSuggestionsFollowed = Progress.ABELSuggestionsFollowed;
+	Result.ABELSuggestionsIgnored = Progress.ABELSuggestionsIgnored;
+	Result.EthicalViolations = Progress.EthicalViolations;
 
 	// 証拠収集率を計算
-	int32 CollectedCount = 0;
-	for (const FEvidence& Evidence : CaseData.AllEvidence)
-	{
-		if (Evidence.bIsCollected)
-		{
-			CollectedCount++;
-		}
-	}
+	const int32 CollectedCount = Progress.Counters.CollectedEvidence;
 	Result.EvidenceCollectionRate = CaseData.AllEvidence.Num() > 0
 		? static_cast<float>(CollectedCount) / static_cast<float>(CaseData.AllEvidence.Num())
 		: 0.0f;
@@ -416,54 +925,847 @@ FGameResult UCaseState::MakeAccusation(FName CharacterId)
 	return Result;
 }
 
+// ============================================================================
+// 統計関連
+// ============================================================================
+
+void UCaseState::IncrementABELFollowed()
+{
+	Progress.ABELSuggestionsFollowed++;
+	Record(ECaseJournalOp::ABELFollowed);
+}
+
+void UCaseState::IncrementABELIgnored()
+{
+	Progress.ABELSuggestionsIgnored++;
+	Record(ECaseJournalOp::ABELIgnored);
+}
+
+void UCaseState::IncrementEthicalViolations()
+{
+	Progress.EthicalViolations++;
+	Record(ECaseJournalOp::EthicalViolation);
+}
+
+// ============================================================================
+// ジャーナル
+// ============================================================================
+
+bool UCaseState::ReplayJournal(const FCaseJournal& InJournal)
+{
+	if (!Definition)
+	{
+		return false;
+	}
+
+	if (InJournal.GetCaseId() != Definition->GetData().CaseId)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 別の事件のジャーナルは再生できません: %s"), *InJournal.GetCaseId().ToString());
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// 失敗時に戻せるよう現在の状態を保持（O(1)）
+	const FCaseProgress PreviousProgress = Progress;
+
+	Progress.Initialize(*Definition);
+	RebuildSchedule();
+	RebuildDeductionChain();
+	RebuildTriggers();
+
+	int32 AppliedCount = 0;
+	bool bAllValid = true;
+	const bool bDecoded = InJournal.ForEachRecord([this, &AppliedCount, &bAllValid](const FCaseJournalRecord& JournalRecord)
+	{
+		if (bAllValid && !ApplyJournalRecord(JournalRecord))
+		{
+			bAllValid = false;
+		}
+		AppliedCount++;
+	});
+
+	if (!bDecoded || !bAllValid)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] ジャーナルの再生に失敗しました (%d 件目)"), AppliedCount);
+		Progress = PreviousProgress;
+		RebuildSchedule();
+		RebuildDeductionChain();
+		RebuildTriggers();
+		return false;
+	}
+
+	Journal = InJournal;
+	bJournalComplete = true;
+	Progress.JournalLength = Journal.NumBytes();
+	Progress.JournalCrc = Journal.GetCrc();
+	Checkpoints.Empty();
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] ジャーナルを再生しました: %d 件 (%.2f ms)"),
+		AppliedCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	BroadcastProgressRestored();
+	return true;
+}
+
+TArray<uint8> UCaseState::ExportJournal() const
+{
+	if (!bJournalComplete)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] ジャーナルが途切れているため、再生しても現在の状態にはなりません"));
+	}
+
+	// operator<< は読み書き兼用で非 const を要求するためコピーを書き出す
+	FCaseJournal JournalCopy = Journal;
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Writer << JournalCopy;
+	return Data;
+}
+
+bool UCaseState::ImportJournal(const TArray<uint8>& Data)
+{
+	FCaseJournal Loaded;
+	FMemoryReader Reader(Data);
+	Reader << Loaded;
+	if (Reader.IsError())
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] ジャーナルを読み込めませんでした"));
+		return false;
+	}
+	return ReplayJournal(Loaded);
+}
+
+// ============================================================================
+// セーブデータ
+// ============================================================================
+
+TArray<uint8> UCaseState::SaveProgressToBytes() const
+{
+	TArray<uint8> Data;
+	if (!Definition)
+	{
+		return Data;
+	}
+
+	FMemoryWriter Writer(Data);
+	FName CaseId = Definition->GetData().CaseId;
+	Writer << CaseId;
+	Progress.Save(Writer, *Definition);
+	return Data;
+}
+
+bool UCaseState::DecodeProgressFromBytes(const TArray<uint8>& Data, const FCaseDefinition& InDefinition, FCaseProgress& OutProgress)
+{
+	FMemoryReader Reader(Data);
+	FName CaseId;
+	Reader << CaseId;
+	if (Reader.IsError() || CaseId != InDefinition.GetData().CaseId)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 別の事件のセーブデータは読み込めません: %s"), *CaseId.ToString());
+		return false;
+	}
+
+	if (!OutProgress.Load(Reader, InDefinition))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] セーブデータを読み込めませんでした"));
+		return false;
+	}
+	return true;
+}
+
+bool UCaseState::LoadProgressFromBytes(const TArray<uint8>& Data)
+{
+	FCaseProgress Decoded;
+	if (!Definition || !DecodeProgressFromBytes(Data, *Definition, Decoded))
+	{
+		return false;
+	}
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] セーブデータをデコードしました (%d バイト)"), Data.Num());
+	return ApplyLoadedProgress(MoveTemp(Decoded));
+}
+
+bool UCaseState::ApplyLoadedProgress(FCaseProgress&& Loaded)
+{
+	if (!Definition || !Loaded.IsCompatibleWith(*Definition))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CaseState] 現在の事件と一致しない進行状態は読み込めません"));
+		return false;
+	}
+	const FName CaseId = Definition->GetData().CaseId;
+
+	Progress = MoveTemp(Loaded);
+	RebuildSchedule();
+	RebuildDeductionChain();
+	RebuildTriggers();
+
+	// 読み込んだ状態に至る操作記録は無く、既存のチェックポイントとも履歴が繋がらない
+	Journal.Reset(CaseId);
+	bJournalComplete = false;
+	Progress.JournalLength = 0;
+	Progress.JournalCrc = Journal.GetCrc();
+	Checkpoints.Empty();
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] セーブデータの進行状態を適用しました"));
+
+	BroadcastProgressRestored();
+	return true;
+}
+
+// ============================================================================
+// 変更通知のまとめ
+// ============================================================================
+
+void UCaseState::SetChangeSetMode(bool bEnabled)
+{
+	if (bChangeSetMode == bEnabled)
+	{
+		return;
+	}
+
+	bChangeSetMode = bEnabled;
+	if (!bEnabled)
+	{
+		FlushChanges();
+	}
+}
+
+void UCaseState::FlushChanges()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+
+	// リスナーがワーカーに渡せるよう、通知より先に公開する
+	if (bSnapshotDirty)
+	{
+		PublishSnapshot();
+	}
+
+	if (PendingChanges.IsEmpty())
+	{
+		return;
+	}
+
+	// リスナーが変更を加えた場合に備え、先に取り出してから通知する
+	const FCaseChangeSet Changes = MoveTemp(PendingChanges);
+	PendingChanges = FCaseChangeSet();
+
+	OnCaseChangedNative.Broadcast(Changes);
+	OnCaseChanged.Broadcast(Changes);
+}
+
+// ============================================================================
+// ゲームスレッド外への公開
+// ============================================================================
+
+void UCaseState::SetSnapshotPublishing(bool bEnabled)
+{
+	check(IsInGameThread());
+	bPublishSnapshots = bEnabled;
+	if (bEnabled)
+	{
+		PublishSnapshot();
+	}
+	else
+	{
+		bSnapshotDirty = false;
+		FRWScopeLock Lock(SnapshotLock, SLT_Write);
+		PublishedSnapshot.Reset();
+	}
+}
+
+void UCaseState::PublishSnapshot()
+{
+	check(IsInGameThread());
+	bSnapshotDirty = false;
+	if (!Definition.IsValid())
+	{
+		return;
+	}
+
+	// 進行状態のコピーはセクションの参照を共有するだけなので O(1)
+	FCaseSnapshotPtr NewSnapshot = MakeShared<const FCaseSnapshot, ESPMode::ThreadSafe>(
+		Definition.ToSharedRef(), Progress, ++SnapshotSequence);
+
+	// 古いスナップショットの解放はロックの外で行う
+	{
+		FRWScopeLock Lock(SnapshotLock, SLT_Write);
+		Swap(PublishedSnapshot, NewSnapshot);
+	}
+}
+
+FCaseSnapshotPtr UCaseState::GetLatestSnapshot() const
+{
+	// TSharedPtr のコピーは参照カウントの増加とポインタの読み取りが一体でないため、差し替えと競合しないよう読み取りロックを取る
+	// （std::atomic<std::shared_ptr> は全プラットフォームの標準ライブラリでは使えず、読み取り同士は競合しないので十分軽い）
+	FRWScopeLock Lock(SnapshotLock, SLT_ReadOnly);
+	return PublishedSnapshot;
+}
+
+// ============================================================================
+// データアクセス
+// ============================================================================
+
+const FCaseData& UCaseState::GetCaseData() const
+{
+	static const FCaseData EmptyCaseData;
+	return Definition.IsValid() ? Definition->GetData() : EmptyCaseData;
+}
+
+SIZE_T UCaseState::GetSessionMemorySize() const
+{
+	// チェックポイントはセクションを共有するため、ここではマップ自体の領域のみを数える
+	return sizeof(UCaseState)
+		+ Progress.GetAllocatedSize()
+		+ Journal.GetAllocatedSize()
+		+ Scheduler.GetAllocatedSize()
+		+ RemainingPremises.GetAllocatedSize()
+		+ Checkpoints.GetAllocatedSize();
+}
+
 // ============================================================================
 // Private ヘルパー関数
 // ============================================================================
 
-int32 UCaseState::FindEvidenceIndex(FName EvidenceId) const
+FEvidence UCaseState::MakeEvidenceSnapshot(int32 Index) const
 {
-	for (int32 i = 0; i < CaseData.AllEvidence.Num(); i++)
+	FEvidence Evidence = Definition->GetData().AllEvidence[Index];
+	Evidence.bIsCollected = Progress.Evidence->Collected[Index];
+	Evidence.bIsExamined = Progress.Evidence->Examined[Index];
+	return Evidence;
+}
+
+FCharacterData UCaseState::MakeCharacterSnapshot(int32 Index) const
+{
+	FCharacterData Character = Definition->GetData().AllCharacters[Index];
+	Character.TrustLevel = Progress.Characters->TrustLevels[Index];
+	Character.EmotionalState = Progress.Characters->EmotionalStates[Index];
+	Character.bHasBeenInterviewed = Progress.Characters->Interviewed[Index];
+
+	// どこにもいない間は作成時の値のまま
+	const int32 LocationIndex = Progress.Characters->CurrentLocations[Index];
+	if (LocationIndex != INDEX_NONE)
+	{
+		Character.CurrentLocation = Definition->GetData().AllLocations[LocationIndex].Location;
+	}
+	return Character;
+}
+
+FLocationData UCaseState::MakeLocationSnapshot(int32 Index) const
+{
+	FLocationData Location = Definition->GetData().AllLocations[Index];
+	Location.bHasVisited = Progress.Locations->Visited[Index];
+	Location.bIsAccessible = Progress.Locations->Accessible[Index];
+
+	// 作成時の配置ではなく、予定に従って移動した後の居場所を反映する
+	const TArray<FCharacterData>& AllCharacters = Definition->GetData().AllCharacters;
+	Location.CharactersPresent.Reset();
+	ForEachCharacterAt(Index, [&Location, &AllCharacters](int32 CharacterIndex)
+	{
+		Location.CharactersPresent.Add(AllCharacters[CharacterIndex].CharacterId);
+	});
+	return Location;
+}
+
+FDeduction UCaseState::MakeDeductionSnapshot(int32 Index) const
+{
+	FDeduction Deduction = Definition->GetData().AllDeductions[Index];
+	Deduction.bIsUnlocked = Progress.Deductions->Unlocked[Index];
+	return Deduction;
+}
+
+void UCaseState::NotifyFlagSet(int32 FlagIndex)
+{
+	const FName FlagName = Definition->GetFlagName(FlagIndex);
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] フラグを設定しました: %s"), *FlagName.ToString());
+	OnFlagSetNative.Broadcast(FlagName);
+	if (DeferChange(ECaseChangeFlags::Flags))
+	{
+		PendingChanges.SetFlags.Add(FlagName);
+	}
+	else
+	{
+		OnFlagSet.Broadcast(FlagName);
+	}
+}
+
+void UCaseState::NotifyDeductionUnlocked(int32 DeductionIndex)
+{
+	const FDeduction& Deduction = Definition->GetData().AllDeductions[DeductionIndex];
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] 推理を解放しました: %s"), *Deduction.DeductionId.ToString());
+
+	OnDeductionUnlockedNative.Broadcast(DeductionIndex);
+	if (DeferChange(ECaseChangeFlags::Deductions))
+	{
+		PendingChanges.UnlockedDeductions.Add(Deduction.DeductionId);
+	}
+	else if (OnDeductionUnlocked.IsBound())
+	{
+		OnDeductionUnlocked.Broadcast(MakeDeductionSnapshot(DeductionIndex));
+	}
+}
+
+void UCaseState::NotifyCharacterMoved(int32 CharacterIndex, int32 FromLocationIndex)
+{
+	const FCaseData& CaseData = Definition->GetData();
+	const FName CharacterId = CaseData.AllCharacters[CharacterIndex].CharacterId;
+	const int32 ToLocationIndex = Progress.Characters->CurrentLocations[CharacterIndex];
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] %s が移動しました: %d -> %d (%d 分)"),
+		*CharacterId.ToString(), FromLocationIndex, ToLocationIndex, Progress.ClockMinutes);
+
+	OnCharacterMovedNative.Broadcast(CharacterIndex, FromLocationIndex, ToLocationIndex);
+	if (DeferChange(ECaseChangeFlags::Characters))
+	{
+		PendingChanges.MovedCharacters.AddUnique(CharacterId);
+	}
+	else if (ToLocationIndex != INDEX_NONE)
+	{
+		OnCharacterMoved.Broadcast(CharacterId, CaseData.AllLocations[ToLocationIndex].Location);
+	}
+}
+
+void UCaseState::RebuildSchedule()
+{
+	Scheduler.Reset(Progress.ClockMinutes);
+	if (!Definition)
+	{
+		return;
+	}
+
+	// 予定は時刻順に並んでいるので、未到来の部分だけを登録する
+	const TArrayView<const FCompiledScheduleEntry> Schedule = Definition->GetSchedule();
+	for (int32 EntryIndex = Definition->FindFirstScheduleEntryAfter(Progress.ClockMinutes); EntryIndex < Schedule.Num(); EntryIndex++)
+	{
+		Scheduler.Schedule(Schedule[EntryIndex].AtMinute, EntryIndex);
+	}
+}
+
+void UCaseState::RebuildDeductionChain()
+{
+	RemainingPremises.Reset();
+	if (!Definition)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<8>> ReadyRules;
+	Definition->GetDeductionChain().CountRemainingPremises(Progress.Evidence->Collected, Progress.Deductions->Unlocked, RemainingPremises, ReadyRules);
+	DeriveDeductions(ReadyRules, false);
+}
+
+void UCaseState::PropagateEvidence(int32 EvidenceIndex, bool bNotify)
+{
+	TArray<int32, TInlineAllocator<8>> ReadyRules;
+	Definition->GetDeductionChain().SatisfyEvidence(EvidenceIndex, RemainingPremises, ReadyRules);
+	DeriveDeductions(ReadyRules, bNotify);
+}
+
+void UCaseState::PropagateDeduction(int32 DeductionIndex, bool bNotify)
+{
+	TArray<int32, TInlineAllocator<8>> ReadyRules;
+	Definition->GetDeductionChain().SatisfyDeduction(DeductionIndex, RemainingPremises, ReadyRules);
+	DeriveDeductions(ReadyRules, bNotify);
+}
+
+void UCaseState::DeriveDeductions(TArray<int32, TInlineAllocator<8>>& ReadyRules, bool bNotify)
+{
+	const FCaseDeductionChain& Chain = Definition->GetDeductionChain();
+
+	// 成立した推理を前提とする規則が続けて揃うことがあるので、待ち行列が空になるまで処理する
+	for (int32 i = 0; i < ReadyRules.Num(); i++)
 	{
-		if (CaseData.AllEvidence[i].EvidenceId == EvidenceId)
+		const int32 DeductionIndex = Chain.GetRuleDeduction(ReadyRules[i]);
+		if (!Progress.MarkDeductionUnlocked(DeductionIndex))
+		{
+			continue; // リスナーの操作で先に成立済み
+		}
+
+		SetFlagBits(Definition->GetDeductionFlagMask(DeductionIndex), false, bNotify);
+		if (bNotify)
 		{
-			return i;
+			NotifyDeductionUnlocked(DeductionIndex);
 		}
+		EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingDeduction(DeductionIndex), bNotify);
+		Chain.SatisfyDeduction(DeductionIndex, RemainingPremises, ReadyRules);
 	}
-	return INDEX_NONE;
 }
 
-int32 UCaseState::FindCharacterIndex(FName CharacterId) const
+void UCaseState::RebuildTriggers()
 {
-	for (int32 i = 0; i < CaseData.AllCharacters.Num(); i++)
+	if (!Definition)
 	{
-		if (CaseData.AllCharacters[i].CharacterId == CharacterId)
+		return;
+	}
+
+	// 発火済みのビットは進行状態と一緒に復元されるので、ここで発火するのは
+	// 事件開始時から条件を満たしているトリガーや、トリガー導入前のセーブデータの分だけ
+	const FCaseTriggerIndex& TriggerIndex = Definition->GetTriggerIndex();
+	for (int32 Trigger = 0; Trigger < TriggerIndex.NumTriggers(); Trigger++)
+	{
+		if (!Progress.Triggers->Fired[Trigger] && TriggerIndex.IsSatisfied(Trigger, Progress))
 		{
-			return i;
+			FireTrigger(Trigger, false);
 		}
 	}
-	return INDEX_NONE;
 }
 
-int32 UCaseState::FindLocationIndex(ELocation Location) const
+void UCaseState::EvaluateTriggers(TConstArrayView<int32> Triggers, bool bNotify)
 {
-	for (int32 i = 0; i < CaseData.AllLocations.Num(); i++)
+	const FCaseTriggerIndex& TriggerIndex = Definition->GetTriggerIndex();
+	for (const int32 Trigger : Triggers)
 	{
-		if (CaseData.AllLocations[i].Location == Location)
+		// リスナーの操作で先に発火している場合があるので、毎回発火済みか確認する
+		if (!Progress.Triggers->Fired[Trigger] && TriggerIndex.IsSatisfied(Trigger, Progress))
 		{
-			return i;
+			FireTrigger(Trigger, bNotify);
 		}
 	}
-	return INDEX_NONE;
 }
 
-int32 UCaseState::FindDeductionIndex(FName DeductionId) const
+void UCaseState::FireTrigger(int32 TriggerIndex, bool bNotify)
 {
-	for (int32 i = 0; i < CaseData.AllDeductions.Num(); i++)
+	Progress.Triggers.Edit().Fired[TriggerIndex] = true;
+	if (bNotify)
 	{
-		if (CaseData.AllDeductions[i].DeductionId == DeductionId)
+		UE_LOG(LogLastWitness, Log, TEXT("[CaseState] トリガーが発火しました: %s"),
+			*Definition->GetData().Triggers[TriggerIndex].TriggerId.ToString());
+	}
+
+	for (const FCompiledTriggerAction& Action : Definition->GetTriggerIndex().GetActions(TriggerIndex))
+	{
+		switch (Action.Type)
+		{
+		case ETriggerActionType::SetLocationAccessible:
 		{
-			return i;
+			const bool bAccessible = Action.Value != 0;
+			if (Progress.Locations->Accessible[Action.Target] != bAccessible)
+			{
+				Progress.Locations.Edit().Accessible[Action.Target] = bAccessible;
+				if (bNotify)
+				{
+					NotifyLocationAccessChanged(Action.Target);
+				}
+			}
+			break;
+		}
+
+		case ETriggerActionType::MoveCharacter:
+		{
+			const int32 FromLocationIndex = Progress.Characters->CurrentLocations[Action.Target];
+			if (Progress.MoveCharacter(Action.Target, Action.LocationIndex) && bNotify)
+			{
+				NotifyCharacterMoved(Action.Target, FromLocationIndex);
+			}
+			break;
+		}
+
+		case ETriggerActionType::SetEmotionalState:
+		{
+			const EEmotionalState NewState = static_cast<EEmotionalState>(Action.Value);
+			if (Progress.Characters->EmotionalStates[Action.Target] != NewState)
+			{
+				Progress.Characters.Edit().EmotionalStates[Action.Target] = NewState;
+				if (bNotify)
+				{
+					NotifyCharacterEmotionChanged(Action.Target);
+				}
+			}
+			break;
+		}
+
+		default:
+			break;
 		}
 	}
-	return INDEX_NONE;
+}
+
+void UCaseState::NotifyLocationAccessChanged(int32 LocationIndex)
+{
+	const ELocation Location = Definition->GetData().AllLocations[LocationIndex].Location;
+	const bool bAccessible = Progress.Locations->Accessible[LocationIndex];
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] ロケーション %d は%sになりました"),
+		static_cast<int32>(Location), bAccessible ? TEXT("アクセス可能") : TEXT("アクセス不可"));
+
+	OnLocationAccessChangedNative.Broadcast(LocationIndex, bAccessible);
+	if (DeferChange(ECaseChangeFlags::Location))
+	{
+		PendingChanges.AccessChangedLocations.AddUnique(Location);
+	}
+	else
+	{
+		OnLocationAccessChanged.Broadcast(Location, bAccessible);
+	}
+}
+
+void UCaseState::NotifyCharacterEmotionChanged(int32 CharacterIndex)
+{
+	const FName CharacterId = Definition->GetData().AllCharacters[CharacterIndex].CharacterId;
+	const EEmotionalState NewState = Progress.Characters->EmotionalStates[CharacterIndex];
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseState] %s の感情状態が変化しました: %s"),
+		*CharacterId.ToString(), *UEnum::GetValueAsString(NewState));
+
+	OnCharacterEmotionChangedNative.Broadcast(CharacterIndex, NewState);
+	if (DeferChange(ECaseChangeFlags::Characters))
+	{
+		PendingChanges.EmotionChangedCharacters.AddUnique(CharacterId);
+	}
+	else
+	{
+		OnCharacterEmotionChanged.Broadcast(CharacterId, NewState);
+	}
+}
+
+void UCaseState::AdvanceClockTo(int32 TargetMinute, bool bNotify)
+{
+	const TArrayView<const FCompiledScheduleEntry> Schedule = Definition->GetSchedule();
+	Scheduler.Advance(TargetMinute, [this, Schedule, bNotify](int32 EntryIndex, int32 DueMinute)
+	{
+		// リスナーが参照できるよう、移動の時点の時刻にしておく
+		Progress.ClockMinutes = FMath::Max(Progress.ClockMinutes, DueMinute);
+
+		const FCompiledScheduleEntry& Entry = Schedule[EntryIndex];
+		const int32 FromLocationIndex = Progress.Characters->CurrentLocations[Entry.CharacterIndex];
+		if (Progress.MoveCharacter(Entry.CharacterIndex, Entry.LocationIndex) && bNotify)
+		{
+			NotifyCharacterMoved(Entry.CharacterIndex, FromLocationIndex);
+		}
+	});
+	Progress.ClockMinutes = FMath::Max(Progress.ClockMinutes, TargetMinute);
+}
+
+bool UCaseState::DeferChange(ECaseChangeFlags Category)
+{
+	if (!bChangeSetMode)
+	{
+		return false;
+	}
+
+	PendingChanges.ChangedMask |= static_cast<int32>(Category);
+
+	ScheduleFlush();
+	return true;
+}
+
+void UCaseState::ScheduleFlush()
+{
+	// フレーム内の最初の変更でのみ予約する
+	if (!FlushTickerHandle.IsValid())
+	{
+		FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &UCaseState::HandleFlushTick));
+	}
+}
+
+bool UCaseState::HandleFlushTick(float DeltaTime)
+{
+	// 一度きりのティックなので false を返して登録を解除する
+	FlushTickerHandle.Reset();
+	FlushChanges();
+	return false;
+}
+
+void UCaseState::BroadcastProgressRestored()
+{
+	PendingChanges = FCaseChangeSet();
+	MarkSnapshotDirty();
+	OnProgressRestoredNative.Broadcast();
+	OnProgressRestored.Broadcast();
+}
+
+void UCaseState::SetFlagBits(const FCompiledMask& Mask, bool bRecord, bool bNotify)
+{
+	// 全て設定済みならセクションを複製せずに済ませる
+	if (!Definition || Mask.IsEmpty() || Definition->ContainsAllFlags(Progress.Flags->Set, Mask))
+	{
+		return;
+	}
+
+	const uint32* MaskWords = Definition->GetMaskWords(Mask);
+	uint32* StateWords = Progress.Flags.Edit().Set.GetData();
+	const int32 NumWords = Definition->NumFlagWords();
+
+	for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+	{
+		// 新たに立つビットだけを記録・通知する
+		uint32 NewBits = MaskWords[WordIndex] & ~StateWords[WordIndex];
+		StateWords[WordIndex] |= NewBits;
+
+		while (NewBits != 0)
+		{
+			const int32 FlagIndex = WordIndex * NumBitsPerDWORD + static_cast<int32>(FMath::CountTrailingZeros(NewBits));
+			NewBits &= NewBits - 1;
+
+			if (bRecord)
+			{
+				Record(ECaseJournalOp::SetFlag, FlagIndex);
+			}
+			if (bNotify)
+			{
+				NotifyFlagSet(FlagIndex);
+			}
+			EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingFlag(FlagIndex), bNotify);
+		}
+	}
+}
+
+bool UCaseState::ApplyJournalRecord(const FCaseJournalRecord& JournalRecord)
+{
+	const int32 A = JournalRecord.A;
+	const int32 B = JournalRecord.B;
+
+	switch (JournalRecord.Op)
+	{
+	case ECaseJournalOp::Reset:
+		Progress.Reset(*Definition);
+		RebuildSchedule();
+		RebuildDeductionChain();
+		RebuildTriggers();
+		return true;
+
+	case ECaseJournalOp::CollectEvidence:
+		if (A < 0 || A >= Definition->NumEvidence())
+		{
+			return false;
+		}
+		if (Progress.MarkEvidenceCollected(*Definition, A))
+		{
+			PropagateEvidence(A, false);
+			EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingEvidence(A), false);
+		}
+		return true;
+
+	case ECaseJournalOp::ExamineEvidence:
+		if (A < 0 || A >= Definition->NumEvidence())
+		{
+			return false;
+		}
+		Progress.Evidence.Edit().Examined[A] = true;
+		return true;
+
+	case ECaseJournalOp::UnlockDeduction:
+	{
+		if (A < 0 || A >= Definition->NumEvidence() || B < 0 || B >= Definition->NumEvidence())
+		{
+			return false;
+		}
+		const int32 DeductionIndex = Definition->FindDeductionByEvidencePair(A, B);
+		if (DeductionIndex == INDEX_NONE)
+		{
+			return false;
+		}
+		if (Progress.MarkDeductionUnlocked(DeductionIndex))
+		{
+			SetFlagBits(Definition->GetDeductionFlagMask(DeductionIndex), false, false);
+			EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingDeduction(DeductionIndex), false);
+			PropagateDeduction(DeductionIndex, false);
+		}
+		return true;
+	}
+
+	case ECaseJournalOp::SetFlag:
+		if (A < 0 || A >= Definition->NumFlags())
+		{
+			return false;
+		}
+		if (!Progress.Flags->Set[A])
+		{
+			Progress.Flags.Edit().Set[A] = true;
+			EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingFlag(A), false);
+		}
+		return true;
+
+	case ECaseJournalOp::SetExtraFlag:
+		Progress.Flags.Edit().Extra.Add(JournalRecord.Name);
+		return true;
+
+	case ECaseJournalOp::ModifyTrust:
+	{
+		if (A < 0 || A >= Definition->NumCharacters())
+		{
+			return false;
+		}
+		uint8& TrustLevel = Progress.Characters.Edit().TrustLevels[A];
+		TrustLevel = static_cast<uint8>(FMath::Clamp(static_cast<int32>(TrustLevel) + B, 0, 100));
+		EvaluateTriggers(Definition->GetTriggerIndex().GetTriggersUsingTrust(A), false);
+		return true;
+	}
+
+	case ECaseJournalOp::MarkInterviewed:
+		if (A < 0 || A >= Definition->NumCharacters())
+		{
+			return false;
+		}
+		Progress.MarkCharacterInterviewed(A);
+		return true;
+
+	case ECaseJournalOp::TravelToLocation:
+	{
+		const int32 LocationIndex = Definition->FindLocationIndex(static_cast<ELocation>(A));
+		if (LocationIndex == INDEX_NONE)
+		{
+			return false;
+		}
+		Progress.CurrentLocation = static_cast<ELocation>(A);
+		if (!Progress.Locations->Visited[LocationIndex])
+		{
+			Progress.Locations.Edit().Visited[LocationIndex] = true;
+		}
+		return true;
+	}
+
+	case ECaseJournalOp::MakeAccusation:
+		// 告発は進行状態を変更しない（再現用に記録のみ）
+		return true;
+
+	case ECaseJournalOp::ABELFollowed:
+		Progress.ABELSuggestionsFollowed++;
+		return true;
+
+	case ECaseJournalOp::ABELIgnored:
+		Progress.ABELSuggestionsIgnored++;
+		return true;
+
+	case ECaseJournalOp::EthicalViolation:
+		Progress.EthicalViolations++;
+		return true;
+
+	case ECaseJournalOp::AdvanceClock:
+		if (A <= 0)
+		{
+			return false;
+		}
+		AdvanceClockTo(FMath::Min(Progress.ClockMinutes + FMath::Min(A, FCaseScheduler::MaxMinute), FCaseScheduler::MaxMinute), false);
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+int32 UCaseState::FindEvidenceIndex(FName EvidenceId) const
+{
+	return Definition.IsValid() ? Definition->FindEvidenceIndex(EvidenceId) : INDEX_NONE;
+}
+
+int32 UCaseState::FindCharacterIndex(FName CharacterId) const
+{
+	return Definition.IsValid() ? Definition->FindCharacterIndex(CharacterId) : INDEX_NONE;
+}
+
+int32 UCaseState::FindLocationIndex(ELocation Location) const
+{
+	return Definition.IsValid() ? Definition->FindLocationIndex(Location) : INDEX_NONE;
+}
+
+int32 UCaseState::FindDeductionIndex(FName DeductionId) const
+{
+	return Definition.IsValid() ? Definition->FindDeductionIndex(DeductionId) : INDEX_NONE;
 }
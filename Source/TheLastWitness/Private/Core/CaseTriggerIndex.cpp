@@ -0,0 +1,265 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CaseTriggerIndex.h"
+#include "Core/CaseDefinition.h"
+#include "Core/CaseProgress.h"
+#include "TheLastWitness.h"
+
+template <typename ElementType, typename KeyFuncType>
+void FCaseTriggerIndex::Invert(int32 NumFacts, const TRows<ElementType>& TriggerRows, KeyFuncType KeyFunc, TRows<int32>& OutFactRows)
+{
+	OutFactRows.Start.Init(0, NumFacts + 1);
+	for (const ElementType& Item : TriggerRows.Items)
+	{
+		OutFactRows.Start[KeyFunc(Item) + 1]++;
+	}
+	for (int32 Fact = 0; Fact < NumFacts; Fact++)
+	{
+		OutFactRows.Start[Fact + 1] += OutFactRows.Start[Fact];
+	}
+
+	TArray<int32> Cursor(OutFactRows.Start.GetData(), NumFacts);
+	OutFactRows.Items.SetNumUninitialized(TriggerRows.Items.Num());
+	for (int32 Trigger = 0; Trigger + 1 < TriggerRows.Start.Num(); Trigger++)
+	{
+		for (const ElementType& Item : TriggerRows.Get(Trigger))
+		{
+			OutFactRows.Items[Cursor[KeyFunc(Item)]++] = Trigger;
+		}
+	}
+}
+
+void FCaseTriggerIndex::Build(const FCaseDefinition& Definition)
+{
+	const TArray<FCaseTrigger>& Triggers = Definition.GetData().Triggers;
+
+	TriggerIndexMap.Reset();
+	Unsatisfiable.Init(false, Triggers.Num());
+	for (TRows<int32>* Rows : { &RequiredFlags, &RequiredEvidence, &RequiredDeductions })
+	{
+		Rows->Start.Reset(Triggers.Num() + 1);
+		Rows->Items.Reset();
+	}
+	TrustConditions.Start.Reset(Triggers.Num() + 1);
+	TrustConditions.Items.Reset();
+	ActionStart.Reset(Triggers.Num() + 1);
+	Actions.Reset();
+
+	// 決して発火しないトリガーは条件を空にして、どの事実の索引にも載せない
+	TArray<int32, TInlineAllocator<8>> Flags;
+	TArray<int32, TInlineAllocator<8>> Evidence;
+	TArray<int32, TInlineAllocator<8>> Deductions;
+	TArray<FCompiledTrustCondition, TInlineAllocator<4>> Trust;
+
+	for (int32 TriggerIndex = 0; TriggerIndex < Triggers.Num(); TriggerIndex++)
+	{
+		const FCaseTrigger& Trigger = Triggers[TriggerIndex];
+		const FString TriggerName = Trigger.TriggerId.ToString();
+
+		if (!Trigger.TriggerId.IsNone())
+		{
+			if (TriggerIndexMap.Contains(Trigger.TriggerId))
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseTriggerIndex] トリガーIDが重複しています: %s"), *TriggerName);
+			}
+			else
+			{
+				TriggerIndexMap.Add(Trigger.TriggerId, TriggerIndex);
+			}
+		}
+
+		bool bValid = true;
+		Flags.Reset();
+		Evidence.Reset();
+		Deductions.Reset();
+		Trust.Reset();
+
+		for (const FName& FlagName : Trigger.RequiredFlags)
+		{
+			// 条件のフラグは CompileFlagsAndRequirements で登録済みなので必ず見つかる
+			Flags.AddUnique(Definition.FindFlagIndex(FlagName));
+		}
+
+		for (const FName& EvidenceId : Trigger.RequiredEvidence)
+		{
+			const int32 EvidenceIndex = Definition.FindEvidenceIndex(EvidenceId);
+			if (EvidenceIndex == INDEX_NONE)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseTriggerIndex] トリガー %s が存在しない証拠を条件にしています: %s"), *TriggerName, *EvidenceId.ToString());
+				bValid = false;
+				continue;
+			}
+			Evidence.AddUnique(EvidenceIndex);
+		}
+
+		for (const FName& DeductionId : Trigger.RequiredDeductions)
+		{
+			const int32 DeductionIndex = Definition.FindDeductionIndex(DeductionId);
+			if (DeductionIndex == INDEX_NONE)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseTriggerIndex] トリガー %s が存在しない推理を条件にしています: %s"), *TriggerName, *DeductionId.ToString());
+				bValid = false;
+				continue;
+			}
+			Deductions.AddUnique(DeductionIndex);
+		}
+
+		for (const FTriggerTrustCondition& Condition : Trigger.TrustConditions)
+		{
+			const int32 CharacterIndex = Definition.FindCharacterIndex(Condition.CharacterId);
+			const int32 MinTrust = FMath::Clamp(Condition.MinTrust, 0, 100);
+			const int32 MaxTrust = FMath::Clamp(Condition.MaxTrust, 0, 100);
+			if (CharacterIndex == INDEX_NONE || MinTrust > MaxTrust)
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseTriggerIndex] トリガー %s の信頼度の条件が不正です: %s (%d-%d)"),
+					*TriggerName, *Condition.CharacterId.ToString(), Condition.MinTrust, Condition.MaxTrust);
+				bValid = false;
+				continue;
+			}
+
+			FCompiledTrustCondition& Compiled = Trust.AddDefaulted_GetRef();
+			Compiled.CharacterIndex = CharacterIndex;
+			Compiled.MinTrust = static_cast<uint8>(MinTrust);
+			Compiled.MaxTrust = static_cast<uint8>(MaxTrust);
+		}
+
+		if (!bValid)
+		{
+			Unsatisfiable[TriggerIndex] = true;
+			Flags.Reset();
+			Evidence.Reset();
+			Deductions.Reset();
+			Trust.Reset();
+		}
+
+		RequiredFlags.Start.Add(RequiredFlags.Items.Num());
+		RequiredFlags.Items.Append(Flags);
+		RequiredEvidence.Start.Add(RequiredEvidence.Items.Num());
+		RequiredEvidence.Items.Append(Evidence);
+		RequiredDeductions.Start.Add(RequiredDeductions.Items.Num());
+		RequiredDeductions.Items.Append(Deductions);
+		TrustConditions.Start.Add(TrustConditions.Items.Num());
+		TrustConditions.Items.Append(Trust);
+
+		ActionStart.Add(Actions.Num());
+		if (!bValid)
+		{
+			continue;
+		}
+
+		for (const FTriggerAction& Action : Trigger.Actions)
+		{
+			FCompiledTriggerAction Compiled;
+			Compiled.Type = Action.Type;
+
+			switch (Action.Type)
+			{
+			case ETriggerActionType::SetLocationAccessible:
+				Compiled.Target = Definition.FindLocationIndex(Action.Location);
+				Compiled.Value = Action.bAccessible ? 1 : 0;
+				break;
+			case ETriggerActionType::MoveCharacter:
+				Compiled.Target = Definition.FindCharacterIndex(Action.CharacterId);
+				Compiled.LocationIndex = Definition.FindLocationIndex(Action.Location);
+				break;
+			case ETriggerActionType::SetEmotionalState:
+				Compiled.Target = Definition.FindCharacterIndex(Action.CharacterId);
+				Compiled.Value = static_cast<uint8>(Action.EmotionalState);
+				break;
+			default:
+				break;
+			}
+
+			const bool bNeedsLocation = Action.Type == ETriggerActionType::MoveCharacter;
+			if (Compiled.Target == INDEX_NONE || (bNeedsLocation && Compiled.LocationIndex == INDEX_NONE))
+			{
+				UE_LOG(LogLastWitness, Warning, TEXT("[CaseTriggerIndex] トリガー %s の操作の対象が見つからないため無視します (%s)"),
+					*TriggerName, *UEnum::GetValueAsString(Action.Type));
+				continue;
+			}
+
+			Actions.Add(Compiled);
+		}
+	}
+
+	RequiredFlags.Start.Add(RequiredFlags.Items.Num());
+	RequiredEvidence.Start.Add(RequiredEvidence.Items.Num());
+	RequiredDeductions.Start.Add(RequiredDeductions.Items.Num());
+	TrustConditions.Start.Add(TrustConditions.Items.Num());
+	ActionStart.Add(Actions.Num());
+
+	auto Identity = [](int32 Fact) { return Fact; };
+	Invert(Definition.NumFlags(), RequiredFlags, Identity, FlagTriggers);
+	Invert(Definition.NumEvidence(), RequiredEvidence, Identity, EvidenceTriggers);
+	Invert(Definition.NumDeductions(), RequiredDeductions, Identity, DeductionTriggers);
+	Invert(Definition.NumCharacters(), TrustConditions, [](const FCompiledTrustCondition& Condition) { return Condition.CharacterIndex; }, TrustTriggers);
+}
+
+int32 FCaseTriggerIndex::FindTriggerIndex(FName TriggerId) const
+{
+	const int32* Found = TriggerIndexMap.Find(TriggerId);
+	return Found ? *Found : INDEX_NONE;
+}
+
+bool FCaseTriggerIndex::IsSatisfied(int32 Trigger, const FCaseProgress& Progress) const
+{
+	if (Unsatisfiable[Trigger])
+	{
+		return false;
+	}
+
+	const TBitArray<>& FlagBits = Progress.Flags->Set;
+	for (const int32 FlagIndex : RequiredFlags.Get(Trigger))
+	{
+		if (!FlagBits[FlagIndex])
+		{
+			return false;
+		}
+	}
+
+	const TBitArray<>& EvidenceBits = Progress.Evidence->Collected;
+	for (const int32 EvidenceIndex : RequiredEvidence.Get(Trigger))
+	{
+		if (!EvidenceBits[EvidenceIndex])
+		{
+			return false;
+		}
+	}
+
+	const TBitArray<>& DeductionBits = Progress.Deductions->Unlocked;
+	for (const int32 DeductionIndex : RequiredDeductions.Get(Trigger))
+	{
+		if (!DeductionBits[DeductionIndex])
+		{
+			return false;
+		}
+	}
+
+	const TArray<uint8>& TrustLevels = Progress.Characters->TrustLevels;
+	for (const FCompiledTrustCondition& Condition : TrustConditions.Get(Trigger))
+	{
+		const uint8 TrustLevel = TrustLevels[Condition.CharacterIndex];
+		if (TrustLevel < Condition.MinTrust || TrustLevel > Condition.MaxTrust)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+SIZE_T FCaseTriggerIndex::GetAllocatedSize() const
+{
+	return TriggerIndexMap.GetAllocatedSize()
+		+ Unsatisfiable.GetAllocatedSize()
+		+ RequiredFlags.GetAllocatedSize()
+		+ RequiredEvidence.GetAllocatedSize()
+		+ RequiredDeductions.GetAllocatedSize()
+		+ TrustConditions.GetAllocatedSize()
+		+ ActionStart.GetAllocatedSize()
+		+ Actions.GetAllocatedSize()
+		+ FlagTriggers.GetAllocatedSize()
+		+ EvidenceTriggers.GetAllocatedSize()
+		+ DeductionTriggers.GetAllocatedSize()
+		+ TrustTriggers.GetAllocatedSize();
+}
@@ -0,0 +1,738 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/CookedCase.h"
+#include "TheLastWitness.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "クック済み事件ファイルはリトルエンディアン前提です");
+
+// ============================================================================
+// クック
+// ============================================================================
+
+namespace
+{
+	/// <summary>
+	/// FCaseData を各テーブルへ平坦化する作業用の状態
+	/// </summary>
+	struct FCookedCaseWriter
+	{
+		TArray<FCookedEvidence> Evidence;
+		TArray<FCookedCharacter> Characters;
+		TArray<FCookedLocation> Locations;
+		TArray<FCookedDialogueTree> Dialogues;
+		TArray<FCookedDialogueNode> DialogueNodes;
+		TArray<FCookedDialogueChoice> DialogueChoices;
+		TArray<FCookedDeduction> Deductions;
+		TArray<FCookedScheduleEntry> Schedule;
+		TArray<FCookedTrigger> Triggers;
+		TArray<FCookedTrustCondition> TrustConditions;
+		TArray<FCookedTriggerAction> TriggerActions;
+		TArray<FCookedString> Names;
+		TArray<uint8> Strings;
+
+		/// <summary>同じ文字列はプールに一度だけ格納する</summary>
+		TMap<FString, FCookedString> StringMap;
+
+		FCookedString AddString(const FString& Value)
+		{
+			if (Value.IsEmpty())
+			{
+				return FCookedString();
+			}
+			if (const FCookedString* Found = StringMap.Find(Value))
+			{
+				return *Found;
+			}
+
+			const FTCHARToUTF8 Utf8(*Value, Value.Len());
+			FCookedString Result;
+			Result.Offset = static_cast<uint32>(Strings.Num());
+			Result.Length = static_cast<uint32>(Utf8.Length());
+			Strings.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+			StringMap.Add(Value, Result);
+			return Result;
+		}
+
+		FCookedString AddName(FName Name)
+		{
+			return Name.IsNone() ? FCookedString() : AddString(Name.ToString());
+		}
+
+		FCookedString AddText(const FText& Text)
+		{
+			return AddString(Text.ToString());
+		}
+
+		FCookedList AddNames(const TArray<FName>& List)
+		{
+			FCookedList Result;
+			Result.First = static_cast<uint32>(Names.Num());
+			Result.Count = static_cast<uint32>(List.Num());
+			for (const FName& Name : List)
+			{
+				Names.Add(AddName(Name));
+			}
+			return Result;
+		}
+
+		template <typename RecordType>
+		static FCookedList MakeList(const TArray<RecordType>& Table, int32 First)
+		{
+			FCookedList Result;
+			Result.First = static_cast<uint32>(First);
+			Result.Count = static_cast<uint32>(Table.Num() - First);
+			return Result;
+		}
+
+		/// <summary>
+		/// テーブルを 4 バイト境界に揃えて書き出します
+		/// </summary>
+		template <typename RecordType>
+		static void AppendTable(TArray<uint8>& OutBytes, const TArray<RecordType>& Records, FCookedTable& OutTable)
+		{
+			OutBytes.AddZeroed(Align(OutBytes.Num(), 4) - OutBytes.Num());
+			OutTable.Offset = static_cast<uint32>(OutBytes.Num());
+			OutTable.Count = static_cast<uint32>(Records.Num());
+			OutBytes.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(RecordType));
+		}
+
+		void AddCharacters(const TArray<FCharacterData>& AllCharacters)
+		{
+			Characters.Reserve(AllCharacters.Num());
+			for (const FCharacterData& Source : AllCharacters)
+			{
+				FCookedCharacter& Record = Characters.AddDefaulted_GetRef();
+				Record.CharacterId = AddName(Source.CharacterId);
+				Record.DisplayName = AddText(Source.DisplayName);
+				Record.Role = AddText(Source.Role);
+				Record.Description = AddText(Source.Description);
+				Record.RelationToVictim = AddText(Source.RelationToVictim);
+				Record.Motive = AddText(Source.Motive);
+				Record.TrustLevel = Source.TrustLevel;
+				Record.EmotionalState = static_cast<uint8>(Source.EmotionalState);
+				Record.CurrentLocation = static_cast<uint8>(Source.CurrentLocation);
+				Record.Flags = (Source.bHasBeenInterviewed ? 1 : 0) | (Source.bIsSuspect ? 2 : 0);
+			}
+		}
+
+		void AddEvidence(const TArray<FEvidence>& AllEvidence)
+		{
+			Evidence.Reserve(AllEvidence.Num());
+			for (const FEvidence& Source : AllEvidence)
+			{
+				FCookedEvidence& Record = Evidence.AddDefaulted_GetRef();
+				Record.EvidenceId = AddName(Source.EvidenceId);
+				Record.DisplayName = AddText(Source.DisplayName);
+				Record.Description = AddText(Source.Description);
+				Record.ABELComment = AddText(Source.ABELComment);
+				Record.RelatedCharacters = AddNames(Source.RelatedCharacters);
+				Record.RelatedEvidence = AddNames(Source.RelatedEvidence);
+				Record.Type = static_cast<uint8>(Source.Type);
+				Record.Importance = static_cast<uint8>(Source.Importance);
+				Record.FoundAt = static_cast<uint8>(Source.FoundAt);
+				Record.Flags = (Source.bIsCollected ? 1 : 0) | (Source.bIsExamined ? 2 : 0);
+			}
+		}
+
+		void AddLocations(const TArray<FLocationData>& AllLocations)
+		{
+			Locations.Reserve(AllLocations.Num());
+			for (const FLocationData& Source : AllLocations)
+			{
+				FCookedLocation& Record = Locations.AddDefaulted_GetRef();
+				Record.DisplayName = AddText(Source.DisplayName);
+				Record.Description = AddText(Source.Description);
+				Record.AvailableEvidence = AddNames(Source.AvailableEvidence);
+				Record.CharactersPresent = AddNames(Source.CharactersPresent);
+				Record.Location = static_cast<uint8>(Source.Location);
+				Record.Flags = (Source.bHasVisited ? 1 : 0) | (Source.bIsAccessible ? 2 : 0);
+			}
+		}
+
+		void AddDialogues(const TArray<FDialogueTree>& AllDialogues)
+		{
+			Dialogues.Reserve(AllDialogues.Num());
+			for (const FDialogueTree& SourceTree : AllDialogues)
+			{
+				FCookedDialogueTree& Tree = Dialogues.AddDefaulted_GetRef();
+				Tree.TreeId = AddName(SourceTree.TreeId);
+				Tree.CharacterId = AddName(SourceTree.CharacterId);
+				Tree.StartNodeId = AddName(SourceTree.StartNodeId);
+
+				// ノードの選択肢を先に詰めると木のノードが連続しなくなるため、ノード・選択肢の順に分けて書く
+				const int32 FirstNode = DialogueNodes.Num();
+				DialogueNodes.AddDefaulted(SourceTree.Nodes.Num());
+				Tree.Nodes = MakeList(DialogueNodes, FirstNode);
+
+				for (int32 i = 0; i < SourceTree.Nodes.Num(); i++)
+				{
+					const FDialogueNode& SourceNode = SourceTree.Nodes[i];
+					FCookedDialogueNode& Node = DialogueNodes[FirstNode + i];
+					Node.NodeId = AddName(SourceNode.NodeId);
+					Node.SpeakerId = AddName(SourceNode.SpeakerId);
+					Node.Text = AddText(SourceNode.Text);
+					Node.NextNodeId = AddName(SourceNode.NextNodeId);
+					Node.GainsEvidence = AddNames(SourceNode.GainsEvidence);
+					Node.SetsFlags = AddNames(SourceNode.SetsFlags);
+					Node.Emotion = static_cast<uint8>(SourceNode.Emotion);
+					Node.Flags = SourceNode.bIsEndNode ? 1 : 0;
+
+					const int32 FirstChoice = DialogueChoices.Num();
+					for (const FDialogueChoice& SourceChoice : SourceNode.Choices)
+					{
+						FCookedDialogueChoice& Choice = DialogueChoices.AddDefaulted_GetRef();
+						Choice.ChoiceId = AddName(SourceChoice.ChoiceId);
+						Choice.DisplayText = AddText(SourceChoice.DisplayText);
+						Choice.NextNodeId = AddName(SourceChoice.NextNodeId);
+						Choice.RequiredEvidence = AddNames(SourceChoice.RequiredEvidence);
+						Choice.RequiredFlags = AddNames(SourceChoice.RequiredFlags);
+						Choice.SetsFlags = AddNames(SourceChoice.SetsFlags);
+						Choice.TrustDelta = SourceChoice.TrustDelta;
+						Choice.Tone = static_cast<uint8>(SourceChoice.Tone);
+					}
+					Node.Choices = MakeList(DialogueChoices, FirstChoice);
+				}
+			}
+		}
+
+		void AddDeductions(const TArray<FDeduction>& AllDeductions)
+		{
+			Deductions.Reserve(AllDeductions.Num());
+			for (const FDeduction& Source : AllDeductions)
+			{
+				FCookedDeduction& Record = Deductions.AddDefaulted_GetRef();
+				Record.DeductionId = AddName(Source.DeductionId);
+				Record.Title = AddText(Source.Title);
+				Record.Description = AddText(Source.Description);
+				Record.EvidenceA = AddName(Source.EvidenceA);
+				Record.EvidenceB = AddName(Source.EvidenceB);
+				Record.PremiseDeductions = AddNames(Source.PremiseDeductions);
+				Record.PremiseEvidence = AddNames(Source.PremiseEvidence);
+				Record.UnlocksFlags = AddNames(Source.UnlocksFlags);
+				Record.UnlocksDialogue = AddNames(Source.UnlocksDialogue);
+				Record.Flags = Source.bIsUnlocked ? 1 : 0;
+			}
+		}
+
+		void AddSchedule(const TArray<FCharacterScheduleEntry>& CharacterSchedule)
+		{
+			Schedule.Reserve(CharacterSchedule.Num());
+			for (const FCharacterScheduleEntry& Source : CharacterSchedule)
+			{
+				FCookedScheduleEntry& Record = Schedule.AddDefaulted_GetRef();
+				Record.CharacterId = AddName(Source.CharacterId);
+				Record.AtMinute = Source.AtMinute;
+				Record.Location = static_cast<uint8>(Source.Location);
+			}
+		}
+
+		void AddTriggers(const TArray<FCaseTrigger>& AllTriggers)
+		{
+			Triggers.Reserve(AllTriggers.Num());
+			for (const FCaseTrigger& Source : AllTriggers)
+			{
+				FCookedTrigger& Record = Triggers.AddDefaulted_GetRef();
+				Record.TriggerId = AddName(Source.TriggerId);
+				Record.RequiredFlags = AddNames(Source.RequiredFlags);
+				Record.RequiredEvidence = AddNames(Source.RequiredEvidence);
+				Record.RequiredDeductions = AddNames(Source.RequiredDeductions);
+
+				const int32 FirstCondition = TrustConditions.Num();
+				for (const FTriggerTrustCondition& SourceCondition : Source.TrustConditions)
+				{
+					FCookedTrustCondition& Condition = TrustConditions.AddDefaulted_GetRef();
+					Condition.CharacterId = AddName(SourceCondition.CharacterId);
+					Condition.MinTrust = SourceCondition.MinTrust;
+					Condition.MaxTrust = SourceCondition.MaxTrust;
+				}
+				Record.TrustConditions = MakeList(TrustConditions, FirstCondition);
+
+				const int32 FirstAction = TriggerActions.Num();
+				for (const FTriggerAction& SourceAction : Source.Actions)
+				{
+					FCookedTriggerAction& Action = TriggerActions.AddDefaulted_GetRef();
+					Action.CharacterId = AddName(SourceAction.CharacterId);
+					Action.Type = static_cast<uint8>(SourceAction.Type);
+					Action.Location = static_cast<uint8>(SourceAction.Location);
+					Action.EmotionalState = static_cast<uint8>(SourceAction.EmotionalState);
+					Action.Flags = SourceAction.bAccessible ? 1 : 0;
+				}
+				Record.Actions = MakeList(TriggerActions, FirstAction);
+			}
+		}
+	};
+}
+
+void FCookedCase::Cook(const FCaseData& CaseData, uint32 SourceHash, TArray<uint8>& OutBytes)
+{
+	FCookedCaseWriter Writer;
+	FCookedCaseHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.SourceHash = SourceHash;
+	Header.CaseId = Writer.AddName(CaseData.CaseId);
+	Header.Title = Writer.AddText(CaseData.Title);
+	Header.Synopsis = Writer.AddText(CaseData.Synopsis);
+	Header.VictimId = Writer.AddName(CaseData.VictimId);
+	Header.TrueCulpritId = Writer.AddName(CaseData.TrueCulpritId);
+	Header.RequiredEvidenceForAccusation = Writer.AddNames(CaseData.RequiredEvidenceForAccusation);
+
+	Writer.AddEvidence(CaseData.AllEvidence);
+	Writer.AddCharacters(CaseData.AllCharacters);
+	Writer.AddLocations(CaseData.AllLocations);
+	Writer.AddDialogues(CaseData.AllDialogues);
+	Writer.AddDeductions(CaseData.AllDeductions);
+	Writer.AddSchedule(CaseData.CharacterSchedule);
+	Writer.AddTriggers(CaseData.Triggers);
+
+	OutBytes.Reset();
+	OutBytes.AddZeroed(sizeof(FCookedCaseHeader));
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Evidence, Header.Evidence);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Characters, Header.Characters);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Locations, Header.Locations);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Dialogues, Header.Dialogues);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.DialogueNodes, Header.DialogueNodes);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.DialogueChoices, Header.DialogueChoices);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Deductions, Header.Deductions);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Schedule, Header.Schedule);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Triggers, Header.Triggers);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.TrustConditions, Header.TrustConditions);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.TriggerActions, Header.TriggerActions);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Names, Header.Names);
+	FCookedCaseWriter::AppendTable(OutBytes, Writer.Strings, Header.Strings);
+	OutBytes.AddZeroed(Align(OutBytes.Num(), 4) - OutBytes.Num());
+
+	Header.TotalSize = static_cast<uint32>(OutBytes.Num());
+	Header.PayloadCrc = FCrc::MemCrc32(OutBytes.GetData() + sizeof(FCookedCaseHeader), OutBytes.Num() - sizeof(FCookedCaseHeader));
+	FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(FCookedCaseHeader));
+}
+
+// ============================================================================
+// 読み込み
+// ============================================================================
+
+namespace
+{
+	/// <summary>
+	/// 列挙型の値として有効なバイトか確認します（自動生成される _MAX は無効とする）
+	/// </summary>
+	bool IsValidEnumByte(const UEnum* Enum, uint8 Value)
+	{
+		if (!Enum->IsValidEnumValue(Value))
+		{
+			return false;
+		}
+		return !Enum->ContainsExistingMax() || Value != Enum->GetValueByIndex(Enum->NumEnums() - 1);
+	}
+}
+
+TSharedPtr<const FCookedCase> FCookedCase::Open(const FString& Path)
+{
+	// ToCaseData() で一度展開したら手放すので、メモリマップせずに一度の読み込みで済ませる（pak 内でも読める）
+	TSharedRef<FCookedCase> Cooked = MakeShareable(new FCookedCase());
+	if (!FFileHelper::LoadFileToArray(Cooked->OwnedBytes, *Path, FILEREAD_Silent))
+	{
+		return nullptr;
+	}
+	Cooked->Data = Cooked->OwnedBytes.GetData();
+	Cooked->Size = Cooked->OwnedBytes.Num();
+
+	if (!Cooked->Validate())
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[CookedCase] クック済みファイルが壊れているか、形式が古いため無視します: %s"), *Path);
+		return nullptr;
+	}
+	return Cooked;
+}
+
+TSharedPtr<const FCookedCase> FCookedCase::FromBytes(TArray<uint8> Bytes)
+{
+	TSharedRef<FCookedCase> Cooked = MakeShareable(new FCookedCase());
+	Cooked->OwnedBytes = MoveTemp(Bytes);
+	Cooked->Data = Cooked->OwnedBytes.GetData();
+	Cooked->Size = Cooked->OwnedBytes.Num();
+
+	if (!Cooked->Validate())
+	{
+		return nullptr;
+	}
+	return Cooked;
+}
+
+FString FCookedCase::GetCookedPath(FName CaseId)
+{
+	return FPaths::ProjectContentDir() / TEXT("Cases") / CaseId.ToString() + TEXT(".lwcase");
+}
+
+bool FCookedCase::Validate() const
+{
+	if (!Data || Size < static_cast<int64>(sizeof(FCookedCaseHeader)))
+	{
+		return false;
+	}
+
+	const FCookedCaseHeader& Header = GetHeader();
+	if (Header.Magic != Magic || Header.Version != Version || Header.TotalSize != Size)
+	{
+		return false;
+	}
+
+	if (FCrc::MemCrc32(Data + sizeof(FCookedCaseHeader), Size - sizeof(FCookedCaseHeader)) != Header.PayloadCrc)
+	{
+		return false;
+	}
+
+	auto IsValidTable = [this](const FCookedTable& Table, SIZE_T RecordSize)
+	{
+		return Table.Offset % 4 == 0
+			&& Table.Offset >= sizeof(FCookedCaseHeader)
+			&& static_cast<uint64>(Table.Offset) + static_cast<uint64>(Table.Count) * RecordSize <= static_cast<uint64>(Size);
+	};
+
+	if (!IsValidTable(Header.Evidence, sizeof(FCookedEvidence))
+		|| !IsValidTable(Header.Characters, sizeof(FCookedCharacter))
+		|| !IsValidTable(Header.Locations, sizeof(FCookedLocation))
+		|| !IsValidTable(Header.Dialogues, sizeof(FCookedDialogueTree))
+		|| !IsValidTable(Header.DialogueNodes, sizeof(FCookedDialogueNode))
+		|| !IsValidTable(Header.DialogueChoices, sizeof(FCookedDialogueChoice))
+		|| !IsValidTable(Header.Deductions, sizeof(FCookedDeduction))
+		|| !IsValidTable(Header.Schedule, sizeof(FCookedScheduleEntry))
+		|| !IsValidTable(Header.Triggers, sizeof(FCookedTrigger))
+		|| !IsValidTable(Header.TrustConditions, sizeof(FCookedTrustCondition))
+		|| !IsValidTable(Header.TriggerActions, sizeof(FCookedTriggerAction))
+		|| !IsValidTable(Header.Names, sizeof(FCookedString))
+		|| !IsValidTable(Header.Strings, 1))
+	{
+		return false;
+	}
+
+	// 以降のアクセスで範囲チェックを省けるよう、全ての参照をここで確認しておく
+	bool bValid = true;
+	auto CheckString = [&bValid, &Header](FCookedString String)
+	{
+		bValid &= static_cast<uint64>(String.Offset) + String.Length <= Header.Strings.Count;
+	};
+	auto CheckList = [&bValid](FCookedList List, const FCookedTable& Table)
+	{
+		bValid &= static_cast<uint64>(List.First) + List.Count <= Table.Count;
+	};
+	auto CheckNames = [&CheckList, &Header](FCookedList List)
+	{
+		CheckList(List, Header.Names);
+	};
+	auto CheckEnum = [&bValid](const UEnum* Enum, uint8 Value)
+	{
+		bValid &= IsValidEnumByte(Enum, Value);
+	};
+	const UEnum* LocationEnum = StaticEnum<ELocation>();
+	const UEnum* EmotionalStateEnum = StaticEnum<EEmotionalState>();
+
+	for (const FCookedString& Name : GetTable<FCookedString>(Header.Names))
+	{
+		CheckString(Name);
+	}
+
+	for (const FCookedString& String : { Header.CaseId, Header.Title, Header.Synopsis, Header.VictimId, Header.TrueCulpritId })
+	{
+		CheckString(String);
+	}
+	CheckNames(Header.RequiredEvidenceForAccusation);
+
+	for (const FCookedEvidence& Record : GetEvidence())
+	{
+		for (const FCookedString& String : { Record.EvidenceId, Record.DisplayName, Record.Description, Record.ABELComment })
+		{
+			CheckString(String);
+		}
+		CheckNames(Record.RelatedCharacters);
+		CheckNames(Record.RelatedEvidence);
+		CheckEnum(StaticEnum<EEvidenceType>(), Record.Type);
+		CheckEnum(StaticEnum<EEvidenceImportance>(), Record.Importance);
+		CheckEnum(LocationEnum, Record.FoundAt);
+	}
+
+	for (const FCookedCharacter& Record : GetCharacters())
+	{
+		for (const FCookedString& String : { Record.CharacterId, Record.DisplayName, Record.Role, Record.Description, Record.RelationToVictim, Record.Motive })
+		{
+			CheckString(String);
+		}
+		CheckEnum(EmotionalStateEnum, Record.EmotionalState);
+		CheckEnum(LocationEnum, Record.CurrentLocation);
+	}
+
+	for (const FCookedLocation& Record : GetLocations())
+	{
+		CheckString(Record.DisplayName);
+		CheckString(Record.Description);
+		CheckNames(Record.AvailableEvidence);
+		CheckNames(Record.CharactersPresent);
+		CheckEnum(LocationEnum, Record.Location);
+	}
+
+	for (const FCookedDialogueTree& Record : GetDialogues())
+	{
+		CheckString(Record.TreeId);
+		CheckString(Record.CharacterId);
+		CheckString(Record.StartNodeId);
+		CheckList(Record.Nodes, Header.DialogueNodes);
+	}
+
+	for (const FCookedDialogueNode& Record : GetTable<FCookedDialogueNode>(Header.DialogueNodes))
+	{
+		for (const FCookedString& String : { Record.NodeId, Record.SpeakerId, Record.Text, Record.NextNodeId })
+		{
+			CheckString(String);
+		}
+		CheckList(Record.Choices, Header.DialogueChoices);
+		CheckNames(Record.GainsEvidence);
+		CheckNames(Record.SetsFlags);
+		CheckEnum(EmotionalStateEnum, Record.Emotion);
+	}
+
+	for (const FCookedDialogueChoice& Record : GetTable<FCookedDialogueChoice>(Header.DialogueChoices))
+	{
+		CheckString(Record.ChoiceId);
+		CheckString(Record.DisplayText);
+		CheckString(Record.NextNodeId);
+		CheckNames(Record.RequiredEvidence);
+		CheckNames(Record.RequiredFlags);
+		CheckNames(Record.SetsFlags);
+		CheckEnum(StaticEnum<EDialogueTone>(), Record.Tone);
+	}
+
+	for (const FCookedDeduction& Record : GetDeductions())
+	{
+		for (const FCookedString& String : { Record.DeductionId, Record.Title, Record.Description, Record.EvidenceA, Record.EvidenceB })
+		{
+			CheckString(String);
+		}
+		CheckNames(Record.PremiseDeductions);
+		CheckNames(Record.PremiseEvidence);
+		CheckNames(Record.UnlocksFlags);
+		CheckNames(Record.UnlocksDialogue);
+	}
+
+	for (const FCookedScheduleEntry& Record : GetSchedule())
+	{
+		CheckString(Record.CharacterId);
+		CheckEnum(LocationEnum, Record.Location);
+	}
+
+	for (const FCookedTrigger& Record : GetTriggers())
+	{
+		CheckString(Record.TriggerId);
+		CheckNames(Record.RequiredFlags);
+		CheckNames(Record.RequiredEvidence);
+		CheckNames(Record.RequiredDeductions);
+		CheckList(Record.TrustConditions, Header.TrustConditions);
+		CheckList(Record.Actions, Header.TriggerActions);
+	}
+
+	for (const FCookedTrustCondition& Record : GetTable<FCookedTrustCondition>(Header.TrustConditions))
+	{
+		CheckString(Record.CharacterId);
+	}
+
+	for (const FCookedTriggerAction& Record : GetTable<FCookedTriggerAction>(Header.TriggerActions))
+	{
+		CheckString(Record.CharacterId);
+		CheckEnum(StaticEnum<ETriggerActionType>(), Record.Type);
+		CheckEnum(LocationEnum, Record.Location);
+		CheckEnum(EmotionalStateEnum, Record.EmotionalState);
+	}
+
+	return bValid;
+}
+
+// ============================================================================
+// 展開
+// ============================================================================
+
+FName FCookedCase::GetName(FCookedString String) const
+{
+	if (String.Length == 0)
+	{
+		return NAME_None;
+	}
+
+	const FUtf8StringView View = GetString(String);
+	return FName(View.Len(), View.GetData());
+}
+
+FText FCookedCase::GetText(FCookedString String) const
+{
+	if (String.Length == 0)
+	{
+		return FText::GetEmpty();
+	}
+	return FText::FromString(FString(GetString(String)));
+}
+
+FCaseData FCookedCase::ToCaseData() const
+{
+	const FCookedCaseHeader& Header = GetHeader();
+
+	auto ToNames = [this](FCookedList List)
+	{
+		TArray<FName> Result;
+		Result.Reserve(List.Count);
+		for (const FCookedString& Name : GetNames(List))
+		{
+			Result.Add(GetName(Name));
+		}
+		return Result;
+	};
+
+	FCaseData CaseData;
+	CaseData.CaseId = GetName(Header.CaseId);
+	CaseData.Title = GetText(Header.Title);
+	CaseData.Synopsis = GetText(Header.Synopsis);
+	CaseData.VictimId = GetName(Header.VictimId);
+	CaseData.TrueCulpritId = GetName(Header.TrueCulpritId);
+	CaseData.RequiredEvidenceForAccusation = ToNames(Header.RequiredEvidenceForAccusation);
+
+	CaseData.AllEvidence.Reserve(Header.Evidence.Count);
+	for (const FCookedEvidence& Record : GetEvidence())
+	{
+		FEvidence& Evidence = CaseData.AllEvidence.AddDefaulted_GetRef();
+		Evidence.EvidenceId = GetName(Record.EvidenceId);
+		Evidence.DisplayName = GetText(Record.DisplayName);
+		Evidence.Description = GetText(Record.Description);
+		Evidence.ABELComment = GetText(Record.ABELComment);
+		Evidence.RelatedCharacters = ToNames(Record.RelatedCharacters);
+		Evidence.RelatedEvidence = ToNames(Record.RelatedEvidence);
+		Evidence.Type = static_cast<EEvidenceType>(Record.Type);
+		Evidence.Importance = static_cast<EEvidenceImportance>(Record.Importance);
+		Evidence.FoundAt = static_cast<ELocation>(Record.FoundAt);
+		Evidence.bIsCollected = (Record.Flags & 1) != 0;
+		Evidence.bIsExamined = (Record.Flags & 2) != 0;
+	}
+
+	CaseData.AllCharacters.Reserve(Header.Characters.Count);
+	for (const FCookedCharacter& Record : GetCharacters())
+	{
+		FCharacterData& Character = CaseData.AllCharacters.AddDefaulted_GetRef();
+		Character.CharacterId = GetName(Record.CharacterId);
+		Character.DisplayName = GetText(Record.DisplayName);
+		Character.Role = GetText(Record.Role);
+		Character.Description = GetText(Record.Description);
+		Character.RelationToVictim = GetText(Record.RelationToVictim);
+		Character.Motive = GetText(Record.Motive);
+		Character.TrustLevel = Record.TrustLevel;
+		Character.EmotionalState = static_cast<EEmotionalState>(Record.EmotionalState);
+		Character.CurrentLocation = static_cast<ELocation>(Record.CurrentLocation);
+		Character.bHasBeenInterviewed = (Record.Flags & 1) != 0;
+		Character.bIsSuspect = (Record.Flags & 2) != 0;
+	}
+
+	CaseData.AllLocations.Reserve(Header.Locations.Count);
+	for (const FCookedLocation& Record : GetLocations())
+	{
+		FLocationData& Location = CaseData.AllLocations.AddDefaulted_GetRef();
+		Location.Location = static_cast<ELocation>(Record.Location);
+		Location.DisplayName = GetText(Record.DisplayName);
+		Location.Description = GetText(Record.Description);
+		Location.AvailableEvidence = ToNames(Record.AvailableEvidence);
+		Location.CharactersPresent = ToNames(Record.CharactersPresent);
+		Location.bHasVisited = (Record.Flags & 1) != 0;
+		Location.bIsAccessible = (Record.Flags & 2) != 0;
+	}
+
+	CaseData.AllDialogues.Reserve(Header.Dialogues.Count);
+	for (const FCookedDialogueTree& Record : GetDialogues())
+	{
+		FDialogueTree& Tree = CaseData.AllDialogues.AddDefaulted_GetRef();
+		Tree.TreeId = GetName(Record.TreeId);
+		Tree.CharacterId = GetName(Record.CharacterId);
+		Tree.StartNodeId = GetName(Record.StartNodeId);
+
+		Tree.Nodes.Reserve(Record.Nodes.Count);
+		for (const FCookedDialogueNode& NodeRecord : GetNodes(Record))
+		{
+			FDialogueNode& Node = Tree.Nodes.AddDefaulted_GetRef();
+			Node.NodeId = GetName(NodeRecord.NodeId);
+			Node.SpeakerId = GetName(NodeRecord.SpeakerId);
+			Node.Text = GetText(NodeRecord.Text);
+			Node.NextNodeId = GetName(NodeRecord.NextNodeId);
+			Node.GainsEvidence = ToNames(NodeRecord.GainsEvidence);
+			Node.SetsFlags = ToNames(NodeRecord.SetsFlags);
+			Node.Emotion = static_cast<EEmotionalState>(NodeRecord.Emotion);
+			Node.bIsEndNode = (NodeRecord.Flags & 1) != 0;
+
+			Node.Choices.Reserve(NodeRecord.Choices.Count);
+			for (const FCookedDialogueChoice& ChoiceRecord : GetChoices(NodeRecord))
+			{
+				FDialogueChoice& Choice = Node.Choices.AddDefaulted_GetRef();
+				Choice.ChoiceId = GetName(ChoiceRecord.ChoiceId);
+				Choice.DisplayText = GetText(ChoiceRecord.DisplayText);
+				Choice.NextNodeId = GetName(ChoiceRecord.NextNodeId);
+				Choice.RequiredEvidence = ToNames(ChoiceRecord.RequiredEvidence);
+				Choice.RequiredFlags = ToNames(ChoiceRecord.RequiredFlags);
+				Choice.SetsFlags = ToNames(ChoiceRecord.SetsFlags);
+				Choice.TrustDelta = ChoiceRecord.TrustDelta;
+				Choice.Tone = static_cast<EDialogueTone>(ChoiceRecord.Tone);
+			}
+		}
+	}
+
+	CaseData.AllDeductions.Reserve(Header.Deductions.Count);
+	for (const FCookedDeduction& Record : GetDeductions())
+	{
+		FDeduction& Deduction = CaseData.AllDeductions.AddDefaulted_GetRef();
+		Deduction.DeductionId = GetName(Record.DeductionId);
+		Deduction.Title = GetText(Record.Title);
+		Deduction.Description = GetText(Record.Description);
+		Deduction.EvidenceA = GetName(Record.EvidenceA);
+		Deduction.EvidenceB = GetName(Record.EvidenceB);
+		Deduction.PremiseDeductions = ToNames(Record.PremiseDeductions);
+		Deduction.PremiseEvidence = ToNames(Record.PremiseEvidence);
+		Deduction.UnlocksFlags = ToNames(Record.UnlocksFlags);
+		Deduction.UnlocksDialogue = ToNames(Record.UnlocksDialogue);
+		Deduction.bIsUnlocked = (Record.Flags & 1) != 0;
+	}
+
+	CaseData.CharacterSchedule.Reserve(Header.Schedule.Count);
+	for (const FCookedScheduleEntry& Record : GetSchedule())
+	{
+		FCharacterScheduleEntry& Entry = CaseData.CharacterSchedule.AddDefaulted_GetRef();
+		Entry.CharacterId = GetName(Record.CharacterId);
+		Entry.AtMinute = Record.AtMinute;
+		Entry.Location = static_cast<ELocation>(Record.Location);
+	}
+
+	CaseData.Triggers.Reserve(Header.Triggers.Count);
+	for (const FCookedTrigger& Record : GetTriggers())
+	{
+		FCaseTrigger& Trigger = CaseData.Triggers.AddDefaulted_GetRef();
+		Trigger.TriggerId = GetName(Record.TriggerId);
+		Trigger.RequiredFlags = ToNames(Record.RequiredFlags);
+		Trigger.RequiredEvidence = ToNames(Record.RequiredEvidence);
+		Trigger.RequiredDeductions = ToNames(Record.RequiredDeductions);
+
+		Trigger.TrustConditions.Reserve(Record.TrustConditions.Count);
+		for (const FCookedTrustCondition& ConditionRecord : GetTrustConditions(Record))
+		{
+			FTriggerTrustCondition& Condition = Trigger.TrustConditions.AddDefaulted_GetRef();
+			Condition.CharacterId = GetName(ConditionRecord.CharacterId);
+			Condition.MinTrust = ConditionRecord.MinTrust;
+			Condition.MaxTrust = ConditionRecord.MaxTrust;
+		}
+
+		Trigger.Actions.Reserve(Record.Actions.Count);
+		for (const FCookedTriggerAction& ActionRecord : GetActions(Record))
+		{
+			FTriggerAction& Action = Trigger.Actions.AddDefaulted_GetRef();
+			Action.Type = static_cast<ETriggerActionType>(ActionRecord.Type);
+			Action.Location = static_cast<ELocation>(ActionRecord.Location);
+			Action.bAccessible = (ActionRecord.Flags & 1) != 0;
+			Action.CharacterId = GetName(ActionRecord.CharacterId);
+			Action.EmotionalState = static_cast<EEmotionalState>(ActionRecord.EmotionalState);
+		}
+	}
+
+	return CaseData;
+}
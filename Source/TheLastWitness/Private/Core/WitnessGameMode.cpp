@@ -2,10 +2,17 @@
 
 #include "Core/WitnessGameMode.h"
 #include "Core/CaseState.h"
+#include "Core/CaseCatalog.h"
+#include "Core/CaseDefinition.h"
+#include "Core/WitnessIds.h"
+#include "Core/WitnessSaveGame.h"
 #include "Dialogue/DialogueManager.h"
 #include "AI/ABELSystem.h"
+#include "Data/CaseDataAsset.h"
 #include "Data/TheLastWitnessCaseData.h"
 #include "TheLastWitness.h"
+#include "Engine/GameInstance.h"
+#include "Kismet/GameplayStatics.h"
 
 AWitnessGameMode::AWitnessGameMode()
 {
@@ -24,12 +31,18 @@ void AWitnessGameMode::InitializeSubsystems()
 {
 	// CaseStateを作成
 	CaseState = NewObject<UCaseState>(this, UCaseState::StaticClass());
+	if (CaseState)
+	{
+		CaseState->SetChangeSetMode(bCoalesceCaseChanges);
+		CaseState->SetSnapshotPublishing(bPublishCaseSnapshots);
+	}
 
 	// DialogueManagerを作成
 	DialogueManager = NewObject<UDialogueManager>(this, UDialogueManager::StaticClass());
 	if (DialogueManager)
 	{
 		DialogueManager->Initialize(CaseState);
+		DialogueManager->OnDialogueEndedNative.AddUObject(this, &AWitnessGameMode::HandleDialogueEnded);
 	}
 
 	// ABELSystemを作成
@@ -46,17 +59,58 @@ void AWitnessGameMode::InitializeSubsystems()
 // ゲームサイクル
 // ============================================================================
 
-void AWitnessGameMode::StartCase()
+void AWitnessGameMode::StartCase(FName CaseId)
 {
-	// 事件データを作成
-	const FCaseData CaseData = CreateCaseData();
+	UCaseCatalog* Catalog = GetGameInstance() ? GetGameInstance()->GetSubsystem<UCaseCatalog>() : nullptr;
+
+	if (CaseId.IsNone())
+	{
+		// 読み込み中の事件があれば、その完了で上書きされないよう取り消す
+		if (Catalog)
+		{
+			Catalog->CancelPendingLoad();
+		}
+
+		// 事件データを作成し、読み取り専用の定義に変換（ムーブなのでコピーは発生しない）
+		BeginCase(FCaseDefinition::Create(CreateCaseData()));
+		return;
+	}
+
+	if (!Catalog || !Catalog->LoadCaseAsync(CaseId, FOnCaseDefinitionLoaded::CreateUObject(this, &AWitnessGameMode::HandleCaseLoaded)))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] 事件を読み込めません: %s"), *CaseId.ToString());
+	}
+}
 
+bool AWitnessGameMode::IsCaseLoading() const
+{
+	const UCaseCatalog* Catalog = GetGameInstance() ? GetGameInstance()->GetSubsystem<UCaseCatalog>() : nullptr;
+	return Catalog && Catalog->IsLoading();
+}
+
+void AWitnessGameMode::HandleCaseLoaded(TSharedPtr<const FCaseDefinition> Definition)
+{
+	if (!Definition.IsValid())
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] 事件の読み込みに失敗しました"));
+		return;
+	}
+
+	BeginCase(Definition.ToSharedRef());
+}
+
+void AWitnessGameMode::BeginCase(const TSharedRef<const FCaseDefinition>& Definition)
+{
 	// CaseStateを初期化
 	if (CaseState)
 	{
-		CaseState->InitializeCase(CaseData);
+		CaseState->InitializeFromDefinition(Definition);
 	}
 
+	// 前の事件のチェックポイントは使えない
+	Checkpoints.Empty();
+	UndoStack.Empty();
+
 	// DialogueManagerに対話ツリーを登録（CaseState初期化後）
 	if (DialogueManager && CaseState)
 	{
@@ -72,9 +126,10 @@ void AWitnessGameMode::StartCase()
 	// フェーズを事件紹介に変更
 	SetPhase(EGamePhase::CaseIntro);
 
+	OnCaseStartedNative.Broadcast();
 	OnCaseStarted.Broadcast();
 
-	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] 事件を開始しました: %s"), *CaseData.CaseId.ToString());
+	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] 事件を開始しました: %s"), *Definition->GetData().CaseId.ToString());
 }
 
 void AWitnessGameMode::SetPhase(EGamePhase NewPhase)
@@ -87,6 +142,7 @@ void AWitnessGameMode::SetPhase(EGamePhase NewPhase)
 		UE_LOG(LogLastWitness, Log, TEXT("[GameMode] フェーズ変更: %d -> %d"),
 			static_cast<int32>(OldPhase), static_cast<int32>(NewPhase));
 
+		OnPhaseChangedNative.Broadcast(NewPhase);
 		OnPhaseChanged.Broadcast(NewPhase);
 	}
 }
@@ -102,7 +158,13 @@ void AWitnessGameMode::TravelToLocation(ELocation Location)
 		return;
 	}
 
+	const ELocation PreviousLocation = CaseState->GetCurrentLocation();
 	CaseState->TravelToLocation(Location);
+	if (CaseState->GetCurrentLocation() != PreviousLocation)
+	{
+		// 到着時点の居場所で表示されるよう、移動の時間は到着後に進める
+		CaseState->AdvanceClock(TravelMinutes);
+	}
 	SetPhase(EGamePhase::Investigation);
 
 	// ABELに場所移動を通知
@@ -122,16 +184,16 @@ TArray<FName> AWitnessGameMode::GetAvailableActionsAtLocation() const
 	}
 
 	// 常に利用可能なアクション
-	Actions.Add(FName("Examine"));      // 調査
-	Actions.Add(FName("TalkTo"));       // 話しかける
-	Actions.Add(FName("ConsultABEL")); // ABELに相談
-	Actions.Add(FName("OpenJournal")); // 証拠帳を開く
-	Actions.Add(FName("Travel"));       // 移動
+	Actions.Add(FWitnessIds::Examine);     // 調査
+	Actions.Add(FWitnessIds::TalkTo);      // 話しかける
+	Actions.Add(FWitnessIds::ConsultABEL); // ABELに相談
+	Actions.Add(FWitnessIds::OpenJournal); // 証拠帳を開く
+	Actions.Add(FWitnessIds::Travel);      // 移動
 
 	// 告発可能な場合
 	if (CaseState->CanMakeAccusation())
 	{
-		Actions.Add(FName("Accuse"));
+		Actions.Add(FWitnessIds::Accuse);
 	}
 
 	return Actions;
@@ -151,34 +213,26 @@ TArray<FEvidence> AWitnessGameMode::GetExaminableEvidenceAtLocation() const
 	}
 
 	const ELocation CurrentLoc = CaseState->GetCurrentLocation();
-	FLocationData LocData;
-	if (!CaseState->GetLocationData(CurrentLoc, LocData))
-	{
-		return Result;
-	}
 
-	// この場所にある証拠を取得
-	for (const FName& EvidenceId : LocData.AvailableEvidence)
+	// 調べ尽くした場所では検索も行わない
+	if (CaseState->GetUncollectedEvidenceCountAt(CurrentLoc) == 0)
 	{
-		FEvidence Evidence;
-		if (CaseState->GetEvidenceById(EvidenceId, Evidence))
-		{
-			// まだ収集していない証拠のみ
-			if (!Evidence.bIsCollected)
-			{
-				Result.Add(Evidence);
-			}
-		}
+		return Result;
 	}
 
-	return Result;
+	// この場所にあり、まだ収集していない証拠のみ
+	return CaseState->QueryEvidence(FEvidenceQuery().At(CurrentLoc).WithCollected(EEvidenceStateFilter::No));
 }
 
 void AWitnessGameMode::ExamineEvidence(FName EvidenceId)
 {
 	if (CaseState)
 	{
-		CaseState->ExamineEvidence(EvidenceId);
+		// 調査済みの証拠や存在しない証拠では時間を進めない
+		if (CaseState->ExamineEvidence(EvidenceId))
+		{
+			CaseState->AdvanceClock(ExamineMinutes);
+		}
 
 		// ABELに証拠調査を通知
 		if (ABELSystem)
@@ -194,19 +248,10 @@ void AWitnessGameMode::ExamineEvidence(FName EvidenceId)
 
 void AWitnessGameMode::CollectEvidence(FName EvidenceId)
 {
+	// ABELへの通知は CaseState のネイティブイベント経由で行われる
 	if (CaseState)
 	{
 		CaseState->CollectEvidence(EvidenceId);
-
-		// ABELに証拠収集を通知
-		if (ABELSystem)
-		{
-			FEvidence Evidence;
-			if (CaseState->GetEvidenceById(EvidenceId, Evidence))
-			{
-				ABELSystem->OnEvidenceCollected(Evidence);
-			}
-		}
 	}
 }
 
@@ -216,30 +261,13 @@ void AWitnessGameMode::CollectEvidence(FName EvidenceId)
 
 TArray<FCharacterData> AWitnessGameMode::GetCharactersAtLocation() const
 {
-	TArray<FCharacterData> Result;
-
 	if (!CaseState)
 	{
-		return Result;
-	}
-
-	const ELocation CurrentLoc = CaseState->GetCurrentLocation();
-	FLocationData LocData;
-	if (!CaseState->GetLocationData(CurrentLoc, LocData))
-	{
-		return Result;
-	}
-
-	for (const FName& CharId : LocData.CharactersPresent)
-	{
-		FCharacterData Character;
-		if (CaseState->GetCharacterById(CharId, Character))
-		{
-			Result.Add(Character);
-		}
+		return TArray<FCharacterData>();
 	}
 
-	return Result;
+	// 予定に従って移動した後の居場所で絞り込む
+	return CaseState->GetCharactersAtLocation(CaseState->GetCurrentLocation());
 }
 
 void AWitnessGameMode::StartDialogueWith(FName CharacterId)
@@ -249,9 +277,19 @@ void AWitnessGameMode::StartDialogueWith(FName CharacterId)
 		return;
 	}
 
-	DialogueManager->StartDialogue(CharacterId);
+	// 対話が始まらなかった場合はフェーズも時間も変えない
+	if (!DialogueManager->StartDialogue(CharacterId))
+	{
+		return;
+	}
 	SetPhase(EGamePhase::Dialogue);
 
+	// 対話中に相手が移動しても対話は続けられる
+	if (CaseState)
+	{
+		CaseState->AdvanceClock(DialogueMinutes);
+	}
+
 	// ABELに対話開始を通知
 	if (ABELSystem)
 	{
@@ -263,7 +301,12 @@ void AWitnessGameMode::SelectDialogueChoice(FName ChoiceId)
 {
 	if (DialogueManager)
 	{
-		DialogueManager->SelectChoice(ChoiceId);
+		// 選べなかった選択肢で何も変わらない取り消し履歴を積まないよう、成功した場合だけ積む
+		FGameCheckpoint Checkpoint = CaptureCheckpoint();
+		if (DialogueManager->SelectChoice(ChoiceId))
+		{
+			PushUndo(MoveTemp(Checkpoint));
+		}
 	}
 }
 
@@ -277,6 +320,15 @@ void AWitnessGameMode::EndDialogue()
 	SetPhase(EGamePhase::Investigation);
 }
 
+void AWitnessGameMode::HandleDialogueEnded()
+{
+	// 終了ノード等で対話が終わった場合も調査フェーズに戻す
+	if (CurrentPhase == EGamePhase::Dialogue)
+	{
+		SetPhase(EGamePhase::Investigation);
+	}
+}
+
 // ============================================================================
 // ABEL操作
 // ============================================================================
@@ -334,8 +386,17 @@ bool AWitnessGameMode::TryMakeDeduction(FName EvidenceA, FName EvidenceB, FDeduc
 		return false;
 	}
 
+	FGameCheckpoint BeforeDeduction = CaptureCheckpoint();
+	const int32 UnlockedBefore = CaseState->GetUnlockedDeductionCount();
+
 	const bool bSuccess = CaseState->TryDeduction(EvidenceA, EvidenceB, OutDeduction);
 
+	// 新たに解放された場合のみ取り消し対象にする
+	if (CaseState->GetUnlockedDeductionCount() > UnlockedBefore)
+	{
+		PushUndo(MoveTemp(BeforeDeduction));
+	}
+
 	if (bSuccess && ABELSystem)
 	{
 		ABELSystem->OnDeductionMade(OutDeduction);
@@ -363,18 +424,268 @@ void AWitnessGameMode::AccuseCharacter(FName CharacterId)
 	const FGameResult Result = CaseState->MakeAccusation(CharacterId);
 
 	SetPhase(EGamePhase::Resolution);
+	OnGameEndedNative.Broadcast(Result);
 	OnGameEnded.Broadcast(Result);
 
 	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] ゲーム終了 - 正解: %s"),
 		Result.bCorrectCulprit ? TEXT("はい") : TEXT("いいえ"));
 }
 
+// ============================================================================
+// チェックポイント / 取り消し
+// ============================================================================
+
+int32 AWitnessGameMode::CreateCheckpoint()
+{
+	const int32 CheckpointId = NextCheckpointId++;
+	Checkpoints.Add(CheckpointId, CaptureCheckpoint());
+
+	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] チェックポイントを作成しました: %d"), CheckpointId);
+	return CheckpointId;
+}
+
+bool AWitnessGameMode::RestoreCheckpoint(int32 CheckpointId)
+{
+	const FGameCheckpoint* Checkpoint = Checkpoints.Find(CheckpointId);
+	if (!Checkpoint)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] チェックポイントが見つかりません: %d"), CheckpointId);
+		return false;
+	}
+
+	// 復元後の操作は別の分岐になるため、取り消し履歴は破棄する
+	UndoStack.Reset();
+	return ApplyCheckpoint(*Checkpoint);
+}
+
+void AWitnessGameMode::DiscardCheckpoint(int32 CheckpointId)
+{
+	Checkpoints.Remove(CheckpointId);
+}
+
+bool AWitnessGameMode::UndoLastAction()
+{
+	if (UndoStack.Num() == 0)
+	{
+		return false;
+	}
+
+	const FGameCheckpoint Checkpoint = UndoStack.Pop(EAllowShrinking::No);
+	return ApplyCheckpoint(Checkpoint);
+}
+
+FGameCheckpoint AWitnessGameMode::CaptureCheckpoint() const
+{
+	FGameCheckpoint Checkpoint;
+	if (CaseState)
+	{
+		Checkpoint.Progress = CaseState->CaptureProgress();
+	}
+	if (DialogueManager)
+	{
+		Checkpoint.Dialogue = DialogueManager->GetPosition();
+	}
+	Checkpoint.Phase = CurrentPhase;
+	return Checkpoint;
+}
+
+bool AWitnessGameMode::ApplyCheckpoint(const FGameCheckpoint& Checkpoint)
+{
+	if (!CaseState || !CaseState->RestoreProgress(Checkpoint.Progress))
+	{
+		return false;
+	}
+
+	if (DialogueManager)
+	{
+		DialogueManager->RestorePosition(Checkpoint.Dialogue);
+	}
+
+	SetPhase(Checkpoint.Phase);
+
+	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] チェックポイントを復元しました"));
+	return true;
+}
+
+void AWitnessGameMode::PushUndo(FGameCheckpoint&& Checkpoint)
+{
+	if (UndoStack.Num() >= MaxUndoDepth)
+	{
+		UndoStack.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+	UndoStack.Add(MoveTemp(Checkpoint));
+}
+
+// ============================================================================
+// セーブ / ロード
+// ============================================================================
+
+bool AWitnessGameMode::SaveGameToSlot(const FString& SlotName, int32 UserIndex)
+{
+	UWitnessSaveGame* SaveGame = CreateSaveGame();
+	if (!SaveGame)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] 事件が開始されていないため保存できません"));
+		return false;
+	}
+
+	PendingSaveCount++;
+	UGameplayStatics::AsyncSaveGameToSlot(SaveGame, SlotName, UserIndex,
+		FAsyncSaveGameToSlotDelegate::CreateUObject(this, &AWitnessGameMode::HandleSaveCompleted));
+	return true;
+}
+
+void AWitnessGameMode::LoadGameFromSlot(const FString& SlotName, int32 UserIndex)
+{
+	UGameplayStatics::AsyncLoadGameFromSlot(SlotName, UserIndex,
+		FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &AWitnessGameMode::HandleLoadCompleted));
+}
+
+UWitnessSaveGame* AWitnessGameMode::CreateSaveGame() const
+{
+	if (!CaseState || !CaseState->GetDefinition().IsValid())
+	{
+		return nullptr;
+	}
+
+	UWitnessSaveGame* SaveGame = Cast<UWitnessSaveGame>(UGameplayStatics::CreateSaveGameObject(UWitnessSaveGame::StaticClass()));
+	if (!SaveGame)
+	{
+		return nullptr;
+	}
+
+	SaveGame->CaseId = CaseState->GetDefinition()->GetData().CaseId;
+	SaveGame->ProgressData = CaseState->SaveProgressToBytes();
+	SaveGame->Phase = CurrentPhase;
+	if (DialogueManager)
+	{
+		const FDialoguePosition Position = DialogueManager->GetPosition();
+		SaveGame->DialogueCharacterId = Position.CharacterId;
+		SaveGame->DialogueNodeId = Position.NodeId;
+	}
+	if (ABELSystem)
+	{
+		SaveGame->ABELRelationshipValue = ABELSystem->GetRelationshipValue();
+	}
+	SaveGame->SavedAt = FDateTime::UtcNow();
+	return SaveGame;
+}
+
+bool AWitnessGameMode::ApplySaveGame(const UWitnessSaveGame& SaveGame)
+{
+	if (SaveGame.Version > UWitnessSaveGame::CurrentVersion)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] 新しい形式のセーブデータは読み込めません: %d"), SaveGame.Version);
+		return false;
+	}
+
+	if (!CaseState)
+	{
+		return false;
+	}
+
+	// 読み込み中の事件があると、完了時に読み込んだ進行状態が上書きされてしまう
+	UCaseCatalog* Catalog = GetGameInstance() ? GetGameInstance()->GetSubsystem<UCaseCatalog>() : nullptr;
+	if (Catalog)
+	{
+		Catalog->CancelPendingLoad();
+	}
+
+	// メインメニューや別の事件からのロードでは、セーブデータの事件定義を用意する
+	const TSharedPtr<const FCaseDefinition> CurrentDefinition = CaseState->GetDefinition();
+	TSharedPtr<const FCaseDefinition> Definition = CurrentDefinition;
+	if (!Definition.IsValid() || Definition->GetData().CaseId != SaveGame.CaseId)
+	{
+		// カタログにある事件はその場で読み込む（進行状態を続けて適用するため非同期にはしない）
+		Definition = Catalog ? Catalog->LoadCaseSynchronous(SaveGame.CaseId) : nullptr;
+		if (!Definition.IsValid())
+		{
+			FCaseData CaseData = CreateCaseData();
+			if (CaseData.CaseId != SaveGame.CaseId)
+			{
+				// マウントされていないDLCの事件など
+				UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] セーブデータの事件が見つかりません: %s"), *SaveGame.CaseId.ToString());
+				return false;
+			}
+			Definition = FCaseDefinition::Create(MoveTemp(CaseData));
+		}
+	}
+
+	// 壊れたセーブデータで進行中の事件を失わないよう、事件を切り替える前に検証する
+	FCaseProgress Decoded;
+	if (!UCaseState::DecodeProgressFromBytes(SaveGame.ProgressData, *Definition, Decoded))
+	{
+		return false;
+	}
+
+	if (Definition != CurrentDefinition)
+	{
+		BeginCase(Definition.ToSharedRef());
+	}
+
+	if (!CaseState->ApplyLoadedProgress(MoveTemp(Decoded)))
+	{
+		return false;
+	}
+
+	// 読み込み前の状態に戻すチェックポイントは意味を持たない
+	Checkpoints.Empty();
+	UndoStack.Empty();
+
+	if (DialogueManager)
+	{
+		FDialoguePosition Position;
+		Position.CharacterId = SaveGame.DialogueCharacterId;
+		Position.NodeId = SaveGame.DialogueNodeId;
+		DialogueManager->RestorePosition(Position);
+	}
+
+	if (ABELSystem)
+	{
+		ABELSystem->RestoreRelationshipValue(SaveGame.ABELRelationshipValue);
+	}
+
+	SetPhase(SaveGame.Phase);
+	return true;
+}
+
+void AWitnessGameMode::HandleSaveCompleted(const FString& SlotName, const int32 UserIndex, bool bSuccess)
+{
+	PendingSaveCount--;
+
+	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] セーブ%s: %s"), bSuccess ? TEXT("完了") : TEXT("失敗"), *SlotName);
+
+	OnGameSavedNative.Broadcast(SlotName, bSuccess);
+	OnGameSaved.Broadcast(SlotName, bSuccess);
+}
+
+void AWitnessGameMode::HandleLoadCompleted(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedGame)
+{
+	const UWitnessSaveGame* SaveGame = Cast<UWitnessSaveGame>(LoadedGame);
+	const bool bSuccess = SaveGame && ApplySaveGame(*SaveGame);
+
+	UE_LOG(LogLastWitness, Log, TEXT("[GameMode] ロード%s: %s"), bSuccess ? TEXT("完了") : TEXT("失敗"), *SlotName);
+
+	OnGameLoadedNative.Broadcast(SlotName, bSuccess);
+	OnGameLoaded.Broadcast(SlotName, bSuccess);
+}
+
 // ============================================================================
 // 事件データ作成（デフォルト実装）
 // ============================================================================
 
 FCaseData AWitnessGameMode::CreateCaseData_Implementation()
 {
-	// TheLastWitnessCaseDataから事件データを取得
-	return UTheLastWitnessCaseData::CreateCaseData();
+	// インポート済みのアセットがあればそれを使う
+	if (!CaseAsset.IsNull())
+	{
+		if (const UCaseDataAsset* Asset = CaseAsset.LoadSynchronous())
+		{
+			return Asset->CaseData;
+		}
+		UE_LOG(LogLastWitness, Warning, TEXT("[GameMode] 事件データアセットを読み込めません: %s"), *CaseAsset.ToString());
+	}
+
+	// TheLastWitnessCaseDataから事件データを取得（クック済みファイルを優先）
+	return UTheLastWitnessCaseData::LoadCaseData();
 }
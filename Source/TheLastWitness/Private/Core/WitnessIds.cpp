@@ -0,0 +1,14 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Core/WitnessIds.h"
+
+#define WITNESS_ID(Name) FName FWitnessIds::Name;
+#include "Core/WitnessIds.inl"
+#undef WITNESS_ID
+
+void FWitnessIds::Initialize()
+{
+#define WITNESS_ID(Name) Name = FName(TEXT(#Name));
+#include "Core/WitnessIds.inl"
+#undef WITNESS_ID
+}
@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/CaseDataAsset.h"
+
+#include "Internationalization/TextStringHelper.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
+const FPrimaryAssetType UCaseDataAsset::PrimaryAssetType(TEXT("Case"));
+const FName UCaseDataAsset::TitleTag(TEXT("CaseTitle"));
+const FName UCaseDataAsset::SynopsisTag(TEXT("CaseSynopsis"));
+const FName UCaseDataAsset::NumCharactersTag(TEXT("NumCharacters"));
+const FName UCaseDataAsset::NumEvidenceTag(TEXT("NumEvidence"));
+const FName UCaseDataAsset::NumDeductionsTag(TEXT("NumDeductions"));
+
+FPrimaryAssetId UCaseDataAsset::GetPrimaryAssetId() const
+{
+	// 事件IDをそのままアセット名として使い、アセットの名前を変えても同じ事件として扱う
+	return FPrimaryAssetId(PrimaryAssetType, CaseData.CaseId.IsNone() ? GetFName() : CaseData.CaseId);
+}
+
+void UCaseDataAsset::GetAssetRegistryTags(FAssetRegistryTagsContext Context) const
+{
+	Super::GetAssetRegistryTags(Context);
+
+	// テキストはローカライズ情報ごと書き出す（ToString() だとクック時の言語に固定される）
+	FString TitleBuffer;
+	FTextStringHelper::WriteToBuffer(TitleBuffer, CaseData.Title);
+	FString SynopsisBuffer;
+	FTextStringHelper::WriteToBuffer(SynopsisBuffer, CaseData.Synopsis);
+
+	Context.AddTag(FAssetRegistryTag(TitleTag, TitleBuffer, FAssetRegistryTag::TT_Alphabetical));
+	Context.AddTag(FAssetRegistryTag(SynopsisTag, SynopsisBuffer, FAssetRegistryTag::TT_Alphabetical));
+	Context.AddTag(FAssetRegistryTag(NumCharactersTag, LexToString(CaseData.AllCharacters.Num()), FAssetRegistryTag::TT_Numerical));
+	Context.AddTag(FAssetRegistryTag(NumEvidenceTag, LexToString(CaseData.AllEvidence.Num()), FAssetRegistryTag::TT_Numerical));
+	Context.AddTag(FAssetRegistryTag(NumDeductionsTag, LexToString(CaseData.AllDeductions.Num()), FAssetRegistryTag::TT_Numerical));
+}
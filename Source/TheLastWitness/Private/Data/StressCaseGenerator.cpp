@@ -0,0 +1,336 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Data/StressCaseGenerator.h"
+
+namespace
+{
+	/// <summary>
+	/// 証拠・キャラクターを置くロケーション（探偵事務所には置かない）
+	/// </summary>
+	const ELocation StressLocations[] =
+	{
+		ELocation::Study,
+		ELocation::DrawingRoom,
+		ELocation::ServantsQuarters,
+		ELocation::Garden,
+		ELocation::Factory,
+		ELocation::Pub
+	};
+
+	FName MakeId(const TCHAR* Prefix, int32 Index)
+	{
+		return FName(Prefix, Index + 1);
+	}
+
+	/// <summary>
+	/// 平均 Density 個になるように個数を決めます（整数部 + 小数部の確率で1つ追加）
+	/// </summary>
+	int32 RollCount(FRandomStream& Random, float Density)
+	{
+		const int32 Whole = FMath::FloorToInt(Density);
+		return Whole + (Random.FRand() < Density - Whole ? 1 : 0);
+	}
+}
+
+FStressCaseParams UStressCaseGenerator::MakeScaledParams(int32 Scale, int32 Seed)
+{
+	Scale = FMath::Max(Scale, 1);
+
+	FStressCaseParams Params;
+	Params.Seed = Seed;
+	Params.NumCharacters *= Scale;
+	Params.NumEvidence *= Scale;
+	Params.NumDialogueTrees *= Scale;
+	Params.NumDeductions *= Scale;
+	Params.NumTriggers *= Scale;
+	return Params;
+}
+
+FCaseData UStressCaseGenerator::Generate(const FStressCaseParams& Params)
+{
+	FRandomStream Random(Params.Seed);
+
+	const int32 NumCharacters = FMath::Max(Params.NumCharacters, 2);
+	const int32 NumEvidence = FMath::Max(Params.NumEvidence, 2);
+	const int32 NumTrees = FMath::Clamp(Params.NumDialogueTrees, 0, NumCharacters - 1);
+	const int32 Depth = FMath::Max(Params.DialogueDepth, 1);
+	const int32 Width = FMath::Max(Params.DialogueWidth, 1);
+	const int32 NumLocations = UE_ARRAY_COUNT(StressLocations);
+
+	FCaseData CaseData;
+	CaseData.CaseId = FName(*FString::Printf(TEXT("Stress_%d"), Params.Seed));
+	CaseData.Title = FText::FromString(FString::Printf(TEXT("負荷試験 (シード %d)"), Params.Seed));
+	CaseData.Synopsis = FText::FromString(FString::Printf(TEXT("キャラクター %d 人、証拠 %d 件、対話 %d 本、推理 %d 件"),
+		NumCharacters, NumEvidence, NumTrees, Params.NumDeductions));
+
+	// ========================================================================
+	// ロケーション
+	// ========================================================================
+
+	CaseData.AllLocations.Reserve(NumLocations + 1);
+	for (const ELocation Location : StressLocations)
+	{
+		FLocationData& Data = CaseData.AllLocations.AddDefaulted_GetRef();
+		Data.Location = Location;
+		Data.DisplayName = UEnum::GetDisplayValueAsText(Location);
+	}
+	{
+		FLocationData& Office = CaseData.AllLocations.AddDefaulted_GetRef();
+		Office.Location = ELocation::Office;
+		Office.DisplayName = FText::FromString(TEXT("探偵事務所"));
+	}
+
+	// ========================================================================
+	// キャラクター（0 が被害者、1 が真犯人）
+	// ========================================================================
+
+	CaseData.AllCharacters.Reserve(NumCharacters);
+	for (int32 i = 0; i < NumCharacters; i++)
+	{
+		FCharacterData& Character = CaseData.AllCharacters.AddDefaulted_GetRef();
+		Character.CharacterId = MakeId(TEXT("Stress_Character"), i);
+		Character.DisplayName = FText::FromString(FString::Printf(TEXT("人物 %d"), i + 1));
+		Character.TrustLevel = Random.RandRange(20, 80);
+		Character.bIsSuspect = i != 0;
+
+		const int32 LocationIndex = Random.RandHelper(NumLocations);
+		Character.CurrentLocation = StressLocations[LocationIndex];
+		if (i != 0)
+		{
+			CaseData.AllLocations[LocationIndex].CharactersPresent.Add(Character.CharacterId);
+		}
+	}
+	CaseData.VictimId = CaseData.AllCharacters[0].CharacterId;
+	CaseData.TrueCulpritId = CaseData.AllCharacters[1].CharacterId;
+
+	// ========================================================================
+	// 証拠
+	// ========================================================================
+
+	CaseData.AllEvidence.Reserve(NumEvidence);
+	for (int32 i = 0; i < NumEvidence; i++)
+	{
+		FEvidence& Evidence = CaseData.AllEvidence.AddDefaulted_GetRef();
+		Evidence.EvidenceId = MakeId(TEXT("Stress_Evidence"), i);
+		Evidence.DisplayName = FText::FromString(FString::Printf(TEXT("証拠 %d"), i + 1));
+		Evidence.Type = static_cast<EEvidenceType>(Random.RandHelper(static_cast<int32>(EEvidenceType::Observation) + 1));
+		Evidence.Importance = static_cast<EEvidenceImportance>(Random.RandHelper(static_cast<int32>(EEvidenceImportance::Critical) + 1));
+
+		const int32 LocationIndex = Random.RandHelper(NumLocations);
+		Evidence.FoundAt = StressLocations[LocationIndex];
+		CaseData.AllLocations[LocationIndex].AvailableEvidence.Add(Evidence.EvidenceId);
+
+		for (int32 Count = RollCount(Random, Params.RelationDensity); Count > 0; Count--)
+		{
+			if (Random.FRand() < 0.5f)
+			{
+				Evidence.RelatedCharacters.AddUnique(MakeId(TEXT("Stress_Character"), Random.RandHelper(NumCharacters)));
+			}
+			else
+			{
+				const int32 Other = Random.RandHelper(NumEvidence);
+				if (Other != i)
+				{
+					Evidence.RelatedEvidence.AddUnique(MakeId(TEXT("Stress_Evidence"), Other));
+				}
+			}
+		}
+	}
+
+	// 告発条件（全ての証拠はアクセス可能なロケーションにあるので必ず満たせる）
+	const int32 NumRequired = FMath::Min(3, NumEvidence);
+	while (CaseData.RequiredEvidenceForAccusation.Num() < NumRequired)
+	{
+		CaseData.RequiredEvidenceForAccusation.AddUnique(MakeId(TEXT("Stress_Evidence"), Random.RandHelper(NumEvidence)));
+	}
+
+	// ========================================================================
+	// 対話
+	// ========================================================================
+
+	// 選択肢が要求するフラグは、それより前に生成したノードが設定するものから選ぶ
+	TArray<FName> ProducedFlags;
+	int32 NextFlag = 0;
+
+	CaseData.AllDialogues.Reserve(NumTrees);
+	for (int32 TreeIndex = 0; TreeIndex < NumTrees; TreeIndex++)
+	{
+		const FName CharacterId = MakeId(TEXT("Stress_Character"), TreeIndex + 1);
+
+		FDialogueTree& Tree = CaseData.AllDialogues.AddDefaulted_GetRef();
+		Tree.TreeId = MakeId(TEXT("Stress_Tree"), TreeIndex);
+		Tree.CharacterId = CharacterId;
+		Tree.StartNodeId = MakeId(TEXT("Node"), 0);
+
+		// 段 0 は開始ノードのみ、以降の段は Width 個のノード
+		auto GetNodeIndex = [Width](int32 Level, int32 Column) { return Level == 0 ? 0 : 1 + (Level - 1) * Width + Column; };
+		Tree.Nodes.Reserve(1 + (Depth - 1) * Width);
+
+		for (int32 Level = 0; Level < Depth; Level++)
+		{
+			const int32 NumColumns = Level == 0 ? 1 : Width;
+			const bool bLastLevel = Level == Depth - 1;
+
+			for (int32 Column = 0; Column < NumColumns; Column++)
+			{
+				FDialogueNode& Node = Tree.Nodes.AddDefaulted_GetRef();
+				Node.NodeId = MakeId(TEXT("Node"), GetNodeIndex(Level, Column));
+				Node.SpeakerId = CharacterId;
+				Node.Text = FText::FromString(FString::Printf(TEXT("対話 %d の %d 段目 %d"), TreeIndex + 1, Level + 1, Column + 1));
+				Node.Emotion = static_cast<EEmotionalState>(Random.RandHelper(static_cast<int32>(EEmotionalState::Cooperative) + 1));
+				Node.bIsEndNode = bLastLevel;
+
+				if (Random.FRand() < Params.FlagDensity)
+				{
+					const FName Flag = MakeId(TEXT("Stress_Flag"), NextFlag++);
+					Node.SetsFlags.Add(Flag);
+					ProducedFlags.Add(Flag);
+				}
+				if (Random.FRand() < Params.FlagDensity * 0.5f)
+				{
+					Node.GainsEvidence.Add(MakeId(TEXT("Stress_Evidence"), Random.RandHelper(NumEvidence)));
+				}
+
+				if (bLastLevel)
+				{
+					continue;
+				}
+
+				// 開始ノードからは次の段の全ノードへ条件なしで進める
+				const bool bStartNode = Level == 0;
+				const int32 NumChoices = bStartNode ? Width : Random.RandRange(1, Width);
+				const int32 FirstTarget = Random.RandHelper(Width);
+				for (int32 ChoiceIndex = 0; ChoiceIndex < NumChoices; ChoiceIndex++)
+				{
+					FDialogueChoice& Choice = Node.Choices.AddDefaulted_GetRef();
+					Choice.ChoiceId = MakeId(TEXT("Choice"), ChoiceIndex);
+					Choice.DisplayText = FText::FromString(FString::Printf(TEXT("選択肢 %d"), ChoiceIndex + 1));
+					Choice.Tone = static_cast<EDialogueTone>(Random.RandHelper(static_cast<int32>(EDialogueTone::Cunning) + 1));
+					Choice.TrustDelta = Random.RandRange(-5, 5);
+
+					// 最初の選択肢は条件なしで次の段の同じ列に進むので、どの列も最後の段まで辿れる
+					const int32 TargetColumn = bStartNode ? ChoiceIndex : ChoiceIndex == 0 ? Column : (FirstTarget + ChoiceIndex) % Width;
+					Choice.NextNodeId = MakeId(TEXT("Node"), GetNodeIndex(Level + 1, TargetColumn));
+					if (bStartNode || ChoiceIndex == 0)
+					{
+						continue;
+					}
+
+					if (Random.FRand() < Params.FlagDensity)
+					{
+						if (ProducedFlags.Num() > 0 && Random.FRand() < 0.5f)
+						{
+							Choice.RequiredFlags.Add(ProducedFlags[Random.RandHelper(ProducedFlags.Num())]);
+						}
+						else
+						{
+							Choice.RequiredEvidence.Add(MakeId(TEXT("Stress_Evidence"), Random.RandHelper(NumEvidence)));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// ========================================================================
+	// 推理（前半は証拠の組み合わせ、後半は前の推理から導かれるもの）
+	// ========================================================================
+
+	const int32 NumDeductions = FMath::Max(Params.NumDeductions, 0);
+	const int32 NumPairDeductions = NumDeductions - NumDeductions / 2;
+	TSet<uint64> UsedPairs;
+
+	CaseData.AllDeductions.Reserve(NumDeductions);
+	for (int32 i = 0; i < NumDeductions; i++)
+	{
+		FDeduction Deduction;
+		Deduction.DeductionId = MakeId(TEXT("Stress_Deduction"), i);
+		Deduction.Title = FText::FromString(FString::Printf(TEXT("推理 %d"), i + 1));
+		Deduction.UnlocksFlags.Add(MakeId(TEXT("Stress_DeductionFlag"), i));
+
+		if (i < NumPairDeductions)
+		{
+			// 同じ証拠の組は1つの推理にしか使えないので、空きが見つからなければ打ち切る
+			bool bFound = false;
+			for (int32 Attempt = 0; Attempt < 16 && !bFound; Attempt++)
+			{
+				const int32 A = Random.RandHelper(NumEvidence);
+				const int32 B = Random.RandHelper(NumEvidence);
+				const uint64 PairKey = (static_cast<uint64>(FMath::Min(A, B)) << 32) | static_cast<uint32>(FMath::Max(A, B));
+				if (A != B && !UsedPairs.Contains(PairKey))
+				{
+					UsedPairs.Add(PairKey);
+					Deduction.EvidenceA = MakeId(TEXT("Stress_Evidence"), A);
+					Deduction.EvidenceB = MakeId(TEXT("Stress_Evidence"), B);
+					bFound = true;
+				}
+			}
+			if (!bFound)
+			{
+				continue;
+			}
+		}
+		else
+		{
+			// 前提は自分より前の推理だけから選ぶので循環しない
+			const int32 NumPremises = FMath::Min(Random.RandRange(2, 3), CaseData.AllDeductions.Num());
+			if (NumPremises == 0)
+			{
+				continue;
+			}
+			while (Deduction.PremiseDeductions.Num() < NumPremises)
+			{
+				Deduction.PremiseDeductions.AddUnique(CaseData.AllDeductions[Random.RandHelper(CaseData.AllDeductions.Num())].DeductionId);
+			}
+		}
+
+		CaseData.AllDeductions.Add(MoveTemp(Deduction));
+	}
+
+	// ========================================================================
+	// 移動予定・トリガー
+	// ========================================================================
+
+	for (int32 CharacterIndex = 1; CharacterIndex < NumCharacters; CharacterIndex++)
+	{
+		int32 Minute = 0;
+		for (int32 Entry = 0; Entry < Params.ScheduleEntriesPerCharacter; Entry++)
+		{
+			Minute += Random.RandRange(15, 120);
+			FCharacterScheduleEntry& Schedule = CaseData.CharacterSchedule.AddDefaulted_GetRef();
+			Schedule.CharacterId = MakeId(TEXT("Stress_Character"), CharacterIndex);
+			Schedule.AtMinute = Minute;
+			Schedule.Location = StressLocations[Random.RandHelper(NumLocations)];
+		}
+	}
+
+	CaseData.Triggers.Reserve(Params.NumTriggers);
+	for (int32 i = 0; i < Params.NumTriggers; i++)
+	{
+		FCaseTrigger& Trigger = CaseData.Triggers.AddDefaulted_GetRef();
+		Trigger.TriggerId = MakeId(TEXT("Stress_Trigger"), i);
+		if (CaseData.AllDeductions.Num() > 0 && Random.FRand() < 0.5f)
+		{
+			Trigger.RequiredDeductions.Add(CaseData.AllDeductions[Random.RandHelper(CaseData.AllDeductions.Num())].DeductionId);
+		}
+		else
+		{
+			Trigger.RequiredEvidence.Add(MakeId(TEXT("Stress_Evidence"), Random.RandHelper(NumEvidence)));
+		}
+
+		FTriggerAction& Action = Trigger.Actions.AddDefaulted_GetRef();
+		Action.CharacterId = MakeId(TEXT("Stress_Character"), 1 + Random.RandHelper(NumCharacters - 1));
+		if (Random.FRand() < 0.5f)
+		{
+			Action.Type = ETriggerActionType::SetEmotionalState;
+			Action.EmotionalState = static_cast<EEmotionalState>(Random.RandHelper(static_cast<int32>(EEmotionalState::Cooperative) + 1));
+		}
+		else
+		{
+			Action.Type = ETriggerActionType::MoveCharacter;
+			Action.Location = StressLocations[Random.RandHelper(NumLocations)];
+		}
+	}
+
+	return CaseData;
+}
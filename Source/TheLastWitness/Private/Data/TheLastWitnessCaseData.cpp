@@ -1,12 +1,38 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Data/TheLastWitnessCaseData.h"
+#include "Core/CookedCase.h"
+#include "Core/WitnessIds.h"
+#include "TheLastWitness.h"
+
+FCaseData UTheLastWitnessCaseData::LoadCaseData()
+{
+	const FString Path = FCookedCase::GetCookedPath(FWitnessIds::TheLastWitness);
+	if (const TSharedPtr<const FCookedCase> Cooked = FCookedCase::Open(Path))
+	{
+		// CreateCaseData() を変更したのにクックし直していない場合は、古いデータを使わずにコードから作成する
+		if (Cooked->GetSourceHash() != GetSourceHash())
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[CaseData] クック済みの事件データが古いため、コードから作成します（CaseCook を実行し直してください）: %s"), *Path);
+			return CreateCaseData();
+		}
+		return Cooked->ToCaseData();
+	}
+
+	UE_LOG(LogLastWitness, Log, TEXT("[CaseData] クック済みの事件データが無いため、コードから作成します"));
+	return CreateCaseData();
+}
+
+uint32 UTheLastWitnessCaseData::GetSourceHash()
+{
+	return THELASTWITNESS_CASE_SOURCE_HASH;
+}
 
 FCaseData UTheLastWitnessCaseData::CreateCaseData()
 {
 	FCaseData CaseData;
 
-	CaseData.CaseId = FName("TheLastWitness");
+	CaseData.CaseId = FWitnessIds::TheLastWitness;
 	CaseData.Title = FText::FromString(TEXT("最後の目撃者"));
 	CaseData.Synopsis = FText::FromString(TEXT(
 		"1888年11月、ロンドン。\n\n"
@@ -18,19 +44,21 @@ FCaseData UTheLastWitnessCaseData::CreateCaseData()
 		"分析エンジン「ABEL」と共に、霧のロンドンに潜む真実を暴け。"
 	));
 
-	CaseData.VictimId = FName("HenryBlackwood");
-	CaseData.TrueCulpritId = FName("EdwardBlackwood");
+	CaseData.VictimId = FWitnessIds::HenryBlackwood;
+	CaseData.TrueCulpritId = FWitnessIds::EdwardBlackwood;
 
 	CaseData.AllCharacters = CreateCharacters();
 	CaseData.AllEvidence = CreateEvidence();
 	CaseData.AllLocations = CreateLocations();
 	CaseData.AllDialogues = CreateDialogues();
 	CaseData.AllDeductions = CreateDeductions();
+	CaseData.CharacterSchedule = CreateCharacterSchedule();
+	CaseData.Triggers = CreateTriggers();
 
 	// 告発に必要な証拠
-	CaseData.RequiredEvidenceForAccusation.Add(FName("Evidence_TornLetter"));
-	CaseData.RequiredEvidenceForAccusation.Add(FName("Evidence_FinancialRecords"));
-	CaseData.RequiredEvidenceForAccusation.Add(FName("Evidence_SecondGunpowder"));
+	CaseData.RequiredEvidenceForAccusation.Add(FWitnessIds::Evidence_TornLetter);
+	CaseData.RequiredEvidenceForAccusation.Add(FWitnessIds::Evidence_FinancialRecords);
+	CaseData.RequiredEvidenceForAccusation.Add(FWitnessIds::Evidence_SecondGunpowder);
 
 	return CaseData;
 }
@@ -42,7 +70,7 @@ TArray<FCharacterData> UTheLastWitnessCaseData::CreateCharacters()
 	// 被害者: ヘンリー・ブラックウッド
 	{
 		FCharacterData C;
-		C.CharacterId = FName("HenryBlackwood");
+		C.CharacterId = FWitnessIds::HenryBlackwood;
 		C.DisplayName = FText::FromString(TEXT("ヘンリー・ブラックウッド卿"));
 		C.Role = FText::FromString(TEXT("被害者 / 実業家"));
 		C.Description = FText::FromString(TEXT(
@@ -59,7 +87,7 @@ TArray<FCharacterData> UTheLastWitnessCaseData::CreateCharacters()
 	// 容疑者1: エレノア・ブラックウッド（依頼人）
 	{
 		FCharacterData C;
-		C.CharacterId = FName("EleanorBlackwood");
+		C.CharacterId = FWitnessIds::EleanorBlackwood;
 		C.DisplayName = FText::FromString(TEXT("エレノア・ブラックウッド"));
 		C.Role = FText::FromString(TEXT("依頼人 / 被害者の娘"));
 		C.Description = FText::FromString(TEXT(
@@ -78,7 +106,7 @@ TArray<FCharacterData> UTheLastWitnessCaseData::CreateCharacters()
 	// 容疑者2: エドワード・ブラックウッド（弟）
 	{
 		FCharacterData C;
-		C.CharacterId = FName("EdwardBlackwood");
+		C.CharacterId = FWitnessIds::EdwardBlackwood;
 		C.DisplayName = FText::FromString(TEXT("エドワード・ブラックウッド"));
 		C.Role = FText::FromString(TEXT("被害者の弟"));
 		C.Description = FText::FromString(TEXT(
@@ -98,7 +126,7 @@ TArray<FCharacterData> UTheLastWitnessCaseData::CreateCharacters()
 	// 容疑者3: トーマス・ハート（執事）
 	{
 		FCharacterData C;
-		C.CharacterId = FName("ThomasHart");
+		C.CharacterId = FWitnessIds::ThomasHart;
 		C.DisplayName = FText::FromString(TEXT("トーマス・ハート"));
 		C.Role = FText::FromString(TEXT("執事"));
 		C.Description = FText::FromString(TEXT(
@@ -117,7 +145,7 @@ TArray<FCharacterData> UTheLastWitnessCaseData::CreateCharacters()
 	// 容疑者4: メアリー・コリンズ（メイド）
 	{
 		FCharacterData C;
-		C.CharacterId = FName("MaryCollins");
+		C.CharacterId = FWitnessIds::MaryCollins;
 		C.DisplayName = FText::FromString(TEXT("メアリー・コリンズ"));
 		C.Role = FText::FromString(TEXT("メイド"));
 		C.Description = FText::FromString(TEXT(
@@ -137,7 +165,7 @@ TArray<FCharacterData> UTheLastWitnessCaseData::CreateCharacters()
 	// 容疑者5: ジェームズ・モーガン（工場監督）
 	{
 		FCharacterData C;
-		C.CharacterId = FName("JamesMorgan");
+		C.CharacterId = FWitnessIds::JamesMorgan;
 		C.DisplayName = FText::FromString(TEXT("ジェームズ・モーガン"));
 		C.Role = FText::FromString(TEXT("工場監督"));
 		C.Description = FText::FromString(TEXT(
@@ -164,7 +192,7 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 	// 書斎の証拠
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_Pistol");
+		E.EvidenceId = FWitnessIds::Evidence_Pistol;
 		E.DisplayName = FText::FromString(TEXT("拳銃"));
 		E.Description = FText::FromString(TEXT(
 			"被害者の手に握られていた拳銃。\n"
@@ -178,13 +206,13 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"火薬残渣の分布パターンを分析中... "
 			"通常の自殺における発砲とは異なる痕跡を検出しました。"
 		));
-		E.RelatedEvidence.Add(FName("Evidence_SecondGunpowder"));
+		E.RelatedEvidence.Add(FWitnessIds::Evidence_SecondGunpowder);
 		Evidence.Add(E);
 	}
 
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_SuicideNote");
+		E.EvidenceId = FWitnessIds::Evidence_SuicideNote;
 		E.DisplayName = FText::FromString(TEXT("遺書"));
 		E.Description = FText::FromString(TEXT(
 			"被害者のデスクで発見された手紙。\n"
@@ -198,13 +226,13 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"筆跡分析を実行中... 基本的なパターンは一致しますが、"
 			"筆圧と傾斜角に微細な不一致を検出しました。"
 		));
-		E.RelatedEvidence.Add(FName("Evidence_TornLetter"));
+		E.RelatedEvidence.Add(FWitnessIds::Evidence_TornLetter);
 		Evidence.Add(E);
 	}
 
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_LockedDoor");
+		E.EvidenceId = FWitnessIds::Evidence_LockedDoor;
 		E.DisplayName = FText::FromString(TEXT("施錠された扉"));
 		E.Description = FText::FromString(TEXT(
 			"書斎の扉は内側から鍵がかかっていた。\n"
@@ -222,7 +250,7 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_SecondGunpowder");
+		E.EvidenceId = FWitnessIds::Evidence_SecondGunpowder;
 		E.DisplayName = FText::FromString(TEXT("第二の火薬痕"));
 		E.Description = FText::FromString(TEXT(
 			"被害者の服に、拳銃の発砲位置とは異なる角度からの火薬痕を発見。\n"
@@ -236,13 +264,13 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"決定的な証拠です。この痕跡は被害者が自ら発砲したものではありません。"
 			"第三者の関与を強く示唆しています。"
 		));
-		E.RelatedEvidence.Add(FName("Evidence_Pistol"));
+		E.RelatedEvidence.Add(FWitnessIds::Evidence_Pistol);
 		Evidence.Add(E);
 	}
 
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_TornLetter");
+		E.EvidenceId = FWitnessIds::Evidence_TornLetter;
 		E.DisplayName = FText::FromString(TEXT("破られた手紙の断片"));
 		E.Description = FText::FromString(TEXT(
 			"ゴミ箱から発見された手紙の断片。\n"
@@ -256,14 +284,14 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"この手紙は事件の動機を示唆しています。"
 			"ブラックウッド卿は誰かの裏切りを知り、告発しようとしていたようです。"
 		));
-		E.RelatedCharacters.Add(FName("EdwardBlackwood"));
+		E.RelatedCharacters.Add(FWitnessIds::EdwardBlackwood);
 		Evidence.Add(E);
 	}
 
 	// 応接室の証拠
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_WillDocument");
+		E.EvidenceId = FWitnessIds::Evidence_WillDocument;
 		E.DisplayName = FText::FromString(TEXT("遺言書"));
 		E.Description = FText::FromString(TEXT(
 			"ブラックウッド卿の遺言書の写し。\n"
@@ -277,15 +305,15 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"遺言の条項を分析中... "
 			"エドワード氏への相続取り消し条件は「不正行為の発覚」です。"
 		));
-		E.RelatedCharacters.Add(FName("EdwardBlackwood"));
-		E.RelatedCharacters.Add(FName("EleanorBlackwood"));
+		E.RelatedCharacters.Add(FWitnessIds::EdwardBlackwood);
+		E.RelatedCharacters.Add(FWitnessIds::EleanorBlackwood);
 		Evidence.Add(E);
 	}
 
 	// 使用人部屋の証拠
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_MaryTestimony");
+		E.EvidenceId = FWitnessIds::Evidence_MaryTestimony;
 		E.DisplayName = FText::FromString(TEXT("メアリーの証言"));
 		E.Description = FText::FromString(TEXT(
 			"メアリーは事件当夜、書斎の前を通った際に\n"
@@ -299,14 +327,14 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"重要な証言です。密室で「自殺」した被害者に、"
 			"死亡時刻前後に訪問者がいた可能性を示しています。"
 		));
-		E.RelatedCharacters.Add(FName("MaryCollins"));
+		E.RelatedCharacters.Add(FWitnessIds::MaryCollins);
 		Evidence.Add(E);
 	}
 
 	// 工場の証拠
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_FinancialRecords");
+		E.EvidenceId = FWitnessIds::Evidence_FinancialRecords;
 		E.DisplayName = FText::FromString(TEXT("財務記録"));
 		E.Description = FText::FromString(TEXT(
 			"工場の財務記録に不審な出金が見つかった。\n"
@@ -320,15 +348,15 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"横領の証拠です。エドワード・ブラックウッド氏が\n"
 			"工場資金を私的に流用していたことを示しています。"
 		));
-		E.RelatedCharacters.Add(FName("EdwardBlackwood"));
-		E.RelatedEvidence.Add(FName("Evidence_TornLetter"));
+		E.RelatedCharacters.Add(FWitnessIds::EdwardBlackwood);
+		E.RelatedEvidence.Add(FWitnessIds::Evidence_TornLetter);
 		Evidence.Add(E);
 	}
 
 	// 庭園の証拠
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_Footprints");
+		E.EvidenceId = FWitnessIds::Evidence_Footprints;
 		E.DisplayName = FText::FromString(TEXT("足跡"));
 		E.Description = FText::FromString(TEXT(
 			"庭園で発見された足跡。\n"
@@ -342,13 +370,13 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"足跡の深さから推定される体重は約75kg。\n"
 			"エドワード・ブラックウッド氏の体格と一致します。"
 		));
-		E.RelatedCharacters.Add(FName("EdwardBlackwood"));
+		E.RelatedCharacters.Add(FWitnessIds::EdwardBlackwood);
 		Evidence.Add(E);
 	}
 
 	{
 		FEvidence E;
-		E.EvidenceId = FName("Evidence_BrokenLatch");
+		E.EvidenceId = FWitnessIds::Evidence_BrokenLatch;
 		E.DisplayName = FText::FromString(TEXT("壊れた掛け金"));
 		E.Description = FText::FromString(TEXT(
 			"書斎の窓の掛け金が内側から無理やり閉められた形跡がある。\n"
@@ -361,7 +389,7 @@ TArray<FEvidence> UTheLastWitnessCaseData::CreateEvidence()
 			"密室のトリックを解明しました。犯人は窓から脱出した後、\n"
 			"細い道具を使って内側から掛け金を閉めたと推定されます。"
 		));
-		E.RelatedEvidence.Add(FName("Evidence_LockedDoor"));
+		E.RelatedEvidence.Add(FWitnessIds::Evidence_LockedDoor);
 		Evidence.Add(E);
 	}
 
@@ -381,11 +409,11 @@ TArray<FLocationData> UTheLastWitnessCaseData::CreateLocations()
 			"重厚なオーク材のデスク、本棚、そして暖炉がある。\n"
 			"窓からは庭園が見える。"
 		));
-		L.AvailableEvidence.Add(FName("Evidence_Pistol"));
-		L.AvailableEvidence.Add(FName("Evidence_SuicideNote"));
-		L.AvailableEvidence.Add(FName("Evidence_LockedDoor"));
-		L.AvailableEvidence.Add(FName("Evidence_SecondGunpowder"));
-		L.AvailableEvidence.Add(FName("Evidence_TornLetter"));
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_Pistol);
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_SuicideNote);
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_LockedDoor);
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_SecondGunpowder);
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_TornLetter);
 		Locations.Add(L);
 	}
 
@@ -398,9 +426,9 @@ TArray<FLocationData> UTheLastWitnessCaseData::CreateLocations()
 			"エレノアとエドワードが待機している。\n"
 			"壁には家族の肖像画が飾られている。"
 		));
-		L.AvailableEvidence.Add(FName("Evidence_WillDocument"));
-		L.CharactersPresent.Add(FName("EleanorBlackwood"));
-		L.CharactersPresent.Add(FName("EdwardBlackwood"));
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_WillDocument);
+		L.CharactersPresent.Add(FWitnessIds::EleanorBlackwood);
+		L.CharactersPresent.Add(FWitnessIds::EdwardBlackwood);
 		Locations.Add(L);
 	}
 
@@ -413,9 +441,9 @@ TArray<FLocationData> UTheLastWitnessCaseData::CreateLocations()
 			"執事のハートとメイドのメアリーがいる。\n"
 			"質素だが清潔に保たれている。"
 		));
-		L.AvailableEvidence.Add(FName("Evidence_MaryTestimony"));
-		L.CharactersPresent.Add(FName("ThomasHart"));
-		L.CharactersPresent.Add(FName("MaryCollins"));
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_MaryTestimony);
+		L.CharactersPresent.Add(FWitnessIds::ThomasHart);
+		L.CharactersPresent.Add(FWitnessIds::MaryCollins);
 		Locations.Add(L);
 	}
 
@@ -428,8 +456,8 @@ TArray<FLocationData> UTheLastWitnessCaseData::CreateLocations()
 			"書斎の窓の下には花壇がある。\n"
 			"裏門は通りに面している。"
 		));
-		L.AvailableEvidence.Add(FName("Evidence_Footprints"));
-		L.AvailableEvidence.Add(FName("Evidence_BrokenLatch"));
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_Footprints);
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_BrokenLatch);
 		Locations.Add(L);
 	}
 
@@ -442,8 +470,8 @@ TArray<FLocationData> UTheLastWitnessCaseData::CreateLocations()
 			"煙突からは煙が立ち上っている。\n"
 			"監督のモーガンがいる。"
 		));
-		L.AvailableEvidence.Add(FName("Evidence_FinancialRecords"));
-		L.CharactersPresent.Add(FName("JamesMorgan"));
+		L.AvailableEvidence.Add(FWitnessIds::Evidence_FinancialRecords);
+		L.CharactersPresent.Add(FWitnessIds::JamesMorgan);
 		Locations.Add(L);
 	}
 
@@ -480,15 +508,15 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 	// エレノアとの対話
 	{
 		FDialogueTree Tree;
-		Tree.TreeId = FName("Dialogue_Eleanor");
-		Tree.CharacterId = FName("EleanorBlackwood");
-		Tree.StartNodeId = FName("Eleanor_Start");
+		Tree.TreeId = FWitnessIds::Dialogue_Eleanor;
+		Tree.CharacterId = FWitnessIds::EleanorBlackwood;
+		Tree.StartNodeId = FWitnessIds::Eleanor_Start;
 
 		// 開始ノード
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Eleanor_Start");
-			Node.SpeakerId = FName("EleanorBlackwood");
+			Node.NodeId = FWitnessIds::Eleanor_Start;
+			Node.SpeakerId = FWitnessIds::EleanorBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"探偵さん、来てくださってありがとうございます。\n"
 				"父は...父は自殺なんかする人ではありません。\n"
@@ -497,25 +525,25 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 			Node.Emotion = EEmotionalState::Sad;
 
 			FDialogueChoice Choice1;
-			Choice1.ChoiceId = FName("Eleanor_Choice_Comfort");
+			Choice1.ChoiceId = FWitnessIds::Eleanor_Choice_Comfort;
 			Choice1.DisplayText = FText::FromString(TEXT("お悔やみ申し上げます。できる限りのことをします。"));
 			Choice1.Tone = EDialogueTone::Empathetic;
-			Choice1.NextNodeId = FName("Eleanor_Grateful");
+			Choice1.NextNodeId = FWitnessIds::Eleanor_Grateful;
 			Choice1.TrustDelta = 10;
 			Node.Choices.Add(Choice1);
 
 			FDialogueChoice Choice2;
-			Choice2.ChoiceId = FName("Eleanor_Choice_Direct");
+			Choice2.ChoiceId = FWitnessIds::Eleanor_Choice_Direct;
 			Choice2.DisplayText = FText::FromString(TEXT("なぜ自殺ではないと思うのですか？"));
 			Choice2.Tone = EDialogueTone::Direct;
-			Choice2.NextNodeId = FName("Eleanor_Explain");
+			Choice2.NextNodeId = FWitnessIds::Eleanor_Explain;
 			Node.Choices.Add(Choice2);
 
 			FDialogueChoice Choice3;
-			Choice3.ChoiceId = FName("Eleanor_Choice_Suspicious");
+			Choice3.ChoiceId = FWitnessIds::Eleanor_Choice_Suspicious;
 			Choice3.DisplayText = FText::FromString(TEXT("あなた自身には何かやましいことは？"));
 			Choice3.Tone = EDialogueTone::Intimidating;
-			Choice3.NextNodeId = FName("Eleanor_Offended");
+			Choice3.NextNodeId = FWitnessIds::Eleanor_Offended;
 			Choice3.TrustDelta = -15;
 			Node.Choices.Add(Choice3);
 
@@ -525,53 +553,53 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 		// 感謝ノード
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Eleanor_Grateful");
-			Node.SpeakerId = FName("EleanorBlackwood");
+			Node.NodeId = FWitnessIds::Eleanor_Grateful;
+			Node.SpeakerId = FWitnessIds::EleanorBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"ありがとうございます...\n"
 				"父は最近、何かに悩んでいるようでした。\n"
 				"叔父のエドワードと言い争っているのを何度か見ました。"
 			));
 			Node.Emotion = EEmotionalState::Sad;
-			Node.GainsEvidence.Add(FName("Evidence_WillDocument"));
-			Node.NextNodeId = FName("Eleanor_End");
+			Node.GainsEvidence.Add(FWitnessIds::Evidence_WillDocument);
+			Node.NextNodeId = FWitnessIds::Eleanor_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		// 説明ノード
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Eleanor_Explain");
-			Node.SpeakerId = FName("EleanorBlackwood");
+			Node.NodeId = FWitnessIds::Eleanor_Explain;
+			Node.SpeakerId = FWitnessIds::EleanorBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"父は強い人でした。どんな困難にも立ち向かう人でした。\n"
 				"それに、来月には工場の労働環境改善計画を発表する予定だったんです。\n"
 				"希望を持っていた人が自ら命を絶つなんて..."
 			));
 			Node.Emotion = EEmotionalState::Sad;
-			Node.NextNodeId = FName("Eleanor_End");
+			Node.NextNodeId = FWitnessIds::Eleanor_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		// 立腹ノード
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Eleanor_Offended");
-			Node.SpeakerId = FName("EleanorBlackwood");
+			Node.NodeId = FWitnessIds::Eleanor_Offended;
+			Node.SpeakerId = FWitnessIds::EleanorBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"...私を疑っているのですか？\n"
 				"父は私の全てでした。そんな質問をされるとは思いませんでした。"
 			));
 			Node.Emotion = EEmotionalState::Angry;
-			Node.NextNodeId = FName("Eleanor_End");
+			Node.NextNodeId = FWitnessIds::Eleanor_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		// 終了ノード
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Eleanor_End");
-			Node.SpeakerId = FName("EleanorBlackwood");
+			Node.NodeId = FWitnessIds::Eleanor_End;
+			Node.SpeakerId = FWitnessIds::EleanorBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"他に聞きたいことがあれば、いつでもどうぞ。\n"
 				"真実のためなら、何でもお話しします。"
@@ -586,14 +614,14 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 	// エドワードとの対話
 	{
 		FDialogueTree Tree;
-		Tree.TreeId = FName("Dialogue_Edward");
-		Tree.CharacterId = FName("EdwardBlackwood");
-		Tree.StartNodeId = FName("Edward_Start");
+		Tree.TreeId = FWitnessIds::Dialogue_Edward;
+		Tree.CharacterId = FWitnessIds::EdwardBlackwood;
+		Tree.StartNodeId = FWitnessIds::Edward_Start;
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Edward_Start");
-			Node.SpeakerId = FName("EdwardBlackwood");
+			Node.NodeId = FWitnessIds::Edward_Start;
+			Node.SpeakerId = FWitnessIds::EdwardBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"ああ、探偵さんですか。\n"
 				"姪が雇ったそうですね。無駄な出費だと思いますがね。\n"
@@ -602,25 +630,25 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 			Node.Emotion = EEmotionalState::Defensive;
 
 			FDialogueChoice Choice1;
-			Choice1.ChoiceId = FName("Edward_Choice_Polite");
+			Choice1.ChoiceId = FWitnessIds::Edward_Choice_Polite;
 			Choice1.DisplayText = FText::FromString(TEXT("念のための調査です。ご協力いただければ。"));
 			Choice1.Tone = EDialogueTone::Polite;
-			Choice1.NextNodeId = FName("Edward_Reluctant");
+			Choice1.NextNodeId = FWitnessIds::Edward_Reluctant;
 			Node.Choices.Add(Choice1);
 
 			FDialogueChoice Choice2;
-			Choice2.ChoiceId = FName("Edward_Choice_Money");
+			Choice2.ChoiceId = FWitnessIds::Edward_Choice_Money;
 			Choice2.DisplayText = FText::FromString(TEXT("お兄様の死で、遺産を相続されるそうですね。"));
 			Choice2.Tone = EDialogueTone::Cunning;
-			Choice2.NextNodeId = FName("Edward_Defensive");
+			Choice2.NextNodeId = FWitnessIds::Edward_Defensive;
 			Choice2.TrustDelta = -10;
 			Node.Choices.Add(Choice2);
 
 			FDialogueChoice Choice3;
-			Choice3.ChoiceId = FName("Edward_Choice_Accuse");
+			Choice3.ChoiceId = FWitnessIds::Edward_Choice_Accuse;
 			Choice3.DisplayText = FText::FromString(TEXT("事件当夜、どこにいましたか？"));
 			Choice3.Tone = EDialogueTone::Direct;
-			Choice3.NextNodeId = FName("Edward_Alibi");
+			Choice3.NextNodeId = FWitnessIds::Edward_Alibi;
 			Node.Choices.Add(Choice3);
 
 			Tree.Nodes.Add(Node);
@@ -628,49 +656,49 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Edward_Reluctant");
-			Node.SpeakerId = FName("EdwardBlackwood");
+			Node.NodeId = FWitnessIds::Edward_Reluctant;
+			Node.SpeakerId = FWitnessIds::EdwardBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"まあ、好きにすればいい。\n"
 				"どうせ何も見つからないでしょうがね。"
 			));
 			Node.Emotion = EEmotionalState::Neutral;
-			Node.NextNodeId = FName("Edward_End");
+			Node.NextNodeId = FWitnessIds::Edward_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Edward_Defensive");
-			Node.SpeakerId = FName("EdwardBlackwood");
+			Node.NodeId = FWitnessIds::Edward_Defensive;
+			Node.SpeakerId = FWitnessIds::EdwardBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"何が言いたいのです！？\n"
 				"私が兄を殺したとでも？ 馬鹿な！\n"
 				"私はその夜、クラブにいました。証人もいます！"
 			));
 			Node.Emotion = EEmotionalState::Angry;
-			Node.NextNodeId = FName("Edward_End");
+			Node.NextNodeId = FWitnessIds::Edward_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Edward_Alibi");
-			Node.SpeakerId = FName("EdwardBlackwood");
+			Node.NodeId = FWitnessIds::Edward_Alibi;
+			Node.SpeakerId = FWitnessIds::EdwardBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"その夜は...ホワイトチャペル・クラブにいました。\n"
 				"夜11時まで。バーテンダーに確認できます。"
 			));
 			Node.Emotion = EEmotionalState::Nervous;
-			Node.SetsFlags.Add(FName("Flag_EdwardAlibiClaimed"));
-			Node.NextNodeId = FName("Edward_End");
+			Node.SetsFlags.Add(FWitnessIds::Flag_EdwardAlibiClaimed);
+			Node.NextNodeId = FWitnessIds::Edward_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Edward_End");
-			Node.SpeakerId = FName("EdwardBlackwood");
+			Node.NodeId = FWitnessIds::Edward_End;
+			Node.SpeakerId = FWitnessIds::EdwardBlackwood;
 			Node.Text = FText::FromString(TEXT(
 				"これ以上の質問は弁護士を通してください。"
 			));
@@ -684,14 +712,14 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 	// メアリーとの対話
 	{
 		FDialogueTree Tree;
-		Tree.TreeId = FName("Dialogue_Mary");
-		Tree.CharacterId = FName("MaryCollins");
-		Tree.StartNodeId = FName("Mary_Start");
+		Tree.TreeId = FWitnessIds::Dialogue_Mary;
+		Tree.CharacterId = FWitnessIds::MaryCollins;
+		Tree.StartNodeId = FWitnessIds::Mary_Start;
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Mary_Start");
-			Node.SpeakerId = FName("MaryCollins");
+			Node.NodeId = FWitnessIds::Mary_Start;
+			Node.SpeakerId = FWitnessIds::MaryCollins;
 			Node.Text = FText::FromString(TEXT(
 				"あ、あの...探偵さんですか？\n"
 				"私、何も知りませんから..."
@@ -699,18 +727,18 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 			Node.Emotion = EEmotionalState::Nervous;
 
 			FDialogueChoice Choice1;
-			Choice1.ChoiceId = FName("Mary_Choice_Kind");
+			Choice1.ChoiceId = FWitnessIds::Mary_Choice_Kind;
 			Choice1.DisplayText = FText::FromString(TEXT("怖がらなくていい。話を聞かせてくれるだけでいいんだ。"));
 			Choice1.Tone = EDialogueTone::Empathetic;
-			Choice1.NextNodeId = FName("Mary_Opens");
+			Choice1.NextNodeId = FWitnessIds::Mary_Opens;
 			Choice1.TrustDelta = 15;
 			Node.Choices.Add(Choice1);
 
 			FDialogueChoice Choice2;
-			Choice2.ChoiceId = FName("Mary_Choice_Pressure");
+			Choice2.ChoiceId = FWitnessIds::Mary_Choice_Pressure;
 			Choice2.DisplayText = FText::FromString(TEXT("何か隠しているなら、今話した方がいい。"));
 			Choice2.Tone = EDialogueTone::Intimidating;
-			Choice2.NextNodeId = FName("Mary_Scared");
+			Choice2.NextNodeId = FWitnessIds::Mary_Scared;
 			Choice2.TrustDelta = -20;
 			Node.Choices.Add(Choice2);
 
@@ -719,50 +747,50 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Mary_Opens");
-			Node.SpeakerId = FName("MaryCollins");
+			Node.NodeId = FWitnessIds::Mary_Opens;
+			Node.SpeakerId = FWitnessIds::MaryCollins;
 			Node.Text = FText::FromString(TEXT(
 				"実は...あの夜、書斎の前を通った時...\n"
 				"中から声が聞こえたんです。二人の男の人の声。\n"
 				"一人は旦那様で、もう一人は..."
 			));
 			Node.Emotion = EEmotionalState::Nervous;
-			Node.NextNodeId = FName("Mary_Reveal");
+			Node.NextNodeId = FWitnessIds::Mary_Reveal;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Mary_Reveal");
-			Node.SpeakerId = FName("MaryCollins");
+			Node.NodeId = FWitnessIds::Mary_Reveal;
+			Node.SpeakerId = FWitnessIds::MaryCollins;
 			Node.Text = FText::FromString(TEXT(
 				"もう一人の声...エドワード様に似ていました。\n"
 				"「金のことは黙っていろ」って怒鳴っているのが聞こえて...\n"
 				"私、怖くなって逃げたんです..."
 			));
 			Node.Emotion = EEmotionalState::Fearful;
-			Node.GainsEvidence.Add(FName("Evidence_MaryTestimony"));
-			Node.NextNodeId = FName("Mary_End");
+			Node.GainsEvidence.Add(FWitnessIds::Evidence_MaryTestimony);
+			Node.NextNodeId = FWitnessIds::Mary_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Mary_Scared");
-			Node.SpeakerId = FName("MaryCollins");
+			Node.NodeId = FWitnessIds::Mary_Scared;
+			Node.SpeakerId = FWitnessIds::MaryCollins;
 			Node.Text = FText::FromString(TEXT(
 				"ひっ...! お、脅さないでください...\n"
 				"本当に何も知らないんです...!"
 			));
 			Node.Emotion = EEmotionalState::Fearful;
-			Node.NextNodeId = FName("Mary_End");
+			Node.NextNodeId = FWitnessIds::Mary_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Mary_End");
-			Node.SpeakerId = FName("MaryCollins");
+			Node.NodeId = FWitnessIds::Mary_End;
+			Node.SpeakerId = FWitnessIds::MaryCollins;
 			Node.Text = FText::FromString(TEXT(
 				"もう...行ってもいいですか...?"
 			));
@@ -776,14 +804,14 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 	// トーマス・ハート（執事）との対話
 	{
 		FDialogueTree Tree;
-		Tree.TreeId = FName("Dialogue_Thomas");
-		Tree.CharacterId = FName("ThomasHart");
-		Tree.StartNodeId = FName("Thomas_Start");
+		Tree.TreeId = FWitnessIds::Dialogue_Thomas;
+		Tree.CharacterId = FWitnessIds::ThomasHart;
+		Tree.StartNodeId = FWitnessIds::Thomas_Start;
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Thomas_Start");
-			Node.SpeakerId = FName("ThomasHart");
+			Node.NodeId = FWitnessIds::Thomas_Start;
+			Node.SpeakerId = FWitnessIds::ThomasHart;
 			Node.Text = FText::FromString(TEXT(
 				"探偵さん、ようこそいらっしゃいました。\n"
 				"この屋敷のことでしたら、何でもお聞きください。\n"
@@ -792,24 +820,24 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 			Node.Emotion = EEmotionalState::Neutral;
 
 			FDialogueChoice Choice1;
-			Choice1.ChoiceId = FName("Thomas_Choice_Night");
+			Choice1.ChoiceId = FWitnessIds::Thomas_Choice_Night;
 			Choice1.DisplayText = FText::FromString(TEXT("事件の夜のことを教えてください。"));
 			Choice1.Tone = EDialogueTone::Polite;
-			Choice1.NextNodeId = FName("Thomas_Night");
+			Choice1.NextNodeId = FWitnessIds::Thomas_Night;
 			Node.Choices.Add(Choice1);
 
 			FDialogueChoice Choice2;
-			Choice2.ChoiceId = FName("Thomas_Choice_Edward");
+			Choice2.ChoiceId = FWitnessIds::Thomas_Choice_Edward;
 			Choice2.DisplayText = FText::FromString(TEXT("エドワード様についてどう思いますか？"));
 			Choice2.Tone = EDialogueTone::Direct;
-			Choice2.NextNodeId = FName("Thomas_Edward");
+			Choice2.NextNodeId = FWitnessIds::Thomas_Edward;
 			Node.Choices.Add(Choice2);
 
 			FDialogueChoice Choice3;
-			Choice3.ChoiceId = FName("Thomas_Choice_Secret");
+			Choice3.ChoiceId = FWitnessIds::Thomas_Choice_Secret;
 			Choice3.DisplayText = FText::FromString(TEXT("この屋敷には何か秘密が？"));
 			Choice3.Tone = EDialogueTone::Cunning;
-			Choice3.NextNodeId = FName("Thomas_Secret");
+			Choice3.NextNodeId = FWitnessIds::Thomas_Secret;
 			Node.Choices.Add(Choice3);
 
 			Tree.Nodes.Add(Node);
@@ -817,37 +845,37 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Thomas_Night");
-			Node.SpeakerId = FName("ThomasHart");
+			Node.NodeId = FWitnessIds::Thomas_Night;
+			Node.SpeakerId = FWitnessIds::ThomasHart;
 			Node.Text = FText::FromString(TEXT(
 				"あの夜は...私は外出しておりました。\n"
 				"妹の家を訪ねていたのです。毎月一度の習慣で。\n"
 				"戻った時には、もう...大騒ぎになっておりました。"
 			));
 			Node.Emotion = EEmotionalState::Sad;
-			Node.NextNodeId = FName("Thomas_End");
+			Node.NextNodeId = FWitnessIds::Thomas_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Thomas_Edward");
-			Node.SpeakerId = FName("ThomasHart");
+			Node.NodeId = FWitnessIds::Thomas_Edward;
+			Node.SpeakerId = FWitnessIds::ThomasHart;
 			Node.Text = FText::FromString(TEXT(
 				"エドワード様は...その、正直に申し上げますと...\n"
 				"旦那様とは違い、少々浪費癖がおありでした。\n"
 				"最近、旦那様と頻繁に言い争いをされていたのは存じております。"
 			));
 			Node.Emotion = EEmotionalState::Nervous;
-			Node.SetsFlags.Add(FName("Flag_ThomasKnowsArgument"));
-			Node.NextNodeId = FName("Thomas_End");
+			Node.SetsFlags.Add(FWitnessIds::Flag_ThomasKnowsArgument);
+			Node.NextNodeId = FWitnessIds::Thomas_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Thomas_Secret");
-			Node.SpeakerId = FName("ThomasHart");
+			Node.NodeId = FWitnessIds::Thomas_Secret;
+			Node.SpeakerId = FWitnessIds::ThomasHart;
 			Node.Text = FText::FromString(TEXT(
 				"秘密...ですか。\n"
 				"古い屋敷には、どこも秘密があるものです。\n"
@@ -855,15 +883,15 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 				"ご存知でしょうか？"
 			));
 			Node.Emotion = EEmotionalState::Neutral;
-			Node.SetsFlags.Add(FName("Flag_ThomasHintLatch"));
-			Node.NextNodeId = FName("Thomas_End");
+			Node.SetsFlags.Add(FWitnessIds::Flag_ThomasHintLatch);
+			Node.NextNodeId = FWitnessIds::Thomas_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("Thomas_End");
-			Node.SpeakerId = FName("ThomasHart");
+			Node.NodeId = FWitnessIds::Thomas_End;
+			Node.SpeakerId = FWitnessIds::ThomasHart;
 			Node.Text = FText::FromString(TEXT(
 				"他に何かございましたら、いつでもお呼びください。"
 			));
@@ -877,14 +905,14 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 	// ジェームズ・モーガン（工場監督）との対話
 	{
 		FDialogueTree Tree;
-		Tree.TreeId = FName("Dialogue_James");
-		Tree.CharacterId = FName("JamesMorgan");
-		Tree.StartNodeId = FName("James_Start");
+		Tree.TreeId = FWitnessIds::Dialogue_James;
+		Tree.CharacterId = FWitnessIds::JamesMorgan;
+		Tree.StartNodeId = FWitnessIds::James_Start;
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("James_Start");
-			Node.SpeakerId = FName("JamesMorgan");
+			Node.NodeId = FWitnessIds::James_Start;
+			Node.SpeakerId = FWitnessIds::JamesMorgan;
 			Node.Text = FText::FromString(TEXT(
 				"何の用だ？ 見ての通り忙しいんだ。\n"
 				"ブラックウッド卿の死？ 自殺だろう。\n"
@@ -893,24 +921,24 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 			Node.Emotion = EEmotionalState::Defensive;
 
 			FDialogueChoice Choice1;
-			Choice1.ChoiceId = FName("James_Choice_Reform");
+			Choice1.ChoiceId = FWitnessIds::James_Choice_Reform;
 			Choice1.DisplayText = FText::FromString(TEXT("労働改革計画についてどう思いますか？"));
 			Choice1.Tone = EDialogueTone::Direct;
-			Choice1.NextNodeId = FName("James_Reform");
+			Choice1.NextNodeId = FWitnessIds::James_Reform;
 			Node.Choices.Add(Choice1);
 
 			FDialogueChoice Choice2;
-			Choice2.ChoiceId = FName("James_Choice_Finance");
+			Choice2.ChoiceId = FWitnessIds::James_Choice_Finance;
 			Choice2.DisplayText = FText::FromString(TEXT("工場の財務状況について聞きたい。"));
 			Choice2.Tone = EDialogueTone::Cunning;
-			Choice2.NextNodeId = FName("James_Finance");
+			Choice2.NextNodeId = FWitnessIds::James_Finance;
 			Node.Choices.Add(Choice2);
 
 			FDialogueChoice Choice3;
-			Choice3.ChoiceId = FName("James_Choice_Threaten");
+			Choice3.ChoiceId = FWitnessIds::James_Choice_Threaten;
 			Choice3.DisplayText = FText::FromString(TEXT("あなたも容疑者の一人だ。協力しないと困るのはあなただ。"));
 			Choice3.Tone = EDialogueTone::Intimidating;
-			Choice3.NextNodeId = FName("James_Angry");
+			Choice3.NextNodeId = FWitnessIds::James_Angry;
 			Choice3.TrustDelta = -20;
 			Node.Choices.Add(Choice3);
 
@@ -919,38 +947,38 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("James_Reform");
-			Node.SpeakerId = FName("JamesMorgan");
+			Node.NodeId = FWitnessIds::James_Reform;
+			Node.SpeakerId = FWitnessIds::JamesMorgan;
 			Node.Text = FText::FromString(TEXT(
 				"労働改革？ ふん、甘い考えだ。\n"
 				"労働者を甘やかせば、生産性は落ちる。\n"
 				"旦那様には反対したが...聞き入れてもらえなかった。"
 			));
 			Node.Emotion = EEmotionalState::Angry;
-			Node.SetsFlags.Add(FName("Flag_JamesOpposedReform"));
-			Node.NextNodeId = FName("James_End");
+			Node.SetsFlags.Add(FWitnessIds::Flag_JamesOpposedReform);
+			Node.NextNodeId = FWitnessIds::James_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("James_Finance");
-			Node.SpeakerId = FName("JamesMorgan");
+			Node.NodeId = FWitnessIds::James_Finance;
+			Node.SpeakerId = FWitnessIds::JamesMorgan;
 			Node.Text = FText::FromString(TEXT(
 				"財務？ それは私の管轄じゃない。\n"
 				"ただ...最近、設備投資の名目で大金が動いていたのは知っている。\n"
 				"実際に新しい設備なんか入っていないがな。エドワード様が何か知っているだろう。"
 			));
 			Node.Emotion = EEmotionalState::Neutral;
-			Node.SetsFlags.Add(FName("Flag_JamesKnowsFinance"));
-			Node.NextNodeId = FName("James_End");
+			Node.SetsFlags.Add(FWitnessIds::Flag_JamesKnowsFinance);
+			Node.NextNodeId = FWitnessIds::James_End;
 			Tree.Nodes.Add(Node);
 		}
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("James_Angry");
-			Node.SpeakerId = FName("JamesMorgan");
+			Node.NodeId = FWitnessIds::James_Angry;
+			Node.SpeakerId = FWitnessIds::JamesMorgan;
 			Node.Text = FText::FromString(TEXT(
 				"脅しか？ 私は何もやましいことはない！\n"
 				"帰れ！ これ以上話すことはない！"
@@ -962,8 +990,8 @@ TArray<FDialogueTree> UTheLastWitnessCaseData::CreateDialogues()
 
 		{
 			FDialogueNode Node;
-			Node.NodeId = FName("James_End");
-			Node.SpeakerId = FName("JamesMorgan");
+			Node.NodeId = FWitnessIds::James_End;
+			Node.SpeakerId = FWitnessIds::JamesMorgan;
 			Node.Text = FText::FromString(TEXT(
 				"もういいだろう。仕事に戻らせてもらう。"
 			));
@@ -984,66 +1012,185 @@ TArray<FDeduction> UTheLastWitnessCaseData::CreateDeductions()
 	// 推理1: 密室トリック
 	{
 		FDeduction D;
-		D.DeductionId = FName("Deduction_LockedRoom");
+		D.DeductionId = FWitnessIds::Deduction_LockedRoom;
 		D.Title = FText::FromString(TEXT("密室のトリック"));
 		D.Description = FText::FromString(TEXT(
 			"壊れた掛け金と施錠された扉を結びつけると...\n"
 			"犯人は窓から脱出した後、細い道具を使って内側から掛け金を閉めた。\n"
 			"これで密室を作り出したのだ。"
 		));
-		D.EvidenceA = FName("Evidence_LockedDoor");
-		D.EvidenceB = FName("Evidence_BrokenLatch");
-		D.UnlocksFlags.Add(FName("Flag_LockedRoomSolved"));
+		D.EvidenceA = FWitnessIds::Evidence_LockedDoor;
+		D.EvidenceB = FWitnessIds::Evidence_BrokenLatch;
+		D.UnlocksFlags.Add(FWitnessIds::Flag_LockedRoomSolved);
 		Deductions.Add(D);
 	}
 
 	// 推理2: 偽装された自殺
 	{
 		FDeduction D;
-		D.DeductionId = FName("Deduction_FakedSuicide");
+		D.DeductionId = FWitnessIds::Deduction_FakedSuicide;
 		D.Title = FText::FromString(TEXT("偽装された自殺"));
 		D.Description = FText::FromString(TEXT(
 			"拳銃と第二の火薬痕を結びつけると...\n"
 			"被害者は自ら発砲したのではない。\n"
 			"誰かが近距離から発砲し、その後拳銃を被害者の手に握らせた。"
 		));
-		D.EvidenceA = FName("Evidence_Pistol");
-		D.EvidenceB = FName("Evidence_SecondGunpowder");
-		D.UnlocksFlags.Add(FName("Flag_SuicideFaked"));
+		D.EvidenceA = FWitnessIds::Evidence_Pistol;
+		D.EvidenceB = FWitnessIds::Evidence_SecondGunpowder;
+		D.UnlocksFlags.Add(FWitnessIds::Flag_SuicideFaked);
 		Deductions.Add(D);
 	}
 
 	// 推理3: 動機の解明
 	{
 		FDeduction D;
-		D.DeductionId = FName("Deduction_Motive");
+		D.DeductionId = FWitnessIds::Deduction_Motive;
 		D.Title = FText::FromString(TEXT("横領という動機"));
 		D.Description = FText::FromString(TEXT(
 			"破られた手紙と財務記録を結びつけると...\n"
 			"ブラックウッド卿はエドワードの横領を発見し、告発しようとしていた。\n"
 			"エドワードには卿を殺す強い動機があった。"
 		));
-		D.EvidenceA = FName("Evidence_TornLetter");
-		D.EvidenceB = FName("Evidence_FinancialRecords");
-		D.UnlocksFlags.Add(FName("Flag_MotiveFound"));
+		D.EvidenceA = FWitnessIds::Evidence_TornLetter;
+		D.EvidenceB = FWitnessIds::Evidence_FinancialRecords;
+		D.UnlocksFlags.Add(FWitnessIds::Flag_MotiveFound);
 		Deductions.Add(D);
 	}
 
 	// 推理4: 目撃者の証言
 	{
 		FDeduction D;
-		D.DeductionId = FName("Deduction_Witness");
+		D.DeductionId = FWitnessIds::Deduction_Witness;
 		D.Title = FText::FromString(TEXT("目撃証言との一致"));
 		D.Description = FText::FromString(TEXT(
 			"メアリーの証言と足跡を結びつけると...\n"
 			"メアリーが聞いたのはエドワードの声だった。\n"
 			"足跡も彼の体格と一致する。エドワードは事件当夜、現場にいた。"
 		));
-		D.EvidenceA = FName("Evidence_MaryTestimony");
-		D.EvidenceB = FName("Evidence_Footprints");
-		D.UnlocksFlags.Add(FName("Flag_EdwardAtScene"));
+		D.EvidenceA = FWitnessIds::Evidence_MaryTestimony;
+		D.EvidenceB = FWitnessIds::Evidence_Footprints;
+		D.UnlocksFlags.Add(FWitnessIds::Flag_EdwardAtScene);
+		Deductions.Add(D);
+	}
+
+	// 推理5: 仕組まれた殺人（推理1・2から導出）
+	{
+		FDeduction D;
+		D.DeductionId = FWitnessIds::Deduction_StagedMurder;
+		D.Title = FText::FromString(TEXT("仕組まれた殺人"));
+		D.Description = FText::FromString(TEXT(
+			"密室のトリックと偽装された自殺を合わせると...\n"
+			"これは衝動的な犯行ではない。\n"
+			"犯人は自殺に見せかけるため、現場を周到に作り上げていた。"
+		));
+		D.PremiseDeductions.Add(FWitnessIds::Deduction_LockedRoom);
+		D.PremiseDeductions.Add(FWitnessIds::Deduction_FakedSuicide);
+		D.UnlocksFlags.Add(FWitnessIds::Flag_MurderStaged);
+		Deductions.Add(D);
+	}
+
+	// 推理6: 犯人像の確定（推理3・4・5から導出）
+	{
+		FDeduction D;
+		D.DeductionId = FWitnessIds::Deduction_CulpritProfile;
+		D.Title = FText::FromString(TEXT("犯人像の確定"));
+		D.Description = FText::FromString(TEXT(
+			"動機、現場での目撃、そして周到な偽装...\n"
+			"全てが一人の人物を指している。\n"
+			"卿の不正を知られたエドワードが、計画的に卿を殺害したのだ。"
+		));
+		D.PremiseDeductions.Add(FWitnessIds::Deduction_Motive);
+		D.PremiseDeductions.Add(FWitnessIds::Deduction_Witness);
+		D.PremiseDeductions.Add(FWitnessIds::Deduction_StagedMurder);
+		D.UnlocksFlags.Add(FWitnessIds::Flag_CulpritIdentified);
 		Deductions.Add(D);
 	}
 
 	return Deductions;
 }
+
+TArray<FCharacterScheduleEntry> UTheLastWitnessCaseData::CreateCharacterSchedule()
+{
+	TArray<FCharacterScheduleEntry> Schedule;
+
+	auto Add = [&Schedule](FName CharacterId, int32 AtMinute, ELocation Location)
+	{
+		FCharacterScheduleEntry& Entry = Schedule.AddDefaulted_GetRef();
+		Entry.CharacterId = CharacterId;
+		Entry.AtMinute = AtMinute;
+		Entry.Location = Location;
+	};
+
+	// トーマス: 午後は庭の手入れに出る
+	Add(FWitnessIds::ThomasHart, 60, ELocation::Garden);
+	Add(FWitnessIds::ThomasHart, 150, ELocation::ServantsQuarters);
+
+	// エドワード: 夕方になると酒場で時間を潰す
+	Add(FWitnessIds::EdwardBlackwood, 120, ELocation::Pub);
+	Add(FWitnessIds::EdwardBlackwood, 240, ELocation::DrawingRoom);
+
+	// エレノア: 父の書斎を片付けに向かう
+	Add(FWitnessIds::EleanorBlackwood, 180, ELocation::Study);
+	Add(FWitnessIds::EleanorBlackwood, 210, ELocation::DrawingRoom);
+
+	// モーガン: 工場の終業後に酒場へ
+	Add(FWitnessIds::JamesMorgan, 300, ELocation::Pub);
+
+	return Schedule;
+}
+
+TArray<FCaseTrigger> UTheLastWitnessCaseData::CreateTriggers()
+{
+	TArray<FCaseTrigger> Triggers;
+
+	auto MakeEmotion = [](FName CharacterId, EEmotionalState EmotionalState)
+	{
+		FTriggerAction Action;
+		Action.Type = ETriggerActionType::SetEmotionalState;
+		Action.CharacterId = CharacterId;
+		Action.EmotionalState = EmotionalState;
+		return Action;
+	};
+
+	auto MakeMove = [](FName CharacterId, ELocation Location)
+	{
+		FTriggerAction Action;
+		Action.Type = ETriggerActionType::MoveCharacter;
+		Action.CharacterId = CharacterId;
+		Action.Location = Location;
+		return Action;
+	};
+
+	// 財務記録を押さえられたモーガンは動揺し、工場を離れて酒場に逃げ込む
+	{
+		FCaseTrigger T;
+		T.TriggerId = FWitnessIds::Trigger_MorganShaken;
+		T.RequiredEvidence.Add(FWitnessIds::Evidence_FinancialRecords);
+		T.Actions.Add(MakeEmotion(FWitnessIds::JamesMorgan, EEmotionalState::Nervous));
+		T.Actions.Add(MakeMove(FWitnessIds::JamesMorgan, ELocation::Pub));
+		Triggers.Add(T);
+	}
+
+	// 動機を突き止められたエドワードは身構える
+	{
+		FCaseTrigger T;
+		T.TriggerId = FWitnessIds::Trigger_EdwardCornered;
+		T.RequiredDeductions.Add(FWitnessIds::Deduction_Motive);
+		T.Actions.Add(MakeEmotion(FWitnessIds::EdwardBlackwood, EEmotionalState::Defensive));
+		Triggers.Add(T);
+	}
+
+	// 探偵を信頼したメアリーは、人目を避けて庭園で話そうとする
+	{
+		FCaseTrigger T;
+		T.TriggerId = FWitnessIds::Trigger_MaryConfides;
+		FTriggerTrustCondition& Trust = T.TrustConditions.AddDefaulted_GetRef();
+		Trust.CharacterId = FWitnessIds::MaryCollins;
+		Trust.MinTrust = 70;
+		T.Actions.Add(MakeEmotion(FWitnessIds::MaryCollins, EEmotionalState::Cooperative));
+		T.Actions.Add(MakeMove(FWitnessIds::MaryCollins, ELocation::Garden));
+		Triggers.Add(T);
+	}
+
+	return Triggers;
+}
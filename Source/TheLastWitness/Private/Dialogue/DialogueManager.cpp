@@ -2,6 +2,7 @@
 
 #include "Dialogue/DialogueManager.h"
 #include "Core/CaseState.h"
+#include "Core/CaseDefinition.h"
 #include "TheLastWitness.h"
 
 UDialogueManager::UDialogueManager()
@@ -11,14 +12,21 @@ UDialogueManager::UDialogueManager()
 void UDialogueManager::Initialize(UCaseState* InCaseState)
 {
 	CaseState = InCaseState;
+	Definition = CaseState ? CaseState->GetDefinition() : nullptr;
+	DialogueTrees.Reset();
+	CompiledTreeIndices.Reset();
 
 	// CaseStateから対話ツリーを読み込み
-	if (CaseState)
+	if (Definition)
 	{
-		const FCaseData& CaseData = CaseState->GetCaseData();
-		for (const FDialogueTree& Tree : CaseData.AllDialogues)
+		const FCaseData& CaseData = Definition->GetData();
+		for (int32 TreeIndex = 0; TreeIndex < CaseData.AllDialogues.Num(); TreeIndex++)
 		{
+			const FDialogueTree& Tree = CaseData.AllDialogues[TreeIndex];
 			RegisterDialogueTree(Tree);
+
+			// 事件定義由来のツリーは事前コンパイル済みの条件を使う
+			CompiledTreeIndices.Add(Tree.CharacterId, TreeIndex);
 		}
 	}
 
@@ -39,26 +47,29 @@ bool UDialogueManager::StartDialogue(FName CharacterId)
 	}
 
 	// 対話ツリーを検索
-	FDialogueTree Tree;
-	if (!GetDialogueTreeForCharacter(CharacterId, Tree))
+	if (!EnterTree(CharacterId))
 	{
 		UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] 対話ツリーが見つかりません: %s"),
 			*CharacterId.ToString());
 		return false;
 	}
 
-	CurrentCharacterId = CharacterId;
-	CurrentTree = Tree;
-	bIsInDialogue = true;
-
 	// キャラクターをインタビュー済みにマーク
 	if (CaseState)
 	{
-		CaseState->MarkCharacterInterviewed(CharacterId);
+		if (CurrentCharacter)
+		{
+			CaseState->MarkCharacterInterviewed(CurrentCharacter);
+		}
+		else
+		{
+			CaseState->MarkCharacterInterviewed(CharacterId);
+		}
 	}
 
 	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] 対話開始: %s"), *CharacterId.ToString());
 
+	OnDialogueStartedNative.Broadcast(CharacterId);
 	OnDialogueStarted.Broadcast(CharacterId);
 
 	// 開始ノードに移動
@@ -67,7 +78,7 @@ bool UDialogueManager::StartDialogue(FName CharacterId)
 	return true;
 }
 
-void UDialogueManager::SelectChoice(FName ChoiceId)
+bool UDialogueManager::SelectChoice(FName ChoiceId)
 {
 	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] SelectChoice called - ChoiceId: %s, bIsInDialogue: %s, CurrentNodeId: %s"),
 		*ChoiceId.ToString(),
@@ -77,7 +88,7 @@ void UDialogueManager::SelectChoice(FName ChoiceId)
 	if (!bIsInDialogue)
 	{
 		UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] 対話中ではありません"));
-		return;
+		return false;
 	}
 
 	// 現在のノードをデバッグ出力
@@ -100,29 +111,68 @@ void UDialogueManager::SelectChoice(FName ChoiceId)
 	{
 		UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] 選択肢が見つかりません: %s"),
 			*ChoiceId.ToString());
-		return;
+		return false;
+	}
+
+	return SelectChoiceAt(static_cast<int32>(Choice - CurrentTree.Nodes[CurrentNodeIndex].Choices.GetData()));
+}
+
+bool UDialogueManager::SelectChoiceAt(int32 ChoiceIndex)
+{
+	const FDialogueNode* CurrentNode = FindCurrentNode();
+	if (!CurrentNode || !CurrentNode->Choices.IsValidIndex(ChoiceIndex))
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] 選択肢の位置が不正です: %d"), ChoiceIndex);
+		return false;
 	}
 
+	const FDialogueChoice& Choice = CurrentNode->Choices[ChoiceIndex];
+	const FCompiledDialogueChoice* Compiled = CurrentTreeIndex != INDEX_NONE
+		? &Definition->GetCompiledChoice(CurrentTreeIndex, CurrentNodeIndex, ChoiceIndex)
+		: nullptr;
+
 	// 信頼度変更を適用
-	if (CaseState && Choice->TrustDelta != 0)
+	if (CaseState && Choice.TrustDelta != 0)
 	{
-		CaseState->ModifyCharacterTrust(CurrentCharacterId, Choice->TrustDelta);
+		if (CurrentCharacter)
+		{
+			CaseState->ModifyCharacterTrust(CurrentCharacter, Choice.TrustDelta);
+		}
+		else
+		{
+			CaseState->ModifyCharacterTrust(CurrentCharacterId, Choice.TrustDelta);
+		}
 	}
 
 	// フラグを設定
 	if (CaseState)
 	{
-		for (const FName& FlagName : Choice->SetsFlags)
+		if (Compiled)
 		{
-			CaseState->SetFlag(FlagName);
+			CaseState->ApplyFlagMask(Compiled->SetsFlags);
+		}
+		else
+		{
+			for (const FName& FlagName : Choice.SetsFlags)
+			{
+				CaseState->SetFlag(FlagName);
+			}
 		}
 	}
 
 	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] 選択肢を選択: %s -> 次のノード: %s"),
-		*ChoiceId.ToString(), *Choice->NextNodeId.ToString());
+		*Choice.ChoiceId.ToString(), *Choice.NextNodeId.ToString());
 
 	// 次のノードに移動
-	GoToNode(Choice->NextNodeId);
+	if (Compiled && Compiled->NextNode != INDEX_NONE)
+	{
+		GoToNodeIndex(Compiled->NextNode);
+	}
+	else
+	{
+		GoToNode(Choice.NextNodeId);
+	}
+	return true;
 }
 
 void UDialogueManager::AdvanceDialogue()
@@ -132,7 +182,7 @@ void UDialogueManager::AdvanceDialogue()
 		return;
 	}
 
-	const FDialogueNode* CurrentNode = FindNodeById(CurrentNodeId);
+	const FDialogueNode* CurrentNode = FindCurrentNode();
 	if (!CurrentNode)
 	{
 		return;
@@ -152,7 +202,14 @@ void UDialogueManager::AdvanceDialogue()
 	}
 
 	// 次のノードに移動
-	if (!CurrentNode->NextNodeId.IsNone())
+	const int32 NextNode = CurrentTreeIndex != INDEX_NONE
+		? Definition->GetCompiledNode(CurrentTreeIndex, CurrentNodeIndex).NextNode
+		: INDEX_NONE;
+	if (NextNode != INDEX_NONE)
+	{
+		GoToNodeIndex(NextNode);
+	}
+	else if (!CurrentNode->NextNodeId.IsNone())
 	{
 		GoToNode(CurrentNode->NextNodeId);
 	}
@@ -173,8 +230,12 @@ void UDialogueManager::EndDialogue()
 
 	bIsInDialogue = false;
 	CurrentCharacterId = NAME_None;
+	CurrentCharacter = FCharacterHandle();
 	CurrentNodeId = NAME_None;
+	CurrentTreeIndex = INDEX_NONE;
+	CurrentNodeIndex = INDEX_NONE;
 
+	OnDialogueEndedNative.Broadcast();
 	OnDialogueEnded.Broadcast();
 }
 
@@ -184,12 +245,7 @@ void UDialogueManager::EndDialogue()
 
 bool UDialogueManager::GetCurrentNode(FDialogueNode& OutNode) const
 {
-	if (!bIsInDialogue)
-	{
-		return false;
-	}
-
-	const FDialogueNode* Node = FindNodeById(CurrentNodeId);
+	const FDialogueNode* Node = FindCurrentNode();
 	if (!Node)
 	{
 		return false;
@@ -199,27 +255,32 @@ bool UDialogueManager::GetCurrentNode(FDialogueNode& OutNode) const
 	return true;
 }
 
-TArray<FDialogueChoice> UDialogueManager::GetAvailableChoices() const
+const FDialogueNode* UDialogueManager::FindCurrentNode() const
 {
-	TArray<FDialogueChoice> Result;
-
-	if (!bIsInDialogue)
+	if (!bIsInDialogue || !CurrentTree.Nodes.IsValidIndex(CurrentNodeIndex))
 	{
-		return Result;
+		return nullptr;
 	}
+	return &CurrentTree.Nodes[CurrentNodeIndex];
+}
 
-	const FDialogueNode* CurrentNode = FindNodeById(CurrentNodeId);
+TArray<FDialogueChoice> UDialogueManager::GetAvailableChoices() const
+{
+	TArray<FDialogueChoice> Result;
+
+	const FDialogueNode* CurrentNode = FindCurrentNode();
 	if (!CurrentNode)
 	{
 		return Result;
 	}
 
-	for (const FDialogueChoice& Choice : CurrentNode->Choices)
+	TArray<int32, TInlineAllocator<8>> ChoiceIndices;
+	GetAvailableChoiceIndices(ChoiceIndices);
+
+	Result.Reserve(ChoiceIndices.Num());
+	for (const int32 ChoiceIndex : ChoiceIndices)
 	{
-		if (CanShowChoice(Choice))
-		{
-			Result.Add(Choice);
-		}
+		Result.Add(CurrentNode->Choices[ChoiceIndex]);
 	}
 
 	return Result;
@@ -227,18 +288,64 @@ TArray<FDialogueChoice> UDialogueManager::GetAvailableChoices() const
 
 bool UDialogueManager::HasChoices() const
 {
-	return GetAvailableChoices().Num() > 0;
+	TArray<int32, TInlineAllocator<8>> ChoiceIndices;
+	GetAvailableChoiceIndices(ChoiceIndices);
+	return ChoiceIndices.Num() > 0;
 }
 
 bool UDialogueManager::IsAtEndNode() const
 {
-	if (!bIsInDialogue)
+	const FDialogueNode* CurrentNode = FindCurrentNode();
+	return CurrentNode && CurrentNode->bIsEndNode;
+}
+
+FDialoguePosition UDialogueManager::GetPosition() const
+{
+	FDialoguePosition Position;
+	if (bIsInDialogue)
 	{
-		return false;
+		Position.CharacterId = CurrentCharacterId;
+		Position.NodeId = CurrentNodeId;
 	}
+	return Position;
+}
 
-	const FDialogueNode* CurrentNode = FindNodeById(CurrentNodeId);
-	return CurrentNode && CurrentNode->bIsEndNode;
+void UDialogueManager::RestorePosition(const FDialoguePosition& Position)
+{
+	if (Position.CharacterId.IsNone())
+	{
+		EndDialogue();
+		return;
+	}
+
+	// 別の相手との対話だった場合のみツリーを切り替える
+	if (!bIsInDialogue || CurrentCharacterId != Position.CharacterId)
+	{
+		if (!EnterTree(Position.CharacterId))
+		{
+			UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] 復元先の対話ツリーが見つかりません: %s"),
+				*Position.CharacterId.ToString());
+			EndDialogue();
+			return;
+		}
+	}
+
+	const int32 NodeIndex = FindNodeIndex(Position.NodeId);
+	if (NodeIndex == INDEX_NONE)
+	{
+		UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] 復元先のノードが見つかりません: %s"),
+			*Position.NodeId.ToString());
+		EndDialogue();
+		return;
+	}
+
+	CurrentNodeId = Position.NodeId;
+	CurrentNodeIndex = NodeIndex;
+
+	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] 対話位置を復元: %s / %s"),
+		*CurrentCharacterId.ToString(), *CurrentNodeId.ToString());
+
+	BroadcastCurrentNode();
 }
 
 // ============================================================================
@@ -249,6 +356,9 @@ void UDialogueManager::RegisterDialogueTree(const FDialogueTree& Tree)
 {
 	DialogueTrees.Add(Tree.CharacterId, Tree);
 
+	// 外部から差し替えられたツリーには事前コンパイル済みの条件が無い
+	CompiledTreeIndices.Remove(Tree.CharacterId);
+
 	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] 対話ツリーを登録: %s (%d ノード)"),
 		*Tree.CharacterId.ToString(), Tree.Nodes.Num());
 }
@@ -270,8 +380,8 @@ bool UDialogueManager::GetDialogueTreeForCharacter(FName CharacterId, FDialogueT
 
 void UDialogueManager::GoToNode(FName NodeId)
 {
-	const FDialogueNode* Node = FindNodeById(NodeId);
-	if (!Node)
+	const int32 NodeIndex = FindNodeIndex(NodeId);
+	if (NodeIndex == INDEX_NONE)
 	{
 		UE_LOG(LogLastWitness, Warning, TEXT("[DialogueManager] ノードが見つかりません: %s"),
 			*NodeId.ToString());
@@ -279,9 +389,16 @@ void UDialogueManager::GoToNode(FName NodeId)
 		return;
 	}
 
-	CurrentNodeId = NodeId;
+	GoToNodeIndex(NodeIndex);
+}
+
+void UDialogueManager::GoToNodeIndex(int32 NodeIndex)
+{
+	const FDialogueNode* Node = &CurrentTree.Nodes[NodeIndex];
+	CurrentNodeId = Node->NodeId;
+	CurrentNodeIndex = NodeIndex;
 
-	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] ノード移動: %s"), *NodeId.ToString());
+	UE_LOG(LogLastWitness, Log, TEXT("[DialogueManager] ノード移動: %s"), *CurrentNodeId.ToString());
 
 	// 証拠取得を処理
 	ProcessNodeEvidence(*Node);
@@ -289,27 +406,39 @@ void UDialogueManager::GoToNode(FName NodeId)
 	// フラグ設定を処理
 	if (CaseState)
 	{
-		for (const FName& FlagName : Node->SetsFlags)
+		if (CurrentTreeIndex != INDEX_NONE)
 		{
-			CaseState->SetFlag(FlagName);
+			CaseState->ApplyFlagMask(Definition->GetCompiledNode(CurrentTreeIndex, NodeIndex).SetsFlags);
+		}
+		else
+		{
+			for (const FName& FlagName : Node->SetsFlags)
+			{
+				CaseState->SetFlag(FlagName);
+			}
 		}
 	}
 
 	// イベント発火
-	OnDialogueNodeChanged.Broadcast(*Node);
-
-	// 選択肢を通知（空の場合もUIが古い選択肢をクリアできるように）
-	const TArray<FDialogueChoice> Choices = GetAvailableChoices();
-	OnChoicesAvailable.Broadcast(Choices);
+	BroadcastCurrentNode();
 }
 
-bool UDialogueManager::CanShowChoice(const FDialogueChoice& Choice) const
+bool UDialogueManager::CanShowChoice(const FDialogueChoice& Choice, int32 ChoiceIndex) const
 {
 	if (!CaseState)
 	{
 		return true;
 	}
 
+	// 事件定義由来のツリーはビットマスクの比較だけで判定する
+	if (CurrentTreeIndex != INDEX_NONE)
+	{
+		const FCompiledDialogueChoice& Compiled = Definition->GetCompiledChoice(CurrentTreeIndex, CurrentNodeIndex, ChoiceIndex);
+		return !Compiled.bUnsatisfiable
+			&& CaseState->HasAllEvidenceInMask(Compiled.RequiredEvidence)
+			&& CaseState->HasAllFlagsInMask(Compiled.RequiredFlags);
+	}
+
 	// 必要な証拠をチェック
 	for (const FName& EvidenceId : Choice.RequiredEvidence)
 	{
@@ -340,34 +469,98 @@ void UDialogueManager::ProcessNodeEvidence(const FDialogueNode& Node)
 
 	TArray<FName> GainedIds;
 
-	for (const FName& EvidenceId : Node.GainsEvidence)
+	if (CurrentTreeIndex != INDEX_NONE)
+	{
+		// 事件定義由来のツリーは解決済みのハンドルで収集する（ID は通知用に引くだけ）
+		for (const FEvidenceHandle Evidence : Definition->GetNodeGainedEvidence(CurrentTreeIndex, CurrentNodeIndex))
+		{
+			if (CaseState->CollectEvidence(Evidence))
+			{
+				GainedIds.Add(Definition->GetEvidence(Evidence).EvidenceId);
+			}
+		}
+	}
+	else
 	{
-		if (CaseState->CollectEvidence(EvidenceId))
+		for (const FName& EvidenceId : Node.GainsEvidence)
 		{
-			GainedIds.Add(EvidenceId);
+			if (CaseState->CollectEvidence(EvidenceId))
+			{
+				GainedIds.Add(EvidenceId);
+			}
 		}
 	}
 
 	if (GainedIds.Num() > 0)
 	{
+		OnEvidenceGainedFromDialogueNative.Broadcast(GainedIds);
 		OnEvidenceGainedFromDialogue.Broadcast(GainedIds);
 	}
 }
 
+void UDialogueManager::BroadcastCurrentNode()
+{
+	const FDialogueNode* Node = FindCurrentNode();
+	if (!Node)
+	{
+		return;
+	}
+
+	OnDialogueNodeChangedNative.Broadcast(*Node);
+	if (OnDialogueNodeChanged.IsBound())
+	{
+		OnDialogueNodeChanged.Broadcast(*Node);
+	}
+
+	// 選択肢を通知（空の場合もUIが古い選択肢をクリアできるように）
+	TArray<int32, TInlineAllocator<8>> ChoiceIndices;
+	GetAvailableChoiceIndices(ChoiceIndices);
+	OnChoicesAvailableNative.Broadcast(ChoiceIndices);
+	if (OnChoicesAvailable.IsBound())
+	{
+		OnChoicesAvailable.Broadcast(GetAvailableChoices());
+	}
+}
+
 // ============================================================================
 // Private
 // ============================================================================
 
-const FDialogueNode* UDialogueManager::FindNodeById(FName NodeId) const
+bool UDialogueManager::EnterTree(FName CharacterId)
 {
-	for (const FDialogueNode& Node : CurrentTree.Nodes)
+	const FDialogueTree* Tree = DialogueTrees.Find(CharacterId);
+	if (!Tree)
 	{
-		if (Node.NodeId == NodeId)
-		{
-			return &Node;
-		}
+		return false;
 	}
-	return nullptr;
+
+	CurrentCharacterId = CharacterId;
+	CurrentCharacter = Definition ? Definition->FindCharacter(CharacterId) : FCharacterHandle();
+	CurrentTree = *Tree;
+	const int32* CompiledTreeIndex = CompiledTreeIndices.Find(CharacterId);
+	CurrentTreeIndex = CompiledTreeIndex ? *CompiledTreeIndex : INDEX_NONE;
+	CurrentNodeIndex = INDEX_NONE;
+	bIsInDialogue = true;
+	return true;
+}
+
+int32 UDialogueManager::FindNodeIndex(FName NodeId) const
+{
+	if (CurrentTreeIndex != INDEX_NONE)
+	{
+		return Definition->FindDialogueNodeIndex(CurrentTreeIndex, NodeId);
+	}
+
+	return CurrentTree.Nodes.IndexOfByPredicate([NodeId](const FDialogueNode& Node)
+	{
+		return Node.NodeId == NodeId;
+	});
+}
+
+const FDialogueNode* UDialogueManager::FindNodeById(FName NodeId) const
+{
+	const int32 NodeIndex = FindNodeIndex(NodeId);
+	return NodeIndex != INDEX_NONE ? &CurrentTree.Nodes[NodeIndex] : nullptr;
 }
 
 const FDialogueChoice* UDialogueManager::FindChoiceById(FName ChoiceId) const
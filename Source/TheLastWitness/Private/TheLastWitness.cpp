@@ -1,8 +1,21 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TheLastWitness.h"
+#include "Core/WitnessIds.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, TheLastWitness, "TheLastWitness");
+/// <summary>
+/// ゲームモジュール
+/// </summary>
+class FTheLastWitnessModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		FWitnessIds::Initialize();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE(FTheLastWitnessModule, TheLastWitness, "TheLastWitness");
 
 DEFINE_LOG_CATEGORY(LogLastWitness);
@@ -3,6 +3,7 @@
 #include "UI/MainGameWidget.h"
 #include "Core/WitnessGameMode.h"
 #include "Core/CaseState.h"
+#include "Core/CaseDefinition.h"
 #include "Dialogue/DialogueManager.h"
 #include "AI/ABELSystem.h"
 #include "UI/EvidenceCardWidget.h"
@@ -30,24 +31,28 @@ void UMainGameWidget::SetupWidget(AWitnessGameMode* InGameMode)
 		DialogueManager = GameMode->GetDialogueManager();
 		ABELSystem = GameMode->GetABELSystem();
 
-		// イベントをバインド
-		GameMode->OnPhaseChanged.AddDynamic(this, &UMainGameWidget::OnPhaseChanged);
-		GameMode->OnGameEnded.AddDynamic(this, &UMainGameWidget::OnGameEnded);
+		// イベントをバインド（構造体のコピーを避けるためネイティブ版を使用）
+		GameMode->OnPhaseChangedNative.AddUObject(this, &UMainGameWidget::OnPhaseChanged);
+		GameMode->OnGameEndedNative.AddUObject(this, &UMainGameWidget::OnGameEnded);
 
 		if (DialogueManager)
 		{
-			DialogueManager->OnDialogueNodeChanged.AddDynamic(this, &UMainGameWidget::OnDialogueNodeChanged);
-			DialogueManager->OnChoicesAvailable.AddDynamic(this, &UMainGameWidget::OnChoicesAvailable);
+			DialogueManager->OnDialogueNodeChangedNative.AddUObject(this, &UMainGameWidget::OnDialogueNodeChanged);
+			DialogueManager->OnChoicesAvailableNative.AddUObject(this, &UMainGameWidget::OnChoicesAvailable);
 		}
 
 		if (ABELSystem)
 		{
-			ABELSystem->OnABELSpeaks.AddDynamic(this, &UMainGameWidget::OnABELSpeaks);
+			ABELSystem->OnABELSpeaksNative.AddUObject(this, &UMainGameWidget::OnABELSpeaks);
 		}
 
 		if (CaseState)
 		{
-			CaseState->OnEvidenceCollected.AddDynamic(this, &UMainGameWidget::OnEvidenceCollected);
+			CaseState->OnEvidenceCollectedNative.AddUObject(this, &UMainGameWidget::OnEvidenceCollected);
+			CaseState->OnCharacterMovedNative.AddUObject(this, &UMainGameWidget::OnCharacterMoved);
+			CaseState->OnLocationAccessChangedNative.AddUObject(this, &UMainGameWidget::OnLocationAccessChanged);
+			CaseState->OnProgressRestoredNative.AddUObject(this, &UMainGameWidget::OnProgressRestored);
+			CaseState->OnCaseChangedNative.AddUObject(this, &UMainGameWidget::OnCaseChanged);
 		}
 	}
 
@@ -184,24 +189,28 @@ void UMainGameWidget::NativeDestruct()
 	// イベントのアンバインド
 	if (GameMode)
 	{
-		GameMode->OnPhaseChanged.RemoveDynamic(this, &UMainGameWidget::OnPhaseChanged);
-		GameMode->OnGameEnded.RemoveDynamic(this, &UMainGameWidget::OnGameEnded);
+		GameMode->OnPhaseChangedNative.RemoveAll(this);
+		GameMode->OnGameEndedNative.RemoveAll(this);
 	}
 
 	if (DialogueManager)
 	{
-		DialogueManager->OnDialogueNodeChanged.RemoveDynamic(this, &UMainGameWidget::OnDialogueNodeChanged);
-		DialogueManager->OnChoicesAvailable.RemoveDynamic(this, &UMainGameWidget::OnChoicesAvailable);
+		DialogueManager->OnDialogueNodeChangedNative.RemoveAll(this);
+		DialogueManager->OnChoicesAvailableNative.RemoveAll(this);
 	}
 
 	if (ABELSystem)
 	{
-		ABELSystem->OnABELSpeaks.RemoveDynamic(this, &UMainGameWidget::OnABELSpeaks);
+		ABELSystem->OnABELSpeaksNative.RemoveAll(this);
 	}
 
 	if (CaseState)
 	{
-		CaseState->OnEvidenceCollected.RemoveDynamic(this, &UMainGameWidget::OnEvidenceCollected);
+		CaseState->OnEvidenceCollectedNative.RemoveAll(this);
+		CaseState->OnCharacterMovedNative.RemoveAll(this);
+		CaseState->OnLocationAccessChangedNative.RemoveAll(this);
+		CaseState->OnProgressRestoredNative.RemoveAll(this);
+		CaseState->OnCaseChangedNative.RemoveAll(this);
 	}
 
 	Super::NativeDestruct();
@@ -268,15 +277,24 @@ void UMainGameWidget::OnDialogueNodeChanged(const FDialogueNode& Node)
 	UpdateDialoguePanel();
 }
 
-void UMainGameWidget::OnChoicesAvailable(const TArray<FDialogueChoice>& Choices)
+void UMainGameWidget::OnChoicesAvailable(TConstArrayView<int32> ChoiceIndices)
 {
+	// 選択肢はコピーせず、現在のノードを直接参照する
+	const FDialogueNode* CurrentNode = DialogueManager ? DialogueManager->FindCurrentNode() : nullptr;
+	if (!CurrentNode)
+	{
+		ChoiceIndices = TConstArrayView<int32>();
+	}
+
 	// 選択肢を動的に生成
 	if (ChoicesBox)
 	{
 		ChoicesBox->ClearChildren();
 
-		for (const FDialogueChoice& Choice : Choices)
+		for (const int32 ChoiceIndex : ChoiceIndices)
 		{
+			const FDialogueChoice& Choice = CurrentNode->Choices[ChoiceIndex];
+
 			if (DialogueChoiceClass)
 			{
 				UDialogueChoiceWidget* ChoiceWidget = CreateWidget<UDialogueChoiceWidget>(GetOwningPlayer(), DialogueChoiceClass);
@@ -298,7 +316,7 @@ void UMainGameWidget::OnChoicesAvailable(const TArray<FDialogueChoice>& Choices)
 	if (ContinueDialogueButton)
 	{
 		ContinueDialogueButton->SetVisibility(
-			Choices.Num() > 0 ? ESlateVisibility::Collapsed : ESlateVisibility::Visible
+			ChoiceIndices.Num() > 0 ? ESlateVisibility::Collapsed : ESlateVisibility::Visible
 		);
 	}
 }
@@ -311,10 +329,17 @@ void UMainGameWidget::OnABELSpeaks(const FText& Message)
 	}
 }
 
-void UMainGameWidget::OnEvidenceCollected(const FEvidence& Evidence)
+void UMainGameWidget::OnEvidenceCollected(int32 EvidenceIndex)
 {
+	// まとめるモードではフレームの終わりに OnCaseChanged で一度だけ更新する
+	if (!CaseState || CaseState->IsChangeSetModeEnabled())
+	{
+		return;
+	}
+
 	// 証拠収集通知を表示
-	UE_LOG(LogLastWitness, Log, TEXT("[MainGameWidget] 証拠を収集: %s"), *Evidence.DisplayName.ToString());
+	UE_LOG(LogLastWitness, Log, TEXT("[MainGameWidget] 証拠を収集: %s"),
+		*CaseState->GetCaseData().AllEvidence[EvidenceIndex].DisplayName.ToString());
 
 	// 証拠リストを更新
 	UpdateEvidenceList();
@@ -322,11 +347,75 @@ void UMainGameWidget::OnEvidenceCollected(const FEvidence& Evidence)
 	// 証拠数を更新
 	if (EvidenceCountText && CaseState)
 	{
-		const int32 Count = CaseState->GetCollectedEvidence().Num();
+		const int32 Count = CaseState->GetCollectedEvidenceCount();
+		EvidenceCountText->SetText(FText::FromString(FString::Printf(TEXT("収集済み証拠: %d 件"), Count)));
+	}
+}
+
+void UMainGameWidget::OnCharacterMoved(int32 CharacterIndex, int32 FromLocationIndex, int32 ToLocationIndex)
+{
+	if (!CaseState || CaseState->IsChangeSetModeEnabled())
+	{
+		return;
+	}
+
+	// 現在地に出入りした場合のみキャラクター一覧を作り直す
+	const int32 CurrentLocationIndex = CaseState->GetDefinition()->FindLocationIndex(CaseState->GetCurrentLocation());
+	if (FromLocationIndex == CurrentLocationIndex || ToLocationIndex == CurrentLocationIndex)
+	{
+		UpdateCharacterList();
+	}
+}
+
+void UMainGameWidget::OnLocationAccessChanged(int32 LocationIndex, bool bAccessible)
+{
+	if (!CaseState || CaseState->IsChangeSetModeEnabled())
+	{
+		return;
+	}
+
+	UpdateLocationPanel();
+}
+
+void UMainGameWidget::OnProgressRestored()
+{
+	// 巻き戻し後は差分ではなく全体を描画し直す
+	UpdateLocationPanel();
+	UpdateEvidenceList();
+	UpdateCharacterList();
+
+	if (EvidenceCountText && CaseState)
+	{
+		const int32 Count = CaseState->GetCollectedEvidenceCount();
 		EvidenceCountText->SetText(FText::FromString(FString::Printf(TEXT("収集済み証拠: %d 件"), Count)));
 	}
 }
 
+void UMainGameWidget::OnCaseChanged(const FCaseChangeSet& Changes)
+{
+	// 同じフレーム内の複数の変更に対して、各パネルを一度だけ更新する
+	if (Changes.HasChanged(ECaseChangeFlags::Location))
+	{
+		UpdateLocationPanel();
+	}
+
+	if (Changes.HasChanged(ECaseChangeFlags::Evidence))
+	{
+		UpdateEvidenceList();
+
+		if (EvidenceCountText && CaseState)
+		{
+			const int32 Count = CaseState->GetCollectedEvidenceCount();
+			EvidenceCountText->SetText(FText::FromString(FString::Printf(TEXT("収集済み証拠: %d 件"), Count)));
+		}
+	}
+
+	if (Changes.HasChanged(ECaseChangeFlags::Characters))
+	{
+		UpdateCharacterList();
+	}
+}
+
 void UMainGameWidget::OnGameEnded(const FGameResult& Result)
 {
 	UE_LOG(LogLastWitness, Log, TEXT("[MainGameWidget] ゲーム終了 - 正解: %s"), Result.bCorrectCulprit ? TEXT("はい") : TEXT("いいえ"));
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Core/WitnessTypes.h"
+#include "Core/CaseProgress.h"
+#include "Core/CaseSolver.h"
 #include "ABELSystem.generated.h"
 
 class UCaseState;
@@ -14,6 +16,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnABELSuggestionReady, const FABELS
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnABELSpeaks, const FText&, Message);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnABELDispositionChanged, EABELDisposition, NewDisposition);
 
+// C++ 向けのネイティブ版（提案は CurrentSuggestions 内の要素への参照を渡します）
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnABELSuggestionReadyNative, const FABELSuggestion& /* Suggestion */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnABELSpeaksNative, const FText& /* Message */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnABELDispositionChangedNative, EABELDisposition /* NewDisposition */);
+
 /// <summary>
 /// ABELシステム - AI分析パートナー
 /// </summary>
@@ -141,6 +148,11 @@ public:
 	UFUNCTION(BlueprintPure, Category = "ABEL")
 	int32 GetRelationshipValue() const { return RelationshipValue; }
 
+	/// <summary>
+	/// 関係値を復元し、性格傾向を再計算します（セーブデータの読み込み用）
+	/// </summary>
+	void RestoreRelationshipValue(int32 InRelationshipValue);
+
 	/// <summary>
 	/// ABELが「話したい」状態かどうか
 	/// </summary>
@@ -185,6 +197,17 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnABELDispositionChanged OnDispositionChanged;
 
+	// ネイティブ版（C++ のリスナーはこちらを使用してください）
+
+	/// <summary>提案が準備できた時に発火</summary>
+	FOnABELSuggestionReadyNative OnSuggestionReadyNative;
+
+	/// <summary>ABELが発言する時に発火</summary>
+	FOnABELSpeaksNative OnABELSpeaksNative;
+
+	/// <summary>性格傾向が変化した時に発火</summary>
+	FOnABELDispositionChangedNative OnDispositionChangedNative;
+
 protected:
 	/// <summary>
 	/// スクリプト化された提案を生成します
@@ -206,6 +229,11 @@ protected:
 	/// </summary>
 	void GenerateNextActionSuggestions();
 
+	/// <summary>
+	/// 解決手順の1ステップを提案文にします（該当しない手順なら空）
+	/// </summary>
+	FText DescribeSolutionStep(const FCaseSolutionStep& Step) const;
+
 	/// <summary>
 	/// 性格傾向を更新します
 	/// </summary>
@@ -251,9 +279,25 @@ protected:
 	/// <summary>提案ID用のカウンター</summary>
 	int32 SuggestionCounter = 0;
 
+	/// <summary>
+	/// 告発までの手順を取得します（進行状態が変わっていなければ前回の解析結果を使います）
+	/// </summary>
+	const FCaseReachability& GetHintReachability();
+
+	/// <summary>前回ヒントを解析した時点の進行状態（セクションを共有するだけなので O(1)）</summary>
+	TOptional<FCaseProgress> HintProgress;
+
+	/// <summary>前回の解析結果</summary>
+	FCaseReachability HintReachability;
+
 private:
 	/// <summary>
 	/// 一意の提案IDを生成します
 	/// </summary>
 	FName GenerateSuggestionId();
+
+	/// <summary>
+	/// CaseState からの証拠収集の通知（対話で得た証拠も含む）
+	/// </summary>
+	void HandleEvidenceCollected(int32 EvidenceIndex);
 };
@@ -7,6 +7,8 @@
 #include "Interfaces/IHttpRequest.h"
 #include "LLMIntegration.generated.h"
 
+struct FCaseSnapshot;
+
 /// <summary>
 /// LLMプロバイダーの種類
 /// </summary>
@@ -105,6 +107,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "LLM")
 	static FString GetABELSystemPrompt();
 
+	/// <summary>
+	/// 事件の進行状況をプロンプト用のテキストにまとめます
+	/// </summary>
+	/// <remarks>
+	/// 公開済みのスナップショットだけを読むため、ワーカースレッドで組み立てられます。
+	/// </remarks>
+	static FString BuildCaseContextPrompt(const FCaseSnapshot& Snapshot);
+
 	/// <summary>
 	/// 接続をテストします
 	/// </summary>
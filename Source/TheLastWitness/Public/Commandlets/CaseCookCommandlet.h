@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CaseCookCommandlet.generated.h"
+
+/// <summary>
+/// コードで作成した事件データをクック済みのバイナリ形式に書き出すコマンドレット
+/// </summary>
+/// <remarks>
+/// エディタのビルド後に、クック済みファイルのソースハッシュが古ければ自動で実行されます（TheLastWitnessEditor.Target.cs）。
+/// 古いファイルは読み込み時に警告して無視されます。
+/// 使い方: UnrealEditor-Cmd.exe TheLastWitness.uproject -run=CaseCook [-Output=ディレクトリ]
+/// 出力先の既定は Content/Cases です（DefaultGame.ini でパッケージに含める設定にしています）。
+/// </remarks>
+UCLASS()
+class THELASTWITNESS_API UCaseCookCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCaseCookCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
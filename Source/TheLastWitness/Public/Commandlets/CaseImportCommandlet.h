@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CaseImportCommandlet.generated.h"
+
+struct FCaseData;
+class FJsonObject;
+
+/// <summary>
+/// JSON/CSV の事件ソースを事件データアセット（UCaseDataAsset）に変換するコマンドレット
+/// </summary>
+/// <remarks>
+/// ソースディレクトリの &lt;名前&gt;.json が1つの事件で、FCaseData と同じ構造のJSONです。
+/// 同じ名前の &lt;名前&gt;.dialogue.csv（列: TreeId, NodeId, ChoiceId, Text）があれば、
+/// 対話ノード（ChoiceId が空の場合）または選択肢の文言をその内容で上書きします。
+/// 事件データの構造に無いJSONのキーと、参照の整合性（証拠・キャラクター・推理・ノードID、設定されないフラグ）をインポート時に検証し、
+/// 問題のある事件はアセットを更新しません。ソースのハッシュがアセットと一致する事件は処理を省きます。
+/// 使い方: UnrealEditor-Cmd.exe TheLastWitness.uproject -run=CaseImport [-Source=ディレクトリ] [-Force] [-Export]
+/// -Export はコードで作成した既存の事件をソースディレクトリにJSONとして書き出します（移行用）。
+/// 1件でも失敗すれば 1 を返します。
+/// </remarks>
+UCLASS()
+class THELASTWITNESS_API UCaseImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCaseImportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/// <summary>
+	/// インポートしたアセットの保存先
+	/// </summary>
+	static const TCHAR* AssetRoot;
+
+	/// <summary>
+	/// 事件データ内のIDの参照と列挙値が全て解決できるか検証します
+	/// </summary>
+	/// <remarks>
+	/// 事件データ内のどこでも設定されないフラグを条件にしている場合は、Blueprint から設定される可能性があるため
+	/// エラーではなく警告として OutWarnings に追加します。
+	/// </remarks>
+	/// <returns>エラーが無ければ true</returns>
+	static bool ValidateReferences(const FCaseData& CaseData, TArray<FString>& OutErrors, TArray<FString>& OutWarnings);
+
+private:
+	/// <summary>
+	/// 1つの事件ソースをインポートします
+	/// </summary>
+	/// <returns>失敗した場合は false（変更が無く省いた場合は true）</returns>
+	bool ImportCase(const FString& JsonPath, bool bForce) const;
+
+	/// <summary>
+	/// JSONのキーが構造体のプロパティに存在するか、入れ子の構造体と配列の要素まで再帰的に確認します
+	/// </summary>
+	/// <remarks>
+	/// 存在しないキーは "allEvidence[2].foundAt" のようなパスで OutErrors に追加します。
+	/// </remarks>
+	static void CheckJsonKeys(const FJsonObject& Object, const UStruct* Struct, const FString& Path, TArray<FString>& OutErrors);
+
+	/// <summary>
+	/// 対話の文言の CSV を事件データに適用します
+	/// </summary>
+	static bool ApplyDialogueCsv(const FString& CsvText, FCaseData& CaseData, TArray<FString>& OutErrors);
+
+	/// <summary>
+	/// コードで作成した既存の事件をJSONとして書き出します
+	/// </summary>
+	bool ExportBuiltInCases(const FString& SourceDir) const;
+};
@@ -0,0 +1,43 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CaseValidationCommandlet.generated.h"
+
+struct FCaseData;
+
+/// <summary>
+/// 事件データが最初から最後まで解決可能かを検証するコマンドレット
+/// </summary>
+/// <remarks>
+/// クック前やCIで実行し、告発条件を満たせない事件や到達できない対話・証拠を検出します。
+/// コードで作成する事件に加え、アセットマネージャーに登録された全ての事件データアセット（CaseImport で作成した事件）を検証します。
+/// 使い方: UnrealEditor-Cmd.exe TheLastWitness.uproject -run=CaseValidation [-ShowPlan] [-Stress=倍率 [-Seed=シード]]
+/// -Stress を指定すると、出荷している事件の指定倍の規模で生成した負荷試験用の事件も検証し、処理時間を計測します。
+/// 解決できない事件や読み込めない事件データアセットが1つでもあれば 1 を返します。
+/// </remarks>
+UCLASS()
+class THELASTWITNESS_API UCaseValidationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCaseValidationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/// <summary>
+	/// アセットマネージャーに登録された事件データアセットの事件データを集めます
+	/// </summary>
+	/// <returns>全て読み込めた場合は true</returns>
+	bool CollectCaseAssets(TArray<FCaseData>& OutCases) const;
+
+	/// <summary>
+	/// 1つの事件を初期状態から解析し、結果をログに出力します
+	/// </summary>
+	/// <returns>解決可能なら true</returns>
+	bool ValidateCase(FCaseData CaseData, bool bShowPlan) const;
+};
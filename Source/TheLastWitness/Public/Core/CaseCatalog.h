@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WitnessTypes.h"
+#include "CaseCatalog.generated.h"
+
+class FCaseDefinition;
+struct FStreamableHandle;
+
+/// <summary>
+/// 事件の読み込み完了時の通知（失敗した場合は無効なポインタ）
+/// </summary>
+DECLARE_DELEGATE_OneParam(FOnCaseDefinitionLoaded, TSharedPtr<const FCaseDefinition>);
+
+/// <summary>
+/// カタログに載っている事件の概要
+/// </summary>
+/// <remarks>
+/// アセットレジストリのタグから作成するため、事件の本体を読み込まずに取得できます。
+/// </remarks>
+USTRUCT(BlueprintType)
+struct FCaseCatalogEntry
+{
+	GENERATED_BODY()
+
+	/// <summary>事件ID</summary>
+	UPROPERTY(BlueprintReadOnly)
+	FName CaseId;
+
+	/// <summary>事件データアセットのID</summary>
+	UPROPERTY(BlueprintReadOnly)
+	FPrimaryAssetId AssetId;
+
+	/// <summary>タイトル</summary>
+	UPROPERTY(BlueprintReadOnly)
+	FText Title;
+
+	/// <summary>あらすじ</summary>
+	UPROPERTY(BlueprintReadOnly)
+	FText Synopsis;
+
+	/// <summary>キャラクター数</summary>
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumCharacters = 0;
+
+	/// <summary>証拠数</summary>
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumEvidence = 0;
+
+	/// <summary>推理数</summary>
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumDeductions = 0;
+};
+
+/// <summary>
+/// 事件データアセット（UCaseDataAsset）のカタログ
+/// </summary>
+/// <remarks>
+/// アセットマネージャーに登録された "Case" 型のプライマリアセットを列挙し、
+/// 選択された事件だけを非同期に読み込みます。
+/// 読み込んだアセットは事件定義を作成した時点でアンロードし、事件定義は事件を切り替えると解放されるため、
+/// 同時にメモリ上にある事件は常に1つです（カタログの規模に関わらずメモリの上限は変わりません）。
+/// 事件定義の構築はワーカースレッドで行うので、大きな事件でもメニューは操作できるままです。
+/// DLCの事件は AddSearchPath() でマウントしたパスを追加してください。
+/// </remarks>
+UCLASS()
+class THELASTWITNESS_API UCaseCatalog : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// ========================================================================
+	// カタログ
+	// ========================================================================
+
+	/// <summary>
+	/// アセットレジストリから事件の一覧を作り直します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Case Catalog")
+	void Refresh();
+
+	/// <summary>
+	/// 事件の一覧を取得します（初回は Refresh() を行います）
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Case Catalog")
+	const TArray<FCaseCatalogEntry>& GetEntries();
+
+	/// <summary>
+	/// 事件の概要を取得します
+	/// </summary>
+	/// <returns>カタログに無い場合は false</returns>
+	UFUNCTION(BlueprintCallable, Category = "Case Catalog")
+	bool FindEntry(FName CaseId, FCaseCatalogEntry& OutEntry);
+
+	/// <summary>
+	/// 事件データアセットを探すパスを追加し、一覧を作り直します（DLC用）
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Case Catalog")
+	void AddSearchPath(const FString& Path);
+
+	// ========================================================================
+	// 読み込み
+	// ========================================================================
+
+	/// <summary>
+	/// 事件を非同期に読み込み、事件定義を作成します
+	/// </summary>
+	/// <remarks>
+	/// 読み込み中に呼ぶと、先の読み込みは取り消されます（先の完了通知は呼ばれません）。
+	/// 完了通知はゲームスレッドで呼ばれます。
+	/// </remarks>
+	/// <returns>カタログに無い事件なら false（完了通知は呼ばれません）</returns>
+	bool LoadCaseAsync(FName CaseId, FOnCaseDefinitionLoaded OnLoaded);
+
+	/// <summary>
+	/// 事件を同期的に読み込みます（セーブデータの読み込み等、すぐに事件定義が必要な場合用）
+	/// </summary>
+	/// <remarks>
+	/// 非同期の読み込み中であれば取り消します。
+	/// </remarks>
+	TSharedPtr<const FCaseDefinition> LoadCaseSynchronous(FName CaseId);
+
+	/// <summary>
+	/// 読み込み中の事件を取り消します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Case Catalog")
+	void CancelPendingLoad();
+
+	/// <summary>
+	/// 事件を読み込み中か確認します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Case Catalog")
+	bool IsLoading() const { return PendingCallback.IsBound(); }
+
+private:
+	/// <summary>
+	/// 事件IDからアセットIDを取得します（一覧に無ければ無効なID）
+	/// </summary>
+	FPrimaryAssetId FindAssetId(FName CaseId);
+
+	/// <summary>
+	/// アセットの読み込み完了時（ゲームスレッド）
+	/// </summary>
+	void HandleAssetLoaded(FPrimaryAssetId AssetId, uint32 Serial);
+
+	/// <summary>
+	/// 読み込み済みのアセットから事件データを取り出し、アセットをアンロードします
+	/// </summary>
+	/// <returns>アセットが無い場合は false</returns>
+	static bool TakeCaseData(FPrimaryAssetId AssetId, FCaseData& OutCaseData);
+
+	/// <summary>事件の一覧</summary>
+	UPROPERTY()
+	TArray<FCaseCatalogEntry> Entries;
+
+	bool bEntriesValid = false;
+
+	/// <summary>読み込み中のアセット</summary>
+	TSharedPtr<FStreamableHandle> PendingHandle;
+
+	/// <summary>読み込み中の事件の完了通知</summary>
+	FOnCaseDefinitionLoaded PendingCallback;
+
+	/// <summary>読み込み要求の通し番号（取り消された読み込みの完了を無視するため）</summary>
+	uint32 LoadSerial = 0;
+};
@@ -0,0 +1,181 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FCaseDefinition;
+
+/// <summary>
+/// 前提から自動的に導かれる推理（導出規則）の前向き連鎖用テーブル
+/// </summary>
+/// <remarks>
+/// EvidenceA・EvidenceB が空の推理を1つの規則とし、PremiseEvidence と PremiseDeductions を前提とします。
+/// 証拠・推理ごとに「それを前提に含む規則」の一覧を CSR 形式で持ち（Rete のアルファネットワークに相当）、
+/// 実行時は規則ごとの未成立の前提数だけを状態として保持します。
+/// 新しい事実が成立したら、その事実を前提に含む規則の残り数だけを減らし、0 になった規則の推理を成立させます。
+/// 成立した推理がさらに別の規則の前提になるため、1回の事実の追加にかかる時間は
+/// 規則の総数ではなく、連鎖で影響を受けた規則の数に比例します。
+/// 存在しないIDを前提に含む規則、前提が空の規則、自身を前提に含む規則は作成しません（決して成立しません）。
+/// </remarks>
+class THELASTWITNESS_API FCaseDeductionChain
+{
+public:
+	/// <summary>
+	/// 事件定義から規則と前提の索引を構築します
+	/// </summary>
+	void Build(const FCaseDefinition& Definition);
+
+	// ========================================================================
+	// 規則
+	// ========================================================================
+
+	int32 NumRules() const { return RuleDeduction.Num(); }
+
+	/// <summary>
+	/// 規則が導く推理のインデックスを取得します
+	/// </summary>
+	int32 GetRuleDeduction(int32 Rule) const { return RuleDeduction[Rule]; }
+
+	/// <summary>
+	/// 推理を導く規則を取得します（導出規則でなければ INDEX_NONE）
+	/// </summary>
+	int32 FindRuleForDeduction(int32 DeductionIndex) const { return DeductionRule[DeductionIndex]; }
+
+	/// <summary>
+	/// 規則の前提となる証拠のインデックスを取得します（重複なし）
+	/// </summary>
+	TConstArrayView<int32> GetPremiseEvidence(int32 Rule) const
+	{
+		return MakeArrayView(PremiseEvidence.GetData() + PremiseEvidenceStart[Rule], PremiseEvidenceStart[Rule + 1] - PremiseEvidenceStart[Rule]);
+	}
+
+	/// <summary>
+	/// 規則の前提となる推理のインデックスを取得します（重複なし）
+	/// </summary>
+	TConstArrayView<int32> GetPremiseDeductions(int32 Rule) const
+	{
+		return MakeArrayView(PremiseDeductions.GetData() + PremiseDeductionStart[Rule], PremiseDeductionStart[Rule + 1] - PremiseDeductionStart[Rule]);
+	}
+
+	// ========================================================================
+	// 前提の索引
+	// ========================================================================
+
+	/// <summary>
+	/// 証拠を前提に含む規則を取得します
+	/// </summary>
+	TConstArrayView<int32> GetRulesUsingEvidence(int32 EvidenceIndex) const
+	{
+		return MakeArrayView(EvidenceRules.GetData() + EvidenceRuleStart[EvidenceIndex], EvidenceRuleStart[EvidenceIndex + 1] - EvidenceRuleStart[EvidenceIndex]);
+	}
+
+	/// <summary>
+	/// 推理を前提に含む規則を取得します
+	/// </summary>
+	TConstArrayView<int32> GetRulesUsingDeduction(int32 DeductionIndex) const
+	{
+		return MakeArrayView(DeductionRules.GetData() + DeductionRuleStart[DeductionIndex], DeductionRuleStart[DeductionIndex + 1] - DeductionRuleStart[DeductionIndex]);
+	}
+
+	// ========================================================================
+	// 実行時の伝播
+	// ========================================================================
+
+	/// <summary>
+	/// 進行状態から規則ごとの未成立の前提数を数え直します
+	/// </summary>
+	/// <param name="Evidence">収集済みの証拠のビット列</param>
+	/// <param name="Deductions">解放済みの推理のビット列</param>
+	/// <param name="OutRemaining">規則ごとの未成立の前提数</param>
+	/// <param name="OutReadyRules">前提が揃っているのに推理がまだ成立していない規則</param>
+	template <typename AllocatorType>
+	void CountRemainingPremises(const TBitArray<>& Evidence, const TBitArray<>& Deductions, TArray<int32>& OutRemaining, TArray<int32, AllocatorType>& OutReadyRules) const
+	{
+		OutRemaining.SetNumUninitialized(NumRules());
+		for (int32 Rule = 0; Rule < NumRules(); Rule++)
+		{
+			int32 Remaining = 0;
+			for (const int32 EvidenceIndex : GetPremiseEvidence(Rule))
+			{
+				Remaining += Evidence[EvidenceIndex] ? 0 : 1;
+			}
+			for (const int32 DeductionIndex : GetPremiseDeductions(Rule))
+			{
+				Remaining += Deductions[DeductionIndex] ? 0 : 1;
+			}
+			OutRemaining[Rule] = Remaining;
+
+			if (Remaining == 0 && !Deductions[RuleDeduction[Rule]])
+			{
+				OutReadyRules.Add(Rule);
+			}
+		}
+	}
+
+	/// <summary>
+	/// 証拠が新たに成立したことを伝え、前提が揃った規則を OutReadyRules に追加します
+	/// </summary>
+	template <typename AllocatorType>
+	void SatisfyEvidence(int32 EvidenceIndex, TArray<int32>& Remaining, TArray<int32, AllocatorType>& OutReadyRules) const
+	{
+		Satisfy(GetRulesUsingEvidence(EvidenceIndex), Remaining, OutReadyRules);
+	}
+
+	/// <summary>
+	/// 推理が新たに成立したことを伝え、前提が揃った規則を OutReadyRules に追加します
+	/// </summary>
+	template <typename AllocatorType>
+	void SatisfyDeduction(int32 DeductionIndex, TArray<int32>& Remaining, TArray<int32, AllocatorType>& OutReadyRules) const
+	{
+		Satisfy(GetRulesUsingDeduction(DeductionIndex), Remaining, OutReadyRules);
+	}
+
+	/// <summary>
+	/// ヒープ上で使用しているバイト数を取得します
+	/// </summary>
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	template <typename AllocatorType>
+	static void Satisfy(TConstArrayView<int32> Rules, TArray<int32>& Remaining, TArray<int32, AllocatorType>& OutReadyRules)
+	{
+		for (const int32 Rule : Rules)
+		{
+			if (--Remaining[Rule] == 0)
+			{
+				OutReadyRules.Add(Rule);
+			}
+		}
+	}
+
+	/// <summary>規則ごとの推理のインデックス</summary>
+	TArray<int32> RuleDeduction;
+
+	/// <summary>推理ごとの規則（導出規則でなければ INDEX_NONE）</summary>
+	TArray<int32> DeductionRule;
+
+	/// <summary>規則ごとの PremiseEvidence 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> PremiseEvidenceStart;
+
+	/// <summary>前提となる証拠（規則順に連結）</summary>
+	TArray<int32> PremiseEvidence;
+
+	/// <summary>規則ごとの PremiseDeductions 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> PremiseDeductionStart;
+
+	/// <summary>前提となる推理（規則順に連結）</summary>
+	TArray<int32> PremiseDeductions;
+
+	/// <summary>証拠ごとの EvidenceRules 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> EvidenceRuleStart;
+
+	/// <summary>証拠を前提に含む規則（証拠順に連結）</summary>
+	TArray<int32> EvidenceRules;
+
+	/// <summary>推理ごとの DeductionRules 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> DeductionRuleStart;
+
+	/// <summary>推理を前提に含む規則（推理順に連結）</summary>
+	TArray<int32> DeductionRules;
+};
@@ -0,0 +1,543 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WitnessTypes.h"
+#include "CaseHandles.h"
+#include "CaseRelationGraph.h"
+#include "CaseDeductionChain.h"
+#include "CaseTriggerIndex.h"
+#include "CaseSolver.h"
+
+/// <summary>
+/// 事前コンパイル済みのビットマスク
+/// </summary>
+/// <remarks>
+/// 実体は FCaseDefinition が持つワードプール内にあり、ここにはその位置だけを保持します。
+/// ワード幅は対象となるビット列（フラグ / 証拠）の長さに一致します。
+/// </remarks>
+struct FCompiledMask
+{
+	/// <summary>ワードプール内の先頭位置（INDEX_NONE なら空マスク）</summary>
+	int32 Offset = INDEX_NONE;
+
+	bool IsEmpty() const { return Offset == INDEX_NONE; }
+};
+
+/// <summary>
+/// 事前コンパイル済みの対話選択肢
+/// </summary>
+struct FCompiledDialogueChoice
+{
+	/// <summary>表示に必要なフラグ</summary>
+	FCompiledMask RequiredFlags;
+
+	/// <summary>表示に必要な証拠</summary>
+	FCompiledMask RequiredEvidence;
+
+	/// <summary>選択時に設定されるフラグ</summary>
+	FCompiledMask SetsFlags;
+
+	/// <summary>遷移先のツリー内ノードインデックス（存在しないノードなら INDEX_NONE）</summary>
+	int32 NextNode = INDEX_NONE;
+
+	/// <summary>存在しない証拠を要求しているため決して表示されない</summary>
+	bool bUnsatisfiable = false;
+};
+
+/// <summary>
+/// 事前コンパイル済みの対話ノード
+/// </summary>
+struct FCompiledDialogueNode
+{
+	/// <summary>到達時に設定されるフラグ</summary>
+	FCompiledMask SetsFlags;
+
+	/// <summary>ChoiceData 内の最初の選択肢の位置</summary>
+	int32 FirstChoice = 0;
+
+	/// <summary>選択肢がない場合の遷移先のツリー内ノードインデックス（存在しないノードなら INDEX_NONE）</summary>
+	int32 NextNode = INDEX_NONE;
+
+	/// <summary>NodeGainedEvidence 内の最初の証拠の位置</summary>
+	int32 FirstGainedEvidence = 0;
+
+	/// <summary>到達時に得られる証拠の数（存在しない証拠は除外）</summary>
+	int32 NumGainedEvidence = 0;
+};
+
+/// <summary>
+/// 事前コンパイル済みの対話ツリー
+/// </summary>
+struct FCompiledDialogueTree
+{
+	/// <summary>ノードID → Nodes のインデックス</summary>
+	TMap<FName, int32> NodeIndexMap;
+
+	/// <summary>NodeData 内の最初のノードの位置</summary>
+	int32 FirstNode = 0;
+};
+
+/// <summary>
+/// 事前コンパイル済みのキャラクターの移動予定
+/// </summary>
+struct FCompiledScheduleEntry
+{
+	/// <summary>移動するゲーム内時刻（分）</summary>
+	int32 AtMinute = 0;
+
+	/// <summary>移動するキャラクター</summary>
+	int32 CharacterIndex = INDEX_NONE;
+
+	/// <summary>移動先のロケーション</summary>
+	int32 LocationIndex = INDEX_NONE;
+};
+
+/// <summary>
+/// 読み取り専用の事件定義
+/// </summary>
+/// <remarks>
+/// 作成後は一切変更されないため、複数の UCaseState から共有できます。
+/// 収集状態や信頼度などの実行時の進行状態は FCaseProgress が保持し、
+/// FCaseData 内の bIsCollected 等の実行時フィールドは参照されません。
+/// </remarks>
+class THELASTWITNESS_API FCaseDefinition
+{
+public:
+	/// <summary>
+	/// 事件データから定義を作成します
+	/// </summary>
+	/// <param name="InData">事件データ（ムーブで受け取るとコピーを避けられます）</param>
+	static TSharedRef<const FCaseDefinition> Create(FCaseData InData);
+
+	/// <summary>
+	/// 元の事件データを取得します
+	/// </summary>
+	const FCaseData& GetData() const { return Data; }
+
+	// ========================================================================
+	// 要素数
+	// ========================================================================
+
+	int32 NumEvidence() const { return Data.AllEvidence.Num(); }
+	int32 NumCharacters() const { return Data.AllCharacters.Num(); }
+	int32 NumLocations() const { return Data.AllLocations.Num(); }
+	int32 NumDeductions() const { return Data.AllDeductions.Num(); }
+	int32 NumFlags() const { return FlagNames.Num(); }
+	int32 NumTriggers() const { return Data.Triggers.Num(); }
+
+	// ========================================================================
+	// ID検索（全て O(1)）
+	// ========================================================================
+
+	/// <summary>
+	/// 証拠IDから AllEvidence のインデックスを取得します
+	/// </summary>
+	int32 FindEvidenceIndex(FName EvidenceId) const;
+
+	/// <summary>
+	/// キャラクターIDから AllCharacters のインデックスを取得します
+	/// </summary>
+	int32 FindCharacterIndex(FName CharacterId) const;
+
+	/// <summary>
+	/// ロケーションから AllLocations のインデックスを取得します
+	/// </summary>
+	int32 FindLocationIndex(ELocation Location) const;
+
+	/// <summary>
+	/// 推理IDから AllDeductions のインデックスを取得します
+	/// </summary>
+	int32 FindDeductionIndex(FName DeductionId) const;
+
+	/// <summary>
+	/// 2つの証拠から成立する推理のインデックスを取得します（順序は問いません）
+	/// </summary>
+	int32 FindDeductionByEvidencePair(int32 EvidenceIndexA, int32 EvidenceIndexB) const;
+
+	/// <summary>
+	/// 証拠インデックスの組から順序に依存しないキーを作ります
+	/// </summary>
+	static uint64 MakeEvidencePairKey(int32 EvidenceIndexA, int32 EvidenceIndexB);
+
+	// ========================================================================
+	// ハンドル
+	// ========================================================================
+
+	// FName からの変換は作成データ・Blueprint との境界で一度だけ行い、以降はハンドルで扱います。
+	// Get 系の関数は有効なハンドルが渡される前提で、範囲外のチェックは行いません。
+
+	FEvidenceHandle FindEvidence(FName EvidenceId) const { return FEvidenceHandle(FindEvidenceIndex(EvidenceId)); }
+	FCharacterHandle FindCharacter(FName CharacterId) const { return FCharacterHandle(FindCharacterIndex(CharacterId)); }
+	FLocationHandle FindLocation(ELocation Location) const { return FLocationHandle(FindLocationIndex(Location)); }
+	FDeductionHandle FindDeduction(FName DeductionId) const { return FDeductionHandle(FindDeductionIndex(DeductionId)); }
+	FFlagHandle FindFlag(FName FlagName) const { return FFlagHandle(FindFlagIndex(FlagName)); }
+	FDialogueTreeHandle FindDialogueTree(FName CharacterId) const { return FDialogueTreeHandle(FindDialogueTreeIndex(CharacterId)); }
+
+	/// <summary>
+	/// 2つの証拠から成立する推理を取得します（順序は問いません）
+	/// </summary>
+	FDeductionHandle FindDeductionByEvidencePair(FEvidenceHandle EvidenceA, FEvidenceHandle EvidenceB) const
+	{
+		return FDeductionHandle(FindDeductionByEvidencePair(EvidenceA.GetIndex(), EvidenceB.GetIndex()));
+	}
+
+	/// <summary>
+	/// ツリー内のノードを取得します
+	/// </summary>
+	FDialogueNodeHandle FindDialogueNode(FDialogueTreeHandle Tree, FName NodeId) const
+	{
+		const int32 NodeIndex = FindDialogueNodeIndex(Tree.GetIndex(), NodeId);
+		return NodeIndex != INDEX_NONE ? FDialogueNodeHandle(TreeData[Tree.GetIndex()].FirstNode + NodeIndex) : FDialogueNodeHandle();
+	}
+
+	/// <summary>
+	/// 外部から渡されたハンドルがこの事件定義の要素を指しているか確認します
+	/// </summary>
+	bool IsValidHandle(FEvidenceHandle Handle) const { return Handle.IsValid() && Handle.GetIndex() < NumEvidence(); }
+	bool IsValidHandle(FCharacterHandle Handle) const { return Handle.IsValid() && Handle.GetIndex() < NumCharacters(); }
+	bool IsValidHandle(FLocationHandle Handle) const { return Handle.IsValid() && Handle.GetIndex() < NumLocations(); }
+	bool IsValidHandle(FDeductionHandle Handle) const { return Handle.IsValid() && Handle.GetIndex() < NumDeductions(); }
+	bool IsValidHandle(FFlagHandle Handle) const { return Handle.IsValid() && Handle.GetIndex() < NumFlags(); }
+
+	const FEvidence& GetEvidence(FEvidenceHandle Handle) const { return Data.AllEvidence[Handle.GetIndex()]; }
+	const FCharacterData& GetCharacter(FCharacterHandle Handle) const { return Data.AllCharacters[Handle.GetIndex()]; }
+	const FLocationData& GetLocation(FLocationHandle Handle) const { return Data.AllLocations[Handle.GetIndex()]; }
+	const FDeduction& GetDeduction(FDeductionHandle Handle) const { return Data.AllDeductions[Handle.GetIndex()]; }
+	FName GetFlagName(FFlagHandle Handle) const { return FlagNames[Handle.GetIndex()]; }
+	const FCompiledDialogueNode& GetCompiledNode(FDialogueNodeHandle Handle) const { return NodeData[Handle.GetIndex()]; }
+	const FCompiledDialogueChoice& GetCompiledChoice(FDialogueChoiceHandle Handle) const { return ChoiceData[Handle.GetIndex()]; }
+
+	// ========================================================================
+	// 集計用テーブル
+	// ========================================================================
+
+	/// <summary>
+	/// 証拠を AvailableEvidence に含むロケーションのインデックス一覧を取得します
+	/// </summary>
+	TArrayView<const int32> GetLocationsListingEvidence(int32 EvidenceIndex) const
+	{
+		return MakeArrayView(EvidenceLocationList.GetData() + EvidenceLocationStart[EvidenceIndex],
+			EvidenceLocationStart[EvidenceIndex + 1] - EvidenceLocationStart[EvidenceIndex]);
+	}
+
+	/// <summary>
+	/// ロケーションに置かれた証拠の数を取得します（重複・存在しないIDは除外）
+	/// </summary>
+	int32 GetEvidenceCountAt(int32 LocationIndex) const { return LocationEvidenceCounts[LocationIndex]; }
+
+	/// <summary>
+	/// 告発に必要な証拠か確認します
+	/// </summary>
+	bool IsRequiredForAccusation(int32 EvidenceIndex) const { return RequiredForAccusation[EvidenceIndex]; }
+
+	/// <summary>
+	/// 告発に必要な条件の数を取得します
+	/// </summary>
+	/// <remarks>
+	/// 存在しない証拠IDも1件として数えるため、その場合は決して満たされません（従来と同じ挙動）。
+	/// </remarks>
+	int32 NumAccusationRequirements() const { return AccusationRequirementCount; }
+
+	/// <summary>
+	/// 証拠・キャラクター・ロケーションの関係グラフを取得します
+	/// </summary>
+	const FCaseRelationGraph& GetRelationGraph() const { return RelationGraph; }
+
+	/// <summary>
+	/// 到達可能性の解析器を取得します
+	/// </summary>
+	const FCaseSolver& GetSolver() const { return Solver; }
+
+	/// <summary>
+	/// 推理の導出規則を取得します
+	/// </summary>
+	const FCaseDeductionChain& GetDeductionChain() const { return DeductionChain; }
+
+	/// <summary>
+	/// トリガーの条件・操作と依存関係の索引を取得します
+	/// </summary>
+	const FCaseTriggerIndex& GetTriggerIndex() const { return TriggerIndex; }
+
+	// ========================================================================
+	// キャラクターの予定
+	// ========================================================================
+
+	/// <summary>
+	/// 事件開始時のキャラクターの居場所を取得します（どこにもいなければ INDEX_NONE）
+	/// </summary>
+	/// <remarks>
+	/// 最初に CharactersPresent に載っているロケーションに、0分以前の移動予定を適用したものです。
+	/// </remarks>
+	int32 GetInitialCharacterLocation(int32 CharacterIndex) const { return InitialCharacterLocations[CharacterIndex]; }
+
+	/// <summary>
+	/// 1分以降の移動予定を取得します（時刻順、同時刻は定義順）
+	/// </summary>
+	TArrayView<const FCompiledScheduleEntry> GetSchedule() const { return Schedule; }
+
+	/// <summary>
+	/// 指定した時刻より後の最初の移動予定の位置を取得します（無ければ GetSchedule().Num()）
+	/// </summary>
+	int32 FindFirstScheduleEntryAfter(int32 Minute) const;
+
+	// ========================================================================
+	// 証拠の二次索引
+	// ========================================================================
+
+	// 各索引は NumEvidenceWords() ワードのビット列で、証拠インデックスのビットが立っています。
+	// 収集・調査済みのビット列と AND を取ることで、条件付きの検索をワード単位で行えます。
+
+	/// <summary>証拠の種類の数</summary>
+	static constexpr int32 NumEvidenceTypes = static_cast<int32>(EEvidenceType::Observation) + 1;
+
+	/// <summary>証拠の重要度の段階数</summary>
+	static constexpr int32 NumEvidenceImportances = static_cast<int32>(EEvidenceImportance::Critical) + 1;
+
+	/// <summary>
+	/// 指定した種類の証拠のビット列を取得します
+	/// </summary>
+	const uint32* GetEvidenceTypeWords(EEvidenceType Type) const
+	{
+		return GetEvidenceIndexWords(static_cast<int32>(Type));
+	}
+
+	/// <summary>
+	/// 指定した重要度以上の証拠のビット列を取得します
+	/// </summary>
+	const uint32* GetEvidenceMinImportanceWords(EEvidenceImportance MinImportance) const
+	{
+		return GetEvidenceIndexWords(NumEvidenceTypes + static_cast<int32>(MinImportance));
+	}
+
+	/// <summary>
+	/// ロケーションに置かれた証拠のビット列を取得します（AvailableEvidence 基準）
+	/// </summary>
+	const uint32* GetEvidenceAtLocationWords(int32 LocationIndex) const
+	{
+		return GetEvidenceIndexWords(NumEvidenceTypes + NumEvidenceImportances + LocationIndex);
+	}
+
+	/// <summary>
+	/// キャラクターに関連する証拠のビット列を取得します（RelatedCharacters 基準）
+	/// </summary>
+	const uint32* GetEvidenceRelatedToCharacterWords(int32 CharacterIndex) const
+	{
+		return GetEvidenceIndexWords(NumEvidenceTypes + NumEvidenceImportances + NumLocations() + CharacterIndex);
+	}
+
+	// ========================================================================
+	// フラグ
+	// ========================================================================
+
+	/// <summary>
+	/// フラグ名から密なフラグIDを取得します（事件内で使われないフラグは INDEX_NONE）
+	/// </summary>
+	int32 FindFlagIndex(FName FlagName) const;
+
+	/// <summary>
+	/// フラグIDからフラグ名を取得します
+	/// </summary>
+	FName GetFlagName(int32 FlagIndex) const { return FlagNames[FlagIndex]; }
+
+	/// <summary>
+	/// 推理の解放時に設定されるフラグのマスクを取得します
+	/// </summary>
+	FCompiledMask GetDeductionFlagMask(int32 DeductionIndex) const { return DeductionFlagMasks[DeductionIndex]; }
+
+	/// <summary>
+	/// フラグのビット列がマスクの全ビットを含むか確認します
+	/// </summary>
+	bool ContainsAllFlags(const TBitArray<>& FlagBits, FCompiledMask Mask) const;
+
+	/// <summary>
+	/// 証拠のビット列がマスクの全ビットを含むか確認します
+	/// </summary>
+	bool ContainsAllEvidence(const TBitArray<>& EvidenceBits, FCompiledMask Mask) const;
+
+	/// <summary>
+	/// マスクの先頭ワードへのポインタを取得します
+	/// </summary>
+	const uint32* GetMaskWords(FCompiledMask Mask) const { return MaskWords.GetData() + Mask.Offset; }
+
+	/// <summary>
+	/// フラグのビット列を構成するワード数を取得します
+	/// </summary>
+	int32 NumFlagWords() const { return FMath::DivideAndRoundUp(NumFlags(), NumBitsPerDWORD); }
+
+	/// <summary>
+	/// 証拠のビット列を構成するワード数を取得します
+	/// </summary>
+	int32 NumEvidenceWords() const { return FMath::DivideAndRoundUp(NumEvidence(), NumBitsPerDWORD); }
+
+	// ========================================================================
+	// 対話
+	// ========================================================================
+
+	/// <summary>
+	/// キャラクターの対話ツリーのインデックスを取得します
+	/// </summary>
+	int32 FindDialogueTreeIndex(FName CharacterId) const;
+
+	/// <summary>
+	/// ツリー内のノードインデックスを取得します
+	/// </summary>
+	int32 FindDialogueNodeIndex(int32 TreeIndex, FName NodeId) const;
+
+	/// <summary>
+	/// コンパイル済みのノードを取得します
+	/// </summary>
+	const FCompiledDialogueNode& GetCompiledNode(int32 TreeIndex, int32 NodeIndex) const;
+
+	/// <summary>
+	/// コンパイル済みの選択肢を取得します
+	/// </summary>
+	const FCompiledDialogueChoice& GetCompiledChoice(int32 TreeIndex, int32 NodeIndex, int32 ChoiceIndex) const;
+
+	/// <summary>
+	/// ノード到達時に得られる証拠を取得します（作成データの並び順、存在しない証拠は除外）
+	/// </summary>
+	TArrayView<const FEvidenceHandle> GetNodeGainedEvidence(int32 TreeIndex, int32 NodeIndex) const
+	{
+		const FCompiledDialogueNode& Node = GetCompiledNode(TreeIndex, NodeIndex);
+		return MakeArrayView(NodeGainedEvidence.GetData() + Node.FirstGainedEvidence, Node.NumGainedEvidence);
+	}
+
+private:
+	FCaseDefinition() = default;
+
+	/// <summary>
+	/// ID検索用のハッシュテーブルを構築します
+	/// </summary>
+	void BuildLookupTables();
+
+	/// <summary>
+	/// フラグ名を密なIDに変換し、選択肢・ノード・推理のマスクを構築します
+	/// </summary>
+	void CompileFlagsAndRequirements();
+
+	/// <summary>
+	/// 進行状態の集計値を差分更新するためのテーブルを構築します
+	/// </summary>
+	void BuildAggregateTables();
+
+	/// <summary>
+	/// 種類・重要度・ロケーション・キャラクターごとの証拠ビット列を構築します
+	/// </summary>
+	void BuildEvidenceIndices();
+
+	/// <summary>
+	/// キャラクターの初期位置と移動予定を構築します
+	/// </summary>
+	void CompileSchedule();
+
+	/// <summary>
+	/// 二次索引の先頭ワードへのポインタを取得します
+	/// </summary>
+	const uint32* GetEvidenceIndexWords(int32 Slot) const
+	{
+		return EvidenceIndexWords.GetData() + Slot * NumEvidenceWords();
+	}
+
+	/// <summary>
+	/// フラグ名をIDとして登録します
+	/// </summary>
+	void InternFlag(FName FlagName);
+
+	/// <summary>
+	/// フラグ名の一覧からマスクを作成します
+	/// </summary>
+	FCompiledMask CompileFlagMask(const TArray<FName>& Flags);
+
+	/// <summary>
+	/// 証拠IDの一覧からマスクを作成します（存在しない証拠があれば bOutHasUnknown を立てます）
+	/// </summary>
+	FCompiledMask CompileEvidenceMask(const TArray<FName>& EvidenceIds, bool& bOutHasUnknown);
+
+	/// <summary>
+	/// 状態ワードがマスクの全ビットを含むか確認します
+	/// </summary>
+	static bool ContainsAllWords(const uint32* StateWords, const uint32* MaskWordData, int32 NumWords);
+
+	/// <summary>元の事件データ</summary>
+	FCaseData Data;
+
+	/// <summary>証拠ID → AllEvidence のインデックス</summary>
+	TMap<FName, int32> EvidenceIndexMap;
+
+	/// <summary>キャラクターID → AllCharacters のインデックス</summary>
+	TMap<FName, int32> CharacterIndexMap;
+
+	/// <summary>推理ID → AllDeductions のインデックス</summary>
+	TMap<FName, int32> DeductionIndexMap;
+
+	/// <summary>ロケーション → AllLocations のインデックス</summary>
+	TMap<ELocation, int32> LocationIndexMap;
+
+	/// <summary>証拠ペアキー → AllDeductions のインデックス</summary>
+	TMap<uint64, int32> DeductionPairIndex;
+
+	/// <summary>証拠ごとの EvidenceLocationList 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> EvidenceLocationStart;
+
+	/// <summary>証拠を置いているロケーションのインデックス（証拠順に連結）</summary>
+	TArray<int32> EvidenceLocationList;
+
+	/// <summary>ロケーションごとの証拠数</summary>
+	TArray<int32> LocationEvidenceCounts;
+
+	/// <summary>告発に必要な証拠のビット</summary>
+	TBitArray<> RequiredForAccusation;
+
+	/// <summary>告発に必要な条件の数</summary>
+	int32 AccusationRequirementCount = 0;
+
+	/// <summary>証拠・キャラクター・ロケーションの関係グラフ</summary>
+	FCaseRelationGraph RelationGraph;
+
+	/// <summary>到達可能性の解析器</summary>
+	FCaseSolver Solver;
+
+	/// <summary>推理の導出規則</summary>
+	FCaseDeductionChain DeductionChain;
+
+	/// <summary>トリガーの索引</summary>
+	FCaseTriggerIndex TriggerIndex;
+
+	/// <summary>証拠の二次索引（種類・重要度・ロケーション・キャラクターの順に連結）</summary>
+	TArray<uint32> EvidenceIndexWords;
+
+	/// <summary>キャラクターごとの事件開始時の居場所</summary>
+	TArray<int32> InitialCharacterLocations;
+
+	/// <summary>1分以降の移動予定（時刻順）</summary>
+	TArray<FCompiledScheduleEntry> Schedule;
+
+	/// <summary>フラグ名 → フラグID</summary>
+	TMap<FName, int32> FlagIndexMap;
+
+	/// <summary>フラグID → フラグ名</summary>
+	TArray<FName> FlagNames;
+
+	/// <summary>全マスクの実体</summary>
+	TArray<uint32> MaskWords;
+
+	/// <summary>推理ごとの解放フラグマスク</summary>
+	TArray<FCompiledMask> DeductionFlagMasks;
+
+	/// <summary>キャラクターID → AllDialogues のインデックス</summary>
+	TMap<FName, int32> DialogueTreeIndexMap;
+
+	/// <summary>AllDialogues と同じ並びのコンパイル済みツリー</summary>
+	TArray<FCompiledDialogueTree> TreeData;
+
+	/// <summary>全ツリーのノードを連結したもの</summary>
+	TArray<FCompiledDialogueNode> NodeData;
+
+	/// <summary>全ノードの選択肢を連結したもの</summary>
+	TArray<FCompiledDialogueChoice> ChoiceData;
+
+	/// <summary>全ノードの到達時に得られる証拠を連結したもの</summary>
+	TArray<FEvidenceHandle> NodeGainedEvidence;
+};
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// 事件定義内の要素を指す型付きハンドル
+/// </summary>
+/// <remarks>
+/// 中身は FCaseDefinition の配列へのインデックスだけで、FName のようなハッシュ計算や
+/// 名前テーブルの参照を伴いません。タグ型ごとに別の型になるため、証拠のハンドルを
+/// キャラクターの引数に渡すといった取り違えはコンパイル時に検出されます。
+/// ハンドルは FCaseDefinition::Find 系の関数から取得し、取得元の事件定義に対してのみ有効です。
+/// FName は作成データと Blueprint との境界でのみ使用し、ネイティブの処理はハンドルで行ってください。
+/// </remarks>
+template <typename TagType>
+struct TCaseHandle
+{
+	TCaseHandle() = default;
+
+	explicit TCaseHandle(int32 InIndex)
+		: Index(InIndex)
+	{
+	}
+
+	/// <summary>
+	/// 要素を指しているか確認します
+	/// </summary>
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	/// <summary>
+	/// 事件定義内のインデックスを取得します
+	/// </summary>
+	int32 GetIndex() const { return Index; }
+
+	explicit operator bool() const { return IsValid(); }
+
+	bool operator==(TCaseHandle Other) const { return Index == Other.Index; }
+	bool operator!=(TCaseHandle Other) const { return Index != Other.Index; }
+
+	friend uint32 GetTypeHash(TCaseHandle Handle) { return ::GetTypeHash(Handle.Index); }
+
+private:
+	/// <summary>事件定義内のインデックス（INDEX_NONE なら無効）</summary>
+	int32 Index = INDEX_NONE;
+};
+
+struct FEvidenceHandleTag;
+struct FCharacterHandleTag;
+struct FLocationHandleTag;
+struct FDeductionHandleTag;
+struct FFlagHandleTag;
+struct FDialogueTreeHandleTag;
+struct FDialogueNodeHandleTag;
+struct FDialogueChoiceHandleTag;
+
+/// <summary>証拠（AllEvidence のインデックス）</summary>
+using FEvidenceHandle = TCaseHandle<FEvidenceHandleTag>;
+
+/// <summary>キャラクター（AllCharacters のインデックス）</summary>
+using FCharacterHandle = TCaseHandle<FCharacterHandleTag>;
+
+/// <summary>ロケーション（AllLocations のインデックス）</summary>
+using FLocationHandle = TCaseHandle<FLocationHandleTag>;
+
+/// <summary>推理（AllDeductions のインデックス）</summary>
+using FDeductionHandle = TCaseHandle<FDeductionHandleTag>;
+
+/// <summary>事件内で使われるフラグ（密なフラグID）</summary>
+using FFlagHandle = TCaseHandle<FFlagHandleTag>;
+
+/// <summary>対話ツリー（AllDialogues のインデックス）</summary>
+using FDialogueTreeHandle = TCaseHandle<FDialogueTreeHandleTag>;
+
+/// <summary>対話ノード（全ツリーのノードを連結した通し番号）</summary>
+using FDialogueNodeHandle = TCaseHandle<FDialogueNodeHandleTag>;
+
+/// <summary>対話の選択肢（全ノードの選択肢を連結した通し番号）</summary>
+using FDialogueChoiceHandle = TCaseHandle<FDialogueChoiceHandleTag>;
+
+static_assert(sizeof(FEvidenceHandle) == sizeof(int32), "ハンドルはインデックスと同じ大きさでなければなりません");
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// ジャーナルに記録される操作の種類
+/// </summary>
+/// <remarks>
+/// 値はバイナリ形式の一部なので、既存の値は変更せず末尾に追加してください。
+/// </remarks>
+enum class ECaseJournalOp : uint8
+{
+	Reset = 0,
+	CollectEvidence,	// 証拠インデックス
+	ExamineEvidence,	// 証拠インデックス
+	UnlockDeduction,	// 証拠インデックスA, 証拠インデックスB
+	SetFlag,			// フラグID
+	SetExtraFlag,		// 名前テーブルのインデックス
+	ModifyTrust,		// キャラクターインデックス, 変化量
+	MarkInterviewed,	// キャラクターインデックス
+	TravelToLocation,	// ELocation
+	MakeAccusation,		// 名前テーブルのインデックス
+	ABELFollowed,
+	ABELIgnored,
+	EthicalViolation,
+	AdvanceClock,		// 進めた分数
+
+	Count
+};
+
+/// <summary>
+/// デコード済みのジャーナルレコード
+/// </summary>
+struct FCaseJournalRecord
+{
+	ECaseJournalOp Op = ECaseJournalOp::Reset;
+
+	/// <summary>第1オペランド（インデックス等）</summary>
+	int32 A = 0;
+
+	/// <summary>第2オペランド</summary>
+	int32 B = 0;
+
+	/// <summary>名前オペランド（SetExtraFlag / MakeAccusation のみ）</summary>
+	FName Name;
+};
+
+/// <summary>
+/// 事件の進行状態に対する操作の記録
+/// </summary>
+/// <remarks>
+/// 各レコードは 1 バイトの操作コードと可変長整数のオペランドで構成され、
+/// 多くの操作は 2〜4 バイトに収まります。
+/// 事件定義のインデックスを記録するため、同じ事件定義に対してのみ再生できます。
+/// 事件定義に登場しない名前（任意のフラグや告発対象）は名前テーブル経由で記録します。
+/// 先頭からのバイト列の CRC を記録ごとに更新しており、チェックポイントが現在の履歴上の地点かどうかの判定に使います。
+/// CRC の初期値はジャーナルごとに異なる系統番号なので、別のジャーナルの同じバイト列とは一致しません
+/// （名前テーブルは巻き戻しても縮まないため、同じ系統内ではバイト列が一致すれば名前も一致します）。
+/// </remarks>
+class THELASTWITNESS_API FCaseJournal
+{
+public:
+	/// <summary>バイナリ形式のバージョン</summary>
+	static constexpr int32 Version = 1;
+
+	/// <summary>
+	/// 記録を全て破棄します
+	/// </summary>
+	/// <param name="InCaseId">記録対象の事件ID</param>
+	void Reset(FName InCaseId);
+
+	/// <summary>
+	/// 指定バイト位置以降の記録を破棄します（チェックポイントへの巻き戻し用）
+	/// </summary>
+	void Truncate(int32 ByteLength);
+
+	void Append(ECaseJournalOp Op);
+	void Append(ECaseJournalOp Op, int32 A);
+	void Append(ECaseJournalOp Op, int32 A, int32 B);
+	void AppendName(ECaseJournalOp Op, FName Name);
+
+	/// <summary>
+	/// 記録済みのバイト数を取得します
+	/// </summary>
+	int32 NumBytes() const { return Bytes.Num(); }
+
+	/// <summary>
+	/// 記録済みのバイト列全体の CRC を取得します
+	/// </summary>
+	uint32 GetCrc() const { return Crc; }
+
+	/// <summary>
+	/// 先頭から指定バイト数までの CRC を計算します
+	/// </summary>
+	uint32 ComputePrefixCrc(int32 ByteLength) const;
+
+	/// <summary>
+	/// 記録済みのレコード数を取得します
+	/// </summary>
+	int32 NumRecords() const { return RecordCount; }
+
+	/// <summary>
+	/// 記録対象の事件IDを取得します
+	/// </summary>
+	FName GetCaseId() const { return CaseId; }
+
+	/// <summary>
+	/// ヒープ上で使用しているバイト数を取得します
+	/// </summary>
+	SIZE_T GetAllocatedSize() const
+	{
+		return Bytes.GetAllocatedSize() + Names.GetAllocatedSize() + NameIndexMap.GetAllocatedSize();
+	}
+
+	/// <summary>
+	/// 全レコードを先頭から順に列挙します
+	/// </summary>
+	/// <returns>途中で不正なデータを検出した場合は false</returns>
+	bool ForEachRecord(TFunctionRef<void(const FCaseJournalRecord&)> Visitor) const;
+
+	/// <summary>
+	/// バイト列との相互変換（名前テーブルとバージョンを含みます）
+	/// </summary>
+	friend THELASTWITNESS_API FArchive& operator<<(FArchive& Ar, FCaseJournal& Journal);
+
+private:
+	/// <summary>
+	/// オペランドの数を取得します
+	/// </summary>
+	static int32 GetOperandCount(ECaseJournalOp Op);
+
+	/// <summary>
+	/// 名前を名前テーブルに登録し、インデックスを返します
+	/// </summary>
+	int32 InternName(FName Name);
+
+	/// <summary>
+	/// 新しい系統番号を割り当て、CRC を計算し直します（記録の破棄・読み込み時）
+	/// </summary>
+	void StartLineage();
+
+	/// <summary>
+	/// 指定位置から追記したレコードを確定します
+	/// </summary>
+	void FinishRecord(int32 RecordStart);
+
+	void WriteVarInt(int32 Value);
+	static bool ReadVarInt(const TArray<uint8>& Data, int32& InOutOffset, int32& OutValue);
+
+	/// <summary>記録対象の事件ID</summary>
+	FName CaseId;
+
+	/// <summary>エンコード済みのレコード</summary>
+	TArray<uint8> Bytes;
+
+	/// <summary>レコード数</summary>
+	int32 RecordCount = 0;
+
+	/// <summary>系統番号（CRC の初期値）</summary>
+	uint32 Lineage = 0;
+
+	/// <summary>Bytes 全体の CRC</summary>
+	uint32 Crc = 0;
+
+	/// <summary>名前テーブル</summary>
+	TArray<FName> Names;
+
+	/// <summary>名前 → 名前テーブルのインデックス</summary>
+	TMap<FName, int32> NameIndexMap;
+};
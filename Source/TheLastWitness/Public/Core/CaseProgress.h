@@ -0,0 +1,276 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WitnessTypes.h"
+
+class FCaseDefinition;
+
+/// <summary>
+/// 書き込み時にのみ複製される共有セクション
+/// </summary>
+/// <remarks>
+/// コピーは参照カウントの増加だけで済み、Edit() を呼んだ側が他と共有している場合に限り
+/// そのセクションだけを複製します。チェックポイント間で変更のないセクションは共有されたままです。
+/// </remarks>
+template <typename SectionType>
+class TCopyOnWrite
+{
+public:
+	TCopyOnWrite()
+		: Section(MakeShared<SectionType, ESPMode::ThreadSafe>())
+	{
+	}
+
+	/// <summary>
+	/// 読み取り用の参照を取得します
+	/// </summary>
+	const SectionType& Get() const { return *Section; }
+	const SectionType* operator->() const { return &Section.Get(); }
+
+	/// <summary>
+	/// 書き込み用の参照を取得します（共有中なら先に複製します）
+	/// </summary>
+	SectionType& Edit()
+	{
+		if (!Section.IsUnique())
+		{
+			Section = MakeShared<SectionType, ESPMode::ThreadSafe>(*Section);
+		}
+		return *Section;
+	}
+
+	/// <summary>
+	/// 他の進行状態とセクションを共有しているか確認します
+	/// </summary>
+	bool IsSharedWith(const TCopyOnWrite& Other) const { return Section == Other.Section; }
+
+private:
+	/// <summary>スナップショットをワーカースレッドで手放せるよう、参照カウントはスレッドセーフ</summary>
+	TSharedRef<SectionType, ESPMode::ThreadSafe> Section;
+};
+
+/// <summary>
+/// 証拠の進行状態（AllEvidence と同じ並び）
+/// </summary>
+struct FEvidenceProgress
+{
+	/// <summary>収集済みビット</summary>
+	TBitArray<> Collected;
+
+	/// <summary>調査済みビット</summary>
+	TBitArray<> Examined;
+
+	/// <summary>ロケーションごとの未収集の証拠数（AllLocations と同じ並び）</summary>
+	TArray<int32> UncollectedPerLocation;
+};
+
+/// <summary>
+/// キャラクターの進行状態（AllCharacters と同じ並び）
+/// </summary>
+struct FCharacterProgress
+{
+	/// <summary>信頼度（0-100）</summary>
+	TArray<uint8> TrustLevels;
+
+	/// <summary>感情状態</summary>
+	TArray<EEmotionalState> EmotionalStates;
+
+	/// <summary>インタビュー済みビット</summary>
+	TBitArray<> Interviewed;
+
+	/// <summary>現在いるロケーションのインデックス（どこにもいなければ INDEX_NONE）</summary>
+	TArray<int32> CurrentLocations;
+};
+
+/// <summary>
+/// ロケーションの進行状態（AllLocations と同じ並び）
+/// </summary>
+struct FLocationProgress
+{
+	/// <summary>訪問済みビット</summary>
+	TBitArray<> Visited;
+
+	/// <summary>アクセス可能ビット（初期値は作成データの bIsAccessible、以降はトリガーで変化）</summary>
+	TBitArray<> Accessible;
+};
+
+/// <summary>
+/// 推理の進行状態（AllDeductions と同じ並び）
+/// </summary>
+struct FDeductionProgress
+{
+	/// <summary>解放済みビット</summary>
+	TBitArray<> Unlocked;
+};
+
+/// <summary>
+/// フラグの進行状態
+/// </summary>
+struct FFlagProgress
+{
+	/// <summary>設定済みビット（FCaseDefinition のフラグIDと同じ並び）</summary>
+	TBitArray<> Set;
+
+	/// <summary>事件定義に登場しないフラグ（Blueprint から任意に設定されたもの）</summary>
+	TSet<FName> Extra;
+};
+
+/// <summary>
+/// トリガーの進行状態（FCaseData::Triggers と同じ並び）
+/// </summary>
+struct FTriggerProgress
+{
+	/// <summary>発火済みビット</summary>
+	TBitArray<> Fired;
+};
+
+/// <summary>
+/// 変更のたびに差分更新される集計値
+/// </summary>
+/// <remarks>
+/// ビット列を数え直さずに O(1) で参照するためのものです。
+/// 値は常に他のメンバーから再計算できる内容と一致している必要があります。
+/// ロケーションごとの未収集数は証拠と同時に変化するため FEvidenceProgress 側に置いています。
+/// </remarks>
+struct FProgressCounters
+{
+	/// <summary>収集済みの証拠数</summary>
+	int32 CollectedEvidence = 0;
+
+	/// <summary>インタビュー済みのキャラクター数</summary>
+	int32 InterviewedCharacters = 0;
+
+	/// <summary>解放済みの推理数</summary>
+	int32 UnlockedDeductions = 0;
+
+	/// <summary>未達成の告発条件の数</summary>
+	int32 UnmetAccusationRequirements = 0;
+};
+
+/// <summary>
+/// 事件の可変な進行状態
+/// </summary>
+/// <remarks>
+/// FCaseDefinition のインデックスに対応するビット列と小さな配列だけで構成され、
+/// テキスト等の作成済みデータは一切含みません。
+/// 各セクションは TCopyOnWrite で保持されるため、この構造体のコピー（チェックポイント）は O(1) です。
+/// 読み取りは Evidence-&gt;Collected、書き込みは Evidence.Edit().Collected のように行います。
+/// </remarks>
+struct THELASTWITNESS_API FCaseProgress
+{
+	/// <summary>リセット時の信頼度</summary>
+	static constexpr uint8 DefaultTrustLevel = 50;
+
+	/// <summary>セーブデータ形式のバージョン（形式を変えたら上げ、Load() に移行処理を追加してください）</summary>
+	static constexpr int32 SaveVersion = 4;
+
+	TCopyOnWrite<FEvidenceProgress> Evidence;
+	TCopyOnWrite<FCharacterProgress> Characters;
+	TCopyOnWrite<FLocationProgress> Locations;
+	TCopyOnWrite<FDeductionProgress> Deductions;
+	TCopyOnWrite<FFlagProgress> Flags;
+	TCopyOnWrite<FTriggerProgress> Triggers;
+	FProgressCounters Counters;
+
+	/// <summary>現在のロケーション</summary>
+	ELocation CurrentLocation = ELocation::Office;
+
+	/// <summary>ゲーム内時刻（事件開始からの分）</summary>
+	int32 ClockMinutes = 0;
+
+	/// <summary>ABELに従った回数</summary>
+	int32 ABELSuggestionsFollowed = 0;
+
+	/// <summary>ABELを無視した回数</summary>
+	int32 ABELSuggestionsIgnored = 0;
+
+	/// <summary>倫理的違反回数</summary>
+	int32 EthicalViolations = 0;
+
+	/// <summary>この状態に至るまでのジャーナルのバイト数（巻き戻し時にジャーナルを切り詰めるため）</summary>
+	int32 JournalLength = 0;
+
+	/// <summary>この状態に至るまでのジャーナルの CRC（別の履歴のチェックポイントで切り詰めないため）</summary>
+	uint32 JournalCrc = 0;
+
+	/// <summary>
+	/// 事件定義の要素数に合わせて領域を確保し、初期状態にします
+	/// </summary>
+	void Initialize(const FCaseDefinition& Definition);
+
+	/// <summary>
+	/// 確保済みの領域をそのまま初期状態に戻します
+	/// </summary>
+	void Reset(const FCaseDefinition& Definition);
+
+	/// <summary>
+	/// 証拠の収集を記録し、集計値を更新します
+	/// </summary>
+	/// <returns>新たに収集された場合は true</returns>
+	bool MarkEvidenceCollected(const FCaseDefinition& Definition, int32 EvidenceIndex);
+
+	/// <summary>
+	/// インタビュー済みを記録し、集計値を更新します
+	/// </summary>
+	/// <returns>新たにインタビュー済みになった場合は true</returns>
+	bool MarkCharacterInterviewed(int32 CharacterIndex);
+
+	/// <summary>
+	/// 推理の解放を記録し、集計値を更新します
+	/// </summary>
+	/// <returns>新たに解放された場合は true</returns>
+	bool MarkDeductionUnlocked(int32 DeductionIndex);
+
+	/// <summary>
+	/// キャラクターの居場所を変更します
+	/// </summary>
+	/// <returns>居場所が変わった場合は true</returns>
+	bool MoveCharacter(int32 CharacterIndex, int32 LocationIndex);
+
+	/// <summary>
+	/// ビット列から集計値を計算し直します（セーブデータの読み込み後など）
+	/// </summary>
+	void RebuildCounters(const FCaseDefinition& Definition);
+
+	/// <summary>
+	/// 可変な進行状態だけをバイナリで書き出します
+	/// </summary>
+	/// <remarks>
+	/// 証拠・キャラクター等はインデックス順のビット列と、その並びを表す要素IDの表として書き出します。
+	/// フラグは名前で書き出します。
+	/// テキスト等の作成済みデータは含まないため、事件の規模に関わらず数百バイト程度に収まります。
+	/// </remarks>
+	void Save(FArchive& Ar, const FCaseDefinition& Definition) const;
+
+	/// <summary>
+	/// Save() で書き出した内容を読み込みます
+	/// </summary>
+	/// <remarks>
+	/// 要素IDで現在の事件定義に対応させるため、要素の並び替えや追加があっても正しく読み込めます。
+	/// 事件定義から削除された要素の状態は捨てます（ID表の無い古い形式は、重なる範囲をインデックスのまま読み込みます）。
+	/// 事件定義に存在しなくなったフラグは Extra として保持します。
+	/// </remarks>
+	/// <returns>データが壊れている場合は false（この場合は状態を変更しません）</returns>
+	bool Load(FArchive& Ar, const FCaseDefinition& Definition);
+
+	/// <summary>
+	/// 事件定義の要素数と一致しているか確認します（別の事件のチェックポイントを弾くため）
+	/// </summary>
+	bool IsCompatibleWith(const FCaseDefinition& Definition) const;
+
+	/// <summary>
+	/// 全セクションを共有し、位置と時刻も同じか確認します（解析結果のキャッシュが使えるかの判定用）
+	/// </summary>
+	/// <remarks>
+	/// どちらかで変更があればそのセクションは複製されるため、O(1) で「変更が無いこと」を判定できます。
+	/// false でも内容が同じ場合はありますが、true なら必ず同じ状態です。
+	/// </remarks>
+	bool SharesStateWith(const FCaseProgress& Other) const;
+
+	/// <summary>
+	/// ヒープ上で使用しているバイト数を取得します（共有中のセクションも含みます）
+	/// </summary>
+	SIZE_T GetAllocatedSize() const;
+};
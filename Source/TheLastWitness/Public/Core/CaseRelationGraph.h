@@ -0,0 +1,139 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FCaseDefinition;
+
+/// <summary>
+/// 関係グラフのノードの種類
+/// </summary>
+enum class ECaseNodeKind : uint8
+{
+	Evidence,
+	Character,
+	Location
+};
+
+/// <summary>
+/// 証拠・キャラクター・ロケーションの関係を表す無向グラフ
+/// </summary>
+/// <remarks>
+/// ノードIDは証拠 → キャラクター → ロケーションの順に事件定義のインデックスを並べた密な整数です。
+/// 隣接リストは CSR 形式（開始位置の配列と連結した隣接ノード配列）で保持し、
+/// 各ノードの隣接ノードは昇順に並んでいるため、種類ごとの部分範囲を二分探索で切り出せます。
+/// 辺は次の関係から作られ、常に両方向に張られます（重複と自己ループは除きます）。
+/// - 証拠 ↔ 証拠: FEvidence::RelatedEvidence
+/// - 証拠 ↔ キャラクター: FEvidence::RelatedCharacters
+/// - ロケーション ↔ 証拠: FLocationData::AvailableEvidence
+/// - ロケーション ↔ キャラクター: FLocationData::CharactersPresent
+/// </remarks>
+class THELASTWITNESS_API FCaseRelationGraph
+{
+public:
+	/// <summary>
+	/// 事件定義から関係グラフを構築します
+	/// </summary>
+	void Build(const FCaseDefinition& Definition);
+
+	// ========================================================================
+	// ノードID
+	// ========================================================================
+
+	int32 EvidenceNode(int32 EvidenceIndex) const { return EvidenceIndex; }
+	int32 CharacterNode(int32 CharacterIndex) const { return CharacterBase + CharacterIndex; }
+	int32 LocationNode(int32 LocationIndex) const { return LocationBase + LocationIndex; }
+
+	/// <summary>
+	/// ノードの種類を取得します
+	/// </summary>
+	ECaseNodeKind GetNodeKind(int32 Node) const
+	{
+		return Node < CharacterBase ? ECaseNodeKind::Evidence
+			: Node < LocationBase ? ECaseNodeKind::Character
+			: ECaseNodeKind::Location;
+	}
+
+	/// <summary>
+	/// ノードIDを種類ごとの事件定義のインデックスに戻します
+	/// </summary>
+	int32 GetLocalIndex(int32 Node) const { return Node - GetKindBase(GetNodeKind(Node)); }
+
+	int32 NumNodes() const { return NodeCount; }
+
+	/// <summary>
+	/// 辺の数を取得します（両方向で1本と数えます）
+	/// </summary>
+	int32 NumEdges() const { return Neighbors.Num() / 2; }
+
+	// ========================================================================
+	// 隣接関係
+	// ========================================================================
+
+	/// <summary>
+	/// 隣接ノードを昇順で取得します
+	/// </summary>
+	TConstArrayView<int32> GetNeighbors(int32 Node) const
+	{
+		return MakeArrayView(Neighbors.GetData() + RowStart[Node], RowStart[Node + 1] - RowStart[Node]);
+	}
+
+	/// <summary>
+	/// 指定した種類の隣接ノードを昇順で取得します
+	/// </summary>
+	TConstArrayView<int32> GetNeighborsOfKind(int32 Node, ECaseNodeKind Kind) const;
+
+	/// <summary>
+	/// 指定した種類の隣接ノードを、種類ごとのインデックスで列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 LocalIndex)</param>
+	template <typename VisitorType>
+	void ForEachNeighbor(int32 Node, ECaseNodeKind Kind, VisitorType&& Visitor) const
+	{
+		const int32 Base = GetKindBase(Kind);
+		for (const int32 Neighbor : GetNeighborsOfKind(Node, Kind))
+		{
+			Visitor(Neighbor - Base);
+		}
+	}
+
+	/// <summary>
+	/// 2つのノードが辺で結ばれているか確認します（次数の小さい側を二分探索）
+	/// </summary>
+	bool HasEdge(int32 NodeA, int32 NodeB) const;
+
+	/// <summary>
+	/// ヒープ上で使用しているバイト数を取得します
+	/// </summary>
+	SIZE_T GetAllocatedSize() const { return RowStart.GetAllocatedSize() + Neighbors.GetAllocatedSize(); }
+
+private:
+	/// <summary>
+	/// 種類ごとの先頭ノードIDを取得します
+	/// </summary>
+	int32 GetKindBase(ECaseNodeKind Kind) const
+	{
+		switch (Kind)
+		{
+		case ECaseNodeKind::Character:	return CharacterBase;
+		case ECaseNodeKind::Location:	return LocationBase;
+		default:						return 0;
+		}
+	}
+
+	/// <summary>キャラクターの先頭ノードID（= 証拠数）</summary>
+	int32 CharacterBase = 0;
+
+	/// <summary>ロケーションの先頭ノードID</summary>
+	int32 LocationBase = 0;
+
+	/// <summary>全ノード数</summary>
+	int32 NodeCount = 0;
+
+	/// <summary>ノードごとの Neighbors 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> RowStart;
+
+	/// <summary>隣接ノード（ノード順に連結、各行は昇順）</summary>
+	TArray<int32> Neighbors;
+};
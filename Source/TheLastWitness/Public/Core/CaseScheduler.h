@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// ゲーム内時刻（分）で発火する予定を管理する階層型タイミングホイール
+/// </summary>
+/// <remarks>
+/// 64 スロットのホイールを 5 段重ね、段 L の1スロットが 64^L 分を表します。
+/// 予定は現在時刻と発火時刻が初めて異なる桁の段に置かれるため、登録は O(1) です。
+/// 各段の使用中スロットを 64 ビットのマスクで持ち、時刻を進める際は空のスロットを
+/// CountTrailingZeros で飛ばします。そのため進める時間の長さには比例せず、
+/// 発火する予定の数と段の繰り下げ回数（各予定につき最大 4 回）だけで済みます。
+/// 同じ時刻の予定は登録順に発火します。
+/// </remarks>
+class THELASTWITNESS_API FCaseScheduler
+{
+public:
+	/// <summary>1段あたりのスロット数のビット幅</summary>
+	static constexpr int32 SlotBits = 6;
+
+	/// <summary>1段あたりのスロット数</summary>
+	static constexpr int32 NumSlots = 1 << SlotBits;
+
+	/// <summary>段数</summary>
+	static constexpr int32 NumLevels = 5;
+
+	/// <summary>扱える最大の時刻（これより後の予定はこの時刻に丸めます）</summary>
+	static constexpr int32 MaxMinute = (1 << (SlotBits * NumLevels)) - 1;
+
+	FCaseScheduler();
+
+	/// <summary>
+	/// 全ての予定を破棄し、現在時刻を設定します（確保済みの領域は保持します）
+	/// </summary>
+	void Reset(int32 StartMinute);
+
+	/// <summary>
+	/// 予定を登録します
+	/// </summary>
+	/// <param name="DueMinute">発火時刻（現在時刻以前なら次の Advance で直ちに発火します）</param>
+	/// <param name="Payload">発火時に渡す値</param>
+	void Schedule(int32 DueMinute, int32 Payload);
+
+	/// <summary>
+	/// 指定した時刻まで進め、その間に到来した予定を時刻順に発火します
+	/// </summary>
+	/// <remarks>
+	/// コールバック中に Schedule を呼んでも構いません（進めている範囲内なら同じ呼び出しの中で発火します）。
+	/// コールバックの時点で GetNow() はその予定が到来した時刻を返します。
+	/// </remarks>
+	/// <param name="ToMinute">進める先の時刻</param>
+	/// <param name="OnFire">void(int32 Payload, int32 DueMinute)</param>
+	/// <returns>発火した予定の数</returns>
+	int32 Advance(int32 ToMinute, TFunctionRef<void(int32 Payload, int32 DueMinute)> OnFire);
+
+	/// <summary>
+	/// 現在時刻を取得します
+	/// </summary>
+	int32 GetNow() const { return Now; }
+
+	/// <summary>
+	/// 未発火の予定の数を取得します
+	/// </summary>
+	int32 Num() const { return Count; }
+
+	/// <summary>
+	/// ヒープ上で使用しているバイト数を取得します
+	/// </summary>
+	SIZE_T GetAllocatedSize() const { return Entries.GetAllocatedSize(); }
+
+private:
+	struct FEntry
+	{
+		int32 Due = 0;
+		int32 Payload = 0;
+		int32 Next = INDEX_NONE;
+	};
+
+	/// <summary>
+	/// 単方向リストの先頭と末尾
+	/// </summary>
+	struct FList
+	{
+		int32 Head = INDEX_NONE;
+		int32 Tail = INDEX_NONE;
+	};
+
+	/// <summary>
+	/// 予定を現在時刻に対する段・スロット（または発火待ちリスト）に繋ぎます
+	/// </summary>
+	void Link(int32 EntryIndex);
+
+	/// <summary>
+	/// リストの末尾に予定を追加します
+	/// </summary>
+	void PushBack(FList& List, int32 EntryIndex);
+
+	/// <summary>予定の実体（未使用のものは FreeHead から繋がっています）</summary>
+	TArray<FEntry> Entries;
+
+	/// <summary>未使用の予定の先頭</summary>
+	int32 FreeHead = INDEX_NONE;
+
+	/// <summary>段ごとのスロット（段 L のスロット S は Slots[L * NumSlots + S]）</summary>
+	FList Slots[NumLevels * NumSlots];
+
+	/// <summary>段ごとの使用中スロットのマスク</summary>
+	uint64 Occupied[NumLevels];
+
+	/// <summary>現在時刻以前で、次の Advance で発火する予定</summary>
+	FList Ready;
+
+	/// <summary>現在時刻</summary>
+	int32 Now = 0;
+
+	/// <summary>未発火の予定の数</summary>
+	int32 Count = 0;
+};
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WitnessTypes.h"
+#include "CaseSessionHost.generated.h"
+
+class FCaseDefinition;
+class UCaseState;
+
+/// <summary>
+/// 1つの事件定義を共有する多数の捜査セッションを管理するサブシステム
+/// </summary>
+/// <remarks>
+/// 自動プレイテストやWebサービス向けのヘッドレス実行を想定しています。
+/// 事件定義は最初のセッションを開く時に一度だけ作成され、各セッションは
+/// 進行状態とジャーナルだけを持つ UCaseState として払い出されます。
+/// 閉じたセッションはプールに戻り、同じ事件定義で再利用されるため領域の再確保は発生しません。
+/// GameMode を介さないため、セッションの操作は UCaseState の API を直接呼んでください。
+/// </remarks>
+UCLASS()
+class THELASTWITNESS_API UCaseSessionHost : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// ========================================================================
+	// 事件定義
+	// ========================================================================
+
+	/// <summary>
+	/// セッションで使用する事件を設定します
+	/// </summary>
+	/// <remarks>
+	/// 開いているセッションがある場合は変更できません。プール済みのセッションは破棄されます。
+	/// 設定しない場合は UTheLastWitnessCaseData の事件が使われます。
+	/// </remarks>
+	/// <returns>設定できたかどうか</returns>
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	bool LoadCase(const FCaseData& CaseData);
+
+	/// <summary>
+	/// 共有の事件定義を取得します（未設定なら既定の事件で作成します）
+	/// </summary>
+	TSharedRef<const FCaseDefinition> GetDefinition();
+
+	// ========================================================================
+	// セッション
+	// ========================================================================
+
+	/// <summary>
+	/// 新しいセッションを開きます
+	/// </summary>
+	/// <returns>初期状態のセッション。メモリ予算を超える場合は nullptr</returns>
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	UCaseState* OpenSession();
+
+	/// <summary>
+	/// セッションを閉じてプールに戻します
+	/// </summary>
+	/// <remarks>
+	/// 以降、このオブジェクトは別のセッションとして払い出される可能性があるため、参照を保持しないでください。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void CloseSession(UCaseState* Session);
+
+	/// <summary>
+	/// 開いているセッション数を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Session")
+	int32 GetActiveSessionCount() const { return ActiveSessions.Num(); }
+
+	/// <summary>
+	/// プールで待機しているセッション数を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Session")
+	int32 GetPooledSessionCount() const { return PooledSessions.Num(); }
+
+	// ========================================================================
+	// メモリ予算
+	// ========================================================================
+
+	/// <summary>
+	/// 全セッションのメモリ予算を設定します（0 なら無制限）
+	/// </summary>
+	/// <remarks>
+	/// 新しいセッションは、開いているセッションが実際に使用しているサイズ（事件定義を除く）に
+	/// 初期状態のセッション1つ分を加えても予算内に収まる場合にだけ開けます。
+	/// 開いた後のジャーナルの伸びも次の判定に反映されますが、既に開いているセッションは閉じません。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	void SetMemoryBudget(int64 InBudgetBytes);
+
+	/// <summary>
+	/// 現在の使用量から見て、予算内で同時に開けるセッション数を取得します（無制限なら MAX_int32）
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Session")
+	int32 GetMaxSessions() const;
+
+	/// <summary>
+	/// 全セッションが実際に使用しているバイト数を集計します（診断用。セッション数に比例します）
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Session")
+	int64 CalculateMemoryUsage() const;
+
+private:
+	/// <summary>
+	/// プールから取り出すか、新しく作成します
+	/// </summary>
+	UCaseState* AcquireSession();
+
+	/// <summary>
+	/// 開いているセッションが実際に使用しているバイト数を集計します
+	/// </summary>
+	int64 CalculateActiveMemoryUsage() const;
+
+	/// <summary>共有の事件定義</summary>
+	TSharedPtr<const FCaseDefinition> Definition;
+
+	/// <summary>開いているセッション</summary>
+	UPROPERTY()
+	TSet<TObjectPtr<UCaseState>> ActiveSessions;
+
+	/// <summary>再利用を待つセッション</summary>
+	UPROPERTY()
+	TArray<TObjectPtr<UCaseState>> PooledSessions;
+
+	/// <summary>全セッションのメモリ予算（0 なら無制限）</summary>
+	int64 MemoryBudgetBytes = 0;
+
+	/// <summary>初期状態のセッション1つのサイズ（最初のセッション作成時に計測）</summary>
+	int64 BytesPerSession = 0;
+};
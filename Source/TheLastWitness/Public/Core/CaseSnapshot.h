@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CaseDefinition.h"
+#include "CaseProgress.h"
+
+/// <summary>
+/// ゲームスレッド外から読むための、公開済みの進行状態
+/// </summary>
+/// <remarks>
+/// UCaseState が変更のまとまりごとに作成し、作成後は一切変更されません。
+/// 進行状態のセクションはライブの状態と参照カウント付きで共有され、ゲームスレッド側が
+/// 次に書き込む時点で複製されるため（TCopyOnWrite）、作成コストはほぼ参照カウントの増加だけです。
+/// 参照カウントはスレッドセーフなので、ワーカースレッドがいつ手放しても安全です。
+/// </remarks>
+struct THELASTWITNESS_API FCaseSnapshot
+{
+	FCaseSnapshot(TSharedRef<const FCaseDefinition> InDefinition, const FCaseProgress& InProgress, uint64 InSequence)
+		: Definition(MoveTemp(InDefinition))
+		, Progress(InProgress)
+		, Sequence(InSequence)
+	{
+	}
+
+	/// <summary>事件定義</summary>
+	const TSharedRef<const FCaseDefinition> Definition;
+
+	/// <summary>公開時点の進行状態</summary>
+	const FCaseProgress Progress;
+
+	/// <summary>公開の通し番号（新しいスナップショットほど大きい）</summary>
+	const uint64 Sequence;
+
+	const FCaseData& GetCaseData() const { return Definition->GetData(); }
+
+	/// <summary>
+	/// 証拠が収集済みか確認します
+	/// </summary>
+	bool HasEvidence(FName EvidenceId) const;
+
+	/// <summary>
+	/// フラグが設定されているか確認します
+	/// </summary>
+	bool HasFlag(FName FlagName) const;
+
+	/// <summary>
+	/// キャラクターの信頼度を取得します（存在しなければ INDEX_NONE）
+	/// </summary>
+	int32 GetTrustLevel(FName CharacterId) const;
+
+	/// <summary>
+	/// 収集済みの証拠を列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 Index, const FEvidence&amp; Evidence)</param>
+	template <typename VisitorType>
+	void ForEachCollectedEvidence(VisitorType&& Visitor) const
+	{
+		const TArray<FEvidence>& AllEvidence = GetCaseData().AllEvidence;
+		for (TConstSetBitIterator<> It(Progress.Evidence->Collected); It; ++It)
+		{
+			Visitor(It.GetIndex(), AllEvidence[It.GetIndex()]);
+		}
+	}
+};
+
+using FCaseSnapshotPtr = TSharedPtr<const FCaseSnapshot, ESPMode::ThreadSafe>;
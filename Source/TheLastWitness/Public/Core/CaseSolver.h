@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WitnessTypes.h"
+#include "CaseSolver.generated.h"
+
+class FCaseDefinition;
+struct FCaseProgress;
+struct FCompiledMask;
+
+/// <summary>
+/// 解決手順の1ステップの種類
+/// </summary>
+UENUM(BlueprintType)
+enum class ECaseSolutionAction : uint8
+{
+	/// <summary>ロケーションへ移動</summary>
+	TravelTo,
+	/// <summary>現在地で証拠を収集</summary>
+	CollectEvidence,
+	/// <summary>キャラクターとの対話を開始</summary>
+	TalkTo,
+	/// <summary>対話の選択肢を選ぶ</summary>
+	SelectChoice,
+	/// <summary>選択肢のないノードから次へ進む</summary>
+	AdvanceDialogue,
+	/// <summary>推理ボードで2つの証拠を結びつける</summary>
+	TryDeduction,
+	/// <summary>キャラクターが予定の場所へ移動するまで時間を進める（Location = 移動先）</summary>
+	WaitForCharacter
+};
+
+/// <summary>
+/// 解決手順の1ステップ
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCaseSolutionStep
+{
+	GENERATED_BODY()
+
+	/// <summary>操作の種類</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	ECaseSolutionAction Action = ECaseSolutionAction::TravelTo;
+
+	/// <summary>移動先（TravelTo）またはその操作を行う場所</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	ELocation Location = ELocation::Study;
+
+	/// <summary>対象のID（証拠・キャラクター・選択肢・ノード・推理のいずれか）</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	FName TargetId;
+};
+
+/// <summary>
+/// Blueprint・コマンドレット向けの解決可能性レポート
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCaseSolvabilityReport
+{
+	GENERATED_BODY()
+
+	/// <summary>告発条件をまだ満たせるか</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	bool bSolvable = false;
+
+	/// <summary>告発条件を満たすまでの手順（満たせない場合は空）</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	TArray<FCaseSolutionStep> Steps;
+
+	/// <summary>今後入手できない証拠</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	TArray<FName> UnreachableEvidence;
+
+	/// <summary>今後設定できないフラグ</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	TArray<FName> UnreachableFlags;
+
+	/// <summary>今後解放できない推理</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	TArray<FName> UnreachableDeductions;
+
+	/// <summary>到達できない対話ノード（"キャラクターID.ノードID" 形式）</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Solver")
+	TArray<FString> UnreachableDialogueNodes;
+};
+
+/// <summary>
+/// 到達可能性の解析結果
+/// </summary>
+struct FCaseReachability
+{
+	/// <summary>入手済み、または今後入手できる証拠</summary>
+	TBitArray<> Evidence;
+
+	/// <summary>設定済み、または今後設定できるフラグ</summary>
+	TBitArray<> Flags;
+
+	/// <summary>解放済み、または今後解放できる推理</summary>
+	TBitArray<> Deductions;
+
+	/// <summary>到達できる対話ノード（全ツリーを連結した通し番号）</summary>
+	TBitArray<> DialogueNodes;
+
+	/// <summary>告発条件をまだ満たせるか</summary>
+	bool bAccusationReachable = false;
+
+	/// <summary>告発条件を満たすまでの手順（bAccusationReachable かつ要求した場合のみ）</summary>
+	TArray<FCaseSolutionStep> Steps;
+};
+
+/// <summary>
+/// 事件内容と進行状態から、到達可能な要素と告発までの手順を求める解析器
+/// </summary>
+/// <remarks>
+/// 事件の状態は証拠・フラグ・推理が増える一方で減ることがないため、
+/// 「実行できる操作を全て実行し続けた不動点」がそのまま到達可能な集合になります。
+/// 事前に対話・選択肢・推理をインデックスとマスクに変換しておき、解析時はビット演算だけで
+/// 不動点まで掃引します。各要素には最初に得られた操作を記録し、告発条件から逆にたどって手順を組み立てます。
+/// 手順は各要素を最初に得られる操作だけで構成された短い手順であり、厳密な最短は保証しません。
+/// ロケーションのアクセス可否とキャラクターの居場所は進行状態から始め、対話は相手がアクセス可能な場所に
+/// いる（またはいられる）場合のみ開始できるものとして扱います。未発火のトリガーは条件のフラグ・証拠・推理が
+/// 揃えば実行できる操作、今後の移動予定は時間を進めれば実行できる操作として、その結果の場所を到達可能に加えます。
+/// ロケーションを閉じる操作と信頼度の条件は考慮せず、一度開いた場所・一度いた場所にはその後も行けるものとみなす楽観的な近似です。
+/// 前提から導かれる推理は前提が全て揃った時点で成立するため、手順には前提を得る操作だけを並べます。
+/// </remarks>
+class THELASTWITNESS_API FCaseSolver
+{
+public:
+	/// <summary>
+	/// 事件定義から解析用のテーブルを構築します
+	/// </summary>
+	void Build(const FCaseDefinition& Definition);
+
+	/// <summary>
+	/// 進行状態から到達可能性を解析します
+	/// </summary>
+	/// <param name="Definition">Build() に渡したものと同じ事件定義</param>
+	/// <param name="Progress">起点となる進行状態</param>
+	/// <param name="bBuildPlan">告発までの手順も組み立てるか</param>
+	FCaseReachability Solve(const FCaseDefinition& Definition, const FCaseProgress& Progress, bool bBuildPlan = true) const;
+
+	/// <summary>
+	/// 解析結果を ID ベースのレポートに変換します
+	/// </summary>
+	FCaseSolvabilityReport MakeReport(const FCaseDefinition& Definition, FCaseReachability&& Reachability) const;
+
+	/// <summary>
+	/// 対話ノードの通し番号を取得します
+	/// </summary>
+	int32 GetGlobalNodeIndex(int32 TreeIndex, int32 NodeIndex) const { return TreeFirstNode[TreeIndex] + NodeIndex; }
+
+	/// <summary>
+	/// 対話ノードの総数を取得します
+	/// </summary>
+	int32 NumDialogueNodes() const { return Nodes.Num(); }
+
+private:
+	/// <summary>
+	/// 要素を最初に得た操作の種類
+	/// </summary>
+	enum class ECause : uint8
+	{
+		/// <summary>解析開始時点で既に持っている（または到達できない）</summary>
+		None,
+		/// <summary>ロケーションで収集（Index = ロケーション）</summary>
+		Location,
+		/// <summary>対話ノードへの到達（Index = ノード）</summary>
+		Node,
+		/// <summary>選択肢の選択（Index = 選択肢）</summary>
+		Choice,
+		/// <summary>推理の解放（Index = 推理）</summary>
+		Deduction,
+		/// <summary>対話の開始（Index = ツリー）</summary>
+		Start,
+		/// <summary>選択肢のないノードからの自動遷移（Index = 遷移元ノード）</summary>
+		AutoNext,
+		/// <summary>トリガーの発火（Index = トリガー）</summary>
+		Trigger,
+		/// <summary>移動予定（Index = FCaseDefinition::GetSchedule() 内の位置）</summary>
+		Schedule
+	};
+
+	struct FCause
+	{
+		ECause Kind = ECause::None;
+		int32 Index = INDEX_NONE;
+	};
+
+	struct FSolverNode
+	{
+		int32 Tree = INDEX_NONE;
+		int32 LocalIndex = INDEX_NONE;
+		int32 AutoNext = INDEX_NONE;
+		int32 FirstChoice = 0;
+		int32 NumChoices = 0;
+		int32 FirstGain = 0;
+		int32 NumGains = 0;
+	};
+
+	struct FSolverChoice
+	{
+		int32 OwnerNode = INDEX_NONE;
+		int32 ChoiceIndex = INDEX_NONE;
+		int32 TargetNode = INDEX_NONE;
+	};
+
+	/// <summary>
+	/// 解析中に記録した、各要素を最初に得た操作
+	/// </summary>
+	struct FSolveCauses
+	{
+		TArray<FCause> Evidence;
+		TArray<FCause> Flags;
+		TArray<FCause> Nodes;
+		TArray<FCause> Locations;
+
+		/// <summary>キャラクターがロケーションにいられるようになった操作（CharacterIndex * NumLocations + LocationIndex）</summary>
+		TArray<FCause> Presence;
+
+		/// <summary>ツリーごとの対話を開始したロケーション</summary>
+		TArray<int32> TreeLocations;
+	};
+
+	class FPlanBuilder;
+
+	/// <summary>ツリーごとの先頭ノードの通し番号</summary>
+	TArray<int32> TreeFirstNode;
+
+	/// <summary>ツリーごとの開始ノード（対話を開始できないツリーは INDEX_NONE）</summary>
+	TArray<int32> TreeStartNode;
+
+	/// <summary>ツリーの相手のキャラクター（TreeStartNode が有効な場合のみ）</summary>
+	TArray<int32> TreeCharacter;
+
+	/// <summary>全ツリーのノード</summary>
+	TArray<FSolverNode> Nodes;
+
+	/// <summary>全ノードの選択肢（事件定義の ChoiceData と同じ並び）</summary>
+	TArray<FSolverChoice> Choices;
+
+	/// <summary>ノードで得られる証拠のインデックス（ノード順に連結）</summary>
+	TArray<int32> GainedEvidence;
+
+	/// <summary>推理ごとの必要証拠（存在しない証拠なら INDEX_NONE）</summary>
+	TArray<TPair<int32, int32>> DeductionEvidence;
+};
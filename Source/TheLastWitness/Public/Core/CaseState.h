@@ -5,13 +5,179 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "WitnessTypes.h"
+#include "CaseProgress.h"
+#include "CaseHandles.h"
+#include "CaseJournal.h"
+#include "CaseSolver.h"
+#include "CaseSnapshot.h"
+#include "CaseScheduler.h"
+#include "Containers/Ticker.h"
 #include "CaseState.generated.h"
 
+class FCaseDefinition;
+struct FCompiledMask;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEvidenceCollected, const FEvidence&, Evidence);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDeductionUnlocked, const FDeduction&, Deduction);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFlagSet, FName, FlagName);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLocationVisited, ELocation, Location);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCharacterTrustChanged, FName, CharacterId, int32, NewTrust);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCharacterMoved, FName, CharacterId, ELocation, NewLocation);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLocationAccessChanged, ELocation, Location, bool, bAccessible);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCharacterEmotionChanged, FName, CharacterId, EEmotionalState, NewState);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnClockAdvanced, int32, ClockMinutes);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnProgressRestored);
+
+// C++ 向けのネイティブ版（構造体をコピーせず、事件定義のインデックスを渡します）
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEvidenceCollectedNative, int32 /* EvidenceIndex */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDeductionUnlockedNative, int32 /* DeductionIndex */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFlagSetNative, FName /* FlagName */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLocationVisitedNative, ELocation /* Location */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnCharacterTrustChangedNative, int32 /* CharacterIndex */, int32 /* NewTrust */);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnCharacterMovedNative, int32 /* CharacterIndex */, int32 /* FromLocationIndex */, int32 /* ToLocationIndex */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLocationAccessChangedNative, int32 /* LocationIndex */, bool /* bAccessible */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnCharacterEmotionChangedNative, int32 /* CharacterIndex */, EEmotionalState /* NewState */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnClockAdvancedNative, int32 /* ClockMinutes */);
+DECLARE_MULTICAST_DELEGATE(FOnProgressRestoredNative);
+
+/// <summary>
+/// まとめて通知される変更の種類
+/// </summary>
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECaseChangeFlags : uint8
+{
+	None = 0 UMETA(Hidden),
+	/// <summary>証拠の収集・調査</summary>
+	Evidence = 1 << 0,
+	/// <summary>推理の解放</summary>
+	Deductions = 1 << 1,
+	/// <summary>フラグの設定</summary>
+	Flags = 1 << 2,
+	/// <summary>キャラクターの信頼度・インタビュー状態・居場所・感情状態</summary>
+	Characters = 1 << 3,
+	/// <summary>現在地・訪問済みロケーション・アクセス可否</summary>
+	Location = 1 << 4,
+	/// <summary>ゲーム内時刻</summary>
+	Clock = 1 << 5
+};
+ENUM_CLASS_FLAGS(ECaseChangeFlags);
+
+/// <summary>
+/// 1フレーム（または明示的なフラッシュ）の間に発生した変更のまとめ
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCaseChangeSet
+{
+	GENERATED_BODY()
+
+	/// <summary>変更のあった種類（ECaseChangeFlags の組み合わせ）</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes", meta = (Bitmask, BitmaskEnum = "/Script/TheLastWitness.ECaseChangeFlags"))
+	int32 ChangedMask = 0;
+
+	/// <summary>新たに収集された証拠</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<FName> CollectedEvidence;
+
+	/// <summary>新たに解放された推理</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<FName> UnlockedDeductions;
+
+	/// <summary>新たに設定されたフラグ</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<FName> SetFlags;
+
+	/// <summary>信頼度が変化したキャラクター</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<FName> TrustChangedCharacters;
+
+	/// <summary>新たに訪問したロケーション</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<ELocation> VisitedLocations;
+
+	/// <summary>居場所が変わったキャラクター</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<FName> MovedCharacters;
+
+	/// <summary>アクセス可否が変わったロケーション</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<ELocation> AccessChangedLocations;
+
+	/// <summary>感情状態が変わったキャラクター</summary>
+	UPROPERTY(BlueprintReadOnly, Category = "Changes")
+	TArray<FName> EmotionChangedCharacters;
+
+	bool HasChanged(ECaseChangeFlags Flag) const { return (ChangedMask & static_cast<int32>(Flag)) != 0; }
+	bool IsEmpty() const { return ChangedMask == 0; }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCaseChanged, const FCaseChangeSet&, Changes);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCaseChangedNative, const FCaseChangeSet& /* Changes */);
+
+/// <summary>
+/// 証拠検索での進行状態の条件
+/// </summary>
+UENUM(BlueprintType)
+enum class EEvidenceStateFilter : uint8
+{
+	/// <summary>条件なし</summary>
+	Any,
+	/// <summary>満たしているもののみ</summary>
+	Yes,
+	/// <summary>満たしていないもののみ</summary>
+	No
+};
+
+/// <summary>
+/// 証拠の検索条件（指定した条件は全て AND で結合されます）
+/// </summary>
+USTRUCT(BlueprintType)
+struct FEvidenceQuery
+{
+	GENERATED_BODY()
+
+	/// <summary>種類で絞り込むか</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	bool bFilterByType = false;
+
+	/// <summary>証拠の種類</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query", meta = (EditCondition = "bFilterByType"))
+	EEvidenceType Type = EEvidenceType::Physical;
+
+	/// <summary>重要度で絞り込むか</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	bool bFilterByImportance = false;
+
+	/// <summary>この重要度以上の証拠のみ</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query", meta = (EditCondition = "bFilterByImportance"))
+	EEvidenceImportance MinImportance = EEvidenceImportance::Minor;
+
+	/// <summary>ロケーションで絞り込むか</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	bool bFilterByLocation = false;
+
+	/// <summary>証拠が置かれているロケーション（AvailableEvidence 基準）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query", meta = (EditCondition = "bFilterByLocation"))
+	ELocation Location = ELocation::Study;
+
+	/// <summary>関連キャラクター（None で条件なし）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	FName RelatedCharacter;
+
+	/// <summary>収集済みかどうか</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	EEvidenceStateFilter Collected = EEvidenceStateFilter::Any;
+
+	/// <summary>調査済みかどうか</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Query")
+	EEvidenceStateFilter Examined = EEvidenceStateFilter::Any;
+
+	FEvidenceQuery& OfType(EEvidenceType InType) { bFilterByType = true; Type = InType; return *this; }
+	FEvidenceQuery& AtLeast(EEvidenceImportance InImportance) { bFilterByImportance = true; MinImportance = InImportance; return *this; }
+	FEvidenceQuery& At(ELocation InLocation) { bFilterByLocation = true; Location = InLocation; return *this; }
+	FEvidenceQuery& RelatedTo(FName CharacterId) { RelatedCharacter = CharacterId; return *this; }
+	FEvidenceQuery& WithCollected(EEvidenceStateFilter InFilter) { Collected = InFilter; return *this; }
+	FEvidenceQuery& WithExamined(EEvidenceStateFilter InFilter) { Examined = InFilter; return *this; }
+};
 
 /// <summary>
 /// 現在の事件の進行状態を管理するクラス
@@ -19,6 +185,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCharacterTrustChanged, FName, Ch
 /// <remarks>
 /// 収集した証拠、解放した推理、設定されたフラグなどを追跡します。
 /// GameModeによって所有され、UIやシステムから参照されます。
+/// 事件の内容は共有の FCaseDefinition を参照し、自身は FCaseProgress のみを保持します。
 /// </remarks>
 UCLASS(BlueprintType)
 class THELASTWITNESS_API UCaseState : public UObject
@@ -28,6 +195,8 @@ class THELASTWITNESS_API UCaseState : public UObject
 public:
 	UCaseState();
 
+	virtual void BeginDestroy() override;
+
 	// ========================================================================
 	// 初期化
 	// ========================================================================
@@ -39,12 +208,144 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Case")
 	void InitializeCase(const FCaseData& CaseData);
 
+	/// <summary>
+	/// 共有の事件定義で状態を初期化します（事件データのコピーは行いません）
+	/// </summary>
+	/// <param name="InDefinition">事件定義</param>
+	void InitializeFromDefinition(TSharedRef<const FCaseDefinition> InDefinition);
+
 	/// <summary>
 	/// 状態をリセットします
 	/// </summary>
 	UFUNCTION(BlueprintCallable, Category = "Case")
 	void ResetState();
 
+	/// <summary>
+	/// プールへ返却するため、リスナー・チェックポイント・保留中の変更を破棄します
+	/// </summary>
+	/// <remarks>
+	/// 進行状態の領域は保持したままなので、同じ事件定義で InitializeFromDefinition を呼べば再確保なしで再利用できます。
+	/// </remarks>
+	void ReleaseForReuse();
+
+	// ========================================================================
+	// チェックポイント
+	// ========================================================================
+
+	/// <summary>
+	/// 現在の進行状態をチェックポイントとして保存します（O(1)）
+	/// </summary>
+	/// <returns>チェックポイントID</returns>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	int32 CreateCheckpoint();
+
+	/// <summary>
+	/// チェックポイントの進行状態に戻します
+	/// </summary>
+	/// <returns>復元に成功したかどうか</returns>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	bool RestoreCheckpoint(int32 CheckpointId);
+
+	/// <summary>
+	/// チェックポイントを破棄します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	void DiscardCheckpoint(int32 CheckpointId);
+
+	/// <summary>
+	/// 進行状態のスナップショットを取得します（セクションを共有するため O(1)）
+	/// </summary>
+	FCaseProgress CaptureProgress() const { return Progress; }
+
+	/// <summary>
+	/// スナップショットから進行状態を復元します
+	/// </summary>
+	/// <returns>現在の事件定義と一致し、復元できたかどうか</returns>
+	bool RestoreProgress(const FCaseProgress& Snapshot);
+
+	// ========================================================================
+	// ジャーナル
+	// ========================================================================
+
+	/// <summary>
+	/// 初期状態からの操作記録を取得します
+	/// </summary>
+	const FCaseJournal& GetJournal() const { return Journal; }
+
+	/// <summary>
+	/// ジャーナルが初期状態からの全操作を含んでいるか確認します
+	/// </summary>
+	/// <remarks>
+	/// 現在の履歴より先のチェックポイントを復元した場合など、記録が途切れると false になります。
+	/// </remarks>
+	UFUNCTION(BlueprintPure, Category = "Journal")
+	bool IsJournalComplete() const { return bJournalComplete; }
+
+	/// <summary>
+	/// ジャーナルを初期状態から再生して進行状態を再構築します
+	/// </summary>
+	/// <remarks>
+	/// 再生中は個別のイベントを発火せず、完了時に OnProgressRestored を一度だけ発火します。
+	/// 失敗した場合は再生前の状態に戻ります。
+	/// </remarks>
+	/// <returns>再生に成功したかどうか</returns>
+	bool ReplayJournal(const FCaseJournal& InJournal);
+
+	/// <summary>
+	/// ジャーナルをバイト列として書き出します（バグ報告やプロファイル用）
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Journal")
+	TArray<uint8> ExportJournal() const;
+
+	/// <summary>
+	/// バイト列からジャーナルを読み込み、再生します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Journal")
+	bool ImportJournal(const TArray<uint8>& Data);
+
+	// ========================================================================
+	// セーブデータ
+	// ========================================================================
+
+	/// <summary>
+	/// 現在の進行状態をセーブデータ用のバイト列に書き出します
+	/// </summary>
+	/// <remarks>
+	/// 事件IDと FCaseProgress::Save() の内容だけを含み、作成済みのテキストは含みません。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	TArray<uint8> SaveProgressToBytes() const;
+
+	/// <summary>
+	/// SaveProgressToBytes() で書き出した進行状態を読み込みます
+	/// </summary>
+	/// <remarks>
+	/// 読み込んだ状態はジャーナルで再現できないため、ジャーナルは途切れた扱いになります。
+	/// 成功時は OnProgressRestored を発火します。
+	/// </remarks>
+	/// <returns>別の事件のデータや壊れたデータの場合は false</returns>
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	bool LoadProgressFromBytes(const TArray<uint8>& Data);
+
+	/// <summary>
+	/// SaveProgressToBytes() で書き出したバイト列を、指定した事件定義に対してデコードします
+	/// </summary>
+	/// <remarks>
+	/// CaseState を変更しないため、事件を切り替える前にセーブデータを検証する用途に使えます。
+	/// </remarks>
+	/// <returns>別の事件のデータや壊れたデータの場合は false（OutProgress は変更しません）</returns>
+	static bool DecodeProgressFromBytes(const TArray<uint8>& Data, const FCaseDefinition& InDefinition, FCaseProgress& OutProgress);
+
+	/// <summary>
+	/// DecodeProgressFromBytes() でデコード済みの進行状態を適用します
+	/// </summary>
+	/// <remarks>
+	/// LoadProgressFromBytes() と同じく、ジャーナルは途切れた扱いになり、チェックポイントは破棄されます。
+	/// 成功時は OnProgressRestored を発火します。
+	/// </remarks>
+	/// <returns>現在の事件定義と一致しない場合は false</returns>
+	bool ApplyLoadedProgress(FCaseProgress&& Loaded);
+
 	// ========================================================================
 	// 証拠関連
 	// ========================================================================
@@ -57,12 +358,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Evidence")
 	bool CollectEvidence(FName EvidenceId);
 
+	/// <summary>
+	/// 証拠を収集します（ネイティブ向け）
+	/// </summary>
+	bool CollectEvidence(FEvidenceHandle Evidence);
+
 	/// <summary>
 	/// 証拠を調査済みにします
 	/// </summary>
 	/// <param name="EvidenceId">証拠ID</param>
+	/// <returns>新たに調査済みになった場合は true</returns>
 	UFUNCTION(BlueprintCallable, Category = "Evidence")
-	void ExamineEvidence(FName EvidenceId);
+	bool ExamineEvidence(FName EvidenceId);
+
+	/// <summary>
+	/// 証拠を調査済みにします（ネイティブ向け）
+	/// </summary>
+	bool ExamineEvidence(FEvidenceHandle Evidence);
 
 	/// <summary>
 	/// 証拠が収集済みか確認します
@@ -70,18 +382,79 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Evidence")
 	bool HasEvidence(FName EvidenceId) const;
 
+	/// <summary>
+	/// 証拠が収集済みか確認します（ネイティブ向け）
+	/// </summary>
+	bool HasEvidence(FEvidenceHandle Evidence) const;
+
 	/// <summary>
 	/// 収集済みの全証拠を取得します
 	/// </summary>
 	UFUNCTION(BlueprintPure, Category = "Evidence")
 	TArray<FEvidence> GetCollectedEvidence() const;
 
+	/// <summary>
+	/// 収集済みの証拠数を取得します（O(1)）
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Evidence")
+	int32 GetCollectedEvidenceCount() const;
+
 	/// <summary>
 	/// 証拠データを取得します
 	/// </summary>
 	UFUNCTION(BlueprintPure, Category = "Evidence")
 	bool GetEvidenceById(FName EvidenceId, FEvidence& OutEvidence) const;
 
+	// ========================================================================
+	// 証拠の検索
+	// ========================================================================
+
+	/// <summary>
+	/// 条件に一致する証拠を取得します（証拠インデックス順）
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Evidence")
+	TArray<FEvidence> QueryEvidence(const FEvidenceQuery& Query) const;
+
+	/// <summary>
+	/// 条件に一致する証拠のIDを取得します（証拠インデックス順）
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Evidence")
+	TArray<FName> QueryEvidenceIds(const FEvidenceQuery& Query) const;
+
+	/// <summary>
+	/// 条件に一致する証拠の数を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Evidence")
+	int32 CountEvidence(const FEvidenceQuery& Query) const;
+
+	/// <summary>
+	/// 条件に一致する証拠のビット列を計算します
+	/// </summary>
+	/// <remarks>
+	/// 事件定義の二次索引と収集・調査済みのビット列をワード単位の AND で結合します。
+	/// 事件内に存在しないキャラクターを指定した場合は全て 0 になります。
+	/// </remarks>
+	/// <returns>ビット列のワード数</returns>
+	int32 ComputeEvidenceQueryWords(const FEvidenceQuery& Query, TArray<uint32, TInlineAllocator<4>>& OutWords) const;
+
+	/// <summary>
+	/// 条件に一致する証拠のインデックスを呼び出し側のバッファに書き出します
+	/// </summary>
+	template <typename AllocatorType>
+	void QueryEvidenceIndices(const FEvidenceQuery& Query, TArray<int32, AllocatorType>& OutIndices) const
+	{
+		OutIndices.Reset();
+		TArray<uint32, TInlineAllocator<4>> Words;
+		const int32 NumWords = ComputeEvidenceQueryWords(Query, Words);
+		for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+		{
+			for (uint32 Word = Words[WordIndex]; Word != 0; Word &= Word - 1)
+			{
+				OutIndices.Add(WordIndex * NumBitsPerDWORD + FMath::CountTrailingZeros(Word));
+			}
+		}
+	}
+
 	// ========================================================================
 	// 推理関連
 	// ========================================================================
@@ -96,6 +469,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Deduction")
 	bool TryDeduction(FName EvidenceA, FName EvidenceB, FDeduction& OutDeduction);
 
+	/// <summary>
+	/// 2つの証拠を結びつけて推理を試みます（ネイティブ向け）
+	/// </summary>
+	/// <returns>成立した推理（既に解放済みのものを含む）。不成立なら無効なハンドル</returns>
+	FDeductionHandle TryDeduction(FEvidenceHandle EvidenceA, FEvidenceHandle EvidenceB);
+
 	/// <summary>
 	/// 解放済みの全推理を取得します
 	/// </summary>
@@ -108,6 +487,24 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Deduction")
 	bool IsDeductionUnlocked(FName DeductionId) const;
 
+	/// <summary>
+	/// 推理が解放済みか確認します（ネイティブ向け）
+	/// </summary>
+	bool IsDeductionUnlocked(FDeductionHandle Deduction) const;
+
+	/// <summary>
+	/// 解放済みの推理数を取得します（O(1)）
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Deduction")
+	int32 GetUnlockedDeductionCount() const;
+
+	/// <summary>
+	/// 2つの証拠を結ぶ推理が既に解放済みか確認します
+	/// </summary>
+	/// <param name="EvidenceIndexA">証拠Aのインデックス</param>
+	/// <param name="EvidenceIndexB">証拠Bのインデックス</param>
+	bool IsEvidencePairDeduced(int32 EvidenceIndexA, int32 EvidenceIndexB) const;
+
 	// ========================================================================
 	// フラグ関連
 	// ========================================================================
@@ -118,18 +515,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Flags")
 	void SetFlag(FName FlagName);
 
+	/// <summary>
+	/// 事件内で使われるフラグを設定します（ネイティブ向け）
+	/// </summary>
+	void SetFlag(FFlagHandle Flag);
+
 	/// <summary>
 	/// フラグが設定されているか確認します
 	/// </summary>
 	UFUNCTION(BlueprintPure, Category = "Flags")
 	bool HasFlag(FName FlagName) const;
 
+	/// <summary>
+	/// 事件内で使われるフラグが設定されているか確認します（ネイティブ向け）
+	/// </summary>
+	bool HasFlag(FFlagHandle Flag) const;
+
 	/// <summary>
 	/// 複数のフラグが全て設定されているか確認します
 	/// </summary>
 	UFUNCTION(BlueprintPure, Category = "Flags")
 	bool HasAllFlags(const TArray<FName>& FlagNames) const;
 
+	/// <summary>
+	/// 事前コンパイル済みマスクのフラグを全て設定します
+	/// </summary>
+	void ApplyFlagMask(const FCompiledMask& Mask);
+
+	/// <summary>
+	/// 事前コンパイル済みマスクのフラグが全て設定されているか確認します
+	/// </summary>
+	bool HasAllFlagsInMask(const FCompiledMask& Mask) const;
+
+	/// <summary>
+	/// 事前コンパイル済みマスクの証拠が全て収集済みか確認します
+	/// </summary>
+	bool HasAllEvidenceInMask(const FCompiledMask& Mask) const;
+
 	// ========================================================================
 	// キャラクター関連
 	// ========================================================================
@@ -146,18 +568,44 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Characters")
 	void ModifyCharacterTrust(FName CharacterId, int32 Delta);
 
+	/// <summary>
+	/// キャラクターの信頼度を変更します（ネイティブ向け）
+	/// </summary>
+	void ModifyCharacterTrust(FCharacterHandle Character, int32 Delta);
+
 	/// <summary>
 	/// キャラクターをインタビュー済みにします
 	/// </summary>
 	UFUNCTION(BlueprintCallable, Category = "Characters")
 	void MarkCharacterInterviewed(FName CharacterId);
 
+	/// <summary>
+	/// キャラクターをインタビュー済みにします（ネイティブ向け）
+	/// </summary>
+	void MarkCharacterInterviewed(FCharacterHandle Character);
+
+	/// <summary>
+	/// キャラクターがインタビュー済みか確認します（ネイティブ向け）
+	/// </summary>
+	bool IsCharacterInterviewed(FCharacterHandle Character) const;
+
+	/// <summary>
+	/// キャラクターの現在の感情状態を取得します（ネイティブ向け）
+	/// </summary>
+	EEmotionalState GetCharacterEmotionalState(FCharacterHandle Character) const;
+
 	/// <summary>
 	/// 全容疑者を取得します
 	/// </summary>
 	UFUNCTION(BlueprintPure, Category = "Characters")
 	TArray<FCharacterData> GetAllSuspects() const;
 
+	/// <summary>
+	/// インタビュー済みのキャラクター数を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Characters")
+	int32 GetInterviewedCharacterCount() const;
+
 	// ========================================================================
 	// ロケーション関連
 	// ========================================================================
@@ -166,7 +614,7 @@ public:
 	/// 現在のロケーションを取得します
 	/// </summary>
 	UFUNCTION(BlueprintPure, Category = "Location")
-	ELocation GetCurrentLocation() const { return CurrentLocation; }
+	ELocation GetCurrentLocation() const { return Progress.CurrentLocation; }
 
 	/// <summary>
 	/// ロケーションを移動します
@@ -186,6 +634,83 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Location")
 	TArray<FLocationData> GetAccessibleLocations() const;
 
+	/// <summary>
+	/// ロケーションに現在アクセスできるか確認します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Location")
+	bool IsLocationAccessible(ELocation Location) const;
+
+	/// <summary>
+	/// ロケーションに残っている未収集の証拠数を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Location")
+	int32 GetUncollectedEvidenceCountAt(ELocation Location) const;
+
+	// ========================================================================
+	// ゲーム内時刻
+	// ========================================================================
+
+	/// <summary>
+	/// ゲーム内時刻を進め、その間に予定されていたキャラクターの移動を時刻順に適用します
+	/// </summary>
+	/// <remarks>
+	/// 移動ごとに OnCharacterMoved を、最後に OnClockAdvanced を発火します。
+	/// 予定はタイミングホイールで管理しているため、コストは進めた時間ではなく発生した移動の数に比例します。
+	/// </remarks>
+	/// <param name="Minutes">進める分数（0以下なら何もしません）</param>
+	UFUNCTION(BlueprintCallable, Category = "Time")
+	void AdvanceClock(int32 Minutes);
+
+	/// <summary>
+	/// ゲーム内時刻（事件開始からの分）を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Time")
+	int32 GetClockMinutes() const { return Progress.ClockMinutes; }
+
+	/// <summary>
+	/// ロケーションに現在いるキャラクターを取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Characters")
+	TArray<FCharacterData> GetCharactersAtLocation(ELocation Location) const;
+
+	/// <summary>
+	/// キャラクターの現在の居場所を取得します
+	/// </summary>
+	/// <returns>どこにもいない場合は false</returns>
+	UFUNCTION(BlueprintPure, Category = "Characters")
+	bool GetCharacterLocation(FName CharacterId, ELocation& OutLocation) const;
+
+	/// <summary>
+	/// ロケーションに現在いるキャラクターを列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 CharacterIndex)</param>
+	template <typename VisitorType>
+	void ForEachCharacterAt(int32 LocationIndex, VisitorType&& Visitor) const
+	{
+		const TArray<int32>& CurrentLocations = Progress.Characters->CurrentLocations;
+		for (int32 i = 0; i < CurrentLocations.Num(); i++)
+		{
+			if (CurrentLocations[i] == LocationIndex)
+			{
+				Visitor(i);
+			}
+		}
+	}
+
+	// ========================================================================
+	// トリガー
+	// ========================================================================
+
+	/// <summary>
+	/// トリガーが発火済みか確認します
+	/// </summary>
+	/// <remarks>
+	/// トリガーは FCaseData::Triggers の条件が全て成立した時点で一度だけ発火します。
+	/// 条件に使われる事実が変化するたびに、その事実に依存するトリガーだけを評価します。
+	/// </remarks>
+	UFUNCTION(BlueprintPure, Category = "Triggers")
+	bool HasTriggerFired(FName TriggerId) const;
+
 	// ========================================================================
 	// 告発関連
 	// ========================================================================
@@ -196,6 +721,26 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Accusation")
 	bool CanMakeAccusation() const;
 
+	/// <summary>
+	/// 告発に必要な証拠のうち未収集のものの数を取得します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Accusation")
+	int32 GetUnmetAccusationRequirementCount() const;
+
+	/// <summary>
+	/// 現在の進行状態から告発条件をまだ満たせるか解析し、満たすまでの手順を求めます
+	/// </summary>
+	/// <remarks>
+	/// 到達できない要素の一覧も含みます。手順だけが必要な場合は AnalyzeReachability() の方が軽量です。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Accusation")
+	FCaseSolvabilityReport AnalyzeSolvability() const;
+
+	/// <summary>
+	/// 現在の進行状態から到達可能性を解析します（ビット列のまま返すネイティブ版）
+	/// </summary>
+	FCaseReachability AnalyzeReachability(bool bBuildPlan = true) const;
+
 	/// <summary>
 	/// 犯人を告発します
 	/// </summary>
@@ -212,19 +757,158 @@ public:
 	/// ABELの提案に従った回数を増やします
 	/// </summary>
 	UFUNCTION(BlueprintCallable, Category = "Stats")
-	void IncrementABELFollowed() { ABELSuggestionsFollowed++; }
+	void IncrementABELFollowed();
 
 	/// <summary>
 	/// ABELの提案を無視した回数を増やします
 	/// </summary>
 	UFUNCTION(BlueprintCallable, Category = "Stats")
-	void IncrementABELIgnored() { ABELSuggestionsIgnored++; }
+	void IncrementABELIgnored();
 
 	/// <summary>
 	/// 倫理的違反回数を増やします
 	/// </summary>
 	UFUNCTION(BlueprintCallable, Category = "Stats")
-	void IncrementEthicalViolations() { EthicalViolations++; }
+	void IncrementEthicalViolations();
+
+	// ========================================================================
+	// ネイティブ向けビュー（コピーなし）
+	// ========================================================================
+
+	// 以下の ForEach は FCaseData 内の作成済みデータを const 参照のまま渡します。
+	// bIsCollected や TrustLevel 等の実行時フィールドは反映されないため、
+	// 進行状態が必要な場合は渡されたインデックスで GetProgress() を参照してください。
+	// Blueprint 向けには従来どおりコピーを返す Get 系関数を使用します。
+
+	/// <summary>
+	/// 収集済みの証拠を列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 Index, const FEvidence&amp; Evidence)</param>
+	template <typename VisitorType>
+	void ForEachCollectedEvidence(VisitorType&& Visitor) const
+	{
+		const TArray<FEvidence>& AllEvidence = GetCaseData().AllEvidence;
+		for (TConstSetBitIterator<> It(Progress.Evidence->Collected); It; ++It)
+		{
+			Visitor(It.GetIndex(), AllEvidence[It.GetIndex()]);
+		}
+	}
+
+	/// <summary>
+	/// 解放済みの推理を列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 Index, const FDeduction&amp; Deduction)</param>
+	template <typename VisitorType>
+	void ForEachUnlockedDeduction(VisitorType&& Visitor) const
+	{
+		const TArray<FDeduction>& AllDeductions = GetCaseData().AllDeductions;
+		for (TConstSetBitIterator<> It(Progress.Deductions->Unlocked); It; ++It)
+		{
+			Visitor(It.GetIndex(), AllDeductions[It.GetIndex()]);
+		}
+	}
+
+	/// <summary>
+	/// 容疑者を列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 Index, const FCharacterData&amp; Character)</param>
+	template <typename VisitorType>
+	void ForEachSuspect(VisitorType&& Visitor) const
+	{
+		const TArray<FCharacterData>& AllCharacters = GetCaseData().AllCharacters;
+		for (int32 i = 0; i < AllCharacters.Num(); i++)
+		{
+			if (AllCharacters[i].bIsSuspect)
+			{
+				Visitor(i, AllCharacters[i]);
+			}
+		}
+	}
+
+	/// <summary>
+	/// アクセス可能なロケーションを列挙します
+	/// </summary>
+	/// <param name="Visitor">void(int32 Index, const FLocationData&amp; Location)</param>
+	template <typename VisitorType>
+	void ForEachAccessibleLocation(VisitorType&& Visitor) const
+	{
+		const TArray<FLocationData>& AllLocations = GetCaseData().AllLocations;
+		for (TConstSetBitIterator<> It(Progress.Locations->Accessible); It; ++It)
+		{
+			Visitor(It.GetIndex(), AllLocations[It.GetIndex()]);
+		}
+	}
+
+	/// <summary>
+	/// 収集済み証拠のインデックスを呼び出し側のバッファに書き出します
+	/// </summary>
+	/// <remarks>
+	/// バッファは上書きされます。使い回すことでフレームごとの確保を避けられます。
+	/// </remarks>
+	template <typename AllocatorType>
+	void GetCollectedEvidenceIndices(TArray<int32, AllocatorType>& OutIndices) const
+	{
+		OutIndices.Reset();
+		for (TConstSetBitIterator<> It(Progress.Evidence->Collected); It; ++It)
+		{
+			OutIndices.Add(It.GetIndex());
+		}
+	}
+
+	// ========================================================================
+	// 変更通知のまとめ
+	// ========================================================================
+
+	/// <summary>
+	/// 変更通知をまとめるモードを切り替えます
+	/// </summary>
+	/// <remarks>
+	/// 有効な間は OnEvidenceCollected / OnDeductionUnlocked / OnFlagSet / OnLocationVisited /
+	/// OnCharacterTrustChanged を個別に発火せず、変更内容を記録して次のフレームで
+	/// OnCaseChanged を一度だけ発火します。無効にすると保留中の変更を直ちに通知します。
+	/// ネイティブ版の個別イベントは安価なため、このモードでも即座に発火します。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Events")
+	void SetChangeSetMode(bool bEnabled);
+
+	/// <summary>
+	/// 変更通知をまとめるモードが有効か確認します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Events")
+	bool IsChangeSetModeEnabled() const { return bChangeSetMode; }
+
+	/// <summary>
+	/// 保留中の変更をフレームの終わりを待たずに通知します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Events")
+	void FlushChanges();
+
+	// ========================================================================
+	// ゲームスレッド外への公開
+	// ========================================================================
+
+	/// <summary>
+	/// 進行状態のスナップショットを公開するか切り替えます
+	/// </summary>
+	/// <remarks>
+	/// 有効な間は、変更のまとまり（OnCaseChanged と同じタイミング、まとめない場合は次のフレーム）ごとに
+	/// 読み取り専用のスナップショットを作り直します。有効にした時点でも1つ公開します。
+	/// </remarks>
+	void SetSnapshotPublishing(bool bEnabled);
+
+	/// <summary>
+	/// 現在の進行状態を直ちにスナップショットとして公開します（ゲームスレッドのみ）
+	/// </summary>
+	void PublishSnapshot();
+
+	/// <summary>
+	/// 最後に公開されたスナップショットを取得します（任意のスレッドから呼び出せます）
+	/// </summary>
+	/// <remarks>
+	/// ロックはポインタの取り出しの間だけで、取得したスナップショットの読み取りにはロックは不要です。
+	/// 公開が無効なら nullptr を返します。
+	/// </remarks>
+	FCaseSnapshotPtr GetLatestSnapshot() const;
 
 	// ========================================================================
 	// イベント
@@ -250,6 +934,65 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnCharacterTrustChanged OnCharacterTrustChanged;
 
+	/// <summary>予定に従ってキャラクターが移動した時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnCharacterMoved OnCharacterMoved;
+
+	/// <summary>トリガーによってロケーションのアクセス可否が変わった時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnLocationAccessChanged OnLocationAccessChanged;
+
+	/// <summary>トリガーによってキャラクターの感情状態が変わった時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnCharacterEmotionChanged OnCharacterEmotionChanged;
+
+	/// <summary>ゲーム内時刻が進んだ時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnClockAdvanced OnClockAdvanced;
+
+	/// <summary>チェックポイント等から進行状態が復元された時に発火（UIは全体を再描画してください）</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnProgressRestored OnProgressRestored;
+
+	/// <summary>変更通知をまとめるモードで、まとめた変更の通知時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnCaseChanged OnCaseChanged;
+
+	// ネイティブ版（C++ のリスナーはこちらを使用してください）
+
+	/// <summary>証拠収集時に発火（証拠のインデックス）</summary>
+	FOnEvidenceCollectedNative OnEvidenceCollectedNative;
+
+	/// <summary>推理解放時に発火（推理のインデックス）</summary>
+	FOnDeductionUnlockedNative OnDeductionUnlockedNative;
+
+	/// <summary>フラグ設定時に発火</summary>
+	FOnFlagSetNative OnFlagSetNative;
+
+	/// <summary>ロケーション訪問時に発火</summary>
+	FOnLocationVisitedNative OnLocationVisitedNative;
+
+	/// <summary>キャラクター信頼度変化時に発火（キャラクターのインデックス）</summary>
+	FOnCharacterTrustChangedNative OnCharacterTrustChangedNative;
+
+	/// <summary>キャラクターの移動時に発火（キャラクターと移動前後のロケーションのインデックス）</summary>
+	FOnCharacterMovedNative OnCharacterMovedNative;
+
+	/// <summary>ロケーションのアクセス可否の変化時に発火（ロケーションのインデックス）</summary>
+	FOnLocationAccessChangedNative OnLocationAccessChangedNative;
+
+	/// <summary>キャラクターの感情状態の変化時に発火（キャラクターのインデックス）</summary>
+	FOnCharacterEmotionChangedNative OnCharacterEmotionChangedNative;
+
+	/// <summary>ゲーム内時刻が進んだ時に発火</summary>
+	FOnClockAdvancedNative OnClockAdvancedNative;
+
+	/// <summary>進行状態の復元時に発火</summary>
+	FOnProgressRestoredNative OnProgressRestoredNative;
+
+	/// <summary>まとめた変更の通知時に発火</summary>
+	FOnCaseChangedNative OnCaseChangedNative;
+
 	// ========================================================================
 	// データアクセス
 	// ========================================================================
@@ -257,35 +1000,248 @@ public:
 	/// <summary>
 	/// 事件データを取得します
 	/// </summary>
+	/// <remarks>
+	/// 返されるのは作成時の定義であり、bIsCollected 等の実行時フィールドは反映されません。
+	/// 進行状態は HasEvidence 等のクエリで取得してください。
+	/// </remarks>
 	UFUNCTION(BlueprintPure, Category = "Case")
-	const FCaseData& GetCaseData() const { return CaseData; }
+	const FCaseData& GetCaseData() const;
+
+	/// <summary>
+	/// 共有の事件定義を取得します
+	/// </summary>
+	TSharedPtr<const FCaseDefinition> GetDefinition() const { return Definition; }
+
+	/// <summary>
+	/// 進行状態を取得します
+	/// </summary>
+	const FCaseProgress& GetProgress() const { return Progress; }
+
+	/// <summary>
+	/// このオブジェクトが使用しているおおよそのバイト数を取得します（事件定義は共有のため含みません）
+	/// </summary>
+	SIZE_T GetSessionMemorySize() const;
 
 protected:
-	/// <summary>事件データ</summary>
-	UPROPERTY()
-	FCaseData CaseData;
+	/// <summary>共有の事件定義（読み取り専用）</summary>
+	TSharedPtr<const FCaseDefinition> Definition;
 
-	/// <summary>現在のロケーション</summary>
-	UPROPERTY()
-	ELocation CurrentLocation = ELocation::Office;
+	/// <summary>進行状態</summary>
+	FCaseProgress Progress;
 
-	/// <summary>設定されたフラグ</summary>
-	UPROPERTY()
-	TSet<FName> SetFlags;
+private:
+	/// <summary>
+	/// 進行状態を反映した証拠データを作成します
+	/// </summary>
+	FEvidence MakeEvidenceSnapshot(int32 Index) const;
 
-	/// <summary>ABELに従った回数</summary>
-	UPROPERTY()
-	int32 ABELSuggestionsFollowed = 0;
+	/// <summary>
+	/// 進行状態を反映したキャラクターデータを作成します
+	/// </summary>
+	FCharacterData MakeCharacterSnapshot(int32 Index) const;
 
-	/// <summary>ABELを無視した回数</summary>
-	UPROPERTY()
-	int32 ABELSuggestionsIgnored = 0;
+	/// <summary>
+	/// 進行状態を反映したロケーションデータを作成します
+	/// </summary>
+	FLocationData MakeLocationSnapshot(int32 Index) const;
 
-	/// <summary>倫理的違反回数</summary>
-	UPROPERTY()
-	int32 EthicalViolations = 0;
+	/// <summary>
+	/// 進行状態を反映した推理データを作成します
+	/// </summary>
+	FDeduction MakeDeductionSnapshot(int32 Index) const;
+
+	/// <summary>
+	/// フラグIDのビットが新たに立ったことを通知します
+	/// </summary>
+	void NotifyFlagSet(int32 FlagIndex);
+
+	/// <summary>
+	/// 推理が新たに解放されたことを通知します
+	/// </summary>
+	void NotifyDeductionUnlocked(int32 DeductionIndex);
+
+	/// <summary>
+	/// キャラクターの居場所が変わったことを通知します
+	/// </summary>
+	void NotifyCharacterMoved(int32 CharacterIndex, int32 FromLocationIndex);
+
+	/// <summary>
+	/// 現在のゲーム内時刻より後の移動予定をタイミングホイールに登録し直します（進行状態を差し替えた後に呼びます）
+	/// </summary>
+	void RebuildSchedule();
+
+	/// <summary>
+	/// 指定した時刻までの移動予定を適用します（記録は行いません）
+	/// </summary>
+	/// <param name="bNotify">移動を通知するか（ジャーナルの再生中は通知しない）</param>
+	void AdvanceClockTo(int32 TargetMinute, bool bNotify);
+
+	/// <summary>未到来の移動予定（ペイロードは事件定義の GetSchedule() の位置）</summary>
+	FCaseScheduler Scheduler;
+
+	/// <summary>
+	/// 進行状態から導出規則の未成立の前提数を数え直します（進行状態を差し替えた後に呼びます）
+	/// </summary>
+	/// <remarks>
+	/// 前提が揃っているのに成立していない推理があれば、通知せずに成立させます。
+	/// </remarks>
+	void RebuildDeductionChain();
+
+	/// <summary>
+	/// 新たに収集した証拠を前提に含む導出規則を評価します
+	/// </summary>
+	/// <param name="bNotify">成立した推理を通知するか（ジャーナルの再生中は通知しない）</param>
+	void PropagateEvidence(int32 EvidenceIndex, bool bNotify);
+
+	/// <summary>
+	/// 新たに解放した推理を前提に含む導出規則を評価します
+	/// </summary>
+	/// <param name="bNotify">成立した推理を通知するか（ジャーナルの再生中は通知しない）</param>
+	void PropagateDeduction(int32 DeductionIndex, bool bNotify);
+
+	/// <summary>
+	/// 前提が揃った規則の推理を成立させ、連鎖が止まるまで伝播します
+	/// </summary>
+	/// <remarks>
+	/// 導出された推理はジャーナルに記録しません（再生時に前提から再び導かれます）。
+	/// </remarks>
+	void DeriveDeductions(TArray<int32, TInlineAllocator<8>>& ReadyRules, bool bNotify);
+
+	/// <summary>導出規則ごとの未成立の前提数（進行状態から数え直せるため保存しない）</summary>
+	TArray<int32> RemainingPremises;
+
+	/// <summary>
+	/// 未発火のトリガーを全て評価します（進行状態を差し替えた後に呼びます）
+	/// </summary>
+	/// <remarks>
+	/// 条件を満たしているトリガーがあれば、通知せずに発火させます。
+	/// </remarks>
+	void RebuildTriggers();
+
+	/// <summary>
+	/// 変化した事実に依存するトリガーを評価し、条件が揃ったものを発火させます
+	/// </summary>
+	/// <param name="Triggers">事件定義の GetTriggersUsing 系で取得したトリガー</param>
+	/// <param name="bNotify">操作による変化を通知するか（ジャーナルの再生中は通知しない）</param>
+	void EvaluateTriggers(TConstArrayView<int32> Triggers, bool bNotify);
+
+	/// <summary>
+	/// トリガーを発火済みにして操作を実行します
+	/// </summary>
+	/// <remarks>
+	/// 操作は条件から再現できるため、ジャーナルには記録しません。
+	/// </remarks>
+	void FireTrigger(int32 TriggerIndex, bool bNotify);
+
+	/// <summary>
+	/// ロケーションのアクセス可否が変わったことを通知します
+	/// </summary>
+	void NotifyLocationAccessChanged(int32 LocationIndex);
+
+	/// <summary>
+	/// キャラクターの感情状態が変わったことを通知します
+	/// </summary>
+	void NotifyCharacterEmotionChanged(int32 CharacterIndex);
+
+	/// <summary>
+	/// 変更通知をまとめるモードなら変更の種類を記録し、フラッシュを予約します
+	/// </summary>
+	/// <returns>記録した場合は true（呼び出し側は差分を PendingChanges に追加し、個別のイベントは発火しない）</returns>
+	bool DeferChange(ECaseChangeFlags Category);
+
+	/// <summary>
+	/// 次のフレームのティックでフラッシュします
+	/// </summary>
+	bool HandleFlushTick(float DeltaTime);
+
+	/// <summary>
+	/// 保留中の変更を破棄して OnProgressRestored を発火します（全体の再描画が差分を包含するため）
+	/// </summary>
+	void BroadcastProgressRestored();
+
+	/// <summary>変更通知をまとめるモードか</summary>
+	bool bChangeSetMode = false;
+
+	/// <summary>保留中の変更</summary>
+	FCaseChangeSet PendingChanges;
+
+	/// <summary>予約済みのフラッシュ</summary>
+	FTSTicker::FDelegateHandle FlushTickerHandle;
+
+	/// <summary>
+	/// 次のフレームのフラッシュを予約します（予約済みなら何もしません）
+	/// </summary>
+	void ScheduleFlush();
+
+	/// <summary>
+	/// スナップショットの公開が有効なら、次のフラッシュで公開し直すよう記録します
+	/// </summary>
+	void MarkSnapshotDirty()
+	{
+		if (bPublishSnapshots && !bSnapshotDirty)
+		{
+			bSnapshotDirty = true;
+			ScheduleFlush();
+		}
+	}
+
+	/// <summary>スナップショットを公開するか</summary>
+	bool bPublishSnapshots = false;
+
+	/// <summary>最後の公開以降に変更があるか</summary>
+	bool bSnapshotDirty = false;
+
+	/// <summary>最後に公開した通し番号</summary>
+	uint64 SnapshotSequence = 0;
+
+	/// <summary>公開済みのスナップショット（SnapshotLock で保護）</summary>
+	FCaseSnapshotPtr PublishedSnapshot;
+
+	/// <summary>PublishedSnapshot の差し替え用ロック</summary>
+	mutable FRWLock SnapshotLock;
+
+	/// <summary>
+	/// マスクのフラグを設定します
+	/// </summary>
+	/// <param name="bRecord">新たに立ったフラグをジャーナルに記録するか</param>
+	/// <param name="bNotify">新たに立ったフラグを通知するか</param>
+	void SetFlagBits(const FCompiledMask& Mask, bool bRecord, bool bNotify);
+
+	/// <summary>
+	/// ジャーナルに記録し、進行状態側の記録位置を更新します
+	/// </summary>
+	template <typename... ArgTypes>
+	void Record(ECaseJournalOp Op, ArgTypes... Args)
+	{
+		Journal.Append(Op, Args...);
+		Progress.JournalLength = Journal.NumBytes();
+		Progress.JournalCrc = Journal.GetCrc();
+		MarkSnapshotDirty();
+	}
+
+	/// <summary>
+	/// 名前オペランドの操作をジャーナルに記録します
+	/// </summary>
+	void RecordName(ECaseJournalOp Op, FName Name)
+	{
+		Journal.AppendName(Op, Name);
+		Progress.JournalLength = Journal.NumBytes();
+		Progress.JournalCrc = Journal.GetCrc();
+		MarkSnapshotDirty();
+	}
+
+	/// <summary>
+	/// ジャーナルのレコードを1件適用します（ログ・イベント・記録なし）
+	/// </summary>
+	/// <returns>レコードが現在の事件定義に対して有効だったかどうか</returns>
+	bool ApplyJournalRecord(const FCaseJournalRecord& Record);
+
+	/// <summary>初期状態からの操作記録</summary>
+	FCaseJournal Journal;
+
+	/// <summary>ジャーナルが初期状態からの全操作を含んでいるか</summary>
+	bool bJournalComplete = true;
 
-private:
 	/// <summary>
 	/// 内部的に証拠配列のインデックスを取得します
 	/// </summary>
@@ -305,4 +1261,10 @@ private:
 	/// 内部的に推理配列のインデックスを取得します
 	/// </summary>
 	int32 FindDeductionIndex(FName DeductionId) const;
+
+	/// <summary>保存済みのチェックポイント</summary>
+	TMap<int32, FCaseProgress> Checkpoints;
+
+	/// <summary>次に発行するチェックポイントID</summary>
+	int32 NextCheckpointId = 1;
 };
@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WitnessTypes.h"
+
+class FCaseDefinition;
+struct FCaseProgress;
+
+/// <summary>
+/// 事前コンパイル済みの信頼度の条件
+/// </summary>
+struct FCompiledTrustCondition
+{
+	int32 CharacterIndex = INDEX_NONE;
+	uint8 MinTrust = 0;
+	uint8 MaxTrust = 100;
+};
+
+/// <summary>
+/// 事前コンパイル済みのトリガーの操作
+/// </summary>
+struct FCompiledTriggerAction
+{
+	ETriggerActionType Type = ETriggerActionType::SetLocationAccessible;
+
+	/// <summary>SetLocationAccessible: アクセス可能にするか / SetEmotionalState: 感情状態</summary>
+	uint8 Value = 0;
+
+	/// <summary>SetLocationAccessible: 対象のロケーション / その他: 対象のキャラクター</summary>
+	int32 Target = INDEX_NONE;
+
+	/// <summary>MoveCharacter: 移動先のロケーション</summary>
+	int32 LocationIndex = INDEX_NONE;
+};
+
+/// <summary>
+/// イベント・条件・操作（ECA）形式のトリガーの索引
+/// </summary>
+/// <remarks>
+/// FCaseData::Triggers と同じ並びで、各トリガーの条件と操作をインデックスに変換して CSR 形式で保持します。
+/// さらにフラグ・証拠・推理・キャラクター（信頼度）ごとに「それを条件に含むトリガー」の一覧を持つため、
+/// 進行状態の変更時は変化した事実に依存するトリガーだけを評価すれば済みます。
+/// 操作は条件に使われる事実（フラグ・証拠・推理・信頼度）を変更しないため、トリガー同士が連鎖することはありません。
+/// 存在しないIDを条件に含むトリガーは決して発火しません。存在しない対象への操作は無視します。
+/// </remarks>
+class THELASTWITNESS_API FCaseTriggerIndex
+{
+public:
+	/// <summary>
+	/// 事件定義からトリガーの条件・操作と依存関係の索引を構築します
+	/// </summary>
+	/// <remarks>
+	/// 条件のフラグは事件定義のフラグIDに登録済みである必要があります。
+	/// </remarks>
+	void Build(const FCaseDefinition& Definition);
+
+	int32 NumTriggers() const { return Unsatisfiable.Num(); }
+
+	/// <summary>
+	/// トリガーIDからインデックスを取得します
+	/// </summary>
+	int32 FindTriggerIndex(FName TriggerId) const;
+
+	/// <summary>
+	/// トリガーの条件が全て成立しているか確認します
+	/// </summary>
+	bool IsSatisfied(int32 Trigger, const FCaseProgress& Progress) const;
+
+	/// <summary>
+	/// トリガーの操作を取得します（定義順）
+	/// </summary>
+	TConstArrayView<FCompiledTriggerAction> GetActions(int32 Trigger) const
+	{
+		return MakeArrayView(Actions.GetData() + ActionStart[Trigger], ActionStart[Trigger + 1] - ActionStart[Trigger]);
+	}
+
+	/// <summary>
+	/// 存在しないIDを条件に含むため、決して発火しないか確認します
+	/// </summary>
+	bool IsUnsatisfiable(int32 Trigger) const { return Unsatisfiable[Trigger]; }
+
+	// 条件の各要素（到達可能性の解析用）
+	TConstArrayView<int32> GetRequiredFlags(int32 Trigger) const { return RequiredFlags.Get(Trigger); }
+	TConstArrayView<int32> GetRequiredEvidence(int32 Trigger) const { return RequiredEvidence.Get(Trigger); }
+	TConstArrayView<int32> GetRequiredDeductions(int32 Trigger) const { return RequiredDeductions.Get(Trigger); }
+
+	// ========================================================================
+	// 依存関係の索引
+	// ========================================================================
+
+	/// <summary>
+	/// フラグを条件に含むトリガーを取得します
+	/// </summary>
+	TConstArrayView<int32> GetTriggersUsingFlag(int32 FlagIndex) const { return FlagTriggers.Get(FlagIndex); }
+
+	/// <summary>
+	/// 証拠を条件に含むトリガーを取得します
+	/// </summary>
+	TConstArrayView<int32> GetTriggersUsingEvidence(int32 EvidenceIndex) const { return EvidenceTriggers.Get(EvidenceIndex); }
+
+	/// <summary>
+	/// 推理を条件に含むトリガーを取得します
+	/// </summary>
+	TConstArrayView<int32> GetTriggersUsingDeduction(int32 DeductionIndex) const { return DeductionTriggers.Get(DeductionIndex); }
+
+	/// <summary>
+	/// キャラクターの信頼度を条件に含むトリガーを取得します
+	/// </summary>
+	TConstArrayView<int32> GetTriggersUsingTrust(int32 CharacterIndex) const { return TrustTriggers.Get(CharacterIndex); }
+
+	/// <summary>
+	/// ヒープ上で使用しているバイト数を取得します
+	/// </summary>
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/// <summary>
+	/// 行ごとの可変長リスト（末尾に番兵のある開始位置と、行順に連結した要素）
+	/// </summary>
+	template <typename ElementType>
+	struct TRows
+	{
+		TArray<int32> Start;
+		TArray<ElementType> Items;
+
+		TConstArrayView<ElementType> Get(int32 Row) const
+		{
+			return MakeArrayView(Items.GetData() + Start[Row], Start[Row + 1] - Start[Row]);
+		}
+
+		SIZE_T GetAllocatedSize() const { return Start.GetAllocatedSize() + Items.GetAllocatedSize(); }
+	};
+
+	/// <summary>
+	/// トリガー → 事実の行を反転し、事実 → トリガーの行を作ります（各行のトリガーは昇順）
+	/// </summary>
+	template <typename ElementType, typename KeyFuncType>
+	static void Invert(int32 NumFacts, const TRows<ElementType>& TriggerRows, KeyFuncType KeyFunc, TRows<int32>& OutFactRows);
+
+	/// <summary>トリガーID → インデックス</summary>
+	TMap<FName, int32> TriggerIndexMap;
+
+	/// <summary>存在しないIDを条件に含むため決して発火しないトリガー</summary>
+	TBitArray<> Unsatisfiable;
+
+	/// <summary>トリガーごとの条件</summary>
+	TRows<int32> RequiredFlags;
+	TRows<int32> RequiredEvidence;
+	TRows<int32> RequiredDeductions;
+	TRows<FCompiledTrustCondition> TrustConditions;
+
+	/// <summary>トリガーごとの Actions 内の開始位置（末尾に番兵あり）</summary>
+	TArray<int32> ActionStart;
+
+	/// <summary>操作（トリガー順に連結）</summary>
+	TArray<FCompiledTriggerAction> Actions;
+
+	/// <summary>事実ごとの依存するトリガー</summary>
+	TRows<int32> FlagTriggers;
+	TRows<int32> EvidenceTriggers;
+	TRows<int32> DeductionTriggers;
+	TRows<int32> TrustTriggers;
+};
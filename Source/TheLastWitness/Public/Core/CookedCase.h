@@ -0,0 +1,321 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WitnessTypes.h"
+
+// ============================================================================
+// クック済み事件ファイルのレイアウト
+// ============================================================================
+//
+// ファイル全体がポインタを含まない 1 つのバイト列で、先頭にヘッダー、その後に
+// 固定長レコードのテーブルと文字列プールが 4 バイト境界で並びます。
+// 位置は全てファイル先頭からのオフセット、またはテーブル内のインデックスで表すため、
+// 読み込んだバイト列をパースせずにそのまま参照できます。バイト順はリトルエンディアン固定です。
+// レコードの形を変えた場合は FCookedCase::Version を上げてください。
+
+/// <summary>
+/// 文字列プール内の UTF-8 文字列（終端文字なし）
+/// </summary>
+struct FCookedString
+{
+	uint32 Offset = 0;
+	uint32 Length = 0;
+};
+
+/// <summary>
+/// テーブル内の連続した要素
+/// </summary>
+struct FCookedList
+{
+	uint32 First = 0;
+	uint32 Count = 0;
+};
+
+/// <summary>
+/// ファイル内のテーブル（要素数とファイル先頭からのバイトオフセット）
+/// </summary>
+struct FCookedTable
+{
+	uint32 Offset = 0;
+	uint32 Count = 0;
+};
+
+struct FCookedEvidence
+{
+	FCookedString EvidenceId;
+	FCookedString DisplayName;
+	FCookedString Description;
+	FCookedString ABELComment;
+	FCookedList RelatedCharacters;	// Names
+	FCookedList RelatedEvidence;	// Names
+	uint8 Type = 0;
+	uint8 Importance = 0;
+	uint8 FoundAt = 0;
+	uint8 Flags = 0;	// bIsCollected, bIsExamined
+};
+
+struct FCookedCharacter
+{
+	FCookedString CharacterId;
+	FCookedString DisplayName;
+	FCookedString Role;
+	FCookedString Description;
+	FCookedString RelationToVictim;
+	FCookedString Motive;
+	int32 TrustLevel = 0;
+	uint8 EmotionalState = 0;
+	uint8 CurrentLocation = 0;
+	uint8 Flags = 0;	// bHasBeenInterviewed, bIsSuspect
+	uint8 Padding = 0;
+};
+
+struct FCookedLocation
+{
+	FCookedString DisplayName;
+	FCookedString Description;
+	FCookedList AvailableEvidence;	// Names
+	FCookedList CharactersPresent;	// Names
+	uint8 Location = 0;
+	uint8 Flags = 0;	// bHasVisited, bIsAccessible
+	uint8 Padding[2] = {};
+};
+
+struct FCookedDialogueChoice
+{
+	FCookedString ChoiceId;
+	FCookedString DisplayText;
+	FCookedString NextNodeId;
+	FCookedList RequiredEvidence;	// Names
+	FCookedList RequiredFlags;		// Names
+	FCookedList SetsFlags;			// Names
+	int32 TrustDelta = 0;
+	uint8 Tone = 0;
+	uint8 Padding[3] = {};
+};
+
+struct FCookedDialogueNode
+{
+	FCookedString NodeId;
+	FCookedString SpeakerId;
+	FCookedString Text;
+	FCookedString NextNodeId;
+	FCookedList Choices;		// DialogueChoices
+	FCookedList GainsEvidence;	// Names
+	FCookedList SetsFlags;		// Names
+	uint8 Emotion = 0;
+	uint8 Flags = 0;	// bIsEndNode
+	uint8 Padding[2] = {};
+};
+
+struct FCookedDialogueTree
+{
+	FCookedString TreeId;
+	FCookedString CharacterId;
+	FCookedString StartNodeId;
+	FCookedList Nodes;	// DialogueNodes
+};
+
+struct FCookedDeduction
+{
+	FCookedString DeductionId;
+	FCookedString Title;
+	FCookedString Description;
+	FCookedString EvidenceA;
+	FCookedString EvidenceB;
+	FCookedList PremiseDeductions;	// Names
+	FCookedList PremiseEvidence;	// Names
+	FCookedList UnlocksFlags;		// Names
+	FCookedList UnlocksDialogue;	// Names
+	uint8 Flags = 0;	// bIsUnlocked
+	uint8 Padding[3] = {};
+};
+
+struct FCookedScheduleEntry
+{
+	FCookedString CharacterId;
+	int32 AtMinute = 0;
+	uint8 Location = 0;
+	uint8 Padding[3] = {};
+};
+
+struct FCookedTrustCondition
+{
+	FCookedString CharacterId;
+	int32 MinTrust = 0;
+	int32 MaxTrust = 0;
+};
+
+struct FCookedTriggerAction
+{
+	FCookedString CharacterId;
+	uint8 Type = 0;
+	uint8 Location = 0;
+	uint8 EmotionalState = 0;
+	uint8 Flags = 0;	// bAccessible
+};
+
+struct FCookedTrigger
+{
+	FCookedString TriggerId;
+	FCookedList RequiredFlags;		// Names
+	FCookedList RequiredEvidence;	// Names
+	FCookedList RequiredDeductions;	// Names
+	FCookedList TrustConditions;	// TrustConditions
+	FCookedList Actions;			// TriggerActions
+};
+
+/// <summary>
+/// クック済み事件ファイルのヘッダー
+/// </summary>
+struct FCookedCaseHeader
+{
+	uint32 Magic = 0;
+	uint32 Version = 0;
+
+	/// <summary>ヘッダーを含むファイル全体のバイト数</summary>
+	uint32 TotalSize = 0;
+
+	/// <summary>ヘッダー以降の CRC32</summary>
+	uint32 PayloadCrc = 0;
+
+	/// <summary>クック元のソースのハッシュ（古いクック済みファイルの検出用。ビルドツールが読むため位置を変えないこと）</summary>
+	uint32 SourceHash = 0;
+
+	FCookedString CaseId;
+	FCookedString Title;
+	FCookedString Synopsis;
+	FCookedString VictimId;
+	FCookedString TrueCulpritId;
+	FCookedList RequiredEvidenceForAccusation;	// Names
+
+	FCookedTable Evidence;
+	FCookedTable Characters;
+	FCookedTable Locations;
+	FCookedTable Dialogues;
+	FCookedTable DialogueNodes;
+	FCookedTable DialogueChoices;
+	FCookedTable Deductions;
+	FCookedTable Schedule;
+	FCookedTable Triggers;
+	FCookedTable TrustConditions;
+	FCookedTable TriggerActions;
+
+	/// <summary>名前の一覧が参照する FCookedString の共有テーブル</summary>
+	FCookedTable Names;
+
+	/// <summary>文字列プール（Count はバイト数）</summary>
+	FCookedTable Strings;
+};
+
+/// <summary>
+/// クック済み事件ファイル（事件データのバイナリキャッシュ）
+/// </summary>
+/// <remarks>
+/// クック時（CaseCook コマンドレット）に FCaseData を文字列プールと固定長レコードの
+/// バイト列へ変換し、実行時はファイル全体を一度に読み込んでパースせずに参照します。
+/// 開く際にヘッダー・CRC・列挙値と全ての参照の範囲を一度だけ検証するので、以降のアクセスは範囲チェック不要です。
+/// 事件定義（FCaseDefinition）は FCaseData を保持するため、ToCaseData() で一度だけ展開し、バイト列はその後手放します。
+/// 名前やテキストの作成は展開時に行われるので、コードから作成する場合と比べて省けるのは構築処理と配列の再確保です
+/// （要素数が分かっているため、配列は全て最終的な大きさで一度に確保されます）。
+/// </remarks>
+class THELASTWITNESS_API FCookedCase
+{
+public:
+	/// <summary>ファイル先頭の識別子（"LWCS"）</summary>
+	static constexpr uint32 Magic = 0x5343574C;
+
+	/// <summary>レイアウトのバージョン</summary>
+	static constexpr uint32 Version = 2;
+
+	/// <summary>
+	/// 事件データをクック済みのバイト列に変換します
+	/// </summary>
+	/// <param name="SourceHash">事件データの作成元のハッシュ（読み込み時に GetSourceHash() で比較します）</param>
+	static void Cook(const FCaseData& CaseData, uint32 SourceHash, TArray<uint8>& OutBytes);
+
+	/// <summary>
+	/// クック済みファイルを読み込んで開きます
+	/// </summary>
+	/// <returns>ファイルが無い・壊れている場合は nullptr</returns>
+	static TSharedPtr<const FCookedCase> Open(const FString& Path);
+
+	/// <summary>
+	/// メモリ上のクック済みバイト列から開きます（クック結果の検証用）
+	/// </summary>
+	static TSharedPtr<const FCookedCase> FromBytes(TArray<uint8> Bytes);
+
+	/// <summary>
+	/// 事件IDに対応するクック済みファイルのパスを取得します
+	/// </summary>
+	static FString GetCookedPath(FName CaseId);
+
+	const FCookedCaseHeader& GetHeader() const { return *reinterpret_cast<const FCookedCaseHeader*>(Data); }
+
+	TConstArrayView<FCookedEvidence> GetEvidence() const { return GetTable<FCookedEvidence>(GetHeader().Evidence); }
+	TConstArrayView<FCookedCharacter> GetCharacters() const { return GetTable<FCookedCharacter>(GetHeader().Characters); }
+	TConstArrayView<FCookedLocation> GetLocations() const { return GetTable<FCookedLocation>(GetHeader().Locations); }
+	TConstArrayView<FCookedDialogueTree> GetDialogues() const { return GetTable<FCookedDialogueTree>(GetHeader().Dialogues); }
+	TConstArrayView<FCookedDeduction> GetDeductions() const { return GetTable<FCookedDeduction>(GetHeader().Deductions); }
+	TConstArrayView<FCookedScheduleEntry> GetSchedule() const { return GetTable<FCookedScheduleEntry>(GetHeader().Schedule); }
+	TConstArrayView<FCookedTrigger> GetTriggers() const { return GetTable<FCookedTrigger>(GetHeader().Triggers); }
+
+	TConstArrayView<FCookedDialogueNode> GetNodes(const FCookedDialogueTree& Tree) const { return GetList<FCookedDialogueNode>(GetHeader().DialogueNodes, Tree.Nodes); }
+	TConstArrayView<FCookedDialogueChoice> GetChoices(const FCookedDialogueNode& Node) const { return GetList<FCookedDialogueChoice>(GetHeader().DialogueChoices, Node.Choices); }
+	TConstArrayView<FCookedTrustCondition> GetTrustConditions(const FCookedTrigger& Trigger) const { return GetList<FCookedTrustCondition>(GetHeader().TrustConditions, Trigger.TrustConditions); }
+	TConstArrayView<FCookedTriggerAction> GetActions(const FCookedTrigger& Trigger) const { return GetList<FCookedTriggerAction>(GetHeader().TriggerActions, Trigger.Actions); }
+	TConstArrayView<FCookedString> GetNames(FCookedList List) const { return GetList<FCookedString>(GetHeader().Names, List); }
+
+	/// <summary>
+	/// 文字列プール内の文字列をコピーせずに参照します
+	/// </summary>
+	FUtf8StringView GetString(FCookedString String) const
+	{
+		return FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Data + GetHeader().Strings.Offset + String.Offset), String.Length);
+	}
+
+	FName GetName(FCookedString String) const;
+	FText GetText(FCookedString String) const;
+
+	/// <summary>
+	/// 事件定義の作成に使う FCaseData に展開します
+	/// </summary>
+	FCaseData ToCaseData() const;
+
+	/// <summary>
+	/// クック時に記録した作成元のハッシュを取得します（古いクック済みファイルの検出用）
+	/// </summary>
+	uint32 GetSourceHash() const { return GetHeader().SourceHash; }
+
+	/// <summary>
+	/// ファイル全体のバイト数を取得します
+	/// </summary>
+	int64 GetSize() const { return Size; }
+
+private:
+	FCookedCase() = default;
+
+	template <typename RecordType>
+	TConstArrayView<RecordType> GetTable(const FCookedTable& Table) const
+	{
+		return MakeArrayView(reinterpret_cast<const RecordType*>(Data + Table.Offset), Table.Count);
+	}
+
+	template <typename RecordType>
+	TConstArrayView<RecordType> GetList(const FCookedTable& Table, FCookedList List) const
+	{
+		return GetTable<RecordType>(Table).Slice(List.First, List.Count);
+	}
+
+	/// <summary>
+	/// ヘッダー・CRC・列挙値と全てのテーブル・一覧・文字列の範囲を検証します
+	/// </summary>
+	bool Validate() const;
+
+	/// <summary>ファイルの内容</summary>
+	TArray<uint8> OwnedBytes;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
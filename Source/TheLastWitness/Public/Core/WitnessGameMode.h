@@ -5,15 +5,46 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "WitnessTypes.h"
+#include "CaseProgress.h"
+#include "Dialogue/DialogueManager.h"
 #include "WitnessGameMode.generated.h"
 
 class UCaseState;
 class UDialogueManager;
 class UABELSystem;
+class USaveGame;
+class UWitnessSaveGame;
+class UCaseDataAsset;
+class FCaseDefinition;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPhaseChanged, EGamePhase, NewPhase);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCaseStarted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameEnded, const FGameResult&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSaveGameCompleted, const FString&, SlotName, bool, bSuccess);
+
+// C++ 向けのネイティブ版
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPhaseChangedNative, EGamePhase /* NewPhase */);
+DECLARE_MULTICAST_DELEGATE(FOnCaseStartedNative);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGameEndedNative, const FGameResult& /* Result */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSaveGameCompletedNative, const FString& /* SlotName */, bool /* bSuccess */);
+
+/// <summary>
+/// ゲーム全体のチェックポイント
+/// </summary>
+/// <remarks>
+/// 進行状態はセクション単位で共有されるため、保存は O(1) です。
+/// </remarks>
+struct FGameCheckpoint
+{
+	/// <summary>事件の進行状態</summary>
+	FCaseProgress Progress;
+
+	/// <summary>対話の位置</summary>
+	FDialoguePosition Dialogue;
+
+	/// <summary>フェーズ</summary>
+	EGamePhase Phase = EGamePhase::MainMenu;
+};
 
 /// <summary>
 /// ゲームの進行を管理するGameMode
@@ -38,8 +69,19 @@ public:
 	/// <summary>
 	/// 事件を開始します
 	/// </summary>
+	/// <remarks>
+	/// CaseId を指定すると事件カタログ（UCaseCatalog）から非同期に読み込み、読み込み後に開始します。
+	/// 読み込み中もメニューは操作でき、別の事件を指定し直すと先の読み込みは取り消されます。
+	/// 省略した場合は CreateCaseData() の事件をその場で開始します。
+	/// </remarks>
 	UFUNCTION(BlueprintCallable, Category = "Game")
-	void StartCase();
+	void StartCase(FName CaseId = NAME_None);
+
+	/// <summary>
+	/// 事件を読み込み中か確認します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Game")
+	bool IsCaseLoading() const;
 
 	/// <summary>
 	/// 現在のフェーズを取得します
@@ -177,6 +219,72 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Accusation")
 	void AccuseCharacter(FName CharacterId);
 
+	// ========================================================================
+	// チェックポイント / 取り消し
+	// ========================================================================
+
+	/// <summary>
+	/// 現在の状態をチェックポイントとして保存します
+	/// </summary>
+	/// <returns>チェックポイントID</returns>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	int32 CreateCheckpoint();
+
+	/// <summary>
+	/// チェックポイントの状態に戻します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	bool RestoreCheckpoint(int32 CheckpointId);
+
+	/// <summary>
+	/// チェックポイントを破棄します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	void DiscardCheckpoint(int32 CheckpointId);
+
+	/// <summary>
+	/// 直前の対話選択または推理を取り消します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+	bool UndoLastAction();
+
+	/// <summary>
+	/// 取り消せる操作があるか確認します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Checkpoint")
+	bool CanUndo() const { return UndoStack.Num() > 0; }
+
+	// ========================================================================
+	// セーブ / ロード
+	// ========================================================================
+
+	/// <summary>
+	/// 現在の進行状態をスロットに保存します
+	/// </summary>
+	/// <remarks>
+	/// 進行状態のバイト列化だけをゲームスレッドで行い、ファイルへの書き込みはバックグラウンドで行います。
+	/// 完了時に OnGameSaved が発火します。
+	/// </remarks>
+	/// <returns>保存を開始できたかどうか（事件が開始されていない場合は false）</returns>
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	bool SaveGameToSlot(const FString& SlotName, int32 UserIndex = 0);
+
+	/// <summary>
+	/// スロットから進行状態を読み込みます
+	/// </summary>
+	/// <remarks>
+	/// ファイルの読み込みはバックグラウンドで行い、完了時に OnGameLoaded が発火します。
+	/// 事件が開始されていない場合は、先に事件を開始してから進行状態を適用します。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void LoadGameFromSlot(const FString& SlotName, int32 UserIndex = 0);
+
+	/// <summary>
+	/// 書き込み中のセーブがあるか確認します
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Save")
+	bool IsSaveInProgress() const { return PendingSaveCount > 0; }
+
 	// ========================================================================
 	// サブシステムアクセス
 	// ========================================================================
@@ -215,10 +323,38 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnGameEnded OnGameEnded;
 
+	/// <summary>セーブ完了時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnSaveGameCompleted OnGameSaved;
+
+	/// <summary>ロード完了時に発火</summary>
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FOnSaveGameCompleted OnGameLoaded;
+
+	// ネイティブ版（C++ のリスナーはこちらを使用してください）
+
+	/// <summary>フェーズ変更時に発火</summary>
+	FOnPhaseChangedNative OnPhaseChangedNative;
+
+	/// <summary>事件開始時に発火</summary>
+	FOnCaseStartedNative OnCaseStartedNative;
+
+	/// <summary>ゲーム終了時に発火</summary>
+	FOnGameEndedNative OnGameEndedNative;
+
+	/// <summary>セーブ完了時に発火</summary>
+	FOnSaveGameCompletedNative OnGameSavedNative;
+
+	/// <summary>ロード完了時に発火</summary>
+	FOnSaveGameCompletedNative OnGameLoadedNative;
+
 protected:
 	/// <summary>
 	/// 事件データを初期化します（子クラスでオーバーライド可能）
 	/// </summary>
+	/// <remarks>
+	/// 既定では CaseAsset が設定されていればそのアセットから、無ければクック済みファイルかコードから作成します。
+	/// </remarks>
 	UFUNCTION(BlueprintNativeEvent, Category = "Setup")
 	FCaseData CreateCaseData();
 
@@ -227,6 +363,101 @@ protected:
 	/// </summary>
 	virtual void InitializeSubsystems();
 
+	/// <summary>
+	/// 作成済みの事件定義で事件を開始します
+	/// </summary>
+	/// <remarks>
+	/// 前の事件の定義は CaseState が参照を手放した時点で解放されます。
+	/// </remarks>
+	void BeginCase(const TSharedRef<const FCaseDefinition>& Definition);
+
+	/// <summary>
+	/// 事件カタログからの読み込みが完了した時
+	/// </summary>
+	void HandleCaseLoaded(TSharedPtr<const FCaseDefinition> Definition);
+
+	/// <summary>
+	/// 現在の状態を取得します
+	/// </summary>
+	FGameCheckpoint CaptureCheckpoint() const;
+
+	/// <summary>
+	/// 状態を適用します
+	/// </summary>
+	bool ApplyCheckpoint(const FGameCheckpoint& Checkpoint);
+
+	/// <summary>
+	/// 取り消し履歴に状態を積みます
+	/// </summary>
+	void PushUndo(FGameCheckpoint&& Checkpoint);
+
+	/// <summary>
+	/// 現在の状態からセーブデータを作成します
+	/// </summary>
+	UWitnessSaveGame* CreateSaveGame() const;
+
+	/// <summary>
+	/// セーブデータの状態を適用します
+	/// </summary>
+	bool ApplySaveGame(const UWitnessSaveGame& SaveGame);
+
+	/// <summary>
+	/// 対話が終了した時（終了ノードへの到達など DialogueManager 側で終わった場合も含む）
+	/// </summary>
+	void HandleDialogueEnded();
+
+	void HandleSaveCompleted(const FString& SlotName, const int32 UserIndex, bool bSuccess);
+	void HandleLoadCompleted(const FString& SlotName, const int32 UserIndex, USaveGame* LoadedGame);
+
+	/// <summary>書き込み中のセーブの数</summary>
+	int32 PendingSaveCount = 0;
+
+	/// <summary>取り消し履歴の上限</summary>
+	static constexpr int32 MaxUndoDepth = 32;
+
+	/// <summary>保存済みのチェックポイント</summary>
+	TMap<int32, FGameCheckpoint> Checkpoints;
+
+	/// <summary>取り消し履歴（末尾が最新）</summary>
+	TArray<FGameCheckpoint> UndoStack;
+
+	/// <summary>次に発行するチェックポイントID</summary>
+	int32 NextCheckpointId = 1;
+
+	/// <summary>
+	/// CaseState の変更通知をフレーム単位でまとめるか
+	/// </summary>
+	/// <remarks>
+	/// 有効な場合、個別の OnEvidenceCollected 等の代わりに OnCaseChanged が1フレームに一度発火します。
+	/// 個別のイベントにバインドした Blueprint は発火しなくなるため、OnCaseChanged で更新する場合のみ有効にしてください。
+	/// </remarks>
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Events")
+	bool bCoalesceCaseChanges = false;
+
+	/// <summary>
+	/// CaseState の読み取り専用スナップショットを公開するか（ワーカースレッドでの解析用）
+	/// </summary>
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Events")
+	bool bPublishCaseSnapshots = true;
+
+	/// <summary>
+	/// 事件データアセット（CaseImport コマンドレットで JSON/CSV から作成）
+	/// </summary>
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Setup")
+	TSoftObjectPtr<UCaseDataAsset> CaseAsset;
+
+	/// <summary>ロケーション間の移動で経過するゲーム内時間（分）</summary>
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Time", meta = (ClampMin = "0"))
+	int32 TravelMinutes = 15;
+
+	/// <summary>証拠の調査で経過するゲーム内時間（分）</summary>
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Time", meta = (ClampMin = "0"))
+	int32 ExamineMinutes = 5;
+
+	/// <summary>対話1回で経過するゲーム内時間（分）</summary>
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Time", meta = (ClampMin = "0"))
+	int32 DialogueMinutes = 10;
+
 	/// <summary>現在のフェーズ</summary>
 	UPROPERTY(BlueprintReadOnly, Category = "State")
 	EGamePhase CurrentPhase = EGamePhase::MainMenu;
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// 事件の要素とUIのアクションの静的ID
+/// </summary>
+/// <remarks>
+/// WitnessIds.inl の一覧から宣言と定義を生成します。
+/// 名前テーブルへの登録はモジュールの起動時に一度だけ行うため、参照側は FName("...") のように
+/// 文字列から名前を作らずに済みます（FName の比較・コピーだけで済みます）。
+/// 起動前（静的初期化中など）に参照すると NAME_None のままなので注意してください。
+/// </remarks>
+struct THELASTWITNESS_API FWitnessIds
+{
+#define WITNESS_ID(Name) static FName Name;
+#include "WitnessIds.inl"
+#undef WITNESS_ID
+
+	/// <summary>
+	/// 全てのIDを名前テーブルに登録します（モジュールの起動時に呼ばれます）
+	/// </summary>
+	static void Initialize();
+};
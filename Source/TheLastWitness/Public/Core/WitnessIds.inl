@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+// ============================================================================
+// 静的IDの一覧（X-macro）
+// ============================================================================
+//
+// WITNESS_ID(Name) を定義してからインクルードすると、一覧の各IDについて展開されます。
+// Name は C++ の識別子とIDの文字列を兼ねるため、参照側でIDを打ち間違えるとコンパイルエラーになります。
+// 事件データにIDを追加した場合はここにも追加してください。
+// インクルードガードは意図的に付けていません。
+
+// UIのアクション
+WITNESS_ID(Examine)
+WITNESS_ID(TalkTo)
+WITNESS_ID(ConsultABEL)
+WITNESS_ID(OpenJournal)
+WITNESS_ID(Travel)
+WITNESS_ID(Accuse)
+
+// ABELの提案ID（番号付きの FName の基底名）
+WITNESS_ID(Suggestion)
+
+// 事件
+WITNESS_ID(TheLastWitness)
+
+// キャラクター
+WITNESS_ID(EdwardBlackwood)
+WITNESS_ID(EleanorBlackwood)
+WITNESS_ID(HenryBlackwood)
+WITNESS_ID(JamesMorgan)
+WITNESS_ID(MaryCollins)
+WITNESS_ID(ThomasHart)
+
+// 証拠
+WITNESS_ID(Evidence_BrokenLatch)
+WITNESS_ID(Evidence_FinancialRecords)
+WITNESS_ID(Evidence_Footprints)
+WITNESS_ID(Evidence_LockedDoor)
+WITNESS_ID(Evidence_MaryTestimony)
+WITNESS_ID(Evidence_Pistol)
+WITNESS_ID(Evidence_SecondGunpowder)
+WITNESS_ID(Evidence_SuicideNote)
+WITNESS_ID(Evidence_TornLetter)
+WITNESS_ID(Evidence_WillDocument)
+
+// 推理
+WITNESS_ID(Deduction_CulpritProfile)
+WITNESS_ID(Deduction_FakedSuicide)
+WITNESS_ID(Deduction_LockedRoom)
+WITNESS_ID(Deduction_Motive)
+WITNESS_ID(Deduction_StagedMurder)
+WITNESS_ID(Deduction_Witness)
+
+// フラグ
+WITNESS_ID(Flag_CulpritIdentified)
+WITNESS_ID(Flag_EdwardAlibiClaimed)
+WITNESS_ID(Flag_EdwardAtScene)
+WITNESS_ID(Flag_JamesKnowsFinance)
+WITNESS_ID(Flag_JamesOpposedReform)
+WITNESS_ID(Flag_LockedRoomSolved)
+WITNESS_ID(Flag_MotiveFound)
+WITNESS_ID(Flag_MurderStaged)
+WITNESS_ID(Flag_SuicideFaked)
+WITNESS_ID(Flag_ThomasHintLatch)
+WITNESS_ID(Flag_ThomasKnowsArgument)
+
+// トリガー
+WITNESS_ID(Trigger_EdwardCornered)
+WITNESS_ID(Trigger_MaryConfides)
+WITNESS_ID(Trigger_MorganShaken)
+
+// 対話ツリー
+WITNESS_ID(Dialogue_Edward)
+WITNESS_ID(Dialogue_Eleanor)
+WITNESS_ID(Dialogue_James)
+WITNESS_ID(Dialogue_Mary)
+WITNESS_ID(Dialogue_Thomas)
+
+// 対話ノード
+WITNESS_ID(Edward_Alibi)
+WITNESS_ID(Edward_Defensive)
+WITNESS_ID(Edward_End)
+WITNESS_ID(Edward_Reluctant)
+WITNESS_ID(Edward_Start)
+WITNESS_ID(Eleanor_End)
+WITNESS_ID(Eleanor_Explain)
+WITNESS_ID(Eleanor_Grateful)
+WITNESS_ID(Eleanor_Offended)
+WITNESS_ID(Eleanor_Start)
+WITNESS_ID(James_Angry)
+WITNESS_ID(James_End)
+WITNESS_ID(James_Finance)
+WITNESS_ID(James_Reform)
+WITNESS_ID(James_Start)
+WITNESS_ID(Mary_End)
+WITNESS_ID(Mary_Opens)
+WITNESS_ID(Mary_Reveal)
+WITNESS_ID(Mary_Scared)
+WITNESS_ID(Mary_Start)
+WITNESS_ID(Thomas_Edward)
+WITNESS_ID(Thomas_End)
+WITNESS_ID(Thomas_Night)
+WITNESS_ID(Thomas_Secret)
+WITNESS_ID(Thomas_Start)
+
+// 対話の選択肢
+WITNESS_ID(Edward_Choice_Accuse)
+WITNESS_ID(Edward_Choice_Money)
+WITNESS_ID(Edward_Choice_Polite)
+WITNESS_ID(Eleanor_Choice_Comfort)
+WITNESS_ID(Eleanor_Choice_Direct)
+WITNESS_ID(Eleanor_Choice_Suspicious)
+WITNESS_ID(James_Choice_Finance)
+WITNESS_ID(James_Choice_Reform)
+WITNESS_ID(James_Choice_Threaten)
+WITNESS_ID(Mary_Choice_Kind)
+WITNESS_ID(Mary_Choice_Pressure)
+WITNESS_ID(Thomas_Choice_Edward)
+WITNESS_ID(Thomas_Choice_Night)
+WITNESS_ID(Thomas_Choice_Secret)
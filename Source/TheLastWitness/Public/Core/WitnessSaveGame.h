@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "WitnessTypes.h"
+#include "WitnessSaveGame.generated.h"
+
+/// <summary>
+/// 捜査の途中経過を保存するセーブデータ
+/// </summary>
+/// <remarks>
+/// 事件の内容は保存せず、可変な進行状態だけを保持します。
+/// 進行状態本体は UCaseState::SaveProgressToBytes() のバイト列で、独自にバージョン管理されています。
+/// </remarks>
+UCLASS()
+class THELASTWITNESS_API UWitnessSaveGame : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>セーブデータ全体の形式バージョン</summary>
+	static constexpr int32 CurrentVersion = 1;
+
+	/// <summary>保存時の形式バージョン</summary>
+	UPROPERTY()
+	int32 Version = CurrentVersion;
+
+	/// <summary>事件ID</summary>
+	UPROPERTY()
+	FName CaseId;
+
+	/// <summary>進行状態（FCaseProgress のバイナリ形式）</summary>
+	UPROPERTY()
+	TArray<uint8> ProgressData;
+
+	/// <summary>フェーズ</summary>
+	UPROPERTY()
+	EGamePhase Phase = EGamePhase::Investigation;
+
+	/// <summary>対話中のキャラクターID（対話中でなければ None）</summary>
+	UPROPERTY()
+	FName DialogueCharacterId;
+
+	/// <summary>対話中のノードID</summary>
+	UPROPERTY()
+	FName DialogueNodeId;
+
+	/// <summary>ABELとの関係値</summary>
+	UPROPERTY()
+	int32 ABELRelationshipValue = 0;
+
+	/// <summary>保存日時（UTC）</summary>
+	UPROPERTY()
+	FDateTime SavedAt;
+};
@@ -154,6 +154,20 @@ enum class ELocation : uint8
 	Office
 };
 
+/// <summary>
+/// トリガーの条件が成立した時に行う操作の種類
+/// </summary>
+UENUM(BlueprintType)
+enum class ETriggerActionType : uint8
+{
+	/// <summary>ロケーションのアクセス可否を変更</summary>
+	SetLocationAccessible,
+	/// <summary>キャラクターを移動</summary>
+	MoveCharacter,
+	/// <summary>キャラクターの感情状態を変更</summary>
+	SetEmotionalState
+};
+
 // ============================================================================
 // 構造体 (Structures)
 // ============================================================================
@@ -402,17 +416,30 @@ struct FDeduction
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FName EvidenceB;
 
+	/// <summary>前提となる推理ID（EvidenceA・EvidenceB が空の推理のみ。前提が全て揃うと自動的に成立）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> PremiseDeductions;
+
+	/// <summary>前提となる証拠ID（EvidenceA・EvidenceB が空の推理のみ。3つ以上の証拠を組み合わせる場合に使用）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> PremiseEvidence;
+
 	/// <summary>この推理で解放されるフラグ</summary>
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FName> UnlocksFlags;
 
-	/// <summary>この推理で解放される新しい対話</summary>
+	/// <summary>この推理で解放される新しい対話（対話ツリーID）</summary>
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FName> UnlocksDialogue;
 
 	/// <summary>解放済みかどうか</summary>
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bIsUnlocked = false;
+
+	/// <summary>
+	/// 証拠の組み合わせではなく、前提から自動的に導かれる推理か
+	/// </summary>
+	bool IsDerived() const { return EvidenceA.IsNone() && EvidenceB.IsNone(); }
 };
 
 /// <summary>
@@ -488,11 +515,115 @@ struct FLocationData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bHasVisited = false;
 
-	/// <summary>アクセス可能かどうか</summary>
+	/// <summary>アクセス可能かどうか（事件開始時の値。以降はトリガーで変化します）</summary>
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bIsAccessible = true;
 };
 
+/// <summary>
+/// キャラクターの移動予定
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCharacterScheduleEntry
+{
+	GENERATED_BODY()
+
+	/// <summary>移動するキャラクターID</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName CharacterId;
+
+	/// <summary>移動するゲーム内時刻（事件開始からの分）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 AtMinute = 0;
+
+	/// <summary>移動先</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ELocation Location = ELocation::Study;
+};
+
+/// <summary>
+/// トリガーの信頼度の条件（MinTrust 以上かつ MaxTrust 以下で成立）
+/// </summary>
+USTRUCT(BlueprintType)
+struct FTriggerTrustCondition
+{
+	GENERATED_BODY()
+
+	/// <summary>対象のキャラクターID</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName CharacterId;
+
+	/// <summary>信頼度の下限</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MinTrust = 0;
+
+	/// <summary>信頼度の上限</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxTrust = 100;
+};
+
+/// <summary>
+/// トリガーの条件が成立した時に行う操作
+/// </summary>
+USTRUCT(BlueprintType)
+struct FTriggerAction
+{
+	GENERATED_BODY()
+
+	/// <summary>操作の種類</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ETriggerActionType Type = ETriggerActionType::SetLocationAccessible;
+
+	/// <summary>対象のロケーション（SetLocationAccessible）または移動先（MoveCharacter）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ELocation Location = ELocation::Study;
+
+	/// <summary>アクセス可能にするか（SetLocationAccessible）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bAccessible = true;
+
+	/// <summary>対象のキャラクターID（MoveCharacter / SetEmotionalState）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName CharacterId;
+
+	/// <summary>変更後の感情状態（SetEmotionalState）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EEmotionalState EmotionalState = EEmotionalState::Neutral;
+};
+
+/// <summary>
+/// 条件が全て成立した時に一度だけ操作を行うトリガー
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCaseTrigger
+{
+	GENERATED_BODY()
+
+	/// <summary>トリガーID</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FName TriggerId;
+
+	/// <summary>設定されている必要があるフラグ</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> RequiredFlags;
+
+	/// <summary>収集済みである必要がある証拠ID</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> RequiredEvidence;
+
+	/// <summary>解放済みである必要がある推理ID</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FName> RequiredDeductions;
+
+	/// <summary>信頼度の条件</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FTriggerTrustCondition> TrustConditions;
+
+	/// <summary>条件の成立時に行う操作（定義順に実行）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FTriggerAction> Actions;
+};
+
 /// <summary>
 /// 事件データ全体
 /// </summary>
@@ -544,6 +675,14 @@ struct FCaseData
 	/// <summary>犯人告発に必要な証拠ID</summary>
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FName> RequiredEvidenceForAccusation;
+
+	/// <summary>キャラクターの移動予定（初期位置は各ロケーションの CharactersPresent）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FCharacterScheduleEntry> CharacterSchedule;
+
+	/// <summary>進行に応じてロケーション・キャラクターを変化させるトリガー</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FCaseTrigger> Triggers;
 };
 
 /// <summary>
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Core/WitnessTypes.h"
+#include "CaseDataAsset.generated.h"
+
+/// <summary>
+/// 事件データを保持するプライマリアセット
+/// </summary>
+/// <remarks>
+/// JSON/CSV の事件ソースから CaseImport コマンドレットで作成します。
+/// シナリオの修正は C++ の再ビルドではなくインポートのやり直しで反映されます。
+/// タイトル・あらすじ・規模はアセットレジストリのタグにも書き出すため、
+/// 事件カタログ（UCaseCatalog）は本体を読み込まずに一覧を表示できます。
+/// </remarks>
+UCLASS(BlueprintType)
+class THELASTWITNESS_API UCaseDataAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>アセットマネージャーで使うプライマリアセットの種類</summary>
+	static const FPrimaryAssetType PrimaryAssetType;
+
+	/// <summary>アセットレジストリのタグ名</summary>
+	static const FName TitleTag;
+	static const FName SynopsisTag;
+	static const FName NumCharactersTag;
+	static const FName NumEvidenceTag;
+	static const FName NumDeductionsTag;
+
+	/// <summary>事件データ</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Case")
+	FCaseData CaseData;
+
+#if WITH_EDITORONLY_DATA
+	/// <summary>インポート元ファイルのハッシュ（変更の無いソースの再インポートを省くため）</summary>
+	UPROPERTY(VisibleAnywhere, Category = "Import")
+	FString SourceHash;
+#endif
+
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	virtual void GetAssetRegistryTags(FAssetRegistryTagsContext Context) const override;
+};
@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/WitnessTypes.h"
+#include "StressCaseGenerator.generated.h"
+
+/// <summary>
+/// 負荷試験用の事件の規模
+/// </summary>
+USTRUCT(BlueprintType)
+struct FStressCaseParams
+{
+	GENERATED_BODY()
+
+	/// <summary>乱数のシード（同じシードと規模からは常に同じ事件が生成されます）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Seed = 1;
+
+	/// <summary>キャラクター数（被害者と真犯人を含むため 2 以上）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "2"))
+	int32 NumCharacters = 6;
+
+	/// <summary>証拠数（告発条件を作るため 2 以上）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "2"))
+	int32 NumEvidence = 10;
+
+	/// <summary>対話ツリー数（対話はキャラクターごとに1つなので、被害者以外のキャラクター数が上限）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 NumDialogueTrees = 5;
+
+	/// <summary>対話ツリーの深さ（開始ノードから終了ノードまでの段数）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	int32 DialogueDepth = 4;
+
+	/// <summary>2段目以降の各段のノード数と、各ノードの選択肢の最大数</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	int32 DialogueWidth = 3;
+
+	/// <summary>推理数（半分が証拠の組み合わせ、残りが前提の推理から導かれるもの）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 NumDeductions = 6;
+
+	/// <summary>トリガー数</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 NumTriggers = 3;
+
+	/// <summary>キャラクター1人あたりの移動予定の数</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	int32 ScheduleEntriesPerCharacter = 1;
+
+	/// <summary>対話ノードがフラグを設定する確率、および選択肢がフラグか証拠を要求する確率（0-1）</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "1"))
+	float FlagDensity = 0.3f;
+
+	/// <summary>証拠1件あたりの関連キャラクター・関連証拠の平均数</summary>
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float RelationDensity = 1.5f;
+};
+
+/// <summary>
+/// 負荷試験・プロファイリング用の事件データを生成するクラス
+/// </summary>
+/// <remarks>
+/// 生成される事件は参照が全て解決でき、告発に必要な証拠は全てアクセス可能なロケーションに置かれるため解決可能です。
+/// 乱数は FRandomStream だけを使うので、プラットフォームや実行順に関わらず同じ結果になります。
+/// 開始ノードの選択肢と各ノードの最初の選択肢は条件なしなので、全ての対話ノードに到達できます。
+/// </remarks>
+UCLASS(BlueprintType)
+class THELASTWITNESS_API UStressCaseGenerator : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/// <summary>
+	/// 指定した規模の事件データを生成します
+	/// </summary>
+	UFUNCTION(BlueprintCallable, Category = "Case Data")
+	static FCaseData Generate(const FStressCaseParams& Params);
+
+	/// <summary>
+	/// 出荷している事件の Scale 倍の規模を取得します（対話の深さと密度は変えません）
+	/// </summary>
+	UFUNCTION(BlueprintPure, Category = "Case Data")
+	static FStressCaseParams MakeScaledParams(int32 Scale, int32 Seed = 1);
+};
@@ -24,6 +24,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Case Data")
 	static FCaseData CreateCaseData();
 
+	/// <summary>
+	/// クック済みファイルがあればそこから、無ければコードから事件データを作成します
+	/// </summary>
+	/// <remarks>
+	/// クック済みファイルは CaseCook コマンドレットで CreateCaseData() の結果から作成します。
+	/// 記録された作成元のハッシュが GetSourceHash() と異なる場合は、古いものとして警告し、コードから作成します。
+	/// </remarks>
+	UFUNCTION(BlueprintCallable, Category = "Case Data")
+	static FCaseData LoadCaseData();
+
+	/// <summary>
+	/// 事件データを作成するソースのハッシュを取得します
+	/// </summary>
+	/// <remarks>
+	/// ビルド時に TheLastWitness.Build.cs がソースファイルの内容から計算します。
+	/// CreateCaseData() を実行せずにクック済みファイルの鮮度を判定するために使います。
+	/// </remarks>
+	static uint32 GetSourceHash();
+
 private:
 	/// <summary>
 	/// キャラクターデータを生成します
@@ -49,4 +68,14 @@ private:
 	/// 推理データを生成します
 	/// </summary>
 	static TArray<FDeduction> CreateDeductions();
+
+	/// <summary>
+	/// キャラクターの移動予定を生成します
+	/// </summary>
+	static TArray<FCharacterScheduleEntry> CreateCharacterSchedule();
+
+	/// <summary>
+	/// 進行に応じて発火するトリガーを生成します
+	/// </summary>
+	static TArray<FCaseTrigger> CreateTriggers();
 };
@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "Core/WitnessTypes.h"
+#include "Core/CaseHandles.h"
 #include "DialogueManager.generated.h"
 
 class UCaseState;
+class FCaseDefinition;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDialogueStarted, FName, CharacterId);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDialogueEnded);
@@ -15,6 +17,25 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDialogueNodeChanged, const FDialo
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnChoicesAvailable, const TArray<FDialogueChoice>&, Choices);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEvidenceGainedFromDialogue, const TArray<FName>&, EvidenceIds);
 
+// C++ 向けのネイティブ版（ノードは登録済みツリー内の要素への参照、選択肢は現在のノード内のインデックスを渡します）
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDialogueStartedNative, FName /* CharacterId */);
+DECLARE_MULTICAST_DELEGATE(FOnDialogueEndedNative);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDialogueNodeChangedNative, const FDialogueNode& /* Node */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnChoicesAvailableNative, TConstArrayView<int32> /* ChoiceIndices */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEvidenceGainedFromDialogueNative, TConstArrayView<FName> /* EvidenceIds */);
+
+/// <summary>
+/// 対話の現在位置（チェックポイント用）
+/// </summary>
+struct FDialoguePosition
+{
+	/// <summary>対話相手（None なら対話中ではない）</summary>
+	FName CharacterId;
+
+	/// <summary>現在のノード</summary>
+	FName NodeId;
+};
+
 /// <summary>
 /// 対話システムを管理するクラス
 /// </summary>
@@ -52,8 +73,16 @@ public:
 	/// 選択肢を選びます
 	/// </summary>
 	/// <param name="ChoiceId">選択肢ID</param>
+	/// <returns>対話中でない・選択肢が無いなどで選べなかった場合は false</returns>
 	UFUNCTION(BlueprintCallable, Category = "Dialogue")
-	void SelectChoice(FName ChoiceId);
+	bool SelectChoice(FName ChoiceId);
+
+	/// <summary>
+	/// 現在のノード内の位置で選択肢を選びます（ネイティブ向け）
+	/// </summary>
+	/// <param name="ChoiceIndex">GetAvailableChoiceIndices() が返す、現在のノード内での選択肢の位置</param>
+	/// <returns>位置が不正で選べなかった場合は false</returns>
+	bool SelectChoiceAt(int32 ChoiceIndex);
 
 	/// <summary>
 	/// 次のノードに進みます（選択肢がない場合）
@@ -89,6 +118,31 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	bool GetCurrentNode(FDialogueNode& OutNode) const;
 
+	/// <summary>
+	/// 現在のノードを参照します（コピーは行いません）
+	/// </summary>
+	/// <returns>対話中でなければ nullptr。次のノードへ移動するまで有効です</returns>
+	const FDialogueNode* FindCurrentNode() const;
+
+	/// <summary>
+	/// 現在利用可能な選択肢の、現在のノード内でのインデックスを取得します
+	/// </summary>
+	template <typename AllocatorType>
+	void GetAvailableChoiceIndices(TArray<int32, AllocatorType>& OutIndices) const
+	{
+		OutIndices.Reset();
+		if (const FDialogueNode* Node = FindCurrentNode())
+		{
+			for (int32 ChoiceIndex = 0; ChoiceIndex < Node->Choices.Num(); ChoiceIndex++)
+			{
+				if (CanShowChoice(Node->Choices[ChoiceIndex], ChoiceIndex))
+				{
+					OutIndices.Add(ChoiceIndex);
+				}
+			}
+		}
+	}
+
 	/// <summary>
 	/// 現在利用可能な選択肢を取得します（条件を満たすもののみ）
 	/// </summary>
@@ -107,6 +161,20 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	bool IsAtEndNode() const;
 
+	/// <summary>
+	/// 現在の対話位置を取得します
+	/// </summary>
+	FDialoguePosition GetPosition() const;
+
+	/// <summary>
+	/// 対話位置を復元します
+	/// </summary>
+	/// <remarks>
+	/// 進行状態は別途復元されている前提のため、ノード到達時の証拠取得やフラグ設定は行いません。
+	/// UIが再描画できるよう、ノード変更と選択肢のイベントのみ発火します。
+	/// </remarks>
+	void RestorePosition(const FDialoguePosition& Position);
+
 	// ========================================================================
 	// 対話ツリー管理
 	// ========================================================================
@@ -147,22 +215,54 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FOnEvidenceGainedFromDialogue OnEvidenceGainedFromDialogue;
 
+	// ネイティブ版（C++ のリスナーはこちらを使用してください）
+
+	/// <summary>対話開始時に発火</summary>
+	FOnDialogueStartedNative OnDialogueStartedNative;
+
+	/// <summary>対話終了時に発火</summary>
+	FOnDialogueEndedNative OnDialogueEndedNative;
+
+	/// <summary>ノード変更時に発火</summary>
+	FOnDialogueNodeChangedNative OnDialogueNodeChangedNative;
+
+	/// <summary>選択肢が利用可能になった時に発火（通知中のみ有効なビュー）</summary>
+	FOnChoicesAvailableNative OnChoicesAvailableNative;
+
+	/// <summary>対話から証拠を得た時に発火（通知中のみ有効なビュー）</summary>
+	FOnEvidenceGainedFromDialogueNative OnEvidenceGainedFromDialogueNative;
+
 protected:
 	/// <summary>
 	/// ノードに移動します
 	/// </summary>
 	void GoToNode(FName NodeId);
 
+	/// <summary>
+	/// 現在のツリー内の位置でノードに移動します
+	/// </summary>
+	void GoToNodeIndex(int32 NodeIndex);
+
 	/// <summary>
 	/// 選択肢が表示条件を満たすか確認します
 	/// </summary>
-	bool CanShowChoice(const FDialogueChoice& Choice) const;
+	/// <param name="Choice">選択肢</param>
+	/// <param name="ChoiceIndex">現在のノード内での選択肢の位置</param>
+	bool CanShowChoice(const FDialogueChoice& Choice, int32 ChoiceIndex) const;
 
 	/// <summary>
 	/// ノードから得られる証拠を処理します
 	/// </summary>
+	/// <remarks>
+	/// 事件定義由来のツリーでは、現在のノードについて事前に解決済みの証拠ハンドルを使用します。
+	/// </remarks>
 	void ProcessNodeEvidence(const FDialogueNode& Node);
 
+	/// <summary>
+	/// 現在のノードと選択肢を通知します
+	/// </summary>
+	void BroadcastCurrentNode();
+
 	/// <summary>CaseStateへの参照</summary>
 	UPROPERTY()
 	TObjectPtr<UCaseState> CaseState;
@@ -187,7 +287,32 @@ protected:
 	UPROPERTY()
 	FName CurrentNodeId;
 
+	/// <summary>事前コンパイル済みの条件を参照する事件定義</summary>
+	TSharedPtr<const FCaseDefinition> Definition;
+
+	/// <summary>キャラクターID → 事件定義内の対話ツリーのインデックス</summary>
+	TMap<FName, int32> CompiledTreeIndices;
+
+	/// <summary>現在のツリーの事件定義内インデックス（外部登録のツリーなら INDEX_NONE）</summary>
+	int32 CurrentTreeIndex = INDEX_NONE;
+
+	/// <summary>現在のノードの CurrentTree.Nodes 内インデックス</summary>
+	int32 CurrentNodeIndex = INDEX_NONE;
+
+	/// <summary>現在の対話相手のハンドル（事件定義に登場しない相手なら無効）</summary>
+	FCharacterHandle CurrentCharacter;
+
 private:
+	/// <summary>
+	/// キャラクターの対話ツリーを現在のツリーにします
+	/// </summary>
+	bool EnterTree(FName CharacterId);
+
+	/// <summary>
+	/// ノードのインデックスをIDで検索します
+	/// </summary>
+	int32 FindNodeIndex(FName NodeId) const;
+
 	/// <summary>
 	/// ノードをIDで検索します
 	/// </summary>
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "Core/WitnessTypes.h"
+#include "Core/CaseState.h"
 #include "MainGameWidget.generated.h"
 
 class AWitnessGameMode;
@@ -51,43 +52,57 @@ protected:
 	virtual void NativeDestruct() override;
 
 	// ========================================================================
-	// イベントハンドラ
+	// イベントハンドラ（各システムのネイティブイベントにバインド）
 	// ========================================================================
 
 	/// <summary>
 	/// フェーズ変更時
 	/// </summary>
-	UFUNCTION()
 	void OnPhaseChanged(EGamePhase NewPhase);
 
 	/// <summary>
 	/// 対話ノード変更時
 	/// </summary>
-	UFUNCTION()
 	void OnDialogueNodeChanged(const FDialogueNode& Node);
 
 	/// <summary>
 	/// 選択肢が利用可能になった時
 	/// </summary>
-	UFUNCTION()
-	void OnChoicesAvailable(const TArray<FDialogueChoice>& Choices);
+	void OnChoicesAvailable(TConstArrayView<int32> ChoiceIndices);
 
 	/// <summary>
 	/// ABELが発言した時
 	/// </summary>
-	UFUNCTION()
 	void OnABELSpeaks(const FText& Message);
 
 	/// <summary>
-	/// 証拠収集時
+	/// 証拠収集時（変更通知をまとめるモードでは OnCaseChanged が代わりに更新します）
 	/// </summary>
-	UFUNCTION()
-	void OnEvidenceCollected(const FEvidence& Evidence);
+	void OnEvidenceCollected(int32 EvidenceIndex);
+
+	/// <summary>
+	/// キャラクターの移動時（変更通知をまとめるモードでは OnCaseChanged が代わりに更新します）
+	/// </summary>
+	void OnCharacterMoved(int32 CharacterIndex, int32 FromLocationIndex, int32 ToLocationIndex);
+
+	/// <summary>
+	/// ロケーションのアクセス可否の変化時（変更通知をまとめるモードでは OnCaseChanged が代わりに更新します）
+	/// </summary>
+	void OnLocationAccessChanged(int32 LocationIndex, bool bAccessible);
+
+	/// <summary>
+	/// 進行状態の復元時
+	/// </summary>
+	void OnProgressRestored();
+
+	/// <summary>
+	/// まとめられた変更の通知時
+	/// </summary>
+	void OnCaseChanged(const FCaseChangeSet& Changes);
 
 	/// <summary>
 	/// ゲーム終了時
 	/// </summary>
-	UFUNCTION()
 	void OnGameEnded(const FGameResult& Result);
 
 	// ========================================================================
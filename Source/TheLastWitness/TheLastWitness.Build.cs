@@ -1,5 +1,6 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class TheLastWitness : ModuleRules
@@ -23,5 +24,77 @@ public class TheLastWitness : ModuleRules
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
+
+		// クック済み事件ファイルが古いかどうかを、事件データを作成せずに判定するためのハッシュ
+		PrivateDefinitions.Add(string.Format("THELASTWITNESS_CASE_SOURCE_HASH=0x{0:X8}u", CaseSourceHash.Compute(ModuleDirectory)));
+	}
+}
+
+/// <summary>
+/// コードで作成する事件データのソースのハッシュ（TheLastWitnessEditor.Target.cs と共有）
+/// </summary>
+public static class CaseSourceHash
+{
+	/// <summary>FCookedCase::Version と合わせること</summary>
+	public const uint CookedVersion = 2;
+
+	/// <summary>事件データの内容を決めるソースファイル（モジュールディレクトリからの相対パス）</summary>
+	private static readonly string[] SourceFiles = {
+		"Private/Data/TheLastWitnessCaseData.cpp",
+		"Public/Core/WitnessIds.inl",
+		"Public/Core/WitnessTypes.h"
+	};
+
+	/// <summary>
+	/// ソースファイルの内容から FNV-1a ハッシュを計算します
+	/// </summary>
+	public static uint Compute(string ModuleDirectory)
+	{
+		uint Hash = 2166136261;
+		foreach (string RelativePath in SourceFiles)
+		{
+			string FilePath = Path.Combine(ModuleDirectory, RelativePath);
+			if (!File.Exists(FilePath))
+			{
+				continue;
+			}
+			foreach (byte Value in File.ReadAllBytes(FilePath))
+			{
+				// チェックアウト時の改行コードの違いでハッシュが変わらないよう、CR は無視する
+				if (Value == (byte)'\r')
+				{
+					continue;
+				}
+				Hash = (Hash ^ Value) * 16777619;
+			}
+		}
+		return Hash;
+	}
+
+	/// <summary>
+	/// クック済みファイルが現在のソースからクックされたものか確認します
+	/// </summary>
+	/// <remarks>
+	/// FCookedCaseHeader の Magic, Version, TotalSize, PayloadCrc, SourceHash の並びを前提に読み取ります。
+	/// </remarks>
+	public static bool IsCookedFileCurrent(string CookedPath, string ModuleDirectory)
+	{
+		if (!File.Exists(CookedPath))
+		{
+			return false;
+		}
+		using (BinaryReader Reader = new BinaryReader(File.OpenRead(CookedPath)))
+		{
+			if (Reader.BaseStream.Length < 20)
+			{
+				return false;
+			}
+			Reader.ReadUInt32();
+			uint Version = Reader.ReadUInt32();
+			Reader.ReadUInt32();
+			Reader.ReadUInt32();
+			uint SourceHash = Reader.ReadUInt32();
+			return Version == CookedVersion && SourceHash == Compute(ModuleDirectory);
+		}
 	}
 }
@@ -2,6 +2,7 @@
 
 using UnrealBuildTool;
 using System.Collections.Generic;
+using System.IO;
 
 public class TheLastWitnessEditorTarget : TargetRules
 {
@@ -11,5 +12,20 @@ public class TheLastWitnessEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.Latest;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
 		ExtraModuleNames.Add("TheLastWitness");
+
+		// 事件データのソースが変わっていたら、ビルドしたエディタでクック済み事件ファイルを作り直す
+		// （Content/Cases はパッケージに含まれるため、パッケージ前のエディタのビルドで最新になる）
+		if (ProjectFile != null)
+		{
+			string ProjectDir = ProjectFile.Directory.FullName;
+			string CookedPath = Path.Combine(ProjectDir, "Content", "Cases", "TheLastWitness.lwcase");
+			if (!CaseSourceHash.IsCookedFileCurrent(CookedPath, Path.Combine(ProjectDir, "Source", "TheLastWitness")))
+			{
+				string EditorCmd = Platform == UnrealTargetPlatform.Win64
+					? "$(EngineDir)\\Binaries\\Win64\\UnrealEditor-Cmd.exe"
+					: "$(EngineDir)/Binaries/" + Platform + "/UnrealEditor";
+				PostBuildSteps.Add(string.Format("\"{0}\" \"$(ProjectFile)\" -run=CaseCook -unattended -nullrhi -nosplash", EditorCmd));
+			}
+		}
 	}
 }